@@ -225,3 +225,122 @@ class AvgChunkFile:
 
           self.timesteps.append(timestep)
           self.total_count.append(total_count)
+
+class ColumnarDump:
+  """Streaming reader for files written by the LAMMPS columnar dump style
+
+  The file is memory-mapped and frames are decoded lazily while iterating.
+  Uncompressed columns of a single chunk are returned as zero-copy views
+  into the mapped file; columns from multiple chunks are concatenated.
+  Columns compressed with zstd require the ``zstandard`` Python module.
+  Column data is returned as NumPy arrays if NumPy is available and as
+  typed memoryviews otherwise.
+
+  :param filename: path to columnar dump file
+  :type  filename: str
+
+  Each frame is a dictionary with the keys "timestep", "natoms",
+  "triclinic", "boundary", "box", "units", "time", "thermo", and
+  "columns", where "columns" maps the column names to their data.
+  """
+
+  MAGIC = b'LMPCOLS\0'
+  DTYPES = { 0 : ('i', 4), 1 : ('q', 8), 2 : ('f', 4), 3 : ('d', 8) }
+  RAW  = 0
+  ZSTD = 1
+
+  def __init__(self, filename):
+    import mmap
+    self.file = open(filename, 'rb')
+    self.map = mmap.mmap(self.file.fileno(), 0, access=mmap.ACCESS_READ)
+    self.view = memoryview(self.map)
+
+  def close(self):
+    self.view.release()
+    self.map.close()
+    self.file.close()
+
+  def __enter__(self):
+    return self
+
+  def __exit__(self, *args):
+    self.close()
+
+  def __iter__(self):
+    offset = 0
+    while offset < len(self.map):
+      frame, offset = self._read_frame(offset)
+      yield frame
+
+  def _unpack(self, fmt, offset):
+    import struct
+    values = struct.unpack_from('<' + fmt, self.map, offset)
+    return values, offset + struct.calcsize('<' + fmt)
+
+  def _read_string(self, offset):
+    (n,), offset = self._unpack('i', offset)
+    return bytes(self.map[offset:offset+n]).decode(), offset + n
+
+  def _column(self, data, typecode):
+    try:
+      import numpy as np
+      return np.frombuffer(data, dtype=typecode)
+    except ImportError:
+      return memoryview(data).cast(typecode)
+
+  def _read_frame(self, offset):
+    if self.map[offset:offset+8] != self.MAGIC:
+      raise Exception("Not a LAMMPS columnar dump frame at offset %d" % offset)
+    (version, endian), offset = self._unpack('ii', offset + 8)
+    if endian != 1:
+      raise Exception("Columnar dump file has incompatible byte order")
+    if version != 1:
+      raise Exception("Unsupported columnar dump format version %d" % version)
+
+    frame = {}
+    (frame['timestep'], frame['natoms'], nchunk), offset = self._unpack('qqi', offset)
+    values, offset = self._unpack('7i', offset)
+    frame['triclinic'] = values[0]
+    frame['boundary'] = list(values[1:])
+    frame['box'], offset = self._unpack('9d' if frame['triclinic'] else '6d', offset)
+    frame['units'], offset = self._read_string(offset)
+    (flag,), offset = self._unpack('B', offset)
+    frame['time'] = None
+    if flag:
+      (frame['time'],), offset = self._unpack('d', offset)
+
+    frame['thermo'] = {}
+    (nthermo,), offset = self._unpack('i', offset)
+    for i in range(nthermo):
+      key, offset = self._read_string(offset)
+      (frame['thermo'][key],), offset = self._unpack('d', offset)
+
+    names = []
+    types = []
+    (ncol,), offset = self._unpack('i', offset)
+    for i in range(ncol):
+      name, offset = self._read_string(offset)
+      (dtype,), offset = self._unpack('B', offset)
+      names.append(name)
+      types.append(dtype)
+
+    parts = [[] for i in range(ncol)]
+    for ichunk in range(nchunk):
+      (nrows,), offset = self._unpack('i', offset)
+      for i in range(ncol):
+        (codec, nbytes), offset = self._unpack('Bq', offset)
+        data = self.view[offset:offset+nbytes]
+        offset += nbytes
+        if codec == self.ZSTD:
+          import zstandard
+          width = self.DTYPES[types[i]][1]
+          data = zstandard.ZstdDecompressor().decompress(data, max_output_size=nrows*width)
+        elif codec != self.RAW:
+          raise Exception("Unknown columnar dump codec %d" % codec)
+        parts[i].append(data)
+
+    frame['columns'] = {}
+    for i, name in enumerate(names):
+      data = parts[i][0] if len(parts[i]) == 1 else b''.join(parts[i])
+      frame['columns'][name] = self._column(data, self.DTYPES[types[i]][0])
+    return frame, offset
@@ -223,7 +223,8 @@ void NPairHalfBinNewtonSSA::build(NeighList *list)
         }
         ipage->vgot(n);
         if (ipage->status())
-          error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+          error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                            "boost neigh_modify one", ipage->chunkmax);
       }
     }
     // record where workItem ends in ilist
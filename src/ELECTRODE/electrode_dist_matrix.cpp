@@ -0,0 +1,217 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "electrode_dist_matrix.h"
+
+#include "comm.h"
+#include "error.h"
+#include "memory.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+extern "C" {
+void dgetrf_(const int *M, const int *N, double *A, const int *lda, int *ipiv, int *info);
+void dgetri_(const int *N, double *A, const int *lda, const int *ipiv, double *work,
+             const int *lwork, int *info);
+}
+
+/* ---------------------------------------------------------------------- */
+
+ElectrodeDistMatrix::ElectrodeDistMatrix(LAMMPS *lmp, bigint n_global, int block_size) :
+    Pointers(lmp), n(n_global), nb(block_size), nrows(0), rows(nullptr), scratch(nullptr),
+    assemble_rows(nullptr)
+{
+  me = comm->me;
+  nprocs = comm->nprocs;
+  if (nb < 1) error->all(FLERR, "Illegal block size {} for distributed electrode matrix", nb);
+
+  // a block of rows must fit into a single MPI message during inversion
+
+  if ((bigint) nb * n > MAXSMALLINT)
+    error->all(FLERR, "Block of {} rows of electrode matrix is too large", nb);
+
+  // list rows in rank order: all rows of proc 0 first, then proc 1, ...
+
+  bigint const nblocks = (n + nb - 1) / nb;
+  nrows_proc.assign(nprocs, 0);
+  displs.assign(nprocs, 0);
+  order.clear();
+  order.reserve(n);
+  for (int p = 0; p < nprocs; p++) {
+    displs[p] = order.size();
+    for (bigint b = p; b < nblocks; b += nprocs)
+      for (bigint r = b * nb; r < std::min(n, (b + 1) * nb); r++) order.push_back(r);
+    nrows_proc[p] = order.size() - displs[p];
+  }
+  nrows = nrows_proc[me];
+  row_ids.assign(order.begin() + displs[me], order.begin() + displs[me] + nrows);
+  ybuf.resize(n);
+
+  memory->create(rows, nrows, n, "electrode:dist_rows");
+}
+
+/* ---------------------------------------------------------------------- */
+
+ElectrodeDistMatrix::~ElectrodeDistMatrix()
+{
+  memory->destroy(rows);
+  memory->destroy(scratch);
+  memory->sfree(assemble_rows);
+}
+
+/* ----------------------------------------------------------------------
+   allocate and zero a full scratch matrix in rank order for assembly
+   returned row pointers are indexed by global row
+------------------------------------------------------------------------- */
+
+double **ElectrodeDistMatrix::assemble_begin()
+{
+  memory->create(scratch, n, n, "electrode:dist_scratch");
+  assemble_rows =
+      (double **) memory->smalloc((bigint) sizeof(double *) * n, "electrode:dist_assemble");
+  if (n) memset(&scratch[0][0], 0, sizeof(double) * n * n);
+  for (bigint r = 0; r < n; r++) assemble_rows[r] = scratch[displs[owner(r)] + local_index(r)];
+  return assemble_rows;
+}
+
+/* ----------------------------------------------------------------------
+   sum assembled contributions of all procs onto the owned rows
+   with a single reduce-scatter, then release the scratch matrix
+------------------------------------------------------------------------- */
+
+void ElectrodeDistMatrix::assemble_end()
+{
+  double *sendbuf = n ? &scratch[0][0] : nullptr;
+  double *recvbuf = nrows ? &rows[0][0] : nullptr;
+  bool fits = true;
+  for (int p = 0; p < nprocs; p++)
+    if ((bigint) nrows_proc[p] * n > MAXSMALLINT) fits = false;
+
+  if (fits) {
+    std::vector<int> counts(nprocs);
+    for (int p = 0; p < nprocs; p++) counts[p] = nrows_proc[p] * n;
+    MPI_Reduce_scatter(sendbuf, recvbuf, counts.data(), MPI_DOUBLE, MPI_SUM, world);
+  } else {
+
+    // counts exceed the MPI int limit, reduce one block of rows at a time
+
+    for (bigint k0 = 0; k0 < n; k0 += nb) {
+      int const root = owner(k0);
+      int const count = std::min((bigint) nb, n - k0) * n;
+      double *dest = (me == root) ? rows[local_index(k0)] : nullptr;
+      MPI_Reduce(assemble_rows[k0], dest, count, MPI_DOUBLE, MPI_SUM, root, world);
+    }
+  }
+
+  memory->destroy(scratch);
+  memory->sfree(assemble_rows);
+  scratch = nullptr;
+  assemble_rows = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   y = A x for full vectors x and y, identical on all procs
+------------------------------------------------------------------------- */
+
+void ElectrodeDistMatrix::matvec(const double *x, double *y)
+{
+  double *ylocal = ybuf.data() + displs[me];
+  for (int l = 0; l < nrows; l++) {
+    double const *_noalias row = rows[l];
+    double yl = 0.0;
+    for (bigint j = 0; j < n; j++) yl += row[j] * x[j];
+    ylocal[l] = yl;
+  }
+  MPI_Allgatherv(MPI_IN_PLACE, nrows, MPI_DOUBLE, ybuf.data(), nrows_proc.data(), displs.data(),
+                 MPI_DOUBLE, world);
+  for (bigint k = 0; k < n; k++) y[order[k]] = ybuf[k];
+}
+
+/* ----------------------------------------------------------------------
+   in-place inversion by blocked Gauss-Jordan elimination without pivoting
+   between blocks, valid for symmetric positive definite matrices.
+   diagonal blocks are inverted with LAPACK by their owner, who broadcasts
+   the scaled block of rows, all procs then eliminate it from their rows
+------------------------------------------------------------------------- */
+
+void ElectrodeDistMatrix::invert()
+{
+  std::vector<double> panel;
+  std::vector<double> akk((size_t) nb * nb), work((size_t) nb * nb), f(nb);
+  std::vector<int> ipiv(nb);
+  int const lwork = nb * nb;
+
+  for (bigint k0 = 0; k0 < n; k0 += nb) {
+    int const kb = std::min((bigint) nb, n - k0);
+    int const root = owner(k0);
+    panel.resize((size_t) kb * n);
+
+    if (me == root) {
+      bigint const l0 = local_index(k0);
+      for (int i = 0; i < kb; i++) {
+        for (int m = 0; m < kb; m++) {
+          akk[i * kb + m] = rows[l0 + i][k0 + m];
+          rows[l0 + i][k0 + m] = (i == m) ? 1.0 : 0.0;
+        }
+      }
+      int info_rf, info_ri;
+      dgetrf_(&kb, &kb, akk.data(), &kb, ipiv.data(), &info_rf);
+      dgetri_(&kb, akk.data(), &kb, ipiv.data(), work.data(), &lwork, &info_ri);
+      if (info_rf != 0 || info_ri != 0) error->one(FLERR, "CONP matrix inversion failed!");
+
+      std::fill(panel.begin(), panel.end(), 0.0);
+      for (int i = 0; i < kb; i++) {
+        double *_noalias w = &panel[(size_t) i * n];
+        for (int m = 0; m < kb; m++) {
+          double const aim = akk[i * kb + m];
+          double const *_noalias a = rows[l0 + m];
+          for (bigint j = 0; j < n; j++) w[j] += aim * a[j];
+        }
+      }
+    }
+    MPI_Bcast(panel.data(), kb * n, MPI_DOUBLE, root, world);
+
+    for (int l = 0; l < nrows; l++) {
+      double *_noalias a = rows[l];
+      bigint const r = row_ids[l];
+      if (r >= k0 && r < k0 + kb) {
+        memcpy(a, &panel[(size_t) (r - k0) * n], sizeof(double) * n);
+        continue;
+      }
+      for (int m = 0; m < kb; m++) {
+        f[m] = a[k0 + m];
+        a[k0 + m] = 0.0;
+      }
+      for (int m = 0; m < kb; m++) {
+        double const fm = f[m];
+        if (fm == 0.0) continue;
+        double const *_noalias w = &panel[(size_t) m * n];
+        for (bigint j = 0; j < n; j++) a[j] -= fm * w[j];
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double ElectrodeDistMatrix::memory_usage()
+{
+  double bytes = (double) nrows * n * sizeof(double);    // rows
+  bytes += (double) n * (sizeof(int) + sizeof(double));    // order, ybuf
+  bytes += (double) nrows * sizeof(bigint);                // row_ids
+  bytes += (double) nprocs * 2 * sizeof(int);              // nrows_proc, displs
+  return bytes;
+}
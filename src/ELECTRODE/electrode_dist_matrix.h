@@ -0,0 +1,58 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_ELECTRODE_DIST_MATRIX_H
+#define LMP_ELECTRODE_DIST_MATRIX_H
+
+#include "pointers.h"
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+// dense n x n matrix whose rows are distributed block-cyclically over all
+// procs: block b of nb consecutive rows is owned by proc b % nprocs
+
+class ElectrodeDistMatrix : protected Pointers {
+ public:
+  ElectrodeDistMatrix(class LAMMPS *, bigint, int);
+  ~ElectrodeDistMatrix() override;
+
+  double **assemble_begin();
+  void assemble_end();
+  void matvec(const double *, double *);
+  void invert();
+  double memory_usage();
+
+  bigint n;                       // global size of matrix
+  int nb;                         // # of rows in one block
+  int nrows;                      // # of rows owned by me
+  double **rows;                  // my rows, nrows x n
+  std::vector<bigint> row_ids;    // global index of each of my rows
+
+ private:
+  int me, nprocs;
+  std::vector<int> nrows_proc;    // # of rows owned by each proc
+  std::vector<int> displs;        // offset of each proc's rows in rank order
+  std::vector<int> order;         // global row index of rows in rank order
+  std::vector<double> ybuf;       // gathered matvec result in rank order
+  double **scratch;               // full matrix during assembly, in rank order
+  double **assemble_rows;         // row pointers into scratch, indexed by global row
+
+  int owner(bigint r) const { return static_cast<int>((r / nb) % nprocs); }
+  bigint local_index(bigint r) const { return (r / ((bigint) nb * nprocs)) * nb + r % nb; }
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
@@ -19,6 +19,7 @@
 
 #include "atom.h"
 #include "comm.h"
+#include "electrode_dist_matrix.h"
 #include "electrode_kspace.h"
 #include "electrode_math.h"
 #include "error.h"
@@ -75,9 +76,38 @@ void ElectrodeMatrix::setup_tf(const std::map<int, double> &tf_types)
 void ElectrodeMatrix::compute_array(double **array, bool timer_flag)
 {
   // setting all entries of coulomb matrix to zero
-  size_t nbytes = sizeof(double) * ngroup * ngroup;
-  if (nbytes) memset(&array[0][0], 0, nbytes);
+  bigint const ntotal = ngroup * ngroup;
+  if (ntotal) memset(&array[0][0], 0, sizeof(double) * ntotal);
 
+  compute_contributions(array, timer_flag);
+
+  // reduce coulomb matrix with contributions from all procs
+  // all procs need to know full matrix for matrix inversion
+  // use a single reduction unless the count exceeds the MPI int limit
+  for (bigint offset = 0; offset < ntotal; offset += MAXSMALLINT) {
+    int const count = MIN(MAXSMALLINT, ntotal - offset);
+    MPI_Allreduce(MPI_IN_PLACE, &array[0][0] + offset, count, MPI_DOUBLE, MPI_SUM, world);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   assemble coulomb matrix into a row-distributed matrix
+   contributions are summed onto the owning procs with one reduce-scatter
+------------------------------------------------------------------------- */
+
+void ElectrodeMatrix::compute_array(ElectrodeDistMatrix *matrix, bool timer_flag)
+{
+  compute_contributions(matrix->assemble_begin(), timer_flag);
+  matrix->assemble_end();
+}
+
+/* ----------------------------------------------------------------------
+   add contributions of my atoms to zeroed coulomb matrix
+   only row pointers of array are used, rows need not be contiguous
+------------------------------------------------------------------------- */
+
+void ElectrodeMatrix::compute_contributions(double **array, bool timer_flag)
+{
   MPI_Barrier(world);
   double kspace_time = MPI_Wtime();
   update_mpos();
@@ -91,12 +121,6 @@ void ElectrodeMatrix::compute_array(double **array, bool timer_flag)
   self_contribution(array);
   electrode_kspace->compute_matrix_corr(&mpos[0], array);
   if (tfflag) tf_contribution(array);
-
-  // reduce coulomb matrix with contributions from all procs
-  // all procs need to know full matrix for matrix inversion
-  for (int i = 0; i < ngroup; i++) {
-    MPI_Allreduce(MPI_IN_PLACE, &array[i][0], ngroup, MPI_DOUBLE, MPI_SUM, world);
-  }
 }
 
 /* ---------------------------------------------------------------------- */
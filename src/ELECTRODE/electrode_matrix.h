@@ -31,6 +31,7 @@ class ElectrodeMatrix : protected Pointers {
   void setup(const std::unordered_map<tagint, int> &, class Pair *, class NeighList *);
   void setup_tf(const std::map<int, double> &);
   void compute_array(double **, bool);
+  void compute_array(class ElectrodeDistMatrix *, bool);
   int igroup;
 
  private:
@@ -48,6 +49,7 @@ class ElectrodeMatrix : protected Pointers {
   class ElectrodeKSpace *electrode_kspace;
 
   void update_mpos();
+  void compute_contributions(double **, bool);
   void pair_contribution(double **);
   void self_contribution(double **);
   void tf_contribution(double **);
@@ -65,6 +65,7 @@ void EwaldElectrode::init()
   if (domain->triclinic) error->all(FLERR, "Cannot (yet) use ewald/electrode with triclinic box ");
   // triclinic_check();
   if (domain->dimension == 2) error->all(FLERR, "Cannot use ewald/electrode with 2d simulation");
+  if (sfac_overlap) error->all(FLERR, "Cannot use kspace_modify sfac/overlap with ewald/electrode");
 
   if (!atom->q_flag) error->all(FLERR, "KSpace style ewald/electrode requires atom attribute q");
 
@@ -21,6 +21,7 @@
 #include "citeme.h"
 #include "comm.h"
 #include "domain.h"
+#include "electrode_dist_matrix.h"
 #include "electrode_math.h"
 #include "electrode_matrix.h"
 #include "electrode_vector.h"
@@ -50,6 +51,8 @@ using namespace MathConst;
 
 #define SMALL 1e-16
 
+static constexpr int DIST_BLOCK = 64;    // row block size of distributed matrix
+
 extern "C" {
 void dgetrf_(const int *M, const int *N, double *A, const int *lda, int *ipiv, int *info);
 void dgetri_(const int *N, double *A, const int *lda, const int *ipiv, double *work,
@@ -73,7 +76,7 @@ static const char cite_fix_electrode[] =
 // fix fxupdate group1 electrode/conp pot1 eta couple group2 pot2
 FixElectrodeConp::FixElectrodeConp(LAMMPS *lmp, int narg, char **arg) :
     Fix(lmp, narg, arg), elyt_vector(nullptr), elec_vector(nullptr), capacitance(nullptr),
-    elastance(nullptr), pair(nullptr), mat_neighlist(nullptr), vec_neighlist(nullptr),
+    elastance(nullptr), dist_matrix(nullptr), pair(nullptr), mat_neighlist(nullptr), vec_neighlist(nullptr),
     recvcounts(nullptr), displs(nullptr), iele_gathered(nullptr), buf_gathered(nullptr),
     potential_i(nullptr), potential_iele(nullptr)
 {
@@ -92,6 +95,7 @@ FixElectrodeConp::FixElectrodeConp(LAMMPS *lmp, int narg, char **arg) :
   write_inv = write_mat = write_vec = read_inv = read_mat = false;
   symm = false;
   ffield = false;
+  distributed = false;
   thermo_time = 0.;
 
   top_group = 0;
@@ -202,6 +206,9 @@ FixElectrodeConp::FixElectrodeConp(LAMMPS *lmp, int narg, char **arg) :
       symm = utils::logical(FLERR, arg[++iarg], false, lmp);
     } else if ((strcmp(arg[iarg], "ffield") == 0)) {
       ffield = utils::logical(FLERR, arg[++iarg], false, lmp);
+    } else if ((strcmp(arg[iarg], "distributed") == 0)) {
+      if (iarg + 2 > narg) error->all(FLERR, "Need one argument after distributed keyword");
+      distributed = utils::logical(FLERR, arg[++iarg], false, lmp);
     } else {
       error->all(FLERR, "Unknown keyword {} for fix {} command", arg[iarg], style);
     }
@@ -240,6 +247,11 @@ FixElectrodeConp::FixElectrodeConp(LAMMPS *lmp, int narg, char **arg) :
                "Selected algorithm does not use matrix. Cannot read/write matrix or vector.");
   }
   if (read_inv && read_mat) error->all(FLERR, "Cannot read matrix from two files");
+  if (distributed) {
+    if (!matrix_algo) error->all(FLERR, "Distributed matrix requires algo mat_inv or mat_cg");
+    if (read_inv || read_mat || write_inv || write_mat)
+      error->all(FLERR, "Cannot read or write matrix files with distributed matrix");
+  }
   if (write_mat && read_inv)
     error->all(FLERR, "Cannot write elastance matrix if reading capacitance matrix from file");
   num_of_groups = static_cast<int>(groups.size());
@@ -490,7 +502,12 @@ void FixElectrodeConp::setup_post_neighbor()
 
     memory->destroy(elastance);
     memory->destroy(capacitance);
-    memory->create(elastance, ngroup, ngroup, "fix_electrode:matrix");
+    delete dist_matrix;
+    dist_matrix = nullptr;
+    if (distributed)
+      dist_matrix = new ElectrodeDistMatrix(lmp, ngroup, DIST_BLOCK);
+    else
+      memory->create(elastance, ngroup, ngroup, "fix_electrode:matrix");
     if (read_mat)
       read_from_file(input_file_mat, elastance, "elastance");
     else if (!read_inv) {
@@ -498,7 +515,10 @@ void FixElectrodeConp::setup_post_neighbor()
       auto array_compute = std::unique_ptr<ElectrodeMatrix>(new ElectrodeMatrix(lmp, igroup, eta));
       array_compute->setup(tag_to_iele, pair, mat_neighlist);
       if (tfflag) { array_compute->setup_tf(tf_types); }
-      array_compute->compute_array(elastance, timer_flag);
+      if (distributed)
+        array_compute->compute_array(dist_matrix, timer_flag);
+      else
+        array_compute->compute_array(elastance, timer_flag);
     }    // write_mat before proceeding
     if (comm->me == 0 && write_mat) {
       auto f_mat = fopen(output_file_mat.c_str(), "w");
@@ -582,6 +602,13 @@ void FixElectrodeConp::invert()
   MPI_Barrier(world);
   double invert_time = MPI_Wtime();
   if (timer_flag && (comm->me == 0)) utils::logmesg(lmp, "CONP inverting matrix\n");
+  if (distributed) {
+    dist_matrix->invert();
+    MPI_Barrier(world);
+    if (timer_flag && (comm->me == 0))
+      utils::logmesg(lmp, "Invert time: {:.4g} s\n", MPI_Wtime() - invert_time);
+    return;
+  }
   int m = ngroup, n = ngroup, lda = ngroup;
   std::vector<int> ipiv(ngroup);
   int const lwork = ngroup * ngroup;
@@ -608,6 +635,18 @@ void FixElectrodeConp::symmetrize()
   assert(algo == Algo::MATRIX_INV);
   std::vector<double> AinvE(ngroup, 0.);
   double EAinvE = 0.0;
+  if (distributed) {
+    // row sums of my rows, gathered as product with vector of ones
+    std::vector<double> ones(ngroup, 1.);
+    dist_matrix->matvec(&ones.front(), &AinvE.front());
+    for (int i = 0; i < ngroup; i++) EAinvE += AinvE[i];
+    for (int l = 0; l < dist_matrix->nrows; l++) {
+      double *_noalias caprow = dist_matrix->rows[l];
+      double iAinvE = AinvE[dist_matrix->row_ids[l]];
+      for (int j = 0; j < ngroup; j++) { caprow[j] -= AinvE[j] * iAinvE / EAinvE; }
+    }
+    return;
+  }
   for (int i = 0; i < ngroup; i++) {
     double AinvEtmp = 0.0;
     for (int j = 0; j < ngroup; j++) { AinvEtmp += capacitance[i][j]; }
@@ -711,6 +750,16 @@ void FixElectrodeConp::pre_reverse(int eflag, int /*vflag*/)
 void FixElectrodeConp::compute_sd_vectors()
 {
   assert(algo == Algo::MATRIX_INV);
+  if (distributed) {
+    // sums over the columns of a group are a product with the group indicator vector
+    std::vector<double> e(ngroup), sd(ngroup);
+    for (int g = 0; g < num_of_groups; g++) {
+      for (int j = 0; j < ngroup; j++) e[j] = (iele_to_group[j] == g) ? evscale : 0.;
+      dist_matrix->matvec(&e.front(), &sd.front());
+      for (int k = 0; k < ngroup; k++) sd_vectors[g][k] += sd[k];
+    }
+    return;
+  }
   for (int g = 0; g < num_of_groups; g++) {
     for (int j = 0; j < ngroup; j++) {
       if (iele_to_group[j] == g) {
@@ -729,6 +778,23 @@ void FixElectrodeConp::compute_sd_vectors_ffield()
   int *mask = atom->mask;
   tagint *tag = atom->tag;
   double zprd = domain->prd[2];
+  if (distributed) {
+    // collect weights of all electrode atoms, then multiply with capacitance
+    std::vector<double> w(ngroup, 0.), sd(ngroup);
+    for (int i = 0; i < atom->nlocal; i++) {
+      if (mask[i] & groupbit) {
+        double const zprd_offset = (mask[i] & group_bits[top_group]) ? 0.0 : 1.0;
+        w[tag_to_iele[tag[i]]] = evscale * (x[i][2] / zprd + zprd_offset);
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &w.front(), ngroup, MPI_DOUBLE, MPI_SUM, world);
+    dist_matrix->matvec(&w.front(), &sd.front());
+    for (int g = 0; g < num_of_groups; g++) {
+      double gmult = (g == top_group) ? -1.0 : 1.0;
+      for (int k = 0; k < ngroup; k++) sd_vectors[g][k] += gmult * sd[k];
+    }
+    return;
+  }
   for (int i = 0; i < atom->nlocal; i++) {
     if (mask[i] & groupbit) {
       int const i_iele = tag_to_iele[tag[i]];
@@ -794,11 +860,20 @@ void FixElectrodeConp::update_charges()
     buffer_and_gather(potential_i, potential_iele);
     MPI_Barrier(world);
     double mult_start = MPI_Wtime();
+    std::vector<double> cpot;
+    if (distributed) {
+      cpot.resize(ngroup);
+      dist_matrix->matvec(potential_iele, &cpot.front());
+    }
     for (int i_iele = 0; i_iele < nlocalele; i_iele++) {
       double q_tmp = 0;
       int const iele = list_iele[i_iele];
-      double *_noalias caprow = capacitance[iele];
-      for (int j = 0; j < ngroup; j++) { q_tmp -= caprow[j] * potential_iele[j]; }
+      if (distributed) {
+        q_tmp = -cpot[iele];
+      } else {
+        double *_noalias caprow = capacitance[iele];
+        for (int j = 0; j < ngroup; j++) { q_tmp -= caprow[j] * potential_iele[j]; }
+      }
       q_local[i_iele] = q_tmp;
       sb_charges[iele_to_group[iele]] += q_tmp;
     }
@@ -964,6 +1039,12 @@ std::vector<double> FixElectrodeConp::times_elastance(std::vector<double> x)
 {
   assert((int)x.size() == ngroup);
   auto out = std::vector<double>(nlocalele, 0.);
+  if (distributed) {
+    std::vector<double> y(ngroup);
+    dist_matrix->matvec(&x.front(), &y.front());
+    for (int i = 0; i < nlocalele; i++) out[i] = y[list_iele[i]];
+    return out;
+  }
   for (int i = 0; i < nlocalele; i++) {
     double *_noalias row = elastance[list_iele[i]];
     double oi = 0;
@@ -1224,6 +1305,7 @@ FixElectrodeConp::~FixElectrodeConp()
   delete elyt_vector;
   memory->destroy(elastance);
   memory->destroy(capacitance);
+  delete dist_matrix;
   if (need_elec_vector) delete elec_vector;
 }
 
@@ -1453,7 +1535,10 @@ double FixElectrodeConp::memory_usage()
   bytes += nmax * (sizeof(double));    // potential_i
   if (matrix_algo) {
     bytes += ngroup * (sizeof(int) + 2 * sizeof(double));    // iele_gathered, buf_gathered, pot
-    bytes += ngroup * ngroup * sizeof(double);               // capacitance or elastance
+    if (dist_matrix)    // capacitance or elastance
+      bytes += dist_matrix->memory_usage();
+    else
+      bytes += ngroup * ngroup * sizeof(double);
     bytes += list_iele.capacity() * sizeof(int);
     bytes += buf_iele.capacity() * sizeof(double);
     bytes += nprocs * (2 * sizeof(int));                               // displs, recvcounts
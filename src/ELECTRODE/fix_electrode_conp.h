@@ -35,6 +35,7 @@ FixStyle(electrode/conp, FixElectrodeConp);
 namespace LAMMPS_NS {
 // forward decls
 
+class ElectrodeDistMatrix;
 class ElectrodeVector;
 class NeighList;
 class Pair;
@@ -107,6 +108,8 @@ class FixElectrodeConp : public Fix {
   std::string input_file_inv, input_file_mat;
   ElectrodeVector *elyt_vector, *elec_vector;
   double **capacitance, **elastance;
+  ElectrodeDistMatrix *dist_matrix;    // row-distributed capacitance or elastance
+  bool distributed;
   bool read_inv, read_mat, write_inv, write_mat, write_vec;
   bool matrix_algo, need_array_compute, need_elec_vector;
   double eta, cg_threshold;
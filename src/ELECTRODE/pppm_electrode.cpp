@@ -269,8 +269,11 @@ void PPPMElectrode::init()
 
   // allocate K-space dependent memory
   // don't invoke allocate peratom() or group(), will be allocated when needed
+  // choose # of FFT batches once the FFTs exist
 
+  fft_nbatch = (fft_batch > 0) ? fft_batch : 1;
   allocate();
+  if (fft_batch == 0) tune_fft_batch();
 
   // pre-compute Green's function denomiator expansion
   // pre-compute 1d charge distribution coefficients
@@ -1068,21 +1071,9 @@ void PPPMElectrode::allocate()
                           "pppm:drho_coeff");
 
   // create 2 FFTs and a Remap
-  // 1st FFT keeps data in FFT decomposition
-  // 2nd FFT returns data in 3d brick decomposition
   // remap takes data from 3d brick to FFT decomposition
 
-  int tmp;
-
-  fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
-
-  fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+  create_fft(fft_nbatch);
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
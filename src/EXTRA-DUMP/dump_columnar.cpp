@@ -0,0 +1,297 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "dump_columnar.h"
+
+#include "domain.h"
+#include "error.h"
+#include "output.h"
+#include "thermo.h"
+#include "update.h"
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef LAMMPS_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+// every frame starts with this 8 byte magic, followed by the format version
+// and an endian marker, so that frames are self-contained when split into
+// one file per timestep
+
+static const char MAGIC[8] = {'L', 'M', 'P', 'C', 'O', 'L', 'S', '\0'};
+static constexpr int32_t VERSION = 1;
+static constexpr int32_t ENDIAN = 0x0001;
+
+/* ---------------------------------------------------------------------- */
+
+DumpColumnar::DumpColumnar(LAMMPS *lmp, int narg, char **arg) :
+    DumpCustom(lmp, narg, arg), dtype(nullptr), single(0), codec(RAW), level(0), thermo(false)
+{
+  // data is always written as typed binary, never converted to strings
+
+  binary = 1;
+  buffer_allow = 0;
+  buffer_flag = 0;
+
+  // map per-atom values to on-disk types
+  // atom and molecule IDs are always stored as 64-bit integers
+  // earg is still valid here, it is freed by the DumpCustom destructor
+
+  dtype = new int[nfield];
+  for (int i = 0; i < nfield; i++) {
+    if (vtype[i] == Dump::STRING)
+      error->all(FLERR, "Dump columnar does not support string attribute {}", earg[i]);
+    if ((strcmp(earg[i], "id") == 0) || (strcmp(earg[i], "mol") == 0))
+      dtype[i] = INT64;
+    else if (vtype[i] == Dump::INT)
+      dtype[i] = INT32;
+    else if (vtype[i] == Dump::BIGINT)
+      dtype[i] = INT64;
+    else
+      dtype[i] = FLOAT64;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+DumpColumnar::~DumpColumnar()
+{
+  delete[] dtype;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::init_style()
+{
+  if (compressed)
+    error->all(FLERR, "Dump columnar does not support compressed text output, use codec zstd");
+
+#ifndef LAMMPS_ZSTD
+  if (codec == ZSTD)
+    error->all(FLERR, "Dump columnar codec zstd requires LAMMPS to be compiled with Zstd support");
+#endif
+
+  for (int i = 0; i < nfield; i++) {
+    if ((dtype[i] == FLOAT64) || (dtype[i] == FLOAT32)) dtype[i] = single ? FLOAT32 : FLOAT64;
+  }
+
+  DumpCustom::init_style();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::write()
+{
+  // thermo keywords may require collective operations,
+  // so evaluate them on all MPI ranks before any output is done
+
+  thermo_values.clear();
+  if (thermo) {
+    Thermo *th = output->thermo;
+    for (int i = 0; i < th->nfield; ++i) {
+      th->call_vfunc(i);
+      if (th->vtype[i] == Thermo::FLOAT)
+        thermo_values.push_back(th->dvalue);
+      else if (th->vtype[i] == Thermo::INT)
+        thermo_values.push_back(th->ivalue);
+      else if (th->vtype[i] == Thermo::BIGINT)
+        thermo_values.push_back(th->bivalue);
+      else
+        thermo_values.push_back(0.0);
+    }
+  }
+
+  Dump::write();
+}
+
+/* ----------------------------------------------------------------------
+   frame header: magic, version, endian, timestep, natoms, nchunk,
+   box, optional units/time/thermo, and the column schema
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_header(bigint ndump)
+{
+  fwrite(MAGIC, sizeof(char), 8, fp);
+  fwrite(&VERSION, sizeof(int32_t), 1, fp);
+  fwrite(&ENDIAN, sizeof(int32_t), 1, fp);
+
+  int64_t ntimestep = update->ntimestep;
+  int64_t natoms = ndump;
+  int32_t nchunk = multiproc ? nclusterprocs : nprocs;
+  fwrite(&ntimestep, sizeof(int64_t), 1, fp);
+  fwrite(&natoms, sizeof(int64_t), 1, fp);
+  fwrite(&nchunk, sizeof(int32_t), 1, fp);
+
+  int32_t ibuf[7];
+  ibuf[0] = domain->triclinic;
+  for (int i = 0; i < 3; i++) {
+    ibuf[1 + 2 * i] = domain->boundary[i][0];
+    ibuf[2 + 2 * i] = domain->boundary[i][1];
+  }
+  fwrite(ibuf, sizeof(int32_t), 7, fp);
+
+  double box[9] = {boxxlo, boxxhi, boxylo, boxyhi, boxzlo, boxzhi, boxxy, boxxz, boxyz};
+  fwrite(box, sizeof(double), domain->triclinic ? 9 : 6, fp);
+
+  write_string(unit_flag ? update->unit_style : "");
+
+  uint8_t flag = time_flag ? 1 : 0;
+  fwrite(&flag, sizeof(uint8_t), 1, fp);
+  if (time_flag) {
+    double t = compute_time();
+    fwrite(&t, sizeof(double), 1, fp);
+  }
+
+  int32_t nthermo = thermo_values.size();
+  fwrite(&nthermo, sizeof(int32_t), 1, fp);
+  for (int i = 0; i < nthermo; i++) {
+    write_string(output->thermo->keyword[i]);
+    fwrite(&thermo_values[i], sizeof(double), 1, fp);
+  }
+
+  int32_t ncol = nfield;
+  fwrite(&ncol, sizeof(int32_t), 1, fp);
+  int i = 0;
+  for (const auto &name : utils::split_words(columns)) {
+    write_string(name);
+    uint8_t type = dtype[i++];
+    fwrite(&type, sizeof(uint8_t), 1, fp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   one chunk per MPI rank: nrows, then for each column
+   its codec, its size in bytes, and the (compressed) column data
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_data(int n, double *mybuf)
+{
+  int32_t nrows = n;
+  fwrite(&nrows, sizeof(int32_t), 1, fp);
+
+  for (int j = 0; j < nfield; j++) {
+    size_t nbytes = pack_column(j, n, mybuf);
+    const char *data = colbuf.data();
+    uint8_t mycodec = RAW;
+
+#ifdef LAMMPS_ZSTD
+    if ((codec == ZSTD) && (nbytes > 0)) {
+      size_t bound = ZSTD_compressBound(nbytes);
+      if (zbuf.size() < bound) zbuf.resize(bound);
+      size_t zbytes = ZSTD_compress(zbuf.data(), bound, colbuf.data(), nbytes, level);
+      if (ZSTD_isError(zbytes))
+        error->one(FLERR, "Dump columnar zstd compression failed: {}", ZSTD_getErrorName(zbytes));
+
+      // keep raw data if compression does not help
+
+      if (zbytes < nbytes) {
+        mycodec = ZSTD;
+        nbytes = zbytes;
+        data = zbuf.data();
+      }
+    }
+#endif
+
+    int64_t size = nbytes;
+    fwrite(&mycodec, sizeof(uint8_t), 1, fp);
+    fwrite(&size, sizeof(int64_t), 1, fp);
+    fwrite(data, sizeof(char), nbytes, fp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   convert column icol of n rows in buf to its on-disk type in colbuf
+   return # of bytes
+------------------------------------------------------------------------- */
+
+size_t DumpColumnar::pack_column(int icol, int n, double *mybuf)
+{
+  size_t width = ((dtype[icol] == INT32) || (dtype[icol] == FLOAT32)) ? 4 : 8;
+  size_t nbytes = width * n;
+  if (colbuf.size() < nbytes) colbuf.resize(nbytes);
+
+  double *src = mybuf + icol;
+  if (dtype[icol] == INT32) {
+    auto dst = (int32_t *) colbuf.data();
+    for (int i = 0; i < n; i++) dst[i] = static_cast<int32_t>(src[i * size_one]);
+  } else if (dtype[icol] == INT64) {
+    auto dst = (int64_t *) colbuf.data();
+    for (int i = 0; i < n; i++) dst[i] = static_cast<int64_t>(src[i * size_one]);
+  } else if (dtype[icol] == FLOAT32) {
+    auto dst = (float *) colbuf.data();
+    for (int i = 0; i < n; i++) dst[i] = static_cast<float>(src[i * size_one]);
+  } else {
+    auto dst = (double *) colbuf.data();
+    for (int i = 0; i < n; i++) dst[i] = src[i * size_one];
+  }
+  return nbytes;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::write_string(const std::string &str)
+{
+  int32_t len = str.size();
+  fwrite(&len, sizeof(int32_t), 1, fp);
+  fwrite(str.c_str(), sizeof(char), len, fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpColumnar::modify_param(int narg, char **arg)
+{
+  int n = DumpCustom::modify_param(narg, arg);
+  if (n > 0) return n;
+
+  if (strcmp(arg[0], "thermo") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify thermo", error);
+    thermo = utils::logical(FLERR, arg[1], false, lmp) == 1;
+    return 2;
+  } else if (strcmp(arg[0], "precision") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify precision", error);
+    if (strcmp(arg[1], "single") == 0)
+      single = 1;
+    else if (strcmp(arg[1], "double") == 0)
+      single = 0;
+    else
+      error->all(FLERR, "Unknown dump_modify precision setting {}", arg[1]);
+    return 2;
+  } else if (strcmp(arg[0], "codec") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify codec", error);
+    if (strcmp(arg[1], "none") == 0)
+      codec = RAW;
+    else if (strcmp(arg[1], "zstd") == 0)
+      codec = ZSTD;
+    else
+      error->all(FLERR, "Unknown dump_modify codec setting {}", arg[1]);
+    return 2;
+  } else if (strcmp(arg[0], "compression_level") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify compression_level", error);
+    level = utils::inumeric(FLERR, arg[1], false, lmp);
+    return 2;
+  }
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double DumpColumnar::memory_usage()
+{
+  double bytes = DumpCustom::memory_usage();
+  bytes += (double) colbuf.capacity() + (double) zbuf.capacity();
+  return bytes;
+}
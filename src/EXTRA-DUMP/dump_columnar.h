@@ -0,0 +1,63 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(columnar,DumpColumnar);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_COLUMNAR_H
+#define LMP_DUMP_COLUMNAR_H
+
+#include "dump_custom.h"
+
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class DumpColumnar : public DumpCustom {
+ public:
+  DumpColumnar(class LAMMPS *, int, char **);
+  ~DumpColumnar() override;
+
+  enum { INT32 = 0, INT64 = 1, FLOAT32 = 2, FLOAT64 = 3 };
+  enum { RAW = 0, ZSTD = 1 };
+
+ protected:
+  int *dtype;         // on-disk data type of each column
+  int single;         // 1 if floating point columns are stored as float32
+  int codec;          // requested per-column compression codec
+  int level;          // zstd compression level
+  bool thermo;        // 1 if thermo data is added to frame header
+
+  std::vector<double> thermo_values;
+  std::vector<char> colbuf;     // one column of one chunk in on-disk type
+  std::vector<char> zbuf;       // compressed column data
+
+  void init_style() override;
+  void write() override;
+  void write_header(bigint) override;
+  void write_data(int, double *) override;
+  int modify_param(int, char **) override;
+  double memory_usage() override;
+
+  void write_string(const std::string &);
+  size_t pack_column(int, int, double *);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
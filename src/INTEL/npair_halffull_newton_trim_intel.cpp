@@ -131,7 +131,8 @@ void NPairHalffullNewtonTrimIntel::build_t(NeighList *list,
 
       ipage.vgot(n);
       if (ipage.status())
-        error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+        error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                          "boost neigh_modify one", ipage.chunkmax);
     }
   }
   list->inum = inum_full;
@@ -225,7 +226,8 @@ void NPairHalffullNewtonTrimIntel::build_t3(NeighList *list, int *numhalf,
 
       ipage.vgot(n);
       if (ipage.status())
-        error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+        error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                          "boost neigh_modify one", ipage.chunkmax);
     }
   }
   list->inum = inum_full;
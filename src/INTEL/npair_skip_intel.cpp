@@ -162,7 +162,8 @@ void NPairSkipIntel::build_t(NeighList *list, int *numhalf, int *cnumneigh,
 
       ipage.vgot(n);
       if (ipage.status())
-        error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+        error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                          "boost neigh_modify one", ipage.chunkmax);
     }
 
     int last_inum = 0, loop_end;
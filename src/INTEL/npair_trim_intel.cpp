@@ -119,7 +119,8 @@ void NPairTrimIntel::build_t(NeighList *list,
 
       ipage.vgot(n);
       if (ipage.status())
-        error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+        error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                          "boost neigh_modify one", ipage.chunkmax);
     }
   }
   list->inum = inum_copy;
@@ -693,7 +693,9 @@ void PairILPGrapheneHBN::ILP_neigh()
                  "There are too many neighbors for some atoms, please check your configuration");
 
     ipage->vgot(n);
-    if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+    if (ipage->status())
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage->chunkmax);
   }
 }
 
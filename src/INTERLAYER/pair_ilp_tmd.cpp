@@ -379,7 +379,9 @@ void PairILPTMD::ILP_neigh()
     ILP_numneigh[i] = n;
 
     ipage->vgot(n);
-    if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+    if (ipage->status())
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage->chunkmax);
   }
 }
 
@@ -123,6 +123,7 @@ PairKIM::PairKIM(LAMMPS *lmp) :
   lmps_maxalloc(0),
   kim_particleSpecies(nullptr),
   kim_particleContributing(nullptr),
+  lmps_maxneigh(0),
   lmps_stripped_neigh_list(nullptr),
   lmps_stripped_neigh_ptr(nullptr)
 {
@@ -225,6 +226,31 @@ void PairKIM::compute(int eflag, int vflag)
       error->all(FLERR,"Unable to set KIM particle species codes and/or contributing");
   }
 
+  // grow lmps_stripped_neigh_list if needed, used for molecular systems
+  // needs to hold the largest # of neighbors of one atom in any list,
+  //   which can be larger than neigh_modify one
+  if (lmps_using_molecular) {
+    int maxneigh = 0;
+    for (int i = 0; i < kim_number_of_neighbor_lists; ++i) {
+      NeighList *list = neighborLists[i];
+      int const nlist = list->inum + list->gnum;
+      for (int ii = 0; ii < nlist; ++ii)
+        maxneigh = MAX(maxneigh,list->numneigh[list->ilist[ii]]);
+    }
+    if ((maxneigh > lmps_maxneigh) || (lmps_stripped_neigh_ptr == nullptr)) {
+      lmps_maxneigh = MAX(maxneigh,neighbor->oneatom);
+      memory->destroy(lmps_stripped_neigh_list);
+      memory->create(lmps_stripped_neigh_list,
+                     kim_number_of_neighbor_lists*lmps_maxneigh,
+                     "pair:lmps_stripped_neigh_list");
+      delete[] lmps_stripped_neigh_ptr;
+      lmps_stripped_neigh_ptr = new int*[kim_number_of_neighbor_lists];
+      for (int i = 0; i < kim_number_of_neighbor_lists; ++i)
+        lmps_stripped_neigh_ptr[i]
+          = &(lmps_stripped_neigh_list[i*lmps_maxneigh]);
+    }
+  }
+
   // kim_particleSpecies = KIM atom species for each LAMMPS atom
 
   int *species = atom->type;
@@ -555,18 +581,12 @@ void PairKIM::init_style()
   if (domain->dimension != 3)
     error->all(FLERR,"PairKIM only works with 3D problems");
 
-  // setup lmps_stripped_neigh_list for neighbors of one atom, if needed
-  if (lmps_using_molecular) {
-    memory->destroy(lmps_stripped_neigh_list);
-    memory->create(lmps_stripped_neigh_list,
-                   kim_number_of_neighbor_lists*neighbor->oneatom,
-                   "pair:lmps_stripped_neigh_list");
-    delete[] lmps_stripped_neigh_ptr;
-    lmps_stripped_neigh_ptr = new int*[kim_number_of_neighbor_lists];
-    for (int i = 0; i < kim_number_of_neighbor_lists; ++i)
-      lmps_stripped_neigh_ptr[i]
-        = &(lmps_stripped_neigh_list[i*(neighbor->oneatom)]);
-  }
+  // lmps_stripped_neigh_list for neighbors of one atom is (re)allocated
+  // in compute(), since the number of neighbors may change between runs
+  memory->destroy(lmps_stripped_neigh_list);
+  delete[] lmps_stripped_neigh_ptr;
+  lmps_stripped_neigh_ptr = nullptr;
+  lmps_maxneigh = 0;
 
   // make sure comm_reverse expects (at most) 9 values when newton is off
   if (!lmps_using_newton) comm_reverse_off = 9;
@@ -744,6 +764,8 @@ void PairKIM::unpack_reverse_comm(int n, int *list, double *buf)
 double PairKIM::memory_usage()
 {
   double bytes = 2 * lmps_maxalloc * sizeof(int);
+  if (lmps_stripped_neigh_list)
+    bytes += (double) kim_number_of_neighbor_lists * lmps_maxneigh * sizeof(int);
   return bytes;
 }
 
@@ -154,6 +154,7 @@ class PairKIM : public Pair {
   int lmps_maxalloc;                // max allocated memory value
   int *kim_particleSpecies;         // array of KIM particle species
   int *kim_particleContributing;    // array of KIM particle contributing
+  int lmps_maxneigh;                // max # of neighbors of one atom in lists
   int *lmps_stripped_neigh_list;    // neighbors of one atom, used when LAMMPS
                                     // is in molecular mode
   int **lmps_stripped_neigh_ptr;    // pointer into lists
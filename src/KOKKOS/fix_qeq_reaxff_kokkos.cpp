@@ -57,6 +57,13 @@ FixQEqReaxFFKokkos(LAMMPS *lmp, int narg, char **arg) :
   FixQEqReaxFF(lmp, narg, arg)
 {
   kokkosable = 1;
+
+  // S and T systems are always solved together, an explicit choice is ignored
+
+  if ((dual_enabled >= 0) && (comm->me == 0))
+    error->warning(FLERR,"Fix {} always solves the S and T systems together and ignores "
+                   "the dual and nodual keywords", style);
+
   comm_forward = comm_reverse = 2; // fused
   forward_comm_device = exchange_comm_device = sort_device = 1;
   atomKK = (AtomKokkos *) atom;
@@ -100,6 +107,11 @@ void FixQEqReaxFFKokkos<DeviceType>::init()
 
   FixQEqReaxFF::init();
 
+  if (precond != JACOBI)
+    error->all(FLERR,"Fix {} only supports the jacobi preconditioner", style);
+  if (keep_pattern)
+    error->all(FLERR,"Fix {} does not support keeping the matrix pattern", style);
+
   // adjust neighbor list request for KOKKOS
 
   neighflag = lmp->kokkos->neighflag_qeq;
@@ -275,7 +287,10 @@ void FixQEqReaxFFKokkos<DeviceType>::pre_force(int /*vflag*/)
 
   //  cg solve over b_s, s & b_t, t
 
+  double time_start = platform::walltime();
   matvecs = cg_solve();
+  time_solve = platform::walltime() - time_start;
+  time_total += time_solve;
 
   // calculate_Q();
 
@@ -758,6 +773,7 @@ int FixQEqReaxFFKokkos<DeviceType>::cg_solve()
 
   F_FLOAT residual[2] = {0.0, 0.0};
   int loop;
+  matvecs_s = matvecs_t = 0;
   for (loop = 1; (loop < imax); loop++) {
     if (!(converged & 1))
       residual[0] = sqrt(sig_new.v[0]) / b_norm.v[0];
@@ -765,6 +781,11 @@ int FixQEqReaxFFKokkos<DeviceType>::cg_solve()
       residual[1] = sqrt(sig_new.v[1]) / b_norm.v[1];
     converged = static_cast<int>(residual[0] <= tolerance) | (static_cast<int>(residual[1] <= tolerance) << 1);
 
+    // count the iterations of each system until it has converged
+
+    if (!(converged & 1)) matvecs_s = loop;
+    if (!(converged & 2)) matvecs_t = loop;
+
     if (converged == 3) {
       // both cg solves have converged
       break;
@@ -116,7 +116,8 @@ void NPairCopyKokkos<DeviceType>::copy_to_cpu(NeighList *list)
     firstneigh[i] = neighptr;
     ipage->vgot(jnum);
     if (ipage->status())
-      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage->chunkmax);
   }
 }
 
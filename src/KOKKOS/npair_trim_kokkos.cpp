@@ -184,7 +184,8 @@ void NPairTrimKokkos<DeviceType>::trim_to_cpu(NeighList *list)
     numneigh[i] = n;
     ipage->vgot(n);
     if (ipage->status())
-      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage->chunkmax);
   }
 }
 
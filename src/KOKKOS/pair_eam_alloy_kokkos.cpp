@@ -45,6 +45,7 @@ PairEAMAlloyKokkos<DeviceType>::PairEAMAlloyKokkos(LAMMPS *lmp) : PairEAM(lmp)
 {
   respa_enable = 0;
   single_enable = 0;
+  local_energy_enable = 0;
   one_coeff = 1;
 
   kokkosable = 1;
@@ -41,6 +41,7 @@ PairEAMKokkos<DeviceType>::PairEAMKokkos(LAMMPS *lmp) : PairEAM(lmp)
 {
   respa_enable = 0;
   single_enable = 0;
+  local_energy_enable = 0;
 
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
@@ -40,6 +40,7 @@ template<class DeviceType>
 PairMLIAPKokkos<DeviceType>::PairMLIAPKokkos(class LAMMPS* l) : PairMLIAP(l)
 {
   kokkosable = 1;
+  local_energy_enable = 0;
   execution_space = ExecutionSpaceFromDevice<DeviceType>::space;
   datamask_modify = 0;
   is_child=true;
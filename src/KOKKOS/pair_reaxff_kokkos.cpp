@@ -158,6 +158,8 @@ void PairReaxFFKokkos<DeviceType>::init_style()
 {
   PairReaxFF::init_style();
   if (fix_reaxff) modify->delete_fix(fix_id); // not needed in the Kokkos version
+  if (api->control->screen_tol > 0.0)
+    error->all(FLERR,"Pair style reaxff/kk does not support the screen keyword");
   fix_reaxff = nullptr;
 
   acks2_flag = api->system->acks2_flag;
@@ -754,7 +756,7 @@ void PairReaxFFKokkos<DeviceType>::compute(int eflag_in, int vflag_in)
   }
 
   if (eflag_global) {
-    for (int i = 0; i < 14; i++)
+    for (int i = 0; i < nextra; i++)
       pvector[i] = 0.0;
   }
 
@@ -56,6 +56,7 @@ template<class DeviceType, typename real_type, int vector_length>
 PairSNAPKokkos<DeviceType, real_type, vector_length>::PairSNAPKokkos(LAMMPS *lmp) : PairSNAP(lmp)
 {
   respa_enable = 0;
+  local_energy_enable = 0;
 
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
@@ -144,6 +144,8 @@ void PPPMKokkos<DeviceType>::init()
 
   if (differentiation_flag == 1)
     error->all(FLERR,"Cannot (yet) use PPPM Kokkos with 'kspace_modify diff ad'");
+  if (fft_batch != 1)
+    error->all(FLERR,"Cannot (yet) use PPPM Kokkos with 'kspace_modify fft/batch'");
 
   triclinic_check();
   if (domain->triclinic && slabflag)
@@ -31,6 +31,7 @@
 #include "pair.h"
 
 #include <cmath>
+#include <cstring>
 
 using namespace LAMMPS_NS;
 using namespace MathConst;
@@ -64,6 +65,10 @@ Ewald::Ewald(LAMMPS *lmp) : KSpace(lmp),
   cs = sn = nullptr;
 
   kcount = 0;
+
+  sfac_overlap = 0;
+  sfac_pending = 0;
+  sfac_request[0] = sfac_request[1] = MPI_REQUEST_NULL;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -78,12 +83,25 @@ void Ewald::settings(int narg, char **arg)
                accuracy_relative, force->kspace_style);
 }
 
+/* ---------------------------------------------------------------------- */
+
+int Ewald::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0],"sfac/overlap") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify sfac/overlap",error);
+    sfac_overlap = utils::logical(FLERR,arg[1],false,lmp);
+    return 2;
+  }
+  return 0;
+}
+
 /* ----------------------------------------------------------------------
    free all memory
 ------------------------------------------------------------------------- */
 
 Ewald::~Ewald()
 {
+  if (sfac_pending) MPI_Waitall(2,sfac_request,MPI_STATUSES_IGNORE);
   deallocate();
   if (group_allocate_flag) deallocate_groups();
   memory->destroy(ek);
@@ -116,6 +134,12 @@ void Ewald::init()
                  "and slab correction");
   }
 
+  // sum of structure factors over procs can overlap with pair
+
+  prepare_flag = (sfac_overlap && comm->nprocs > 1) ? 1 : 0;
+  if (sfac_pending) MPI_Waitall(2,sfac_request,MPI_STATUSES_IGNORE);
+  sfac_pending = 0;
+
   // compute two charge force
 
   two_charge();
@@ -369,31 +393,14 @@ void Ewald::compute(int eflag, int vflag)
 
   // return if there are no charges
 
-  if (qsqsum == 0.0) return;
-
-  // extend size of per-atom arrays if necessary
-
-  if (atom->nmax > nmax) {
-    memory->destroy(ek);
-    memory->destroy3d_offset(cs,-kmax_created);
-    memory->destroy3d_offset(sn,-kmax_created);
-    nmax = atom->nmax;
-    memory->create(ek,nmax,3,"ewald:ek");
-    memory->create3d_offset(cs,-kmax,kmax,3,nmax,"ewald:cs");
-    memory->create3d_offset(sn,-kmax,kmax,3,nmax,"ewald:sn");
-    kmax_created = kmax;
+  if (qsqsum == 0.0) {
+    if (sfac_pending) sum_structure_factors();
+    return;
   }
 
-  // partial structure factors on each processor
-  // total structure factor by summing over procs
-
-  if (triclinic == 0)
-    eik_dot_r();
-  else
-    eik_dot_r_triclinic();
+  // total structure factors, unless already summed during pair
 
-  MPI_Allreduce(sfacrl,sfacrl_all,kcount,MPI_DOUBLE,MPI_SUM,world);
-  MPI_Allreduce(sfacim,sfacim_all,kcount,MPI_DOUBLE,MPI_SUM,world);
+  sum_structure_factors();
 
   // K-space portion of electric field
   // double loop over K-vectors and local atoms
@@ -492,6 +499,103 @@ void Ewald::compute(int eflag, int vflag)
   if (slabflag == 1) slabcorr();
 }
 
+/* ----------------------------------------------------------------------
+   compute partial structure factors before the pair computation and
+   start summing them over procs, compute() waits for the sum
+------------------------------------------------------------------------- */
+
+void Ewald::compute_prepare(int /*eflag*/, int /*vflag*/)
+{
+  // qsum and qsqsum are updated by compute() if the atom count changed
+
+  if ((atom->natoms != natoms_original) || (qsqsum == 0.0)) return;
+
+  grow_trig_tables();
+
+  if (triclinic == 0)
+    eik_dot_r();
+  else
+    eik_dot_r_triclinic();
+
+  MPI_Iallreduce(sfacrl,sfacrl_all,kcount,MPI_DOUBLE,MPI_SUM,world,&sfac_request[0]);
+  MPI_Iallreduce(sfacim,sfacim_all,kcount,MPI_DOUBLE,MPI_SUM,world,&sfac_request[1]);
+  sfac_pending = 1;
+}
+
+/* ----------------------------------------------------------------------
+   total structure factors summed over procs
+   wait for the sum started by compute_prepare(), if any
+------------------------------------------------------------------------- */
+
+void Ewald::sum_structure_factors()
+{
+  if (sfac_pending) {
+    MPI_Waitall(2,sfac_request,MPI_STATUSES_IGNORE);
+    sfac_pending = 0;
+    return;
+  }
+
+  grow_trig_tables();
+
+  // partial structure factors on each processor
+  // total structure factor by summing over procs
+
+  if (triclinic == 0)
+    eik_dot_r();
+  else
+    eik_dot_r_triclinic();
+
+  MPI_Allreduce(sfacrl,sfacrl_all,kcount,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(sfacim,sfacim_all,kcount,MPI_DOUBLE,MPI_SUM,world);
+}
+
+/* ----------------------------------------------------------------------
+   extend size of per-atom arrays if necessary
+------------------------------------------------------------------------- */
+
+void Ewald::grow_trig_tables()
+{
+  if (atom->nmax > nmax) {
+    memory->destroy(ek);
+    memory->destroy3d_offset(cs,-kmax_created);
+    memory->destroy3d_offset(sn,-kmax_created);
+    nmax = atom->nmax;
+    memory->create(ek,nmax,3,"ewald:ek");
+    memory->create3d_offset(cs,-kmax,kmax,3,nmax,"ewald:cs");
+    memory->create3d_offset(sn,-kmax,kmax,3,nmax,"ewald:sn");
+    kmax_created = kmax;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   cos and sin of m times the unit k-vector in dimension ic
+   for atoms ifrom <= i < ito from the two previous multiples
+   with the Chebyshev recurrence cos(mx) = 2 cos(x) cos((m-1)x) - cos((m-2)x)
+------------------------------------------------------------------------- */
+
+void Ewald::eik_recurrence(int m, int ic, int ifrom, int ito)
+{
+  const double * _noalias const c1 = cs[1][ic];
+  const double * _noalias const cm1 = cs[m-1][ic];
+  const double * _noalias const cm2 = cs[m-2][ic];
+  const double * _noalias const sm1 = sn[m-1][ic];
+  const double * _noalias const sm2 = sn[m-2][ic];
+  double * _noalias const cm = cs[m][ic];
+  double * _noalias const sm = sn[m][ic];
+  double * _noalias const cmneg = cs[-m][ic];
+  double * _noalias const smneg = sn[-m][ic];
+
+  for (int i = ifrom; i < ito; i++) {
+    const double c1two = 2.0*c1[i];
+    const double cmi = c1two*cm1[i] - cm2[i];
+    const double smi = c1two*sm1[i] - sm2[i];
+    cm[i] = cmi;
+    sm[i] = smi;
+    cmneg[i] = cmi;
+    smneg[i] = -smi;
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void Ewald::eik_dot_r()
@@ -534,13 +638,8 @@ void Ewald::eik_dot_r()
       if (sqk <= gsqmx) {
         cstr1 = 0.0;
         sstr1 = 0.0;
+        eik_recurrence(m,ic,0,nlocal);
         for (i = 0; i < nlocal; i++) {
-          cs[m][ic][i] = cs[m-1][ic][i]*cs[1][ic][i] -
-            sn[m-1][ic][i]*sn[1][ic][i];
-          sn[m][ic][i] = sn[m-1][ic][i]*cs[1][ic][i] +
-            cs[m-1][ic][i]*sn[1][ic][i];
-          cs[-m][ic][i] = cs[m][ic][i];
-          sn[-m][ic][i] = -sn[m][ic][i];
           cstr1 += q[i]*cs[m][ic][i];
           sstr1 += q[i]*sn[m][ic][i];
         }
@@ -721,14 +820,7 @@ void Ewald::eik_dot_r_triclinic()
       unitk_lamda[ic] = 2.0*MY_PI*m;
       x2lamdaT(&unitk_lamda[0],&unitk_lamda[0]);
       sqk = unitk_lamda[ic]*unitk_lamda[ic];
-      for (i = 0; i < nlocal; i++) {
-        cs[m][ic][i] = cs[m-1][ic][i]*cs[1][ic][i] -
-          sn[m-1][ic][i]*sn[1][ic][i];
-        sn[m][ic][i] = sn[m-1][ic][i]*cs[1][ic][i] +
-          cs[m-1][ic][i]*sn[1][ic][i];
-        cs[-m][ic][i] = cs[m][ic][i];
-        sn[-m][ic][i] = -sn[m][ic][i];
-      }
+      eik_recurrence(m,ic,0,nlocal);
     }
   }
 
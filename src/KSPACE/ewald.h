@@ -32,6 +32,8 @@ class Ewald : public KSpace {
   void setup() override;
   void settings(int, char **) override;
   void compute(int, int) override;
+  void compute_prepare(int, int) override;
+  int modify_param(int, char **) override;
   double memory_usage() override;
 
   void compute_group_group(int, int, int) override;
@@ -51,6 +53,10 @@ class Ewald : public KSpace {
   double *sfacrl, *sfacim, *sfacrl_all, *sfacim_all;
   double ***cs, ***sn;
 
+  int sfac_overlap;               // 1 if structure factors are summed during pair
+  int sfac_pending;               // 1 if a non-blocking sum is in progress
+  MPI_Request sfac_request[2];
+
   // group-group interactions
 
   int group_allocate_flag;
@@ -59,6 +65,9 @@ class Ewald : public KSpace {
 
   double rms(int, double, bigint, double);
   virtual void eik_dot_r();
+  void eik_recurrence(int, int, int, int);
+  void grow_trig_tables();
+  void sum_structure_factors();
   virtual void coeffs();
   virtual void allocate();
   virtual void deallocate();
@@ -67,7 +76,7 @@ class Ewald : public KSpace {
   // triclinic
 
   int triclinic;
-  void eik_dot_r_triclinic();
+  virtual void eik_dot_r_triclinic();
   void coeffs_triclinic();
 
   // group-group interactions
@@ -86,6 +86,9 @@ void EwaldDipole::init()
   if (domain->dimension == 2)
     error->all(FLERR,"Cannot use EwaldDipole with 2d simulation");
 
+  if (sfac_overlap)
+    error->all(FLERR,"Cannot use kspace_modify sfac/overlap with EwaldDipole");
+
   if (!atom->mu) error->all(FLERR,"Kspace style requires atom attribute mu");
 
   if (dipoleflag && strcmp(update->unit_style,"electron") == 0)
@@ -74,6 +74,9 @@ void EwaldDipoleSpin::init()
   if (domain->dimension == 2)
     error->all(FLERR,"Cannot use EwaldDipoleSpin with 2d simulation");
 
+  if (sfac_overlap)
+    error->all(FLERR,"Cannot use kspace_modify sfac/overlap with EwaldDipoleSpin");
+
   if (!atom->sp) error->all(FLERR,"Kspace style requires atom attribute sp");
 
   if ((spinflag && strcmp(update->unit_style,"metal") != 0) != 0)
@@ -39,6 +39,10 @@
 #define MIN(A,B) ((A) < (B) ? (A) : (B))
 #define MAX(A,B) ((A) > (B) ? (A) : (B))
 
+static struct fft_batch_1d *fft_1d_create_batch(struct remap_plan_3d *, int);
+static void fft_1d_destroy_batch(struct fft_batch_1d *);
+static void fft_1d_batch(FFT_DATA *, int, struct fft_batch_1d *, int);
+
 /* ----------------------------------------------------------------------
    Data layout for 3d FFTs:
 
@@ -99,104 +103,134 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
     data = in;
 
   // 1d FFTs along fast axis
-
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_fast,data);
-  else
-    DftiComputeBackward(plan->handle_fast,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_fast_forward;
-  else
-    theplan=plan->plan_fast_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  int total = plan->total1;
-  int length = plan->length1;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_fast_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_fast_backward,&data[offset],&data[offset]);
-#endif
-
   // 1st mid-remap to prepare for 2nd FFTs
   // copy = loc for remap result
+  // if batched, each batch is remapped while the next batch is computed
 
   if (plan->mid1_target == 0) copy = out;
   else copy = plan->copy;
-  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
-           (FFT_SCALAR *) plan->scratch, plan->mid1_plan);
-  data = copy;
 
-  // 1d FFTs along mid axis
+  if (plan->batch_fast) {
+    for (int ibatch = 0; ibatch < plan->batch_fast->nbatch; ibatch++) {
+      fft_1d_batch(data,flag,plan->batch_fast,ibatch);
+      remap_3d_batch_start((FFT_SCALAR *) data,(FFT_SCALAR *) plan->scratch,
+                           plan->mid1_plan,ibatch);
+    }
+    remap_3d_batch_wait((FFT_SCALAR *) copy,(FFT_SCALAR *) plan->scratch,plan->mid1_plan);
+  } else {
 
 #if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_mid,data);
-  else
-    DftiComputeBackward(plan->handle_mid,data);
+    if (flag == 1)
+      DftiComputeForward(plan->handle_fast,data);
+    else
+      DftiComputeBackward(plan->handle_fast,data);
 #elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_mid_forward;
-  else
-    theplan=plan->plan_mid_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
+    if (flag == 1)
+      theplan=plan->plan_fast_forward;
+    else
+      theplan=plan->plan_fast_backward;
+    FFTW_API(execute_dft)(theplan,data,data);
 #else
-  total = plan->total2;
-  length = plan->length2;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_mid_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_mid_backward,&data[offset],&data[offset]);
+    int total = plan->total1;
+    int length = plan->length1;
+
+    if (flag == 1)
+      for (int offset = 0; offset < total; offset += length)
+        kiss_fft(plan->cfg_fast_forward,&data[offset],&data[offset]);
+    else
+      for (int offset = 0; offset < total; offset += length)
+        kiss_fft(plan->cfg_fast_backward,&data[offset],&data[offset]);
 #endif
 
+    remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+             (FFT_SCALAR *) plan->scratch, plan->mid1_plan);
+  }
+  data = copy;
+
+  // 1d FFTs along mid axis
   // 2nd mid-remap to prepare for 3rd FFTs
   // copy = loc for remap result
 
   if (plan->mid2_target == 0) copy = out;
   else copy = plan->copy;
-  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
-           (FFT_SCALAR *) plan->scratch, plan->mid2_plan);
-  data = copy;
 
-  // 1d FFTs along slow axis
+  if (plan->batch_mid) {
+    for (int ibatch = 0; ibatch < plan->batch_mid->nbatch; ibatch++) {
+      fft_1d_batch(data,flag,plan->batch_mid,ibatch);
+      remap_3d_batch_start((FFT_SCALAR *) data,(FFT_SCALAR *) plan->scratch,
+                           plan->mid2_plan,ibatch);
+    }
+    remap_3d_batch_wait((FFT_SCALAR *) copy,(FFT_SCALAR *) plan->scratch,plan->mid2_plan);
+  } else {
 
 #if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_slow,data);
-  else
-    DftiComputeBackward(plan->handle_slow,data);
+    if (flag == 1)
+      DftiComputeForward(plan->handle_mid,data);
+    else
+      DftiComputeBackward(plan->handle_mid,data);
 #elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_slow_forward;
-  else
-    theplan=plan->plan_slow_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
+    if (flag == 1)
+      theplan=plan->plan_mid_forward;
+    else
+      theplan=plan->plan_mid_backward;
+    FFTW_API(execute_dft)(theplan,data,data);
 #else
-  total = plan->total3;
-  length = plan->length3;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_slow_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_slow_backward,&data[offset],&data[offset]);
+    int total = plan->total2;
+    int length = plan->length2;
+
+    if (flag == 1)
+      for (int offset = 0; offset < total; offset += length)
+        kiss_fft(plan->cfg_mid_forward,&data[offset],&data[offset]);
+    else
+      for (int offset = 0; offset < total; offset += length)
+        kiss_fft(plan->cfg_mid_backward,&data[offset],&data[offset]);
 #endif
 
+    remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+             (FFT_SCALAR *) plan->scratch, plan->mid2_plan);
+  }
+  data = copy;
+
+  // 1d FFTs along slow axis
   // post-remap to put data in output format if needed
   // destination is always out
 
-  if (plan->post_plan)
-    remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) out,
-             (FFT_SCALAR *) plan->scratch, plan->post_plan);
+  if (plan->batch_slow) {
+    for (int ibatch = 0; ibatch < plan->batch_slow->nbatch; ibatch++) {
+      fft_1d_batch(data,flag,plan->batch_slow,ibatch);
+      remap_3d_batch_start((FFT_SCALAR *) data,(FFT_SCALAR *) plan->scratch,
+                           plan->post_plan,ibatch);
+    }
+    remap_3d_batch_wait((FFT_SCALAR *) out,(FFT_SCALAR *) plan->scratch,plan->post_plan);
+  } else {
+
+#if defined(FFT_MKL)
+    if (flag == 1)
+      DftiComputeForward(plan->handle_slow,data);
+    else
+      DftiComputeBackward(plan->handle_slow,data);
+#elif defined(FFT_FFTW3)
+    if (flag == 1)
+      theplan=plan->plan_slow_forward;
+    else
+      theplan=plan->plan_slow_backward;
+    FFTW_API(execute_dft)(theplan,data,data);
+#else
+    int total = plan->total3;
+    int length = plan->length3;
+
+    if (flag == 1)
+      for (int offset = 0; offset < total; offset += length)
+        kiss_fft(plan->cfg_slow_forward,&data[offset],&data[offset]);
+    else
+      for (int offset = 0; offset < total; offset += length)
+        kiss_fft(plan->cfg_slow_backward,&data[offset],&data[offset]);
+#endif
+
+    if (plan->post_plan)
+      remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) out,
+               (FFT_SCALAR *) plan->scratch, plan->post_plan);
+  }
 
   // scaling if required
 
@@ -240,6 +274,8 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
                           2 = permute twice = slow->fast, fast->mid, mid->slow
    nbuf                 returns size of internal storage buffers used by FFT
    usecollective        use collective MPI operations for remapping data
+   nbatch               # of batches to overlap 1d FFTs with non-blocking
+                          remaps of previous batches, 1 = no overlap
 ------------------------------------------------------------------------- */
 
 struct fft_plan_3d *fft_3d_create_plan(
@@ -248,7 +284,7 @@ struct fft_plan_3d *fft_3d_create_plan(
        int in_klo, int in_khi,
        int out_ilo, int out_ihi, int out_jlo, int out_jhi,
        int out_klo, int out_khi,
-       int scaled, int permute, int *nbuf, int usecollective)
+       int scaled, int permute, int *nbuf, int usecollective, int nbatch)
 {
   struct fft_plan_3d *plan;
   int me,nprocs,nthreads;
@@ -283,6 +319,12 @@ struct fft_plan_3d *fft_3d_create_plan(
   plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
   if (plan == nullptr) return nullptr;
 
+  // MKL descriptors have a fixed # of transforms, so no batches
+
+#if defined(FFT_MKL)
+  nbatch = 1;
+#endif
+
   // remap from initial distribution to layout needed for 1st set of 1d FFTs
   // not needed if all procs own entire fast axis initially
   // first indices = distribution after 1st set of FFTs
@@ -311,7 +353,7 @@ struct fft_plan_3d *fft_3d_create_plan(
     first_khi = (ip2+1)*nslow/np2 - 1;
     plan->pre_plan = remap_3d_create_plan(comm,in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
                                           first_ilo,first_ihi,first_jlo,first_jhi,
-                                          first_klo,first_khi,2,0,0,FFT_PRECISION,0);
+                                          first_klo,first_khi,2,0,0,FFT_PRECISION,0,1);
     if (plan->pre_plan == nullptr) return nullptr;
   }
 
@@ -333,7 +375,7 @@ struct fft_plan_3d *fft_3d_create_plan(
   plan->mid1_plan = remap_3d_create_plan(comm, first_ilo,first_ihi,first_jlo,first_jhi,
                                          first_klo,first_khi,second_ilo,second_ihi,
                                          second_jlo,second_jhi,second_klo,second_khi,
-                                         2,1,0,FFT_PRECISION,usecollective);
+                                         2,1,0,FFT_PRECISION,usecollective,nbatch);
   if (plan->mid1_plan == nullptr) return nullptr;
 
   // 1d FFTs along mid axis
@@ -374,7 +416,7 @@ struct fft_plan_3d *fft_3d_create_plan(
                          second_jlo,second_jhi,second_klo,second_khi,
                          second_ilo,second_ihi,
                          third_jlo,third_jhi,third_klo,third_khi,
-                         third_ilo,third_ihi,2,1,0,FFT_PRECISION,usecollective);
+                         third_ilo,third_ihi,2,1,0,FFT_PRECISION,usecollective,nbatch);
   if (plan->mid2_plan == nullptr) return nullptr;
 
   // 1d FFTs along slow axis
@@ -403,7 +445,7 @@ struct fft_plan_3d *fft_3d_create_plan(
                            third_klo,third_khi,third_ilo,third_ihi,
                            third_jlo,third_jhi,
                            out_klo,out_khi,out_ilo,out_ihi,
-                           out_jlo,out_jhi,2,(permute+1)%3,0,FFT_PRECISION,0);
+                           out_jlo,out_jhi,2,(permute+1)%3,0,FFT_PRECISION,0,nbatch);
     if (plan->post_plan == nullptr) return nullptr;
   }
 
@@ -583,6 +625,36 @@ struct fft_plan_3d *fft_3d_create_plan(
 
 #endif
 
+  // batches of 1d FFTs follow the batches of the remap after them
+
+  plan->batch_fast = plan->batch_mid = plan->batch_slow = nullptr;
+  if (plan->mid1_plan->batch)
+    plan->batch_fast = fft_1d_create_batch(plan->mid1_plan,nfast);
+  if (plan->mid2_plan->batch)
+    plan->batch_mid = fft_1d_create_batch(plan->mid2_plan,nmid);
+  if (plan->post_plan && plan->post_plan->batch)
+    plan->batch_slow = fft_1d_create_batch(plan->post_plan,nslow);
+
+#if defined(FFT_KISS)
+  if (plan->batch_fast) {
+    plan->batch_fast->cfg_forward = plan->cfg_fast_forward;
+    plan->batch_fast->cfg_backward = plan->cfg_fast_backward;
+  }
+  if (plan->batch_mid) {
+    plan->batch_mid->cfg_forward = plan->cfg_mid_forward;
+    plan->batch_mid->cfg_backward = plan->cfg_mid_backward;
+  }
+  if (plan->batch_slow) {
+    plan->batch_slow->cfg_forward = plan->cfg_slow_forward;
+    plan->batch_slow->cfg_backward = plan->cfg_slow_backward;
+  }
+#endif
+
+  plan->nbatch = 1;
+  if (plan->batch_fast) plan->nbatch = MAX(plan->nbatch,plan->batch_fast->nbatch);
+  if (plan->batch_mid) plan->nbatch = MAX(plan->nbatch,plan->batch_mid->nbatch);
+  if (plan->batch_slow) plan->nbatch = MAX(plan->nbatch,plan->batch_slow->nbatch);
+
   if (scaled == 0)
     plan->scaled = 0;
   else {
@@ -609,6 +681,10 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
   if (plan->copy) free(plan->copy);
   if (plan->scratch) free(plan->scratch);
 
+  if (plan->batch_fast) fft_1d_destroy_batch(plan->batch_fast);
+  if (plan->batch_mid) fft_1d_destroy_batch(plan->batch_mid);
+  if (plan->batch_slow) fft_1d_destroy_batch(plan->batch_slow);
+
 #if defined(FFT_MKL)
   DftiFreeDescriptor(&(plan->handle_fast));
   DftiFreeDescriptor(&(plan->handle_mid));
@@ -812,3 +888,101 @@ void fft_1d_only(FFT_DATA *data, int nsize, int flag, struct fft_plan_3d *plan)
     }
   }
 }
+
+/* ----------------------------------------------------------------------
+   split the 1d FFTs before a batched remap into the same batches
+   remap batches are contiguous input data in units of FFT_SCALAR
+------------------------------------------------------------------------- */
+
+static struct fft_batch_1d *fft_1d_create_batch(struct remap_plan_3d *remap, int length)
+{
+  struct fft_batch_1d *batch;
+  const int nbatch = remap->batch->nbatch;
+
+  batch = (struct fft_batch_1d *) malloc(sizeof(struct fft_batch_1d));
+  if (batch == nullptr) return nullptr;
+
+  batch->nbatch = nbatch;
+  batch->length = length;
+  batch->offset = (int *) malloc(nbatch*sizeof(int));
+  batch->total = (int *) malloc(nbatch*sizeof(int));
+
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+    batch->offset[ibatch] = remap->batch->offset[ibatch]/2;
+    batch->total[ibatch] = remap->batch->size[ibatch]/2;
+  }
+
+  // batches start at arbitrary offsets into the data
+
+#if defined(FFT_FFTW3)
+  batch->plan_forward = (FFTW_API(plan) *) malloc(nbatch*sizeof(FFTW_API(plan)));
+  batch->plan_backward = (FFTW_API(plan) *) malloc(nbatch*sizeof(FFTW_API(plan)));
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+    const int howmany = batch->total[ibatch]/length;
+    if (howmany == 0) {
+      batch->plan_forward[ibatch] = batch->plan_backward[ibatch] = nullptr;
+      continue;
+    }
+    batch->plan_forward[ibatch] =
+      FFTW_API(plan_many_dft)(1,&length,howmany,nullptr,&length,1,length,
+                              nullptr,&length,1,length,FFTW_FORWARD,
+                              FFTW_ESTIMATE | FFTW_UNALIGNED);
+    batch->plan_backward[ibatch] =
+      FFTW_API(plan_many_dft)(1,&length,howmany,nullptr,&length,1,length,
+                              nullptr,&length,1,length,FFTW_BACKWARD,
+                              FFTW_ESTIMATE | FFTW_UNALIGNED);
+  }
+#endif
+
+  return batch;
+}
+
+/* ----------------------------------------------------------------------
+   free all memory of batched 1d FFTs, KISS configs are owned by the plan
+------------------------------------------------------------------------- */
+
+static void fft_1d_destroy_batch(struct fft_batch_1d *batch)
+{
+#if defined(FFT_FFTW3)
+  for (int ibatch = 0; ibatch < batch->nbatch; ibatch++) {
+    if (batch->plan_forward[ibatch]) FFTW_API(destroy_plan)(batch->plan_forward[ibatch]);
+    if (batch->plan_backward[ibatch]) FFTW_API(destroy_plan)(batch->plan_backward[ibatch]);
+  }
+  free(batch->plan_forward);
+  free(batch->plan_backward);
+#endif
+  free(batch->offset);
+  free(batch->total);
+  free(batch);
+}
+
+/* ----------------------------------------------------------------------
+   perform the 1d FFTs of one batch in place
+------------------------------------------------------------------------- */
+
+static void fft_1d_batch(FFT_DATA *data, int flag, struct fft_batch_1d *batch, int ibatch)
+{
+  FFT_DATA *first = data + batch->offset[ibatch];
+
+#if defined(FFT_FFTW3)
+  FFTW_API(plan) theplan;
+  if (flag == 1)
+    theplan = batch->plan_forward[ibatch];
+  else
+    theplan = batch->plan_backward[ibatch];
+  if (theplan) FFTW_API(execute_dft)(theplan,first,first);
+#elif defined(FFT_KISS)
+  const int total = batch->total[ibatch];
+  const int length = batch->length;
+
+  if (flag == 1)
+    for (int offset = 0; offset < total; offset += length)
+      kiss_fft(batch->cfg_forward,&first[offset],&first[offset]);
+  else
+    for (int offset = 0; offset < total; offset += length)
+      kiss_fft(batch->cfg_backward,&first[offset],&first[offset]);
+#else
+  (void) first;
+  (void) flag;
+#endif
+}
@@ -86,6 +86,24 @@ typedef struct kiss_fft_state *kiss_fft_cfg;
 
 // -------------------------------------------------------------------------
 
+// 1d FFTs of one stage split into batches, so that each batch can be
+// remapped while the FFTs of the following batches are computed
+
+struct fft_batch_1d {
+  int nbatch;      // # of batches
+  int length;      // length of 1d FFTs
+  int *offset;     // first element of each batch
+  int *total;      // # of elements in each batch
+
+#if defined(FFT_FFTW3)
+  FFTW_API(plan) *plan_forward;
+  FFTW_API(plan) *plan_backward;
+#elif defined(FFT_KISS)
+  kiss_fft_cfg cfg_forward;
+  kiss_fft_cfg cfg_backward;
+#endif
+};
+
 // details of how to do a 3d FFT
 
 struct fft_plan_3d {
@@ -102,6 +120,11 @@ struct fft_plan_3d {
   int scaled;     // whether to scale FFT results
   int normnum;    // # of values to rescale
   double norm;    // normalization factor for rescaling
+  int nbatch;     // # of batches of pipelined FFTs and remaps, 1 = none
+
+  struct fft_batch_1d *batch_fast;    // batches of 1st FFTs, nullptr if not pipelined
+  struct fft_batch_1d *batch_mid;     // batches of 2nd FFTs
+  struct fft_batch_1d *batch_slow;    // batches of 3rd FFTs
 
   // system specific 1d FFT info
 #if defined(FFT_MKL)
@@ -130,7 +153,7 @@ struct fft_plan_3d {
 extern "C" {
 void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int, int,
-                                       int, int, int, int, int, int, int, int *, int);
+                                       int, int, int, int, int, int, int, int *, int, int);
 void fft_3d_destroy_plan(struct fft_plan_3d *);
 void factor(int, int *, int *);
 void bifactor(int, int *, int *);
@@ -24,10 +24,11 @@ class FFT3d : protected Pointers {
   enum { FORWARD = 1, BACKWARD = -1 };
 
   FFT3d(class LAMMPS *, MPI_Comm, int, int, int, int, int, int, int, int, int, int, int, int, int,
-        int, int, int, int, int *, int);
+        int, int, int, int, int *, int, int nbatch = 1);
   ~FFT3d() override;
   void compute(FFT_SCALAR *, FFT_SCALAR *, int);
   void timing1d(FFT_SCALAR *, int, int);
+  int get_nbatch() const { return plan->nbatch; }
 
  private:
   struct fft_plan_3d *plan;
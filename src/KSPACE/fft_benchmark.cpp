@@ -0,0 +1,167 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fft_benchmark.h"
+
+#include "comm.h"
+#include "error.h"
+#include "fft3d_wrap.h"
+#include "memory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+using namespace LAMMPS_NS;
+
+static constexpr int MAXBATCH = 8;
+
+/* ---------------------------------------------------------------------- */
+
+void FFTBenchmark::command(int narg, char **arg)
+{
+  if (narg < 3) utils::missing_cmd_args(FLERR, "fft_benchmark", error);
+
+  int nx = utils::inumeric(FLERR, arg[0], false, lmp);
+  int ny = utils::inumeric(FLERR, arg[1], false, lmp);
+  int nz = utils::inumeric(FLERR, arg[2], false, lmp);
+  if ((nx < 1) || (ny < 1) || (nz < 1))
+    error->all(FLERR, "Illegal fft_benchmark grid {}x{}x{}", nx, ny, nz);
+
+  int niter = 10;
+  int collective = 0;
+  int batch = 0;
+
+  int iarg = 3;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "iterations") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fft_benchmark iterations", error);
+      niter = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
+      if (niter < 1) error->all(FLERR, "Illegal fft_benchmark iterations value {}", niter);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "collective") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fft_benchmark collective", error);
+      collective = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "batch") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "fft_benchmark batch", error);
+      if (strcmp(arg[iarg + 1], "auto") == 0)
+        batch = 0;
+      else {
+        batch = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
+        if (batch < 1) error->all(FLERR, "Illegal fft_benchmark batch value {}", batch);
+      }
+      iarg += 2;
+    } else
+      error->all(FLERR, "Unknown fft_benchmark keyword: {}", arg[iarg]);
+  }
+
+  // x-pencil decomposition, same in and out layout as the 1st PPPM FFT
+  // y and z are split over a 2d grid of procs
+
+  const int me = comm->me;
+  const int nprocs = comm->nprocs;
+  int npy, npz;
+  bifactor(nprocs, &npy, &npz);
+  if ((npy > ny) || (npz > nz)) std::swap(npy, npz);
+  if ((npy > ny) || (npz > nz))
+    error->all(FLERR, "Fft_benchmark grid {}x{}x{} is too small for {} procs", nx, ny, nz, nprocs);
+
+  const int iy = me % npy;
+  const int iz = me / npy;
+  const int ilo = 0;
+  const int ihi = nx - 1;
+  const int jlo = iy * ny / npy;
+  const int jhi = (iy + 1) * ny / npy - 1;
+  const int klo = iz * nz / npz;
+  const int khi = (iz + 1) * nz / npz - 1;
+  const int nlocal = (ihi - ilo + 1) * (jhi - jlo + 1) * (khi - klo + 1);
+
+  // reproducible input values, independent of the decomposition
+
+  FFT_SCALAR *orig, *data;
+  memory->create(orig, 2 * nlocal, "fft_benchmark:orig");
+  memory->create(data, 2 * nlocal, "fft_benchmark:data");
+
+  int n = 0;
+  for (int k = klo; k <= khi; k++)
+    for (int j = jlo; j <= jhi; j++)
+      for (int i = ilo; i <= ihi; i++) {
+        const double m = ((double) k * ny + j) * nx + i;
+        orig[n++] = sin(0.37 * m + 0.11);
+        orig[n++] = cos(0.23 * m - 0.57);
+      }
+
+  if (me == 0)
+    utils::logmesg(lmp,
+                   "FFT benchmark: {}x{}x{} grid, {}x{} procs, {} remaps, using {} precision {}\n"
+                   "  batches  time/FFT (s)   GFlop/s    max error\n",
+                   nx, ny, nz, npy, npz, collective ? "collective" : "point-to-point",
+                   LMP_FFT_PREC, LMP_FFT_LIB);
+
+  // 5 N log2(N) flops per complex 3d FFT of N points
+
+  const double ntotal = (double) nx * ny * nz;
+  const double flops = 5.0 * ntotal * log2(ntotal);
+
+  int nfirst = batch ? batch : 1;
+  int nlast = batch ? batch : MAXBATCH;
+  if (nprocs == 1) nfirst = nlast = 1;
+
+  for (int nbatch = nfirst; nbatch <= nlast; nbatch *= 2) {
+    int tmp;
+    auto fft = new FFT3d(lmp, world, nx, ny, nz, ilo, ihi, jlo, jhi, klo, khi, ilo, ihi, jlo, jhi,
+                         klo, khi, 1, 0, &tmp, collective, nbatch);
+
+    // stop auto scan once the remaps cannot be split any further
+
+    const int nused = fft->get_nbatch();
+    if ((batch == 0) && (nbatch > 1) && (nused < nbatch)) {
+      delete fft;
+      break;
+    }
+
+    // warm up, then time forward + scaled backward round trips
+
+    memcpy(data, orig, 2 * nlocal * sizeof(FFT_SCALAR));
+    fft->compute(data, data, FFT3d::FORWARD);
+    fft->compute(data, data, FFT3d::BACKWARD);
+
+    memcpy(data, orig, 2 * nlocal * sizeof(FFT_SCALAR));
+    MPI_Barrier(world);
+    double time = platform::walltime();
+    for (int iter = 0; iter < niter; iter++) {
+      fft->compute(data, data, FFT3d::FORWARD);
+      fft->compute(data, data, FFT3d::BACKWARD);
+    }
+    time = platform::walltime() - time;
+    delete fft;
+
+    double error_local = 0.0;
+    for (int m = 0; m < 2 * nlocal; m++)
+      error_local = std::max(error_local, fabs((double) data[m] - (double) orig[m]));
+
+    double time_all, error_all;
+    MPI_Allreduce(&time, &time_all, 1, MPI_DOUBLE, MPI_MAX, world);
+    MPI_Allreduce(&error_local, &error_all, 1, MPI_DOUBLE, MPI_MAX, world);
+
+    const double time_fft = time_all / (2.0 * niter);
+    if (me == 0)
+      utils::logmesg(lmp, "  {:7d}  {:12.6g}  {:10.4g}  {:11.4g}\n", nused, time_fft,
+                     flops / time_fft * 1.0e-9, error_all);
+  }
+
+  memory->destroy(orig);
+  memory->destroy(data);
+}
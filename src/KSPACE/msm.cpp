@@ -32,6 +32,7 @@
 
 #include <cstring>
 #include <cmath>
+#include <climits>
 
 using namespace LAMMPS_NS;
 using namespace MathConst;
@@ -42,6 +43,7 @@ using namespace MathConst;
 
 enum{REVERSE_RHO,REVERSE_AD,REVERSE_AD_PERATOM};
 enum{FORWARD_RHO,FORWARD_AD,FORWARD_AD_PERATOM};
+enum{TIME_COMM,TIME_DIRECT,TIME_RESTRICT,TIME_PROLONG,NTIME};
 
 /* ---------------------------------------------------------------------- */
 
@@ -75,6 +77,28 @@ MSM::MSM(LAMMPS *lmp)
   warn_nonneutral = 0;
 
   order = 10;
+
+  transfer = nullptr;
+  ntransfer = nstencil = 0;
+  transfer_buf1 = transfer_buf2 = nullptr;
+
+  level_timing_flag = 0;
+  nlevel_time = 0;
+  level_time = nullptr;
+  level_tstart = 0.0;
+  level_ncompute = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MSM::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0],"timing/levels") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify timing/levels",error);
+    level_timing_flag = utils::logical(FLERR,arg[1],false,lmp);
+    return 2;
+  }
+  return 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -114,6 +138,7 @@ MSM::~MSM()
   memory->destroy(v3_direct_top);
   memory->destroy(v4_direct_top);
   memory->destroy(v5_direct_top);
+  memory->destroy(level_time);
 }
 
 /* ----------------------------------------------------------------------
@@ -178,6 +203,14 @@ void MSM::init()
 
   double estimated_error = estimate_total_error();
 
+  // reset per-level timing
+
+  memory->destroy(level_time);
+  nlevel_time = levels;
+  memory->create(level_time,nlevel_time,NTIME,"msm:level_time");
+  memset(&level_time[0][0],0,nlevel_time*NTIME*sizeof(double));
+  level_ncompute = 0;
+
   // output grid stats
 
   int ngrid_max;
@@ -443,6 +476,8 @@ void MSM::compute(int eflag, int vflag)
   particle_map();
   make_rho();
 
+  if (level_timing_flag) level_tstart = platform::walltime();
+
   // all procs reverse communicate charge density values from
   // their ghost grid points
   // to fully sum contribution in their 3d grid
@@ -450,17 +485,24 @@ void MSM::compute(int eflag, int vflag)
   current_level = 0;
   gcall->reverse_comm(Grid3d::KSPACE,this,REVERSE_RHO,1,sizeof(double),
                       gcall_buf1,gcall_buf2,MPI_DOUBLE);
+  level_timer(0,TIME_COMM);
 
   // forward communicate charge density values to fill ghost grid points
   // compute direct sum interaction and then restrict to coarser grid
 
   for (int n=0; n<=levels-2; n++) {
-    if (!active_flag[n]) continue;
+    if (!active_flag[n]) {
+      level_timer_skip();
+      continue;
+    }
     current_level = n;
     gc[n]->forward_comm(Grid3d::KSPACE,this,FORWARD_RHO,1,sizeof(double),
                         gc_buf1[n],gc_buf2[n],MPI_DOUBLE);
+    level_timer(n,TIME_COMM);
     direct(n);
+    level_timer(n,TIME_DIRECT);
     restriction(n);
+    level_timer(n,TIME_RESTRICT);
   }
 
   // compute direct interation for top grid level for non-periodic
@@ -472,7 +514,9 @@ void MSM::compute(int eflag, int vflag)
       gc[levels-1]->
         forward_comm(Grid3d::KSPACE,this,FORWARD_RHO,1,sizeof(double),
                      gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
+      level_timer(levels-1,TIME_COMM);
       direct_top(levels-1);
+      level_timer(levels-1,TIME_DIRECT);
       gc[levels-1]->
         reverse_comm(Grid3d::KSPACE,this,REVERSE_AD,1,sizeof(double),
                      gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
@@ -480,26 +524,34 @@ void MSM::compute(int eflag, int vflag)
         gc[levels-1]->
           reverse_comm(Grid3d::KSPACE,this,REVERSE_AD_PERATOM,6,sizeof(double),
                        gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
+      level_timer(levels-1,TIME_COMM);
 
     } else {
       // Here using MPI_Allreduce is cheaper than using commgrid
       grid_swap_forward(levels-1,qgrid[levels-1]);
+      level_timer(levels-1,TIME_COMM);
       direct(levels-1);
+      level_timer(levels-1,TIME_DIRECT);
       grid_swap_reverse(levels-1,egrid[levels-1]);
       current_level = levels-1;
       if (vflag_atom)
         gc[levels-1]->
           reverse_comm(Grid3d::KSPACE,this,REVERSE_AD_PERATOM,6,sizeof(double),
                        gc_buf1[levels-1],gc_buf2[levels-1],MPI_DOUBLE);
+      level_timer(levels-1,TIME_COMM);
     }
-  }
+  } else level_timer_skip();
 
   // prolongate energy/virial from coarser grid to finer grid
   // reverse communicate from ghost grid points to get full sum
 
   for (int n=levels-2; n>=0; n--) {
-    if (!active_flag[n]) continue;
+    if (!active_flag[n]) {
+      level_timer_skip();
+      continue;
+    }
     prolongation(n);
+    level_timer(n,TIME_PROLONG);
 
     current_level = n;
     gc[n]->reverse_comm(Grid3d::KSPACE,this,REVERSE_AD,1,sizeof(double),
@@ -510,6 +562,7 @@ void MSM::compute(int eflag, int vflag)
     if (vflag_atom)
       gc[n]->reverse_comm(Grid3d::KSPACE,this,REVERSE_AD_PERATOM,6,sizeof(double),
                           gc_buf1[n],gc_buf2[n],MPI_DOUBLE);
+    level_timer(n,TIME_COMM);
   }
 
   // all procs communicate E-field values
@@ -525,6 +578,9 @@ void MSM::compute(int eflag, int vflag)
     gcall->forward_comm(Grid3d::KSPACE,this,FORWARD_AD_PERATOM,6,sizeof(double),
                         gcall_buf1,gcall_buf2,MPI_DOUBLE);
 
+  level_timer(0,TIME_COMM);
+  if (level_timing_flag) level_ncompute++;
+
   // calculate the force on my particles (interpolation)
 
   fieldforce();
@@ -656,6 +712,10 @@ void MSM::allocate()
       gc_buf1[n] = gc_buf2[n] = nullptr;
     }
   }
+
+  // 1d stencils for transfers between levels
+
+  setup_transfer();
 }
 
 /* ----------------------------------------------------------------------
@@ -672,6 +732,8 @@ void MSM::deallocate()
   memory->destroy(gcall_buf2);
   gcall = nullptr;
   gcall_buf1 = gcall_buf2 = nullptr;
+
+  deallocate_transfer();
 }
 
 /* ----------------------------------------------------------------------
@@ -2245,173 +2307,342 @@ void MSM::direct_peratom_top(int n)
 /* ----------------------------------------------------------------------
    MSM restriction procedure for intermediate grid levels, interpolate
    charges from finer grid to coarser grid
+   the 3d stencil is a product of 1d stencils, so the charges are
+   interpolated along x, y, and z in turn
 ------------------------------------------------------------------------- */
 
 void MSM::restriction(int n)
 {
-  const int p = order-1;
+  double ***qgrid2 = qgrid[n+1];
+  const Transfer1d *tr = &transfer[3*n];
+
+  // zero out charge on coarser grid
+
+  memset(&(qgrid2[nzlo_out[n+1]][nylo_out[n+1]][nxlo_out[n+1]]),0,ngrid[n+1]*sizeof(double));
+
+  if (!tr[0].nc || !tr[1].nc || !tr[2].nc) return;
+
+  restrict_x(n,0,tr[2].nf*tr[1].nf);
+  restrict_y(n,0,tr[2].nf);
+  restrict_z(n,0,tr[1].nc);
+}
+
+/* ----------------------------------------------------------------------
+   MSM prolongation procedure for intermediate grid levels, interpolate
+   per-atom energy/virial from coarser grid to finer grid
+   transpose of restriction, along z, y, and x in turn
+------------------------------------------------------------------------- */
+
+void MSM::prolongation(int n)
+{
+  const Transfer1d *tr = &transfer[3*n];
+  if (!tr[0].nc || !tr[1].nc || !tr[2].nc) return;
+
+  double ****grids[7] = {egrid,v0grid,v1grid,v2grid,v3grid,v4grid,v5grid};
+  const int ngrids = vflag_atom ? 7 : 1;
 
+  for (int m = 0; m < ngrids; m++) {
+    prolong_z(n,grids[m][n+1],0,tr[1].nc);
+    prolong_y(n,0,tr[2].nf);
+    prolong_x(n,grids[m][n],0,tr[2].nf*tr[1].nf);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   restriction along x for rows from <= r < to of fine (z,y) points
+   transfer_buf1[fine z][fine y][coarse x]
+------------------------------------------------------------------------- */
+
+void MSM::restrict_x(int n, int from, int to)
+{
+  const Transfer1d &tx = transfer[3*n];
+  const Transfer1d &ty = transfer[3*n+1];
+  const Transfer1d &tz = transfer[3*n+2];
   double ***qgrid1 = qgrid[n];
+  const int ncx = tx.nc;
+
+  for (int r = from; r < to; r++) {
+    const double *src = qgrid1[tz.flo + r/ty.nf][ty.flo + r%ty.nf];
+    double *dst = &transfer_buf1[(bigint) r*ncx];
+    for (int c = 0; c < ncx; c++) {
+      const int *index = &tx.index[c*nstencil];
+      const double *weight = &tx.weight[c*nstencil];
+      double sum = 0.0;
+      for (int m = 0; m < tx.count[c]; m++) sum += weight[m]*src[index[m]];
+      dst[c] = sum;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   restriction along y for fine z planes from <= kz < to
+   transfer_buf2[fine z][coarse y][coarse x]
+------------------------------------------------------------------------- */
+
+void MSM::restrict_y(int n, int from, int to)
+{
+  const Transfer1d &tx = transfer[3*n];
+  const Transfer1d &ty = transfer[3*n+1];
+  const int ncx = tx.nc;
+
+  for (int kz = from; kz < to; kz++) {
+    for (int c = 0; c < ty.nc; c++) {
+      double *dst = &transfer_buf2[((bigint) kz*ty.nc + c)*ncx];
+      for (int i = 0; i < ncx; i++) dst[i] = 0.0;
+      for (int m = 0; m < ty.count[c]; m++) {
+        const double w = ty.weight[c*nstencil+m];
+        const double *src =
+          &transfer_buf1[((bigint) kz*ty.nf + ty.index[c*nstencil+m] - ty.flo)*ncx];
+        for (int i = 0; i < ncx; i++) dst[i] += w*src[i];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   restriction along z for coarse y rows from <= cy < to
+   result is stored in owned points of coarser grid
+------------------------------------------------------------------------- */
+
+void MSM::restrict_z(int n, int from, int to)
+{
+  const Transfer1d &tx = transfer[3*n];
+  const Transfer1d &ty = transfer[3*n+1];
+  const Transfer1d &tz = transfer[3*n+2];
   double ***qgrid2 = qgrid[n+1];
+  const int ncx = tx.nc;
+
+  for (int cy = from; cy < to; cy++) {
+    for (int c = 0; c < tz.nc; c++) {
+      double *dst = &qgrid2[tz.clo + c][ty.clo + cy][tx.clo];
+      for (int m = 0; m < tz.count[c]; m++) {
+        const double w = tz.weight[c*nstencil+m];
+        const double *src =
+          &transfer_buf2[((bigint) (tz.index[c*nstencil+m] - tz.flo)*ty.nc + cy)*ncx];
+        for (int i = 0; i < ncx; i++) dst[i] += w*src[i];
+      }
+    }
+  }
+}
 
-  int k = 0;
-  int *index = new int[p+2];
-  for (int nu=-p; nu<=p; nu++) {
-    if (nu%2 == 0 && nu != 0) continue;
-    phi1d[0][k] = compute_phi(nu*delxinv[n+1]/delxinv[n]);
-    phi1d[1][k] = compute_phi(nu*delyinv[n+1]/delyinv[n]);
-    phi1d[2][k] = compute_phi(nu*delzinv[n+1]/delzinv[n]);
-    index[k] = nu;
-    k++;
+/* ----------------------------------------------------------------------
+   prolongation along z of coarse grid egrid2 for coarse y rows from <= cy < to
+   transfer_buf2[fine z][coarse y][coarse x]
+------------------------------------------------------------------------- */
+
+void MSM::prolong_z(int n, double ***egrid2, int from, int to)
+{
+  const Transfer1d &tx = transfer[3*n];
+  const Transfer1d &ty = transfer[3*n+1];
+  const Transfer1d &tz = transfer[3*n+2];
+  const int ncx = tx.nc;
+
+  for (int cy = from; cy < to; cy++) {
+    for (int kz = 0; kz < tz.nf; kz++) {
+      double *dst = &transfer_buf2[((bigint) kz*ty.nc + cy)*ncx];
+      for (int i = 0; i < ncx; i++) dst[i] = 0.0;
+    }
+    for (int c = 0; c < tz.nc; c++) {
+      const double *src = &egrid2[tz.clo + c][ty.clo + cy][tx.clo];
+      for (int m = 0; m < tz.count[c]; m++) {
+        const double w = tz.weight[c*nstencil+m];
+        double *dst = &transfer_buf2[((bigint) (tz.index[c*nstencil+m] - tz.flo)*ty.nc + cy)*ncx];
+        for (int i = 0; i < ncx; i++) dst[i] += w*src[i];
+      }
+    }
   }
+}
 
-  int ip,jp,kp,ic,jc,kc,i,j;
-  int ii,jj,kk;
-  double phiz,phizy,q2sum;
+/* ----------------------------------------------------------------------
+   prolongation along y for fine z planes from <= kz < to
+   transfer_buf1[fine z][fine y][coarse x]
+------------------------------------------------------------------------- */
 
-  // zero out charge on coarser grid
+void MSM::prolong_y(int n, int from, int to)
+{
+  const Transfer1d &tx = transfer[3*n];
+  const Transfer1d &ty = transfer[3*n+1];
+  const int ncx = tx.nc;
+
+  for (int kz = from; kz < to; kz++) {
+    double *plane = &transfer_buf1[(bigint) kz*ty.nf*ncx];
+    for (int i = 0; i < ty.nf*ncx; i++) plane[i] = 0.0;
+    for (int c = 0; c < ty.nc; c++) {
+      const double *src = &transfer_buf2[((bigint) kz*ty.nc + c)*ncx];
+      for (int m = 0; m < ty.count[c]; m++) {
+        const double w = ty.weight[c*nstencil+m];
+        double *dst = &plane[(ty.index[c*nstencil+m] - ty.flo)*ncx];
+        for (int i = 0; i < ncx; i++) dst[i] += w*src[i];
+      }
+    }
+  }
+}
 
-  memset(&(qgrid2[nzlo_out[n+1]][nylo_out[n+1]][nxlo_out[n+1]]),0,ngrid[n+1]*sizeof(double));
+/* ----------------------------------------------------------------------
+   prolongation along x for rows from <= r < to of fine (z,y) points
+   result is added to fine grid egrid1, including its ghost points
+------------------------------------------------------------------------- */
 
-  for (kp = nzlo_in[n+1]; kp <= nzhi_in[n+1]; kp++)
-    for (jp = nylo_in[n+1]; jp <= nyhi_in[n+1]; jp++)
-      for (ip = nxlo_in[n+1]; ip <= nxhi_in[n+1]; ip++) {
+void MSM::prolong_x(int n, double ***egrid1, int from, int to)
+{
+  const Transfer1d &tx = transfer[3*n];
+  const Transfer1d &ty = transfer[3*n+1];
+  const Transfer1d &tz = transfer[3*n+2];
+  const int ncx = tx.nc;
+
+  for (int r = from; r < to; r++) {
+    double *dst = egrid1[tz.flo + r/ty.nf][ty.flo + r%ty.nf];
+    const double *src = &transfer_buf1[(bigint) r*ncx];
+    for (int c = 0; c < ncx; c++) {
+      const int *index = &tx.index[c*nstencil];
+      const double *weight = &tx.weight[c*nstencil];
+      const double etmp = src[c];
+      for (int m = 0; m < tx.count[c]; m++) dst[index[m]] += weight[m]*etmp;
+    }
+  }
+}
 
-        ic = ip * static_cast<int> (delxinv[n]/delxinv[n+1]);
-        jc = jp * static_cast<int> (delyinv[n]/delyinv[n+1]);
-        kc = kp * static_cast<int> (delzinv[n]/delzinv[n+1]);
+/* ----------------------------------------------------------------------
+   precompute 1d stencils between all pairs of adjacent levels
+   for each of my coarse grid points: the fine grid points it is
+   interpolated from, clipped at non-periodic boundaries, and their weights
+------------------------------------------------------------------------- */
 
-        q2sum = 0.0;
+void MSM::setup_transfer()
+{
+  deallocate_transfer();
 
-        for (k=0; k<=p+1; k++) {
-          kk = kc+index[k];
-          if (!domain->zperiodic) {
-            if (kk < alpha[n]) continue;
-            if (kk > betaz[n]) break;
-          }
-          phiz = phi1d[2][k];
-          for (j=0; j<=p+1; j++) {
-            jj = jc+index[j];
-            if (!domain->yperiodic) {
-              if (jj < alpha[n]) continue;
-              if (jj > betay[n]) break;
-            }
-            phizy = phi1d[1][j]*phiz;
-            for (i=0; i<=p+1; i++) {
-              ii = ic+index[i];
-              if (!domain->xperiodic) {
-                if (ii < alpha[n]) continue;
-                if (ii > betax[n]) break;
-              }
-              q2sum += qgrid1[kk][jj][ii] *
-                phi1d[0][i]*phizy;
-            }
-          }
+  const int p = order-1;
+  nstencil = p+2;
+  ntransfer = levels-1;
+  if (ntransfer <= 0) return;
+  transfer = new Transfer1d[3*ntransfer];
+
+  bigint nbuf1 = 0, nbuf2 = 0;
+
+  for (int n = 0; n < ntransfer; n++) {
+    for (int d = 0; d < 3; d++) {
+      Transfer1d &t = transfer[3*n+d];
+      int clo,chi,beta,periodic;
+      double delinv1,delinv2;
+      if (d == 0) {
+        clo = nxlo_in[n+1]; chi = nxhi_in[n+1]; beta = betax[n];
+        periodic = domain->xperiodic; delinv1 = delxinv[n]; delinv2 = delxinv[n+1];
+      } else if (d == 1) {
+        clo = nylo_in[n+1]; chi = nyhi_in[n+1]; beta = betay[n];
+        periodic = domain->yperiodic; delinv1 = delyinv[n]; delinv2 = delyinv[n+1];
+      } else {
+        clo = nzlo_in[n+1]; chi = nzhi_in[n+1]; beta = betaz[n];
+        periodic = domain->zperiodic; delinv1 = delzinv[n]; delinv2 = delzinv[n+1];
+      }
+      const int factor = static_cast<int> (delinv1/delinv2);
+
+      t.clo = clo;
+      t.nc = MAX(chi-clo+1,0);
+      t.count = new int[t.nc];
+      t.index = new int[t.nc*nstencil];
+      t.weight = new double[t.nc*nstencil];
+
+      int flo = INT_MAX, fhi = INT_MIN;
+      for (int c = 0; c < t.nc; c++) {
+        const int ic = (clo+c) * factor;
+        int m = 0;
+        for (int nu = -p; nu <= p; nu++) {
+          if (nu%2 == 0 && nu != 0) continue;
+          const int ii = ic+nu;
+          if (!periodic && ((ii < alpha[n]) || (ii > beta))) continue;
+          t.index[c*nstencil+m] = ii;
+          t.weight[c*nstencil+m] = compute_phi(nu*delinv2/delinv1);
+          flo = MIN(flo,ii);
+          fhi = MAX(fhi,ii);
+          m++;
         }
-        qgrid2[kp][jp][ip] += q2sum;
+        t.count[c] = m;
       }
-  delete[] index;
+      t.flo = (flo <= fhi) ? flo : 0;
+      t.nf = (flo <= fhi) ? fhi-flo+1 : 0;
+    }
+
+    const Transfer1d *tr = &transfer[3*n];
+    nbuf1 = MAX(nbuf1,(bigint) tr[2].nf*tr[1].nf*tr[0].nc);
+    nbuf2 = MAX(nbuf2,(bigint) tr[2].nf*tr[1].nc*tr[0].nc);
+  }
+
+  memory->create(transfer_buf1,MAX(nbuf1,1),"msm:transfer_buf1");
+  memory->create(transfer_buf2,MAX(nbuf2,1),"msm:transfer_buf2");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void MSM::deallocate_transfer()
+{
+  if (transfer) {
+    for (int i = 0; i < 3*ntransfer; i++) {
+      delete[] transfer[i].count;
+      delete[] transfer[i].index;
+      delete[] transfer[i].weight;
+    }
+    delete[] transfer;
+  }
+  transfer = nullptr;
+  ntransfer = 0;
+  memory->destroy(transfer_buf1);
+  memory->destroy(transfer_buf2);
 }
 
 /* ----------------------------------------------------------------------
-   MSM prolongation procedure for intermediate grid levels, interpolate
-   per-atom energy/virial from coarser grid to finer grid
+   add time since last call to a part of the timing breakdown of a level
 ------------------------------------------------------------------------- */
 
-void MSM::prolongation(int n)
+void MSM::level_timer(int n, int which)
 {
-  const int p = order-1;
+  if (!level_timing_flag) return;
+  const double now = platform::walltime();
+  level_time[n][which] += now - level_tstart;
+  level_tstart = now;
+}
 
-  double ***egrid1 = egrid[n];
-  double ***egrid2 = egrid[n+1];
-
-  double ***v0grid1 = v0grid[n];
-  double ***v0grid2 = v0grid[n+1];
-  double ***v1grid1 = v1grid[n];
-  double ***v1grid2 = v1grid[n+1];
-  double ***v2grid1 = v2grid[n];
-  double ***v2grid2 = v2grid[n+1];
-  double ***v3grid1 = v3grid[n];
-  double ***v3grid2 = v3grid[n+1];
-  double ***v4grid1 = v4grid[n];
-  double ***v4grid2 = v4grid[n+1];
-  double ***v5grid1 = v5grid[n];
-  double ***v5grid2 = v5grid[n+1];
+/* ----------------------------------------------------------------------
+   restart timing when a level is skipped because this proc owns no
+   part of its grid, so the skipped level is not charged to the next one
+------------------------------------------------------------------------- */
 
-  int k = 0;
-  int *index = new int[p+2];
-  for (int nu=-p; nu<=p; nu++) {
-    if (nu%2 == 0 && nu != 0) continue;
-    phi1d[0][k] = compute_phi(nu*delxinv[n+1]/delxinv[n]);
-    phi1d[1][k] = compute_phi(nu*delyinv[n+1]/delyinv[n]);
-    phi1d[2][k] = compute_phi(nu*delzinv[n+1]/delzinv[n]);
-    index[k] = nu;
-    k++;
-  }
+void MSM::level_timer_skip()
+{
+  if (!level_timing_flag) return;
+  level_tstart = platform::walltime();
+}
 
-  int ip,jp,kp,ic,jc,kc,i,j;
-  int ii,jj,kk;
-  double phiz,phizy,phi3d;
-  double etmp2,v0tmp2,v1tmp2,v2tmp2,v3tmp2,v4tmp2,v5tmp2;
-
-  for (kp = nzlo_in[n+1]; kp <= nzhi_in[n+1]; kp++)
-    for (jp = nylo_in[n+1]; jp <= nyhi_in[n+1]; jp++)
-      for (ip = nxlo_in[n+1]; ip <= nxhi_in[n+1]; ip++) {
-
-        ic = ip * static_cast<int> (delxinv[n]/delxinv[n+1]);
-        jc = jp * static_cast<int> (delyinv[n]/delyinv[n+1]);
-        kc = kp * static_cast<int> (delzinv[n]/delzinv[n+1]);
-
-        etmp2 = egrid2[kp][jp][ip];
-
-        if (vflag_atom) {
-          v0tmp2 = v0grid2[kp][jp][ip];
-          v1tmp2 = v1grid2[kp][jp][ip];
-          v2tmp2 = v2grid2[kp][jp][ip];
-          v3tmp2 = v3grid2[kp][jp][ip];
-          v4tmp2 = v4grid2[kp][jp][ip];
-          v5tmp2 = v5grid2[kp][jp][ip];
-        }
+/* ----------------------------------------------------------------------
+   print per-level timing breakdown of the run, max over procs
+------------------------------------------------------------------------- */
 
-        for (k=0; k<=p+1; k++) {
-          kk = kc+index[k];
-          if (!domain->zperiodic) {
-            if (kk < alpha[n]) continue;
-            if (kk > betaz[n]) break;
-          }
-          phiz = phi1d[2][k];
-          for (j=0; j<=p+1; j++) {
-            jj = jc+index[j];
-            if (!domain->yperiodic) {
-              if (jj < alpha[n]) continue;
-              if (jj > betay[n]) break;
-            }
-            phizy = phi1d[1][j]*phiz;
-            for (i=0; i<=p+1; i++) {
-              ii = ic+index[i];
-              if (!domain->xperiodic) {
-                if (ii < alpha[n]) continue;
-                if (ii > betax[n]) break;
-              }
-              phi3d = phi1d[0][i]*phizy;
+void MSM::finish()
+{
+  if (!level_timing_flag || !level_time) return;
 
-              egrid1[kk][jj][ii] += etmp2 * phi3d;
+  bigint ncompute;
+  MPI_Allreduce(&level_ncompute,&ncompute,1,MPI_LMP_BIGINT,MPI_MAX,world);
+  if (ncompute == 0) return;
 
-              if (vflag_atom) {
-                v0grid1[kk][jj][ii] += v0tmp2 * phi3d;
-                v1grid1[kk][jj][ii] += v1tmp2 * phi3d;
-                v2grid1[kk][jj][ii] += v2tmp2 * phi3d;
-                v3grid1[kk][jj][ii] += v3tmp2 * phi3d;
-                v4grid1[kk][jj][ii] += v4tmp2 * phi3d;
-                v5grid1[kk][jj][ii] += v5tmp2 * phi3d;
-              }
+  double **time_max;
+  memory->create(time_max,nlevel_time,NTIME,"msm:time_max");
+  MPI_Reduce(&level_time[0][0],&time_max[0][0],nlevel_time*NTIME,MPI_DOUBLE,MPI_MAX,0,world);
 
-            }
-          }
-        }
+  if (me == 0) {
+    std::string mesg = fmt::format("\nMSM time per level and step (max over procs, {} steps):\n",
+                                   ncompute);
+    mesg += "  Level         Grid        Comm      Direct    Restrict     Prolong\n";
+    for (int n = 0; n < nlevel_time; n++)
+      mesg += fmt::format("  {:5d} {:>12} {:11.4g} {:11.4g} {:11.4g} {:11.4g}\n",n,
+                          fmt::format("{}x{}x{}",nx_msm[n],ny_msm[n],nz_msm[n]),
+                          time_max[n][TIME_COMM]/ncompute,time_max[n][TIME_DIRECT]/ncompute,
+                          time_max[n][TIME_RESTRICT]/ncompute,
+                          time_max[n][TIME_PROLONG]/ncompute);
+    utils::logmesg(lmp,mesg);
+  }
 
-      }
-  delete[] index;
+  memory->destroy(time_max);
 }
 
 /* ----------------------------------------------------------------------
@@ -3417,5 +3648,17 @@ double MSM::memory_usage()
     if (active_flag[n])
       bytes += (double)(ngc_buf1[n] + ngc_buf2[n]) * npergrid * sizeof(double);
 
+  // 1d transfer stencils and buffers
+
+  bigint nbuf1 = 0, nbuf2 = 0;
+  for (int n = 0; n < ntransfer; n++) {
+    const Transfer1d *tr = &transfer[3*n];
+    for (int d = 0; d < 3; d++)
+      bytes += (double)tr[d].nc * (sizeof(int) + nstencil * (sizeof(int) + sizeof(double)));
+    nbuf1 = MAX(nbuf1,(bigint) tr[2].nf*tr[1].nf*tr[0].nc);
+    nbuf2 = MAX(nbuf2,(bigint) tr[2].nf*tr[1].nc*tr[0].nc);
+  }
+  bytes += (double)(nbuf1 + nbuf2) * sizeof(double);
+
   return bytes;
 }
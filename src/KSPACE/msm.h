@@ -32,6 +32,8 @@ class MSM : public KSpace {
   void setup() override;
   void settings(int, char **) override;
   void compute(int, int) override;
+  int modify_param(int, char **) override;
+  void finish() override;
   double memory_usage() override;
 
  protected:
@@ -97,6 +99,31 @@ class MSM : public KSpace {
   int triclinic;
   double *boxlo;
 
+  // separable 1d stencils of restriction and prolongation between levels
+  // n and n+1, precomputed per level and dimension when grids are allocated
+
+  struct Transfer1d {
+    int clo, nc;       // first and # of my coarse grid points at level n+1
+    int flo, nf;       // first and # of fine grid points at level n in their stencils
+    int *count;        // # of fine points in the stencil of each coarse point
+    int *index;        // fine points of each stencil, nstencil per coarse point
+    double *weight;    // stencil weights of the fine points
+  };
+
+  Transfer1d *transfer;    // 3 dimensions for each of levels 0 to levels-2
+  int ntransfer;           // # of levels with stencils
+  int nstencil;            // max # of fine points per coarse point
+  double *transfer_buf1;   // grid after the 1st 1d transfer
+  double *transfer_buf2;   // grid after the 2nd 1d transfer
+
+  // per-level timing breakdown
+
+  int level_timing_flag;
+  int nlevel_time;
+  double **level_time;     // comm, direct, restriction, prolongation time per level
+  double level_tstart;
+  bigint level_ncompute;
+
   void set_grid_global();
   void set_proc_grid(int);
   void set_grid_local();
@@ -117,8 +144,18 @@ class MSM : public KSpace {
   void direct_peratom(int);
   void direct_top(int);
   void direct_peratom_top(int);
-  void restriction(int);
-  void prolongation(int);
+  virtual void restriction(int);
+  virtual void prolongation(int);
+  void setup_transfer();
+  void deallocate_transfer();
+  void restrict_x(int, int, int);
+  void restrict_y(int, int, int);
+  void restrict_z(int, int, int);
+  void prolong_z(int, double ***, int, int);
+  void prolong_y(int, int, int);
+  void prolong_x(int, double ***, int, int);
+  void level_timer(int, int);
+  void level_timer_skip();
   void grid_swap_forward(int, double ***&);
   void grid_swap_reverse(int, double ***&);
   virtual void fieldforce();
@@ -37,9 +37,15 @@
 #include "neighbor.h"
 #include "pair.h"
 #include "remap_wrap.h"
+#include "update.h"
 
 #include <cmath>
 #include <cstring>
+#include <utility>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 using namespace LAMMPS_NS;
 using namespace MathConst;
@@ -50,6 +56,9 @@ using namespace MathSpecial;
 #define LARGE 10000.0
 #define SMALL 0.00001
 #define EPS_HOC 1.0e-7
+#define SKIPWARN 0.05
+#define MAXFFTBATCH 8
+#define NFFTTUNE 4
 
 enum{REVERSE_RHO};
 enum{FORWARD_IK,FORWARD_AD,FORWARD_IK_PERATOM,FORWARD_AD_PERATOM};
@@ -123,6 +132,24 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   nmax = 0;
   part2grid = nullptr;
 
+  kernel_flag = 0;
+  kernel_threads = 0;
+  cellperm = cellcount = nullptr;
+  ncellperm = ncellcount = 0;
+  density_thr = nullptr;
+  ndensity_thr = 0;
+
+  skip_every = 1;
+  skip_extrapolate = 0;
+  skip_step[0] = skip_step[1] = -1;
+  skip_field[0] = skip_field[1] = nullptr;
+  nskip_field = 0;
+  skip_nfull = skip_nreuse = 0;
+  skip_ncheck = 0;
+  skip_fdev_max = skip_fdev_sum = skip_edev_max = skip_edev_sum = 0.0;
+
+  fft_batch = fft_nbatch = 1;
+
   // define acons coefficients for estimation of kspace errors
   // see JCP 109, pg 7698 for derivation of coefficients
   // higher order coefficients may be computed if needed
@@ -170,6 +197,43 @@ void PPPM::settings(int narg, char **arg)
                accuracy_relative, force->kspace_style);
 }
 
+/* ----------------------------------------------------------------------
+   pppm-specific kspace_modify options
+------------------------------------------------------------------------- */
+
+int PPPM::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0],"kernel") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify kernel",error);
+    if (strcmp(arg[1],"generic") == 0) kernel_flag = 0;
+    else if (strcmp(arg[1],"vector") == 0) kernel_flag = 1;
+    else error->all(FLERR,"Unknown kspace_modify kernel setting {}",arg[1]);
+    return 2;
+  } else if (strcmp(arg[0],"kernel/threads") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify kernel/threads",error);
+    kernel_threads = utils::logical(FLERR,arg[1],false,lmp);
+    return 2;
+  } else if (strcmp(arg[0],"skip") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify skip",error);
+    skip_every = utils::inumeric(FLERR,arg[1],false,lmp);
+    if (skip_every < 1) error->all(FLERR,"Illegal kspace_modify skip value {}",skip_every);
+    return 2;
+  } else if (strcmp(arg[0],"extrapolate") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify extrapolate",error);
+    skip_extrapolate = utils::logical(FLERR,arg[1],false,lmp);
+    return 2;
+  } else if (strcmp(arg[0],"fft/batch") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR,"kspace_modify fft/batch",error);
+    if (strcmp(arg[1],"auto") == 0) fft_batch = 0;
+    else {
+      fft_batch = utils::inumeric(FLERR,arg[1],false,lmp);
+      if (fft_batch < 1) error->all(FLERR,"Illegal kspace_modify fft/batch value {}",fft_batch);
+    }
+    return 2;
+  }
+  return 0;
+}
+
 /* ----------------------------------------------------------------------
    free all memory
 ------------------------------------------------------------------------- */
@@ -184,6 +248,11 @@ PPPM::~PPPM()
   if (group_allocate_flag) PPPM::deallocate_groups();
   memory->destroy(part2grid);
   memory->destroy(acons);
+  memory->destroy(cellperm);
+  memory->destroy(cellcount);
+  memory->sfree(density_thr);
+  memory->sfree(skip_field[0]);
+  memory->sfree(skip_field[1]);
 }
 
 /* ----------------------------------------------------------------------
@@ -208,6 +277,23 @@ void PPPM::init()
   if (domain->dimension == 2)
     error->all(FLERR,"Cannot use PPPM with 2d simulation");
 
+  // vector kernels replace PPPM::make_rho() and PPPM::fieldforce(),
+  // which derived styles may override
+
+  if (kernel_flag && (strcmp(force->kspace_style,"pppm") != 0))
+    error->all(FLERR,"Kspace_modify kernel vector is not supported by kspace style {}",
+               force->kspace_style);
+
+  // field reuse bypasses PPPM::compute() of derived styles
+
+  if ((skip_every > 1) && (strcmp(force->kspace_style,"pppm") != 0))
+    error->all(FLERR,"Kspace_modify skip is not supported by kspace style {}",
+               force->kspace_style);
+
+  skip_nfull = skip_nreuse = 0;
+  skip_ncheck = 0;
+  skip_fdev_max = skip_fdev_sum = skip_edev_max = skip_edev_sum = 0.0;
+
   if (!atom->q_flag)
     error->all(FLERR,"Kspace style requires atom attribute q");
 
@@ -342,8 +428,11 @@ void PPPM::init()
 
   // allocate K-space dependent memory
   // don't invoke allocate peratom() or group(), will be allocated when needed
+  // choose # of FFT batches once the FFTs exist
 
+  fft_nbatch = (fft_batch > 0) ? fft_batch : 1;
   allocate();
+  if (fft_batch == 0) tune_fft_batch();
 
   // pre-compute Green's function denomiator expansion
   // pre-compute 1d charge distribution coefficients
@@ -369,6 +458,8 @@ void PPPM::init()
     mesg += "  using " LMP_FFT_PREC " precision " LMP_FFT_LIB "\n";
     mesg += fmt::format("  3d grid and FFT values/proc = {} {}\n",
                        ngrid_max,nfft_both_max);
+    if (fft_batch != 1)
+      mesg += fmt::format("  FFT remap batches = {}\n",fft1->get_nbatch());
     utils::logmesg(lmp,mesg);
   }
 }
@@ -379,6 +470,10 @@ void PPPM::init()
 
 void PPPM::setup()
 {
+  // a stored field is invalid for a new run or a changed box
+
+  skip_step[0] = skip_step[1] = -1;
+
   if (triclinic) {
     setup_triclinic();
     return;
@@ -634,6 +729,30 @@ void PPPM::compute(int eflag, int vflag)
     memory->create(part2grid,nmax,3,"pppm:part2grid");
   }
 
+  // with kspace_modify skip, reuse or extrapolate the field of previous
+  //   full evaluations during dynamics and only interpolate forces from it
+  // full evaluations always tally global energy and virial for later reuse
+
+  const int skipflag = (skip_every > 1) && (update->whichflag == 1);
+
+  if (skipflag) {
+    if (skip_reuse()) {
+      particle_map();
+      fieldforce();
+      if (slabflag == 1) slabcorr();
+      if (triclinic) domain->lamda2x(atom->nlocal);
+      return;
+    }
+    if (!eflag_global) {
+      eflag_global = 1;
+      energy = 0.0;
+    }
+    if (!vflag_global) {
+      vflag_global = 1;
+      for (i = 0; i < 6; i++) virial[i] = 0.0;
+    }
+  }
+
   // find grid points for all my particles
   // map my particle charge onto my local 3d density grid
 
@@ -707,6 +826,10 @@ void PPPM::compute(int eflag, int vflag)
     for (i = 0; i < 6; i++) virial[i] = 0.5*qscale*volume*virial_all[i];
   }
 
+  // store field, energy, and virial for reuse on following steps
+
+  if (skipflag) skip_store();
+
   // per-atom energy/virial
   // energy includes self-energy correction
   // ntotal accounts for TIP4P tallying eatom/vatom for ghost atoms
@@ -839,26 +962,69 @@ void PPPM::allocate()
                           "pppm:drho_coeff");
 
   // create 2 FFTs and a Remap
-  // 1st FFT keeps data in FFT decomposition
-  // 2nd FFT returns data in 3d brick decomposition
   // remap takes data from 3d brick to FFT decomposition
 
+  create_fft(fft_nbatch);
+
+  remap = new Remap(lmp,world,
+                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
+                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                    1,0,0,FFT_PRECISION,collective_flag);
+}
+
+/* ----------------------------------------------------------------------
+   create 2 FFTs with nbatch pipelined batches, replacing existing ones
+   1st FFT keeps data in FFT decomposition
+   2nd FFT returns data in 3d brick decomposition
+------------------------------------------------------------------------- */
+
+void PPPM::create_fft(int nbatch)
+{
   int tmp;
 
+  delete fft1;
+  delete fft2;
+
   fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,nbatch);
 
   fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,nbatch);
+}
 
-  remap = new Remap(lmp,world,
-                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                    1,0,0,FFT_PRECISION,collective_flag);
+/* ----------------------------------------------------------------------
+   time the 3d FFTs of a timestep for 1,2,4,... batches and keep the fastest
+   stop once the remaps cannot be split into more batches
+------------------------------------------------------------------------- */
+
+void PPPM::tune_fft_batch()
+{
+  if (comm->nprocs == 1) return;
+
+  double time,time_all;
+  double time_best = 0.0;
+  int nbest = 1;
+
+  for (int nbatch = 1; nbatch <= MAXFFTBATCH; nbatch *= 2) {
+    create_fft(nbatch);
+    if (fft1->get_nbatch() < nbatch) break;
+
+    timing_3d(1,time);
+    timing_3d(NFFTTUNE,time);
+    MPI_Allreduce(&time,&time_all,1,MPI_DOUBLE,MPI_MAX,world);
+
+    if ((nbatch == 1) || (time_all < time_best)) {
+      time_best = time_all;
+      nbest = nbatch;
+    }
+  }
+
+  fft_nbatch = nbest;
+  create_fft(fft_nbatch);
 }
 
 /* ----------------------------------------------------------------------
@@ -913,6 +1079,8 @@ void PPPM::deallocate()
   delete fft1;
   delete fft2;
   delete remap;
+  fft1 = fft2 = nullptr;
+  remap = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -1837,6 +2005,8 @@ void PPPM::particle_map()
   }
 
   if (flag) error->one(FLERR,"Out of range atoms - cannot compute PPPM");
+
+  if (kernel_flag) sort_by_cell();
 }
 
 /* ----------------------------------------------------------------------
@@ -1848,6 +2018,17 @@ void PPPM::particle_map()
 
 void PPPM::make_rho()
 {
+  if (kernel_flag) {
+    switch (order) {
+    case 2: make_rho_vector<2>(); return;
+    case 3: make_rho_vector<3>(); return;
+    case 4: make_rho_vector<4>(); return;
+    case 5: make_rho_vector<5>(); return;
+    case 6: make_rho_vector<6>(); return;
+    case 7: make_rho_vector<7>(); return;
+    }
+  }
+
   int l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
 
@@ -2340,6 +2521,29 @@ void PPPM::poisson_peratom()
 
 void PPPM::fieldforce()
 {
+  if (kernel_flag && (order >= 2) && (order <= MAXORDER)) {
+    if (differentiation_flag == 1) {
+      switch (order) {
+      case 2: fieldforce_ad_vector<2>(); break;
+      case 3: fieldforce_ad_vector<3>(); break;
+      case 4: fieldforce_ad_vector<4>(); break;
+      case 5: fieldforce_ad_vector<5>(); break;
+      case 6: fieldforce_ad_vector<6>(); break;
+      case 7: fieldforce_ad_vector<7>(); break;
+      }
+    } else {
+      switch (order) {
+      case 2: fieldforce_ik_vector<2>(); break;
+      case 3: fieldforce_ik_vector<3>(); break;
+      case 4: fieldforce_ik_vector<4>(); break;
+      case 5: fieldforce_ik_vector<5>(); break;
+      case 6: fieldforce_ik_vector<6>(); break;
+      case 7: fieldforce_ik_vector<7>(); break;
+      }
+    }
+    return;
+  }
+
   if (differentiation_flag == 1) fieldforce_ad();
   else fieldforce_ik();
 }
@@ -2489,6 +2693,300 @@ void PPPM::fieldforce_ad()
   }
 }
 
+/* ----------------------------------------------------------------------
+   sort my particles by the (y,z) grid pencil of their stencil origin,
+   so that the vector kernels visit the grid with little scatter
+------------------------------------------------------------------------- */
+
+void PPPM::sort_by_cell()
+{
+  const int nlocal = atom->nlocal;
+  const int nyout = nyhi_out - nylo_out + 1;
+  const int ncell = (nzhi_out - nzlo_out + 1) * nyout;
+
+  if (nlocal > ncellperm) {
+    memory->destroy(cellperm);
+    ncellperm = atom->nmax;
+    memory->create(cellperm,ncellperm,"pppm:cellperm");
+  }
+  if (ncell + 1 > ncellcount) {
+    memory->destroy(cellcount);
+    ncellcount = ncell + 1;
+    memory->create(cellcount,ncellcount,"pppm:cellcount");
+  }
+
+  // counting sort, stable within each pencil
+
+  memset(cellcount,0,(ncell+1)*sizeof(int));
+  for (int i = 0; i < nlocal; i++) {
+    const int icell = (part2grid[i][2]-nzlo_out)*nyout + part2grid[i][1]-nylo_out;
+    cellcount[icell+1]++;
+  }
+  for (int icell = 0; icell < ncell; icell++) cellcount[icell+1] += cellcount[icell];
+  for (int i = 0; i < nlocal; i++) {
+    const int icell = (part2grid[i][2]-nzlo_out)*nyout + part2grid[i][1]-nylo_out;
+    cellperm[cellcount[icell]++] = i;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   # of threads used by the vector kernels
+------------------------------------------------------------------------- */
+
+int PPPM::kernel_nthreads() const
+{
+#if defined(_OPENMP)
+  if (kernel_threads) return comm->nthreads;
+#endif
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   charge assignment weights for a stencil of fixed size ORDER
+   coeff holds NCOEFF polynomial coefficients per stencil point
+------------------------------------------------------------------------- */
+
+template <int ORDER, int NCOEFF>
+static inline void stencil_weights(const FFT_SCALAR d, const FFT_SCALAR (*coeff)[ORDER],
+                                   FFT_SCALAR *w)
+{
+  for (int k = 0; k < ORDER; k++) w[k] = ZEROF;
+  for (int l = NCOEFF-1; l >= 0; l--)
+    for (int k = 0; k < ORDER; k++) w[k] = coeff[l][k] + w[k]*d;
+}
+
+/* ----------------------------------------------------------------------
+   make_rho() with compile-time stencil size, looping over particles
+   sorted by grid pencil. with kernel/threads each thread accumulates
+   a contiguous range of sorted particles into a private density brick,
+   which are summed afterwards, so no atomic updates are needed
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPM::make_rho_vector()
+{
+  const int nthreads = kernel_nthreads();
+  if ((nthreads > 1) && ((bigint) (nthreads-1)*ngrid > ndensity_thr)) {
+    memory->sfree(density_thr);
+    ndensity_thr = (bigint) (nthreads-1)*ngrid;
+    density_thr = (FFT_SCALAR *)
+      memory->smalloc(ndensity_thr*sizeof(FFT_SCALAR),"pppm:density_thr");
+  }
+
+  FFT_SCALAR coeff[ORDER][ORDER];
+  for (int l = 0; l < ORDER; l++)
+    for (int k = 0; k < ORDER; k++) coeff[l][k] = rho_coeff[l][k+nlower];
+
+  const double *const q = atom->q;
+  const double *const *const x = atom->x;
+  const int nlocal = atom->nlocal;
+  const int nxout = nxhi_out - nxlo_out + 1;
+  const int nxyout = nxout * (nyhi_out - nylo_out + 1);
+  FFT_SCALAR *const density0 = &density_brick[nzlo_out][nylo_out][nxlo_out];
+
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+#endif
+  {
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+#else
+    const int tid = 0;
+#endif
+    FFT_SCALAR *const density = tid ? density_thr + (bigint) (tid-1)*ngrid : density0;
+    memset(density,0,ngrid*sizeof(FFT_SCALAR));
+
+    const int ifrom = (bigint) nlocal*tid / nthreads;
+    const int ito = (bigint) nlocal*(tid+1) / nthreads;
+    FFT_SCALAR wx[ORDER], wy[ORDER], wz[ORDER];
+
+    for (int ii = ifrom; ii < ito; ii++) {
+      const int i = cellperm[ii];
+      const int nx = part2grid[i][0];
+      const int ny = part2grid[i][1];
+      const int nz = part2grid[i][2];
+      stencil_weights<ORDER,ORDER>(nx+shiftone - (x[i][0]-boxlo[0])*delxinv,coeff,wx);
+      stencil_weights<ORDER,ORDER>(ny+shiftone - (x[i][1]-boxlo[1])*delyinv,coeff,wy);
+      stencil_weights<ORDER,ORDER>(nz+shiftone - (x[i][2]-boxlo[2])*delzinv,coeff,wz);
+
+      const FFT_SCALAR z0 = delvolinv * q[i];
+      FFT_SCALAR *const origin = density + (nz+nlower-nzlo_out)*nxyout +
+        (ny+nlower-nylo_out)*nxout + nx+nlower-nxlo_out;
+      for (int n = 0; n < ORDER; n++) {
+        const FFT_SCALAR y0 = z0*wz[n];
+        for (int m = 0; m < ORDER; m++) {
+          const FFT_SCALAR x0 = y0*wy[m];
+          FFT_SCALAR *_noalias row = origin + n*nxyout + m*nxout;
+          for (int l = 0; l < ORDER; l++) row[l] += x0*wx[l];
+        }
+      }
+    }
+
+    // sum private density bricks into density_brick
+
+    if (nthreads > 1) {
+#if defined(_OPENMP)
+#pragma omp barrier
+#pragma omp for schedule(static)
+#endif
+      for (int j = 0; j < ngrid; j++) {
+        FFT_SCALAR sum = density0[j];
+        for (int t = 1; t < nthreads; t++) sum += density_thr[(bigint) (t-1)*ngrid + j];
+        density0[j] = sum;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   fieldforce_ik() with compile-time stencil size
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPM::fieldforce_ik_vector()
+{
+  FFT_SCALAR coeff[ORDER][ORDER];
+  for (int l = 0; l < ORDER; l++)
+    for (int k = 0; k < ORDER; k++) coeff[l][k] = rho_coeff[l][k+nlower];
+
+  const double *const q = atom->q;
+  const double *const *const x = atom->x;
+  double *const *const f = atom->f;
+  const int nlocal = atom->nlocal;
+  const int nthreads = kernel_nthreads();
+  const int nxout = nxhi_out - nxlo_out + 1;
+  const int nxyout = nxout * (nyhi_out - nylo_out + 1);
+  const FFT_SCALAR *const vdx0 = &vdx_brick[nzlo_out][nylo_out][nxlo_out];
+  const FFT_SCALAR *const vdy0 = &vdy_brick[nzlo_out][nylo_out][nxlo_out];
+  const FFT_SCALAR *const vdz0 = &vdz_brick[nzlo_out][nylo_out][nxlo_out];
+
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) schedule(static)
+#endif
+  for (int ii = 0; ii < nlocal; ii++) {
+    FFT_SCALAR wx[ORDER], wy[ORDER], wz[ORDER];
+    const int i = cellperm[ii];
+    const int nx = part2grid[i][0];
+    const int ny = part2grid[i][1];
+    const int nz = part2grid[i][2];
+    stencil_weights<ORDER,ORDER>(nx+shiftone - (x[i][0]-boxlo[0])*delxinv,coeff,wx);
+    stencil_weights<ORDER,ORDER>(ny+shiftone - (x[i][1]-boxlo[1])*delyinv,coeff,wy);
+    stencil_weights<ORDER,ORDER>(nz+shiftone - (x[i][2]-boxlo[2])*delzinv,coeff,wz);
+
+    const int origin = (nz+nlower-nzlo_out)*nxyout + (ny+nlower-nylo_out)*nxout +
+      nx+nlower-nxlo_out;
+    FFT_SCALAR ekx = ZEROF, eky = ZEROF, ekz = ZEROF;
+    for (int n = 0; n < ORDER; n++) {
+      const FFT_SCALAR z0 = wz[n];
+      for (int m = 0; m < ORDER; m++) {
+        const FFT_SCALAR y0 = z0*wy[m];
+        const int row = origin + n*nxyout + m*nxout;
+        for (int l = 0; l < ORDER; l++) {
+          const FFT_SCALAR x0 = y0*wx[l];
+          ekx -= x0*vdx0[row+l];
+          eky -= x0*vdy0[row+l];
+          ekz -= x0*vdz0[row+l];
+        }
+      }
+    }
+
+    // convert E-field to force
+
+    const double qfactor = qqrd2e * scale * q[i];
+    f[i][0] += qfactor*ekx;
+    f[i][1] += qfactor*eky;
+    if (slabflag != 2) f[i][2] += qfactor*ekz;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   fieldforce_ad() with compile-time stencil size
+------------------------------------------------------------------------- */
+
+template <int ORDER>
+void PPPM::fieldforce_ad_vector()
+{
+  FFT_SCALAR coeff[ORDER][ORDER], dcoeff[ORDER][ORDER];
+  for (int l = 0; l < ORDER; l++) {
+    for (int k = 0; k < ORDER; k++) {
+      coeff[l][k] = rho_coeff[l][k+nlower];
+      dcoeff[l][k] = (l < ORDER-1) ? drho_coeff[l][k+nlower] : ZEROF;
+    }
+  }
+
+  const double *prd = domain->prd;
+  const double hx_inv = nx_pppm/prd[0];
+  const double hy_inv = ny_pppm/prd[1];
+  const double hz_inv = nz_pppm/prd[2];
+  const double qfactor = qqrd2e * scale;
+
+  const double *const q = atom->q;
+  const double *const *const x = atom->x;
+  double *const *const f = atom->f;
+  const int nlocal = atom->nlocal;
+  const int nthreads = kernel_nthreads();
+  const int nxout = nxhi_out - nxlo_out + 1;
+  const int nxyout = nxout * (nyhi_out - nylo_out + 1);
+  const FFT_SCALAR *const u0 = &u_brick[nzlo_out][nylo_out][nxlo_out];
+
+#if defined(_OPENMP)
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) schedule(static)
+#endif
+  for (int ii = 0; ii < nlocal; ii++) {
+    FFT_SCALAR wx[ORDER], wy[ORDER], wz[ORDER], dwx[ORDER], dwy[ORDER], dwz[ORDER];
+    const int i = cellperm[ii];
+    const int nx = part2grid[i][0];
+    const int ny = part2grid[i][1];
+    const int nz = part2grid[i][2];
+    const FFT_SCALAR dx = nx+shiftone - (x[i][0]-boxlo[0])*delxinv;
+    const FFT_SCALAR dy = ny+shiftone - (x[i][1]-boxlo[1])*delyinv;
+    const FFT_SCALAR dz = nz+shiftone - (x[i][2]-boxlo[2])*delzinv;
+    stencil_weights<ORDER,ORDER>(dx,coeff,wx);
+    stencil_weights<ORDER,ORDER>(dy,coeff,wy);
+    stencil_weights<ORDER,ORDER>(dz,coeff,wz);
+    stencil_weights<ORDER,ORDER-1>(dx,dcoeff,dwx);
+    stencil_weights<ORDER,ORDER-1>(dy,dcoeff,dwy);
+    stencil_weights<ORDER,ORDER-1>(dz,dcoeff,dwz);
+
+    const int origin = (nz+nlower-nzlo_out)*nxyout + (ny+nlower-nylo_out)*nxout +
+      nx+nlower-nxlo_out;
+    FFT_SCALAR ekx = ZEROF, eky = ZEROF, ekz = ZEROF;
+    for (int n = 0; n < ORDER; n++) {
+      for (int m = 0; m < ORDER; m++) {
+        const int row = origin + n*nxyout + m*nxout;
+        for (int l = 0; l < ORDER; l++) {
+          const FFT_SCALAR u = u0[row+l];
+          ekx += dwx[l]*wy[m]*wz[n]*u;
+          eky += wx[l]*dwy[m]*wz[n]*u;
+          ekz += wx[l]*wy[m]*dwz[n]*u;
+        }
+      }
+    }
+    ekx *= hx_inv;
+    eky *= hy_inv;
+    ekz *= hz_inv;
+
+    // convert E-field to force and subtract self forces
+
+    const double s1 = x[i][0]*hx_inv;
+    const double s2 = x[i][1]*hy_inv;
+    const double s3 = x[i][2]*hz_inv;
+    const double qi2 = 2.0*q[i]*q[i];
+
+    double sf = sf_coeff[0]*sin(2*MY_PI*s1);
+    sf += sf_coeff[1]*sin(4*MY_PI*s1);
+    f[i][0] += qfactor*(ekx*q[i] - sf*qi2);
+
+    sf = sf_coeff[2]*sin(2*MY_PI*s2);
+    sf += sf_coeff[3]*sin(4*MY_PI*s2);
+    f[i][1] += qfactor*(eky*q[i] - sf*qi2);
+
+    sf = sf_coeff[4]*sin(2*MY_PI*s3);
+    sf += sf_coeff[5]*sin(4*MY_PI*s3);
+    if (slabflag != 2) f[i][2] += qfactor*(ekz*q[i] - sf*qi2);
+  }
+}
+
 /* ----------------------------------------------------------------------
    interpolate from grid to get per-atom energy/virial
 ------------------------------------------------------------------------- */
@@ -2978,6 +3476,168 @@ int PPPM::timing_3d(int n, double &time3d)
   return 4;
 }
 
+/* ----------------------------------------------------------------------
+   # of field bricks used by fieldforce()
+   3 bricks of E-field components for ik, 1 brick of potential for ad
+------------------------------------------------------------------------- */
+
+int PPPM::skip_nbrick() const
+{
+  return (differentiation_flag == 1) ? 1 : 3;
+}
+
+/* ----------------------------------------------------------------------
+   first owned+ghost grid value of field brick M
+------------------------------------------------------------------------- */
+
+FFT_SCALAR *PPPM::skip_brick(int m)
+{
+  if (differentiation_flag == 1) return &u_brick[nzlo_out][nylo_out][nxlo_out];
+  if (m == 0) return &vdx_brick[nzlo_out][nylo_out][nxlo_out];
+  if (m == 1) return &vdy_brick[nzlo_out][nylo_out][nxlo_out];
+  return &vdz_brick[nzlo_out][nylo_out][nxlo_out];
+}
+
+/* ----------------------------------------------------------------------
+   factor for linear extrapolation of the stored field to timestep ntimestep
+   0.0 = reuse field of last full evaluation
+------------------------------------------------------------------------- */
+
+double PPPM::skip_factor(bigint ntimestep) const
+{
+  if (!skip_extrapolate || (skip_step[1] < 0) || (skip_step[0] <= skip_step[1])) return 0.0;
+  return (double) (ntimestep - skip_step[0]) / (double) (skip_step[0] - skip_step[1]);
+}
+
+/* ----------------------------------------------------------------------
+   fill field bricks, energy, and virial from previous full evaluations
+   return 0 if a full evaluation is required on this step
+------------------------------------------------------------------------- */
+
+int PPPM::skip_reuse()
+{
+  const bigint ntimestep = update->ntimestep;
+
+  // per-atom energy/virial are only available from full evaluations
+
+  if (evflag_atom || (skip_step[0] < 0)) return 0;
+  if ((ntimestep < skip_step[0]) || (ntimestep - skip_step[0] >= skip_every)) return 0;
+
+  const double a = skip_factor(ntimestep);
+
+  for (int m = 0; m < skip_nbrick(); m++) {
+    FFT_SCALAR *_noalias brick = skip_brick(m);
+    const FFT_SCALAR *_noalias f0 = skip_field[0] + (bigint) m*ngrid;
+    const FFT_SCALAR *_noalias f1 = skip_field[1] + (bigint) m*ngrid;
+    if (a == 0.0) memcpy(brick,f0,ngrid*sizeof(FFT_SCALAR));
+    else for (int i = 0; i < ngrid; i++) brick[i] = f0[i] + a*(f0[i]-f1[i]);
+  }
+
+  energy = skip_energy[0];
+  for (int i = 0; i < 6; i++) virial[i] = skip_virial[0][i];
+  if (a != 0.0) {
+    energy += a*(skip_energy[0]-skip_energy[1]);
+    for (int i = 0; i < 6; i++) virial[i] += a*(skip_virial[0][i]-skip_virial[1][i]);
+  }
+
+  skip_nreuse++;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   store field bricks, energy, and virial of a full evaluation
+   first compare them to what a reused step would have predicted
+------------------------------------------------------------------------- */
+
+void PPPM::skip_store()
+{
+  const bigint ntimestep = update->ntimestep;
+  const bigint nfield = (bigint) skip_nbrick()*ngrid;
+
+  if (nfield > nskip_field) {
+    memory->sfree(skip_field[0]);
+    memory->sfree(skip_field[1]);
+    nskip_field = nfield;
+    skip_field[0] = (FFT_SCALAR *) memory->smalloc(nfield*sizeof(FFT_SCALAR),"pppm:skip_field");
+    skip_field[1] = (FFT_SCALAR *) memory->smalloc(nfield*sizeof(FFT_SCALAR),"pppm:skip_field");
+    skip_step[0] = skip_step[1] = -1;
+  }
+
+  // deviation of the predicted field is accumulated over owned+ghost values
+  // relative to the field itself, the energy deviation is absolute
+
+  if ((skip_step[0] >= 0) && (ntimestep > skip_step[0])) {
+    const double a = skip_factor(ntimestep);
+    double dsq[2] = {0.0, 0.0};
+    double dsq_all[2];
+
+    for (int m = 0; m < skip_nbrick(); m++) {
+      const FFT_SCALAR *_noalias brick = skip_brick(m);
+      const FFT_SCALAR *_noalias f0 = skip_field[0] + (bigint) m*ngrid;
+      const FFT_SCALAR *_noalias f1 = skip_field[1] + (bigint) m*ngrid;
+      for (int i = 0; i < ngrid; i++) {
+        double predict = f0[i];
+        if (a != 0.0) predict += a*(f0[i]-f1[i]);
+        const double delta = brick[i] - predict;
+        dsq[0] += delta*delta;
+        dsq[1] += (double) brick[i]*brick[i];
+      }
+    }
+    MPI_Allreduce(dsq,dsq_all,2,MPI_DOUBLE,MPI_SUM,world);
+
+    double epredict = skip_energy[0];
+    if (a != 0.0) epredict += a*(skip_energy[0]-skip_energy[1]);
+    const double fdev = (dsq_all[1] > 0.0) ? sqrt(dsq_all[0]/dsq_all[1]) : 0.0;
+    const double edev = fabs(energy-epredict);
+
+    skip_ncheck++;
+    skip_fdev_sum += fdev;
+    skip_fdev_max = MAX(skip_fdev_max,fdev);
+    skip_edev_sum += edev;
+    skip_edev_max = MAX(skip_edev_max,edev);
+  }
+
+  // shift history unless this step replaces the last full evaluation
+
+  if (ntimestep != skip_step[0]) {
+    std::swap(skip_field[0],skip_field[1]);
+    skip_step[1] = skip_step[0];
+    skip_energy[1] = skip_energy[0];
+    for (int i = 0; i < 6; i++) skip_virial[1][i] = skip_virial[0][i];
+  }
+
+  for (int m = 0; m < skip_nbrick(); m++)
+    memcpy(skip_field[0] + (bigint) m*ngrid,skip_brick(m),ngrid*sizeof(FFT_SCALAR));
+  skip_step[0] = ntimestep;
+  skip_energy[0] = energy;
+  for (int i = 0; i < 6; i++) skip_virial[0][i] = virial[i];
+
+  skip_nfull++;
+}
+
+/* ----------------------------------------------------------------------
+   report statistics of field reuse at end of run
+------------------------------------------------------------------------- */
+
+void PPPM::finish()
+{
+  if ((skip_every <= 1) || (me != 0) || (skip_nfull == 0)) return;
+
+  std::string mesg = "\nPPPM field reuse stats:\n";
+  mesg += fmt::format("  Full, reused evaluations = {} {}\n",skip_nfull,skip_nreuse);
+  if (skip_ncheck) {
+    mesg += fmt::format("  Predicted field relative deviation (ave, max) = {:.8} {:.8}\n",
+                        skip_fdev_sum/skip_ncheck,skip_fdev_max);
+    mesg += fmt::format("  Predicted energy deviation (ave, max) = {:.8} {:.8}\n",
+                        skip_edev_sum/skip_ncheck,skip_edev_max);
+  }
+  utils::logmesg(lmp,mesg);
+
+  if (skip_ncheck && (skip_fdev_sum/skip_ncheck > SKIPWARN))
+    error->warning(FLERR,"Average relative deviation {:.8} of reused PPPM field is large, "
+                   "consider a smaller kspace_modify skip value",skip_fdev_sum/skip_ncheck);
+}
+
 /* ----------------------------------------------------------------------
    memory usage of local arrays
 ------------------------------------------------------------------------- */
@@ -3011,6 +3671,15 @@ double PPPM::memory_usage()
 
   bytes += (double)(ngc_buf1 + ngc_buf2) * npergrid * sizeof(FFT_SCALAR);
 
+  // vector kernels
+
+  bytes += (double)(ncellperm + ncellcount) * sizeof(int);
+  bytes += (double)ndensity_thr * sizeof(FFT_SCALAR);
+
+  // stored field for reuse
+
+  bytes += (double)2 * nskip_field * sizeof(FFT_SCALAR);
+
   return bytes;
 }
 
@@ -37,6 +37,7 @@ class PPPM : public KSpace {
   int timing_1d(int, double &) override;
   int timing_3d(int, double &) override;
   double memory_usage() override;
+  void finish() override;
 
   void compute_group_group(int, int, int) override;
 
@@ -94,6 +95,35 @@ class PPPM : public KSpace {
   int **part2grid;    // storage for particle -> grid mapping
   int nmax;
 
+  // order-specialized charge assignment and interpolation kernels
+
+  int kernel_flag;                  // 0 = generic, 1 = vector kernels
+  int kernel_threads;               // 1 = per-thread density subgrids
+  int *cellperm;                    // local particles sorted by grid pencil
+  int *cellcount;                   // # of particles per grid pencil
+  int ncellperm, ncellcount;        // allocated size of cellperm and cellcount
+  FFT_SCALAR *density_thr;          // private density bricks of extra threads
+  bigint ndensity_thr;              // allocated size of density_thr
+
+  // reuse of the grid field between full evaluations
+
+  int skip_every;                   // do a full evaluation every this many steps
+  int skip_extrapolate;             // 1 = extrapolate field from last two full steps
+  bigint skip_step[2];              // timesteps of last two full evaluations, -1 if none
+  FFT_SCALAR *skip_field[2];        // grid field of last two full evaluations
+  bigint nskip_field;               // allocated size of each skip_field
+  double skip_energy[2];            // energy of last two full evaluations
+  double skip_virial[2][6];         // virial of last two full evaluations
+  bigint skip_nfull, skip_nreuse;   // # of full and reused evaluations in run
+  int skip_ncheck;                  // # of full evaluations compared to prediction
+  double skip_fdev_max, skip_fdev_sum;    // relative RMS deviation of predicted field
+  double skip_edev_max, skip_edev_sum;    // deviation of predicted energy
+
+  // pipelining of 1d FFTs with the remaps between them
+
+  int fft_batch;                    // requested # of batches, 0 = auto-tune
+  int fft_nbatch;                   // # of batches the FFTs are created with
+
   double *boxlo;
   // TIP4P settings
   int typeH, typeO;    // atom types of TIP4P water H and O atoms
@@ -108,6 +138,8 @@ class PPPM : public KSpace {
   double final_accuracy();
 
   virtual void allocate();
+  void create_fft(int);
+  void tune_fft_batch();
   virtual void allocate_peratom();
   virtual void deallocate();
   virtual void deallocate_peratom();
@@ -120,6 +152,8 @@ class PPPM : public KSpace {
   virtual void compute_gf_ad();
   void compute_sf_precoeff();
 
+  int modify_param(int, char **) override;
+
   virtual void particle_map();
   virtual void make_rho();
   virtual void brick2fft();
@@ -140,6 +174,17 @@ class PPPM : public KSpace {
   void compute_rho_coeff();
   virtual void slabcorr();
 
+  void sort_by_cell();
+  int kernel_nthreads() const;
+  int skip_nbrick() const;
+  FFT_SCALAR *skip_brick(int);
+  double skip_factor(bigint) const;
+  int skip_reuse();
+  void skip_store();
+  template <int ORDER> void make_rho_vector();
+  template <int ORDER> void fieldforce_ik_vector();
+  template <int ORDER> void fieldforce_ad_vector();
+
   // grid communication
 
   void pack_forward_grid(int, void *, int, int *) override;
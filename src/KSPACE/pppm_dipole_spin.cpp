@@ -238,8 +238,11 @@ void PPPMDipoleSpin::init()
 
   // allocate K-space dependent memory
   // don't invoke allocate peratom(), will be allocated when needed
+  // choose # of FFT batches once the FFTs exist
 
+  fft_nbatch = (fft_batch > 0) ? fft_batch : 1;
   allocate();
+  if (fft_batch == 0) tune_fft_batch();
 
   // pre-compute Green's function denominator expansion
   // pre-compute 1d charge distribution coefficients
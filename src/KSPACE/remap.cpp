@@ -23,6 +23,17 @@
 #define MIN(A,B) ((A) < (B) ? (A) : (B))
 #define MAX(A,B) ((A) > (B) ? (A) : (B))
 
+static void remap_3d_pack_info(struct extent_3d *, struct extent_3d *, int, int *,
+                               struct pack_plan_3d *);
+static void remap_3d_unpack_info(struct extent_3d *, struct extent_3d *, int, int, int *,
+                                 struct pack_plan_3d *);
+static void remap_3d_slab(struct extent_3d *, int, int, struct extent_3d *);
+static struct remap_batch_3d *remap_3d_create_batch(struct remap_plan_3d *, MPI_Comm,
+                                                    struct extent_3d *, struct extent_3d *,
+                                                    struct extent_3d *, struct extent_3d *,
+                                                    int, int, int);
+static void remap_3d_destroy_batch(struct remap_batch_3d *);
+
 /* ----------------------------------------------------------------------
    Data layout for 3d remaps:
 
@@ -202,6 +213,146 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
   }
 }
 
+/* ----------------------------------------------------------------------
+   Start remap of one batch of a batched 3d remap
+
+   Arguments:
+   in           starting address of input data on this proc
+   buf          extra memory required for remap, same as for remap_3d()
+   plan         plan returned by previous call to remap_3d_create_plan
+   ibatch       index of batch, batches must be started in order
+
+   packs the input data of the batch and starts its non-blocking
+     communication, so that the input data of the following batches
+     can still be computed while the messages are in transit
+   input data of the batch must not change until remap_3d_batch_wait()
+   all batches must be started before calling remap_3d_batch_wait()
+------------------------------------------------------------------------- */
+
+void remap_3d_batch_start(FFT_SCALAR *in, FFT_SCALAR *buf,
+                          struct remap_plan_3d *plan, int ibatch)
+{
+  struct remap_batch_3d *batch = plan->batch;
+  FFT_SCALAR *scratch;
+  int m;
+
+  if (plan->memory == 0)
+    scratch = buf;
+  else
+    scratch = plan->scratch;
+
+  // use point-to-point communication
+  // post recvs of all batches with the first batch
+  // self data is packed directly into scratch space
+
+  if (!plan->usecollective) {
+    const int nrecv = batch->recv_first[batch->nbatch];
+
+    if (ibatch == 0) {
+      for (m = 0; m < nrecv; m++) {
+        if (batch->recv_proc[m] == batch->me)
+          batch->request[m] = MPI_REQUEST_NULL;
+        else
+          MPI_Irecv(&scratch[batch->recv_bufloc[m]],batch->recv_size[m],
+                    MPI_FFT_SCALAR,batch->recv_proc[m],0,plan->comm,
+                    &batch->request[m]);
+      }
+    }
+
+    for (m = batch->send_first[ibatch]; m < batch->send_first[ibatch+1]; m++) {
+      if (batch->send_proc[m] == batch->me) {
+        plan->pack(&in[batch->send_offset[m]],
+                   &scratch[batch->recv_bufloc[batch->self_recv[ibatch]]],
+                   &batch->packplan[m]);
+        batch->request[nrecv+m] = MPI_REQUEST_NULL;
+      } else {
+        plan->pack(&in[batch->send_offset[m]],&batch->sendbuf[batch->send_bufloc[m]],
+                   &batch->packplan[m]);
+        MPI_Isend(&batch->sendbuf[batch->send_bufloc[m]],batch->send_size[m],
+                  MPI_FFT_SCALAR,batch->send_proc[m],0,plan->comm,
+                  &batch->request[nrecv+m]);
+      }
+    }
+
+  // use one non-blocking All2Allv collective per batch
+
+  } else {
+    if (plan->commringlen > 0) {
+      const int offset = ibatch*plan->commringlen;
+
+      for (m = batch->send_first[ibatch]; m < batch->send_first[ibatch+1]; m++)
+        plan->pack(&in[batch->send_offset[m]],&batch->sendbuf[batch->send_bufloc[m]],
+                   &batch->packplan[m]);
+
+      MPI_Ialltoallv(batch->sendbuf,&batch->sendcnts[offset],&batch->sdispls[offset],
+                     MPI_FFT_SCALAR,scratch,&batch->recvcnts[offset],
+                     &batch->rdispls[offset],MPI_FFT_SCALAR,plan->comm,
+                     &batch->request[ibatch]);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Complete all batches of a batched 3d remap
+
+   Arguments:
+   out          starting address of where output data for this proc
+                  will be placed (can be same as in)
+   buf          extra memory required for remap, same as for remap_3d()
+   plan         plan returned by previous call to remap_3d_create_plan
+
+   unpacks messages in the order in which they arrive
+------------------------------------------------------------------------- */
+
+void remap_3d_batch_wait(FFT_SCALAR *out, FFT_SCALAR *buf, struct remap_plan_3d *plan)
+{
+  struct remap_batch_3d *batch = plan->batch;
+  FFT_SCALAR *scratch;
+  int i,m,ibatch;
+
+  if (plan->memory == 0)
+    scratch = buf;
+  else
+    scratch = plan->scratch;
+
+  // use point-to-point communication
+  // unpack self data first, then other messages as they arrive
+
+  if (!plan->usecollective) {
+    const int nrecv = batch->recv_first[batch->nbatch];
+    const int nsend = batch->send_first[batch->nbatch];
+    int nother = nrecv;
+
+    for (ibatch = 0; ibatch < batch->nbatch; ibatch++) {
+      m = batch->self_recv[ibatch];
+      if (m < 0) continue;
+      plan->unpack(&scratch[batch->recv_bufloc[m]],&out[batch->recv_offset[m]],
+                   &batch->unpackplan[m]);
+      nother--;
+    }
+
+    for (i = 0; i < nother; i++) {
+      MPI_Waitany(nrecv,batch->request,&m,MPI_STATUS_IGNORE);
+      plan->unpack(&scratch[batch->recv_bufloc[m]],&out[batch->recv_offset[m]],
+                   &batch->unpackplan[m]);
+    }
+
+    MPI_Waitall(nsend,&batch->request[nrecv],MPI_STATUS_IGNORE);
+
+  // unpack all messages of a batch when its collective has completed
+
+  } else {
+    if (plan->commringlen > 0) {
+      for (i = 0; i < batch->nbatch; i++) {
+        MPI_Waitany(batch->nbatch,batch->request,&ibatch,MPI_STATUS_IGNORE);
+        for (m = batch->recv_first[ibatch]; m < batch->recv_first[ibatch+1]; m++)
+          plan->unpack(&scratch[batch->recv_bufloc[m]],&out[batch->recv_offset[m]],
+                       &batch->unpackplan[m]);
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    Create plan for performing a 3d remap
 
@@ -225,6 +376,10 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
                           1 = single precision (4 bytes per datum)
                           2 = double precision (8 bytes per datum)
    usecollective        whether to use collective MPI or point-to-point
+   nbatch               # of batches for remap_3d_batch_start(), 1 = no batches
+                          is reduced if not all procs own that many slow indices
+                          ignored if input and output slow index ranges of
+                            any pair of communicating procs differ
 ------------------------------------------------------------------------- */
 
 struct remap_plan_3d *remap_3d_create_plan(
@@ -233,7 +388,8 @@ struct remap_plan_3d *remap_3d_create_plan(
   int in_klo, int in_khi,
   int out_ilo, int out_ihi, int out_jlo, int out_jhi,
   int out_klo, int out_khi,
-  int nqty, int permute, int memory, int /*precision*/, int usecollective)
+  int nqty, int permute, int memory, int /*precision*/, int usecollective,
+  int nbatch)
 
 {
 
@@ -324,15 +480,8 @@ struct remap_plan_3d *remap_3d_create_plan(
     if (iproc == nprocs) iproc = 0;
     if (remap_3d_collide(&in,&outarray[iproc],&overlap)) {
       plan->send_proc[nsend] = iproc;
-      plan->send_offset[nsend] = nqty *
-        ((overlap.klo-in.klo)*in.jsize*in.isize +
-         ((overlap.jlo-in.jlo)*in.isize + overlap.ilo-in.ilo));
-      plan->packplan[nsend].nfast = nqty*overlap.isize;
-      plan->packplan[nsend].nmid = overlap.jsize;
-      plan->packplan[nsend].nslow = overlap.ksize;
-      plan->packplan[nsend].nstride_line = nqty*in.isize;
-      plan->packplan[nsend].nstride_plane = nqty*in.jsize*in.isize;
-      plan->packplan[nsend].nqty = nqty;
+      remap_3d_pack_info(&in,&overlap,nqty,&plan->send_offset[nsend],
+                         &plan->packplan[nsend]);
       plan->send_size[nsend] = nqty*overlap.isize*overlap.jsize*overlap.ksize;
       nsend++;
     }
@@ -410,41 +559,8 @@ struct remap_plan_3d *remap_3d_create_plan(
     if (remap_3d_collide(&out,&inarray[iproc],&overlap)) {
       plan->recv_proc[nrecv] = iproc;
       plan->recv_bufloc[nrecv] = ibuf;
-
-      if (permute == 0) {
-        plan->recv_offset[nrecv] = nqty *
-          ((overlap.klo-out.klo)*out.jsize*out.isize +
-           (overlap.jlo-out.jlo)*out.isize + (overlap.ilo-out.ilo));
-        plan->unpackplan[nrecv].nfast = nqty*overlap.isize;
-        plan->unpackplan[nrecv].nmid = overlap.jsize;
-        plan->unpackplan[nrecv].nslow = overlap.ksize;
-        plan->unpackplan[nrecv].nstride_line = nqty*out.isize;
-        plan->unpackplan[nrecv].nstride_plane = nqty*out.jsize*out.isize;
-        plan->unpackplan[nrecv].nqty = nqty;
-      }
-      else if (permute == 1) {
-        plan->recv_offset[nrecv] = nqty *
-          ((overlap.ilo-out.ilo)*out.ksize*out.jsize +
-           (overlap.klo-out.klo)*out.jsize + (overlap.jlo-out.jlo));
-        plan->unpackplan[nrecv].nfast = overlap.isize;
-        plan->unpackplan[nrecv].nmid = overlap.jsize;
-        plan->unpackplan[nrecv].nslow = overlap.ksize;
-        plan->unpackplan[nrecv].nstride_line = nqty*out.jsize;
-        plan->unpackplan[nrecv].nstride_plane = nqty*out.ksize*out.jsize;
-        plan->unpackplan[nrecv].nqty = nqty;
-      }
-      else {
-        plan->recv_offset[nrecv] = nqty *
-          ((overlap.jlo-out.jlo)*out.isize*out.ksize +
-           (overlap.ilo-out.ilo)*out.ksize + (overlap.klo-out.klo));
-        plan->unpackplan[nrecv].nfast = overlap.isize;
-        plan->unpackplan[nrecv].nmid = overlap.jsize;
-        plan->unpackplan[nrecv].nslow = overlap.ksize;
-        plan->unpackplan[nrecv].nstride_line = nqty*out.ksize;
-        plan->unpackplan[nrecv].nstride_plane = nqty*out.isize*out.ksize;
-        plan->unpackplan[nrecv].nqty = nqty;
-      }
-
+      remap_3d_unpack_info(&out,&overlap,nqty,permute,&plan->recv_offset[nrecv],
+                           &plan->unpackplan[nrecv]);
       plan->recv_size[nrecv] = nqty*overlap.isize*overlap.jsize*overlap.ksize;
       ibuf += plan->recv_size[nrecv];
       nrecv++;
@@ -569,6 +685,14 @@ struct remap_plan_3d *remap_3d_create_plan(
   if (nrecv == plan->nrecv) plan->self = 0;
   else plan->self = 1;
 
+  // optionally split remap into batches along the slow index
+  // not useful without communication to other procs
+
+  plan->batch = nullptr;
+  if (nbatch > 1 && nprocs > 1)
+    plan->batch = remap_3d_create_batch(plan,comm,&in,&out,inarray,outarray,
+                                        nqty,permute,nbatch);
+
   // free locally malloced space
 
   free(inarray);
@@ -635,6 +759,8 @@ struct remap_plan_3d *remap_3d_create_plan(
 
 void remap_3d_destroy_plan(struct remap_plan_3d *plan)
 {
+  if (plan->batch) remap_3d_destroy_batch(plan->batch);
+
   // free MPI communicator
 
   if (!(plan->usecollective) || (plan->commringlen != 0))
@@ -698,3 +824,277 @@ int remap_3d_collide(struct extent_3d *block1, struct extent_3d *block2,
 
   return 1;
 }
+
+/* ----------------------------------------------------------------------
+   extraction loc and pack plan for overlap section of input block
+------------------------------------------------------------------------- */
+
+static void remap_3d_pack_info(struct extent_3d *in, struct extent_3d *overlap,
+                               int nqty, int *offset, struct pack_plan_3d *packplan)
+{
+  *offset = nqty *
+    ((overlap->klo-in->klo)*in->jsize*in->isize +
+     ((overlap->jlo-in->jlo)*in->isize + overlap->ilo-in->ilo));
+  packplan->nfast = nqty*overlap->isize;
+  packplan->nmid = overlap->jsize;
+  packplan->nslow = overlap->ksize;
+  packplan->nstride_line = nqty*in->isize;
+  packplan->nstride_plane = nqty*in->jsize*in->isize;
+  packplan->nqty = nqty;
+}
+
+/* ----------------------------------------------------------------------
+   insertion loc and unpack plan for overlap section of output block
+------------------------------------------------------------------------- */
+
+static void remap_3d_unpack_info(struct extent_3d *out, struct extent_3d *overlap,
+                                 int nqty, int permute, int *offset,
+                                 struct pack_plan_3d *unpackplan)
+{
+  if (permute == 0) {
+    *offset = nqty *
+      ((overlap->klo-out->klo)*out->jsize*out->isize +
+       (overlap->jlo-out->jlo)*out->isize + (overlap->ilo-out->ilo));
+    unpackplan->nfast = nqty*overlap->isize;
+    unpackplan->nmid = overlap->jsize;
+    unpackplan->nslow = overlap->ksize;
+    unpackplan->nstride_line = nqty*out->isize;
+    unpackplan->nstride_plane = nqty*out->jsize*out->isize;
+    unpackplan->nqty = nqty;
+  }
+  else if (permute == 1) {
+    *offset = nqty *
+      ((overlap->ilo-out->ilo)*out->ksize*out->jsize +
+       (overlap->klo-out->klo)*out->jsize + (overlap->jlo-out->jlo));
+    unpackplan->nfast = overlap->isize;
+    unpackplan->nmid = overlap->jsize;
+    unpackplan->nslow = overlap->ksize;
+    unpackplan->nstride_line = nqty*out->jsize;
+    unpackplan->nstride_plane = nqty*out->ksize*out->jsize;
+    unpackplan->nqty = nqty;
+  }
+  else {
+    *offset = nqty *
+      ((overlap->jlo-out->jlo)*out->isize*out->ksize +
+       (overlap->ilo-out->ilo)*out->ksize + (overlap->klo-out->klo));
+    unpackplan->nfast = overlap->isize;
+    unpackplan->nmid = overlap->jsize;
+    unpackplan->nslow = overlap->ksize;
+    unpackplan->nstride_line = nqty*out->ksize;
+    unpackplan->nstride_plane = nqty*out->isize*out->ksize;
+    unpackplan->nqty = nqty;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   section of block with slow indices of batch ibatch out of nbatch
+------------------------------------------------------------------------- */
+
+static void remap_3d_slab(struct extent_3d *block, int ibatch, int nbatch,
+                          struct extent_3d *slab)
+{
+  *slab = *block;
+  slab->klo = block->klo + ibatch*block->ksize/nbatch;
+  slab->khi = block->klo + (ibatch+1)*block->ksize/nbatch - 1;
+  slab->ksize = slab->khi - slab->klo + 1;
+}
+
+/* ----------------------------------------------------------------------
+   split a remap plan into batches along the slow index
+   each proc splits the slow index range of its input and of its output
+     the same way, so both sides of each message must have the same range
+   return nullptr if remap cannot be split
+------------------------------------------------------------------------- */
+
+static struct remap_batch_3d *remap_3d_create_batch(
+  struct remap_plan_3d *plan, MPI_Comm comm,
+  struct extent_3d *in, struct extent_3d *out,
+  struct extent_3d *inarray, struct extent_3d *outarray,
+  int nqty, int permute, int nbatch)
+{
+  struct remap_batch_3d *batch;
+  struct extent_3d slab,overlap;
+  int i,m,ibatch,iproc,me,nprocs,flag,flag_all,nmin;
+
+  MPI_Comm_rank(comm,&me);
+  MPI_Comm_size(comm,&nprocs);
+
+  // check that procs I send to have the same output range of slow indices
+  // limit # of batches to smallest range of slow indices of any proc
+
+  flag = 1;
+  for (iproc = 0; iproc < nprocs; iproc++)
+    if (remap_3d_collide(in,&outarray[iproc],&overlap) &&
+        (in->klo != outarray[iproc].klo || in->khi != outarray[iproc].khi))
+      flag = 0;
+  MPI_Allreduce(&flag,&flag_all,1,MPI_INT,MPI_MIN,comm);
+
+  nmin = nbatch;
+  if (in->isize > 0 && in->jsize > 0 && in->ksize > 0) nmin = MIN(nmin,in->ksize);
+  if (out->isize > 0 && out->jsize > 0 && out->ksize > 0) nmin = MIN(nmin,out->ksize);
+  MPI_Allreduce(&nmin,&nbatch,1,MPI_INT,MPI_MIN,comm);
+
+  if (flag_all == 0 || nbatch < 2) return nullptr;
+
+  batch = (struct remap_batch_3d *) calloc(1,sizeof(struct remap_batch_3d));
+  if (batch == nullptr) return nullptr;
+  batch->me = me;
+  batch->nbatch = nbatch;
+
+  batch->offset = (int *) malloc(nbatch*sizeof(int));
+  batch->size = (int *) malloc(nbatch*sizeof(int));
+  batch->send_first = (int *) malloc((nbatch+1)*sizeof(int));
+  batch->recv_first = (int *) malloc((nbatch+1)*sizeof(int));
+  batch->self_recv = (int *) malloc(nbatch*sizeof(int));
+
+  // input data of each batch is contiguous since slow index varies slowest
+
+  for (ibatch = 0; ibatch < nbatch; ibatch++) {
+    remap_3d_slab(in,ibatch,nbatch,&slab);
+    if (in->isize > 0 && in->jsize > 0 && slab.ksize > 0) {
+      batch->offset[ibatch] = nqty*(slab.klo-in->klo)*in->jsize*in->isize;
+      batch->size[ibatch] = nqty*slab.ksize*in->jsize*in->isize;
+    } else batch->offset[ibatch] = batch->size[ibatch] = 0;
+  }
+
+  // count send and recv collides of all batches, including self
+
+  int nsend = 0;
+  int nrecv = 0;
+  for (ibatch = 0; ibatch < nbatch; ibatch++) {
+    remap_3d_slab(in,ibatch,nbatch,&slab);
+    for (iproc = 0; iproc < nprocs; iproc++)
+      nsend += remap_3d_collide(&slab,&outarray[iproc],&overlap);
+    remap_3d_slab(out,ibatch,nbatch,&slab);
+    for (iproc = 0; iproc < nprocs; iproc++)
+      nrecv += remap_3d_collide(&slab,&inarray[iproc],&overlap);
+  }
+
+  batch->send_offset = (int *) malloc(MAX(nsend,1)*sizeof(int));
+  batch->send_size = (int *) malloc(MAX(nsend,1)*sizeof(int));
+  batch->send_proc = (int *) malloc(MAX(nsend,1)*sizeof(int));
+  batch->send_bufloc = (int *) malloc(MAX(nsend,1)*sizeof(int));
+  batch->packplan = (struct pack_plan_3d *)
+    malloc(MAX(nsend,1)*sizeof(struct pack_plan_3d));
+  batch->recv_offset = (int *) malloc(MAX(nrecv,1)*sizeof(int));
+  batch->recv_size = (int *) malloc(MAX(nrecv,1)*sizeof(int));
+  batch->recv_proc = (int *) malloc(MAX(nrecv,1)*sizeof(int));
+  batch->recv_bufloc = (int *) malloc(MAX(nrecv,1)*sizeof(int));
+  batch->unpackplan = (struct pack_plan_3d *)
+    malloc(MAX(nrecv,1)*sizeof(struct pack_plan_3d));
+
+  if (plan->usecollective)
+    batch->request = (MPI_Request *) malloc(nbatch*sizeof(MPI_Request));
+  else
+    batch->request = (MPI_Request *) malloc(MAX(nsend+nrecv,1)*sizeof(MPI_Request));
+
+  // store send and recv info of each batch in same proc order as full remap
+  // offsets and pack plans refer to the full input and output blocks
+
+  int sendloc = 0;
+  int recvloc = 0;
+  nsend = nrecv = 0;
+
+  for (ibatch = 0; ibatch < nbatch; ibatch++) {
+    batch->send_first[ibatch] = nsend;
+    remap_3d_slab(in,ibatch,nbatch,&slab);
+    iproc = me;
+    for (i = 0; i < nprocs; i++) {
+      iproc++;
+      if (iproc == nprocs) iproc = 0;
+      if (remap_3d_collide(&slab,&outarray[iproc],&overlap)) {
+        batch->send_proc[nsend] = iproc;
+        remap_3d_pack_info(in,&overlap,nqty,&batch->send_offset[nsend],
+                           &batch->packplan[nsend]);
+        batch->send_size[nsend] = nqty*overlap.isize*overlap.jsize*overlap.ksize;
+        batch->send_bufloc[nsend] = sendloc;
+        sendloc += batch->send_size[nsend];
+        nsend++;
+      }
+    }
+
+    batch->recv_first[ibatch] = nrecv;
+    batch->self_recv[ibatch] = -1;
+    remap_3d_slab(out,ibatch,nbatch,&slab);
+    iproc = me;
+    for (i = 0; i < nprocs; i++) {
+      iproc++;
+      if (iproc == nprocs) iproc = 0;
+      if (remap_3d_collide(&slab,&inarray[iproc],&overlap)) {
+        batch->recv_proc[nrecv] = iproc;
+        if (iproc == me) batch->self_recv[ibatch] = nrecv;
+        remap_3d_unpack_info(out,&overlap,nqty,permute,&batch->recv_offset[nrecv],
+                             &batch->unpackplan[nrecv]);
+        batch->recv_size[nrecv] = nqty*overlap.isize*overlap.jsize*overlap.ksize;
+        batch->recv_bufloc[nrecv] = recvloc;
+        recvloc += batch->recv_size[nrecv];
+        nrecv++;
+      }
+    }
+  }
+  batch->send_first[nbatch] = nsend;
+  batch->recv_first[nbatch] = nrecv;
+
+  // all packed messages are kept until the last batch has completed
+
+  batch->sendbuf = (FFT_SCALAR *) malloc(MAX(sendloc,1)*sizeof(FFT_SCALAR));
+
+  // counts and displacements of each batch for alltoallv on the comm ring
+  // comm ring is sorted, so rank in plan communicator is index in list
+
+  if (plan->usecollective && plan->commringlen > 0) {
+    const int n = nbatch*plan->commringlen;
+    batch->sendcnts = (int *) calloc(n,sizeof(int));
+    batch->sdispls = (int *) calloc(n,sizeof(int));
+    batch->recvcnts = (int *) calloc(n,sizeof(int));
+    batch->rdispls = (int *) calloc(n,sizeof(int));
+
+    for (ibatch = 0; ibatch < nbatch; ibatch++) {
+      const int offset = ibatch*plan->commringlen;
+      for (m = batch->send_first[ibatch]; m < batch->send_first[ibatch+1]; m++) {
+        for (i = 0; i < plan->commringlen; i++)
+          if (plan->commringlist[i] == batch->send_proc[m]) break;
+        batch->sendcnts[offset+i] = batch->send_size[m];
+        batch->sdispls[offset+i] = batch->send_bufloc[m];
+      }
+      for (m = batch->recv_first[ibatch]; m < batch->recv_first[ibatch+1]; m++) {
+        for (i = 0; i < plan->commringlen; i++)
+          if (plan->commringlist[i] == batch->recv_proc[m]) break;
+        batch->recvcnts[offset+i] = batch->recv_size[m];
+        batch->rdispls[offset+i] = batch->recv_bufloc[m];
+      }
+    }
+  }
+
+  return batch;
+}
+
+/* ----------------------------------------------------------------------
+   free all memory of a batched remap
+------------------------------------------------------------------------- */
+
+static void remap_3d_destroy_batch(struct remap_batch_3d *batch)
+{
+  free(batch->offset);
+  free(batch->size);
+  free(batch->send_first);
+  free(batch->send_offset);
+  free(batch->send_size);
+  free(batch->send_proc);
+  free(batch->send_bufloc);
+  free(batch->packplan);
+  free(batch->recv_first);
+  free(batch->recv_offset);
+  free(batch->recv_size);
+  free(batch->recv_proc);
+  free(batch->recv_bufloc);
+  free(batch->unpackplan);
+  free(batch->self_recv);
+  free(batch->sendbuf);
+  free(batch->request);
+  free(batch->sendcnts);
+  free(batch->sdispls);
+  free(batch->recvcnts);
+  free(batch->rdispls);
+  free(batch);
+}
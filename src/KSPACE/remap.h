@@ -15,6 +15,33 @@
 
 #include "lmpfftsettings.h"
 
+// details of a 3d remap split into batches along the slow index
+// messages of all batches are stored consecutively, batch by batch
+
+struct remap_batch_3d {
+  int me;                             // my rank in communicator of plan
+  int nbatch;                         // # of batches
+  int *offset;                        // first input datum of each batch
+  int *size;                          // # of input datums in each batch
+  int *send_first;                    // first send message of each batch and total
+  int *send_offset;                   // extraction loc for each send
+  int *send_size;                     // size of each send message
+  int *send_proc;                     // proc to send each message to
+  int *send_bufloc;                   // offset in sendbuf for each send
+  struct pack_plan_3d *packplan;      // pack plan for each send message
+  int *recv_first;                    // first recv message of each batch and total
+  int *recv_offset;                   // insertion loc for each recv
+  int *recv_size;                     // size of each recv message
+  int *recv_proc;                     // proc to recv each message from
+  int *recv_bufloc;                   // offset in scratch buf for each recv
+  struct pack_plan_3d *unpackplan;    // unpack plan for each recv message
+  int *self_recv;                     // recv message from myself in each batch or -1
+  FFT_SCALAR *sendbuf;                // packed send messages of all batches
+  MPI_Request *request;               // all recvs and sends, or one per batch for collectives
+  int *sendcnts, *sdispls;            // alltoallv send counts for each batch
+  int *recvcnts, *rdispls;            // alltoallv recv counts for each batch
+};
+
 // details of how to do a 3d remap
 
 struct remap_plan_3d {
@@ -42,6 +69,7 @@ struct remap_plan_3d {
   int usecollective;                  // use collective or point-to-point MPI
   int commringlen;                    // length of commringlist
   int *commringlist;                  // ranks on communication ring of this plan
+  struct remap_batch_3d *batch;       // batched non-blocking remap, nullptr if not used
 };
 
 // collision between 2 regions
@@ -55,7 +83,9 @@ struct extent_3d {
 // function prototypes
 
 void remap_3d(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *, struct remap_plan_3d *);
+void remap_3d_batch_start(FFT_SCALAR *, FFT_SCALAR *, struct remap_plan_3d *, int);
+void remap_3d_batch_wait(FFT_SCALAR *, FFT_SCALAR *, struct remap_plan_3d *);
 struct remap_plan_3d *remap_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int,
-                                           int, int, int, int, int, int, int, int);
+                                           int, int, int, int, int, int, int, int, int);
 void remap_3d_destroy_plan(struct remap_plan_3d *);
 int remap_3d_collide(struct extent_3d *, struct extent_3d *, struct extent_3d *);
@@ -63,6 +63,10 @@ PairAIREBO::PairAIREBO(LAMMPS *lmp)
   REBO_numneigh = nullptr;
   REBO_firstneigh = nullptr;
   ipage = nullptr;
+  REBO_firstbond = nullptr;
+  bpage = nullptr;
+  maxgcache = 0;
+  gcache = nullptr;
   pgsize = oneatom = 0;
 
   nC = nH = nullptr;
@@ -83,6 +87,9 @@ PairAIREBO::~PairAIREBO()
   memory->destroy(REBO_numneigh);
   memory->sfree(REBO_firstneigh);
   delete[] ipage;
+  memory->sfree(REBO_firstbond);
+  delete[] bpage;
+  memory->destroy(gcache);
   memory->destroy(nC);
   memory->destroy(nH);
   delete[] pvector;
@@ -246,13 +253,17 @@ void PairAIREBO::init_style()
 
   if (create) {
     delete[] ipage;
+    delete[] bpage;
     pgsize = neighbor->pgsize;
     oneatom = neighbor->oneatom;
 
     int nmypage= comm->nthreads;
     ipage = new MyPage<int>[nmypage];
-    for (int i = 0; i < nmypage; i++)
+    bpage = new MyPage<double>[nmypage];
+    for (int i = 0; i < nmypage; i++) {
       ipage[i].init(oneatom,pgsize,PGDELTA);
+      bpage[i].init(NREBOBOND*oneatom,NREBOBOND*pgsize,PGDELTA);
+    }
   }
 }
 
@@ -339,75 +350,150 @@ double PairAIREBO::init_one(int i, int j)
 
 void PairAIREBO::REBO_neigh()
 {
-  int i,j,ii,jj,n,allnum,jnum,itype,jtype;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq,dS;
-  int *ilist,*jlist,*numneigh,**firstneigh;
+  int i,ii,n,allnum,maxneigh;
+  int *ilist;
   int *neighptr;
-
-  double **x = atom->x;
-  int *type = atom->type;
+  double *bondptr;
 
   if (atom->nmax > maxlocal) {
     maxlocal = atom->nmax;
     memory->destroy(REBO_numneigh);
     memory->sfree(REBO_firstneigh);
+    memory->sfree(REBO_firstbond);
     memory->destroy(nC);
     memory->destroy(nH);
     memory->create(REBO_numneigh,maxlocal,"AIREBO:numneigh");
     REBO_firstneigh = (int **) memory->smalloc(maxlocal*sizeof(int *),
                                                "AIREBO:firstneigh");
+    REBO_firstbond = (double **) memory->smalloc(maxlocal*sizeof(double *),
+                                                 "AIREBO:firstbond");
     memory->create(nC,maxlocal,"AIREBO:nC");
     memory->create(nH,maxlocal,"AIREBO:nH");
   }
 
   allnum = list->inum + list->gnum;
   ilist = list->ilist;
-  numneigh = list->numneigh;
-  firstneigh = list->firstneigh;
 
   // store all REBO neighs of owned and ghost atoms
   // scan full neighbor list of I
 
   ipage->reset();
+  bpage->reset();
+  maxneigh = 0;
 
   for (ii = 0; ii < allnum; ii++) {
     i = ilist[ii];
 
-    n = 0;
     neighptr = ipage->vget();
-
-    xtmp = x[i][0];
-    ytmp = x[i][1];
-    ztmp = x[i][2];
-    itype = map[type[i]];
-    nC[i] = nH[i] = 0.0;
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
-
-    for (jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
-      j &= NEIGHMASK;
-      jtype = map[type[j]];
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
-
-      if (rsq < rcmaxsq[itype][jtype]) {
-        neighptr[n++] = j;
-        if (jtype == 0)
-          nC[i] += Sp(sqrt(rsq),rcmin[itype][jtype],rcmax[itype][jtype],dS);
-        else
-          nH[i] += Sp(sqrt(rsq),rcmin[itype][jtype],rcmax[itype][jtype],dS);
-      }
-    }
+    bondptr = bpage->vget();
+    n = REBO_neigh_bonds(i,neighptr,bondptr);
 
     REBO_firstneigh[i] = neighptr;
+    REBO_firstbond[i] = bondptr;
     REBO_numneigh[i] = n;
+    maxneigh = MAX(maxneigh,n);
     ipage->vgot(n);
-    if (ipage->status())
+    bpage->vgot(NREBOBOND*n);
+    if (ipage->status() || bpage->status())
       error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
   }
+
+  REBO_neigh_coord(0,allnum);
+  REBO_grow_gcache(maxneigh);
+}
+
+/* ----------------------------------------------------------------------
+   store REBO neighbors of atom I and their bond data, accumulate nC, nH
+   return # of REBO neighbors
+------------------------------------------------------------------------- */
+
+int PairAIREBO::REBO_neigh_bonds(int i, int *neighptr, double *bondptr)
+{
+  int j,jj,n,jnum,itype,jtype;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  int *jlist;
+  double *bond;
+
+  double **x = atom->x;
+  int *type = atom->type;
+
+  n = 0;
+  xtmp = x[i][0];
+  ytmp = x[i][1];
+  ztmp = x[i][2];
+  itype = map[type[i]];
+  nC[i] = nH[i] = 0.0;
+  jlist = list->firstneigh[i];
+  jnum = list->numneigh[i];
+
+  for (jj = 0; jj < jnum; jj++) {
+    j = jlist[jj];
+    j &= NEIGHMASK;
+    jtype = map[type[j]];
+    delx = xtmp - x[j][0];
+    dely = ytmp - x[j][1];
+    delz = ztmp - x[j][2];
+    rsq = delx*delx + dely*dely + delz*delz;
+
+    if (rsq < rcmaxsq[itype][jtype]) {
+      bond = &bondptr[NREBOBOND*n];
+      neighptr[n++] = j;
+      bond[0] = delx;
+      bond[1] = dely;
+      bond[2] = delz;
+      bond[3] = sqrt(rsq);
+      bond[4] = Sp(bond[3],rcmin[itype][jtype],rcmax[itype][jtype],bond[5]);
+      if (jtype == 0)
+        nC[i] += bond[4];
+      else
+        nH[i] += bond[4];
+    }
+  }
+
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   coordination of each REBO neighbor J without I for atoms in list range
+   requires nC and nH of all owned and ghost atoms to be complete
+------------------------------------------------------------------------- */
+
+void PairAIREBO::REBO_neigh_coord(int iifrom, int iito)
+{
+  int i,j,ii,jj,itype;
+  double Nji;
+  int *neighptr;
+  double *bond;
+
+  int *ilist = list->ilist;
+  int *type = atom->type;
+
+  for (ii = iifrom; ii < iito; ii++) {
+    i = ilist[ii];
+    itype = map[type[i]];
+    neighptr = REBO_firstneigh[i];
+
+    for (jj = 0; jj < REBO_numneigh[i]; jj++) {
+      j = neighptr[jj];
+      bond = REBO_bond(i,jj);
+      Nji = nC[j]-(bond[4]*kronecker(itype,0))+nH[j] -
+        (bond[4]*kronecker(itype,1));
+      bond[6] = Sp(Nji,Nmin,Nmax,bond[7]);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   per-thread storage for g spline values of the neighbors of one atom
+------------------------------------------------------------------------- */
+
+void PairAIREBO::REBO_grow_gcache(int maxneigh)
+{
+  if (maxneigh > maxgcache) {
+    maxgcache = maxneigh;
+    memory->destroy(gcache);
+    memory->create(gcache,comm->nthreads,3*maxgcache,"AIREBO:gcache");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -423,6 +509,7 @@ void PairAIREBO::FREBO(int eflag)
   double Qij,Aij,alphaij,VR,pre,dVRdi,VA,term,bij,dVAdi,dVA;
   double dwij,del[3];
   int *ilist,*REBO_neighs;
+  double *bond;
 
   evdwl = 0.0;
 
@@ -463,12 +550,14 @@ void PairAIREBO::FREBO(int eflag)
 
       jtype = map[type[j]];
 
-      delx = x[i][0] - x[j][0];
-      dely = x[i][1] - x[j][1];
-      delz = x[i][2] - x[j][2];
+      bond = REBO_bond(i,k);
+      delx = bond[0];
+      dely = bond[1];
+      delz = bond[2];
       rsq = delx*delx + dely*dely + delz*delz;
-      rij = sqrt(rsq);
-      wij = Sp(rij,rcmin[itype][jtype],rcmax[itype][jtype],dwij);
+      rij = bond[3];
+      wij = bond[4];
+      dwij = bond[5];
       if (wij <= TOL) continue;
 
       Qij = Q[itype][jtype];
@@ -528,6 +617,7 @@ void PairAIREBO::FLJ(int eflag)
   double delkm[3],rkm,deljm[3],rmj,wmj,r2inv,r6inv,scale,delscale[3];
   int *ilist,*jlist,*numneigh,**firstneigh;
   int *REBO_neighs_i,*REBO_neighs_k;
+  double *bik,*bkm;
   double delikS[3],deljkS[3],delkmS[3],deljmS[3],delimS[3];
   double rikS,rkjS,rkmS,rmjS,wikS,dwikS;
   double wkjS,dwkjS,wkmS,dwkmS,wmjS,dwmjS;
@@ -625,14 +715,12 @@ void PairAIREBO::FLJ(int eflag)
           if (k == j) continue;
           ktype = map[type[k]];
 
-          delik[0] = x[i][0] - x[k][0];
-          delik[1] = x[i][1] - x[k][1];
-          delik[2] = x[i][2] - x[k][2];
-          rsq = delik[0]*delik[0] + delik[1]*delik[1] + delik[2]*delik[2];
-          if (rsq < rcmaxsq[itype][ktype]) {
-            rik = sqrt(rsq);
-            wik = Sp(rik,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-          } else { dwik = wik = 0.0; rikS = rik = 1.0; }
+          bik = REBO_bond(i,kk);
+          rik = REBO_bond_del(bik,delik);
+
+          wik = bik[4];
+
+          dwik = bik[5];
 
           if (wik > best) {
             deljk[0] = x[j][0] - x[k][0];
@@ -675,14 +763,10 @@ void PairAIREBO::FLJ(int eflag)
               m = REBO_neighs_k[mm];
               if (m == i || m == j) continue;
               mtype = map[type[m]];
-              delkm[0] = x[k][0] - x[m][0];
-              delkm[1] = x[k][1] - x[m][1];
-              delkm[2] = x[k][2] - x[m][2];
-              rsq = delkm[0]*delkm[0] + delkm[1]*delkm[1] + delkm[2]*delkm[2];
-              if (rsq < rcmaxsq[ktype][mtype]) {
-                rkm = sqrt(rsq);
-                wkm = Sp(rkm,rcmin[ktype][mtype],rcmax[ktype][mtype],dwkm);
-              } else { dwkm = wkm = 0.0; rkmS = rkm = 1.0; }
+              bkm = REBO_bond(k,mm);
+              rkm = REBO_bond_del(bkm,delkm);
+              wkm = bkm[4];
+              dwkm = bkm[5];
 
               if (wik*wkm > best) {
                 deljm[0] = x[j][0] - x[m][0];
@@ -905,6 +989,7 @@ void PairAIREBO::TORSION(int eflag)
   double fi[3],fj[3],fk[3],fl[3];
   int itype,jtype,ktype,ltype,kk,ll,jj;
   int *ilist,*REBO_neighs_i,*REBO_neighs_j;
+  double *b21,*b34;
 
   double **x = atom->x;
   double **f = atom->f;
@@ -956,11 +1041,8 @@ void PairAIREBO::TORSION(int eflag)
         k = REBO_neighs_i[kk];
         ktype = map[type[k]];
         if (k == j) continue;
-        del21[0] = x[i][0]-x[k][0];
-        del21[1] = x[i][1]-x[k][1];
-        del21[2] = x[i][2]-x[k][2];
-        rsq = del21[0]*del21[0] + del21[1]*del21[1] + del21[2]*del21[2];
-        r21 = sqrt(rsq);
+        b21 = REBO_bond(i,kk);
+        r21 = REBO_bond_del(b21,del21);
         cos321 = - ((del21[0]*del32[0]) + (del21[1]*del32[1]) +
                     (del21[2]*del32[2])) / (r21*r32);
         cos321 = MIN(cos321,1.0);
@@ -974,7 +1056,8 @@ void PairAIREBO::TORSION(int eflag)
         rjk2 = deljk[0]*deljk[0] + deljk[1]*deljk[1] + deljk[2]*deljk[2];
         rjk=sqrt(rjk2);
         rik2 = r21*r21;
-        w21 = Sp(r21,rcmin[itype][ktype],rcmax[itype][ktype],dw21);
+        w21 = b21[4];
+        dw21 = b21[5];
 
         rij = r32;
         rik = r21;
@@ -989,18 +1072,16 @@ void PairAIREBO::TORSION(int eflag)
           l = REBO_neighs_j[ll];
           ltype = map[type[l]];
           if (l == i || l == k) continue;
-          del34[0] = x[j][0]-x[l][0];
-          del34[1] = x[j][1]-x[l][1];
-          del34[2] = x[j][2]-x[l][2];
-          rsq = del34[0]*del34[0] + del34[1]*del34[1] + del34[2]*del34[2];
-          r34 = sqrt(rsq);
+          b34 = REBO_bond(j,ll);
+          r34 = REBO_bond_del(b34,del34);
           cos234 = (del32[0]*del34[0] + del32[1]*del34[1] +
                     del32[2]*del34[2]) / (r32*r34);
           cos234 = MIN(cos234,1.0);
           cos234 = MAX(cos234,-1.0);
           sin234 = sqrt(1.0 - cos234*cos234);
           if (sin234 < TOL) continue;
-          w34 = Sp(r34,rcmin[jtype][ltype],rcmax[jtype][ltype],dw34);
+          w34 = b34[4];
+          dw34 = b34[5];
           delil[0] = del23[0] + del34[0];
           delil[1] = del23[1] + del34[1];
           delil[2] = del23[2] + del34[2];
@@ -1244,12 +1325,13 @@ void PairAIREBO::TORSION(int eflag)
 double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double VA, double **f)
 {
   int atomi,atomj,k,n,l,atomk,atoml,atomn,atom1,atom2,atom3,atom4;
-  int itype,jtype,ktype,ltype,ntype;
+  int itype,jtype,ktype,ltype;
   double rik[3],rjl[3],rkn[3],rji[3],rki[3],rlj[3],rknmag,dNki,dwjl,bij;
   double NijC,NijH,NjiC,NjiH,wik,dwik,dwkn,wjl;
   double rikmag,rjlmag,cosjik,cosijl,g,tmp2,tmp3;
-  double Etmp,pij,tmp,wij,dwij,NconjtmpI,NconjtmpJ,Nki,Nlj,dS;
+  double Etmp,pij,tmp,wij,dwij,NconjtmpI,NconjtmpJ;
   double lamdajik,lamdaijl,dgdc,dgdN,pji,Nijconj,piRC;
+  double explamda;
   double dcosjikdri[3],dcosijldri[3],dcosjikdrk[3];
   double dN2[2],dN3[3];
   double dcosjikdrj[3],dcosijldrj[3],dcosijldrl[3];
@@ -1270,12 +1352,14 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
   double dcut321,PijS,PjiS;
   double rij2,tspjik,dtsjik,tspijl,dtsijl,costmp;
   int *REBO_neighs,*REBO_neighs_i,*REBO_neighs_j,*REBO_neighs_k,*REBO_neighs_l;
+  double *bik,*bjl,*bkn,*bln;
 
   double **x = atom->x;
   int *type = atom->type;
 
   atomi = i;
   atomj = j;
+  double *gbuf = gcache[0];
   itype = map[type[i]];
   jtype = map[type[j]];
   wij = Sp(rijmag,rcmin[itype][jtype],rcmax[itype][jtype],dwij);
@@ -1298,15 +1382,11 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
     atomk = REBO_neighs[k];
     if (atomk != atomj) {
       ktype = map[type[atomk]];
-      rik[0] = x[atomi][0]-x[atomk][0];
-      rik[1] = x[atomi][1]-x[atomk][1];
-      rik[2] = x[atomi][2]-x[atomk][2];
-      rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
+      bik = REBO_bond(i,k);
+      rikmag = REBO_bond_del(bik,rik);
       lamdajik = 4.0*kronecker(itype,1) *
         ((rho[ktype][1]-rikmag)-(rho[jtype][1]-rijmag));
-      wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dS);
-      Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-        (wik*kronecker(itype,1));
+      wik = bik[4];
       cosjik = ((rij[0]*rik[0])+(rij[1]*rik[1])+(rij[2]*rik[2])) /
         (rijmag*rikmag);
       cosjik = MIN(cosjik,1.0);
@@ -1315,9 +1395,11 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
       // evaluate splines g and derivatives dg
 
       g = gSpline(cosjik,(NijC+NijH),itype,&dgdc,&dgdN);
-      Etmp = Etmp+(wik*g*exp(lamdajik));
-      tmp3 = tmp3+(wik*dgdN*exp(lamdajik));
-      NconjtmpI = NconjtmpI+(kronecker(ktype,0)*wik*Sp(Nki,Nmin,Nmax,dS));
+      explamda = exp(lamdajik);
+      gcache_put(gbuf,k,g,dgdc,explamda);
+      Etmp = Etmp+(wik*g*explamda);
+      tmp3 = tmp3+(wik*dgdN*explamda);
+      NconjtmpI = NconjtmpI+(kronecker(ktype,0)*wik*bik[6]);
     }
   }
 
@@ -1335,13 +1417,10 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
     atomk = REBO_neighs[k];
     if (atomk != atomj) {
       ktype = map[type[atomk]];
-      rik[0] = x[atomi][0]-x[atomk][0];
-      rik[1] = x[atomi][1]-x[atomk][1];
-      rik[2] = x[atomi][2]-x[atomk][2];
-      rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-      lamdajik = 4.0*kronecker(itype,1) *
-        ((rho[ktype][1]-rikmag)-(rho[jtype][1]-rijmag));
-      wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
+      bik = REBO_bond(i,k);
+      rikmag = REBO_bond_del(bik,rik);
+      wik = bik[4];
+      dwik = bik[5];
       cosjik = (rij[0]*rik[0] + rij[1]*rik[1] + rij[2]*rik[2]) /
         (rijmag*rikmag);
       cosjik = MIN(cosjik,1.0);
@@ -1366,8 +1445,8 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
       dcosjikdrj[2] = (-rik[2]/(rijmag*rikmag)) +
         (cosjik*(rij[2]/(rijmag*rijmag)));
 
-      g = gSpline(cosjik,(NijC+NijH),itype,&dgdc,&dgdN);
-      tmp2 = VA*.5*(tmp*wik*dgdc*exp(lamdajik));
+      gcache_get(gbuf,k,g,dgdc,explamda);
+      tmp2 = VA*.5*(tmp*wik*dgdc*explamda);
       fj[0] = -tmp2*dcosjikdrj[0];
       fj[1] = -tmp2*dcosjikdrj[1];
       fj[2] = -tmp2*dcosjikdrj[2];
@@ -1378,7 +1457,7 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
       fk[1] = -tmp2*dcosjikdrk[1];
       fk[2] = -tmp2*dcosjikdrk[2];
 
-      tmp2 = VA*.5*(tmp*wik*g*exp(lamdajik)*4.0*kronecker(itype,1));
+      tmp2 = VA*.5*(tmp*wik*g*explamda*4.0*kronecker(itype,1));
       fj[0] -= tmp2*(-rij[0]/rijmag);
       fj[1] -= tmp2*(-rij[1]/rijmag);
       fj[2] -= tmp2*(-rij[2]/rijmag);
@@ -1393,7 +1472,7 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
 
       // dwik forces
 
-      tmp2 = VA*.5*(tmp*dwik*g*exp(lamdajik))/rikmag;
+      tmp2 = VA*.5*(tmp*dwik*g*explamda)/rikmag;
       fi[0] -= tmp2*rik[0];
       fi[1] -= tmp2*rik[1];
       fi[2] -= tmp2*rik[2];
@@ -1443,15 +1522,11 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
     atoml = REBO_neighs[l];
     if (atoml != atomi) {
       ltype = map[type[atoml]];
-      rjl[0] = x[atomj][0]-x[atoml][0];
-      rjl[1] = x[atomj][1]-x[atoml][1];
-      rjl[2] = x[atomj][2]-x[atoml][2];
-      rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
+      bjl = REBO_bond(j,l);
+      rjlmag = REBO_bond_del(bjl,rjl);
       lamdaijl = 4.0*kronecker(jtype,1) *
         ((rho[ltype][1]-rjlmag)-(rho[itype][1]-rijmag));
-      wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dS);
-      Nlj = nC[atoml]-(wjl*kronecker(jtype,0)) +
-        nH[atoml]-(wjl*kronecker(jtype,1));
+      wjl = bjl[4];
       cosijl = -1.0*((rij[0]*rjl[0])+(rij[1]*rjl[1])+(rij[2]*rjl[2])) /
         (rijmag*rjlmag);
       cosijl = MIN(cosijl,1.0);
@@ -1460,9 +1535,11 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
       // evaluate splines g and derivatives dg
 
       g = gSpline(cosijl,NjiC+NjiH,jtype,&dgdc,&dgdN);
-      Etmp = Etmp+(wjl*g*exp(lamdaijl));
-      tmp3 = tmp3+(wjl*dgdN*exp(lamdaijl));
-      NconjtmpJ = NconjtmpJ+(kronecker(ltype,0)*wjl*Sp(Nlj,Nmin,Nmax,dS));
+      explamda = exp(lamdaijl);
+      gcache_put(gbuf,l,g,dgdc,explamda);
+      Etmp = Etmp+(wjl*g*explamda);
+      tmp3 = tmp3+(wjl*dgdN*explamda);
+      NconjtmpJ = NconjtmpJ+(kronecker(ltype,0)*wjl*bjl[6]);
     }
   }
 
@@ -1478,13 +1555,10 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
     atoml = REBO_neighs[l];
     if (atoml != atomi) {
       ltype = map[type[atoml]];
-      rjl[0] = x[atomj][0]-x[atoml][0];
-      rjl[1] = x[atomj][1]-x[atoml][1];
-      rjl[2] = x[atomj][2]-x[atoml][2];
-      rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-      lamdaijl = 4.0*kronecker(jtype,1) *
-        ((rho[ltype][1]-rjlmag)-(rho[itype][1]-rijmag));
-      wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
+      bjl = REBO_bond(j,l);
+      rjlmag = REBO_bond_del(bjl,rjl);
+      wjl = bjl[4];
+      dwjl = bjl[5];
       cosijl = (-1.0*((rij[0]*rjl[0])+(rij[1]*rjl[1])+(rij[2]*rjl[2]))) /
         (rijmag*rjlmag);
       cosijl = MIN(cosijl,1.0);
@@ -1508,8 +1582,8 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
 
       // evaluate splines g and derivatives dg
 
-      g = gSpline(cosijl,NjiC+NjiH,jtype,&dgdc,&dgdN);
-      tmp2 = VA*.5*(tmp*wjl*dgdc*exp(lamdaijl));
+      gcache_get(gbuf,l,g,dgdc,explamda);
+      tmp2 = VA*.5*(tmp*wjl*dgdc*explamda);
       fi[0] = -tmp2*dcosijldri[0];
       fi[1] = -tmp2*dcosijldri[1];
       fi[2] = -tmp2*dcosijldri[2];
@@ -1520,7 +1594,7 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
       fl[1] = -tmp2*dcosijldrl[1];
       fl[2] = -tmp2*dcosijldrl[2];
 
-      tmp2 = VA*.5*(tmp*wjl*g*exp(lamdaijl)*4.0*kronecker(jtype,1));
+      tmp2 = VA*.5*(tmp*wjl*g*explamda*4.0*kronecker(jtype,1));
       fi[0] -= tmp2*(rij[0]/rijmag);
       fi[1] -= tmp2*(rij[1]/rijmag);
       fi[2] -= tmp2*(rij[2]/rijmag);
@@ -1535,7 +1609,7 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
 
       // dwik forces
 
-      tmp2 = VA*.5*(tmp*dwjl*g*exp(lamdaijl))/rjlmag;
+      tmp2 = VA*.5*(tmp*dwjl*g*explamda)/rjlmag;
       fj[0] -= tmp2*rjl[0];
       fj[1] -= tmp2*rjl[1];
       fj[2] -= tmp2*rjl[2];
@@ -1586,14 +1660,12 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
     atomk = REBO_neighs_i[k];
     if (atomk !=atomj) {
       ktype = map[type[atomk]];
-      rik[0] = x[atomi][0]-x[atomk][0];
-      rik[1] = x[atomi][1]-x[atomk][1];
-      rik[2] = x[atomi][2]-x[atomk][2];
-      rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-      wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-      Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-        (wik*kronecker(itype,1));
-      SpN = Sp(Nki,Nmin,Nmax,dNki);
+      bik = REBO_bond(i,k);
+      rikmag = REBO_bond_del(bik,rik);
+      wik = bik[4];
+      dwik = bik[5];
+      SpN = bik[6];
+      dNki = bik[7];
 
       tmp2 = VA*dN3[0]*dwik/rikmag;
       f[atomi][0] -= tmp2*rik[0];
@@ -1624,12 +1696,9 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
         for (n = 0; n < REBO_numneigh[atomk]; n++) {
           atomn = REBO_neighs_k[n];
           if (atomn != atomi) {
-            ntype = map[type[atomn]];
-            rkn[0] = x[atomk][0]-x[atomn][0];
-            rkn[1] = x[atomk][1]-x[atomn][1];
-            rkn[2] = x[atomk][2]-x[atomn][2];
-            rknmag = sqrt((rkn[0]*rkn[0])+(rkn[1]*rkn[1])+(rkn[2]*rkn[2]));
-            Sp(rknmag,rcmin[ktype][ntype],rcmax[ktype][ntype],dwkn);
+            bkn = REBO_bond(atomk,n);
+            rknmag = REBO_bond_del(bkn,rkn);
+            dwkn = bkn[5];
 
             tmp2 = VA*dN3[2]*(2.0*NconjtmpI*wik*dNki*dwkn)/rknmag;
             f[atomk][0] -= tmp2*rkn[0];
@@ -1653,14 +1722,12 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
     atoml = REBO_neighs[l];
     if (atoml !=atomi) {
       ltype = map[type[atoml]];
-      rjl[0] = x[atomj][0]-x[atoml][0];
-      rjl[1] = x[atomj][1]-x[atoml][1];
-      rjl[2] = x[atomj][2]-x[atoml][2];
-      rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-      wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
-      Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-        (wjl*kronecker(jtype,1));
-      SpN = Sp(Nlj,Nmin,Nmax,dNlj);
+      bjl = REBO_bond(j,l);
+      rjlmag = REBO_bond_del(bjl,rjl);
+      wjl = bjl[4];
+      dwjl = bjl[5];
+      SpN = bjl[6];
+      dNlj = bjl[7];
 
       tmp2 = VA*dN3[1]*dwjl/rjlmag;
       f[atomj][0] -= tmp2*rjl[0];
@@ -1691,12 +1758,9 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
         for (n = 0; n < REBO_numneigh[atoml]; n++) {
           atomn = REBO_neighs_l[n];
           if (atomn != atomj) {
-            ntype = map[type[atomn]];
-            rln[0] = x[atoml][0]-x[atomn][0];
-            rln[1] = x[atoml][1]-x[atomn][1];
-            rln[2] = x[atoml][2]-x[atomn][2];
-            rlnmag = sqrt((rln[0]*rln[0])+(rln[1]*rln[1])+(rln[2]*rln[2]));
-            Sp(rlnmag,rcmin[ltype][ntype],rcmax[ltype][ntype],dwln);
+            bln = REBO_bond(atoml,n);
+            rlnmag = REBO_bond_del(bln,rln);
+            dwln = bln[5];
 
             tmp2 = VA*dN3[2]*(2.0*NconjtmpJ*wjl*dNlj*dwln)/rlnmag;
             f[atoml][0] -= tmp2*rln[0];
@@ -1937,14 +2001,12 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
       atomk = REBO_neighs[k];
       if (atomk != atomj) {
         ktype = map[type[atomk]];
-        rik[0] = x[atomi][0]-x[atomk][0];
-        rik[1] = x[atomi][1]-x[atomk][1];
-        rik[2] = x[atomi][2]-x[atomk][2];
-        rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-        wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-        Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-          (wik*kronecker(itype,1));
-        SpN = Sp(Nki,Nmin,Nmax,dNki);
+        bik = REBO_bond(i,k);
+        rikmag = REBO_bond_del(bik,rik);
+        wik = bik[4];
+        dwik = bik[5];
+        SpN = bik[6];
+        dNki = bik[7];
 
         tmp2 = VA*dN3[0]*dwik*Etmp/rikmag;
         f[atomi][0] -= tmp2*rik[0];
@@ -1974,13 +2036,10 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
           REBO_neighs_k = REBO_firstneigh[atomk];
           for (n = 0; n < REBO_numneigh[atomk]; n++) {
             atomn = REBO_neighs_k[n];
-            ntype = map[type[atomn]];
             if (atomn != atomi) {
-              rkn[0] = x[atomk][0]-x[atomn][0];
-              rkn[1] = x[atomk][1]-x[atomn][1];
-              rkn[2] = x[atomk][2]-x[atomn][2];
-              rknmag = sqrt((rkn[0]*rkn[0])+(rkn[1]*rkn[1])+(rkn[2]*rkn[2]));
-              Sp(rknmag,rcmin[ktype][ntype],rcmax[ktype][ntype],dwkn);
+              bkn = REBO_bond(atomk,n);
+              rknmag = REBO_bond_del(bkn,rkn);
+              dwkn = bkn[5];
 
               tmp2 = VA*dN3[2]*(2.0*NconjtmpI*wik*dNki*dwkn)*Etmp/rknmag;
               f[atomk][0] -= tmp2*rkn[0];
@@ -2004,14 +2063,12 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
       atoml = REBO_neighs[l];
       if (atoml != atomi) {
         ltype = map[type[atoml]];
-        rjl[0] = x[atomj][0]-x[atoml][0];
-        rjl[1] = x[atomj][1]-x[atoml][1];
-        rjl[2] = x[atomj][2]-x[atoml][2];
-        rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-        wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
-        Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-          (wjl*kronecker(jtype,1));
-        SpN = Sp(Nlj,Nmin,Nmax,dNlj);
+        bjl = REBO_bond(j,l);
+        rjlmag = REBO_bond_del(bjl,rjl);
+        wjl = bjl[4];
+        dwjl = bjl[5];
+        SpN = bjl[6];
+        dNlj = bjl[7];
 
         tmp2 = VA*dN3[1]*dwjl*Etmp/rjlmag;
         f[atomj][0] -= tmp2*rjl[0];
@@ -2041,13 +2098,10 @@ double PairAIREBO::bondorder(int i, int j, double rij[3], double rijmag, double
           REBO_neighs_l = REBO_firstneigh[atoml];
           for (n = 0; n < REBO_numneigh[atoml]; n++) {
             atomn = REBO_neighs_l[n];
-            ntype = map[type[atomn]];
             if (atomn !=atomj) {
-              rln[0] = x[atoml][0]-x[atomn][0];
-              rln[1] = x[atoml][1]-x[atomn][1];
-              rln[2] = x[atoml][2]-x[atomn][2];
-              rlnmag = sqrt((rln[0]*rln[0])+(rln[1]*rln[1])+(rln[2]*rln[2]));
-              Sp(rlnmag,rcmin[ltype][ntype],rcmax[ltype][ntype],dwln);
+              bln = REBO_bond(atoml,n);
+              rlnmag = REBO_bond_del(bln,rln);
+              dwln = bln[5];
 
               tmp2 = VA*dN3[2]*(2.0*NconjtmpJ*wjl*dNlj*dwln)*Etmp/rlnmag;
               f[atoml][0] -= tmp2*rln[0];
@@ -2106,11 +2160,11 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
                                double VA, double rij[3], double rijmag, double **f)
 {
   int atomi,atomj,k,n,l,atomk,atoml,atomn,atom1,atom2,atom3,atom4;
-  int itype,jtype,ktype,ltype,ntype;
+  int itype,jtype,ktype,ltype;
   double rik[3],rjl[3],rkn[3],rji[3],rki[3],rlj[3],rknmag,dNki,dwjl,bij;
   double NijC,NijH,NjiC,NjiH,wik,dwik,dwkn,wjl;
   double rikmag,rjlmag,cosjik,cosijl,g,tmp2,tmp3;
-  double Etmp,pij,tmp,wij,dwij,NconjtmpI,NconjtmpJ,Nki,Nlj,dS;
+  double Etmp,pij,tmp,wij,dwij,NconjtmpI,NconjtmpJ;
   double lamdajik,lamdaijl,dgdc,dgdN,pji,Nijconj,piRC;
   double dcosjikdri[3],dcosijldri[3],dcosjikdrk[3];
   double dN2[2],dN3[3];
@@ -2132,6 +2186,7 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
   double PijS,PjiS;
   double rij2,tspjik,dtsjik,tspijl,dtsijl,costmp;
   int *REBO_neighs,*REBO_neighs_i,*REBO_neighs_j,*REBO_neighs_k,*REBO_neighs_l;
+  double *bik,*bjl,*bkn,*bln;
   double tmppij,tmppji,dN2PIJ[2],dN2PJI[2],dN3piRC[3],dN3Tij[3];
   double tmp3pij,tmp3pji,Stb,dStb;
 
@@ -2164,15 +2219,11 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
     atomk = REBO_neighs[k];
     if (atomk != atomj) {
       ktype = map[type[atomk]];
-      rik[0] = x[atomi][0]-x[atomk][0];
-      rik[1] = x[atomi][1]-x[atomk][1];
-      rik[2] = x[atomi][2]-x[atomk][2];
-      rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
+      bik = REBO_bond(i,k);
+      rikmag = REBO_bond_del(bik,rik);
       lamdajik = 4.0*kronecker(itype,1) *
         ((rho[ktype][1]-rikmag)-(rho[jtype][1]-rijmag_mod));
-      wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dS);
-      Nki = nC[atomk]-(wik*kronecker(itype,0))+
-        nH[atomk]-(wik*kronecker(itype,1));
+      wik = bik[4];
       cosjik = ((rij[0]*rik[0])+(rij[1]*rik[1])+(rij[2]*rik[2])) /
         (rijmag*rikmag);
       cosjik = MIN(cosjik,1.0);
@@ -2183,7 +2234,7 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
       g = gSpline(cosjik,(NijC+NijH),itype,&dgdc,&dgdN);
       Etmp += (wik*g*exp(lamdajik));
       tmp3 += (wik*dgdN*exp(lamdajik));
-      NconjtmpI = NconjtmpI+(kronecker(ktype,0)*wik*Sp(Nki,Nmin,Nmax,dS));
+      NconjtmpI = NconjtmpI+(kronecker(ktype,0)*wik*bik[6]);
     }
   }
 
@@ -2205,15 +2256,11 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
     atoml = REBO_neighs[l];
     if (atoml != atomi) {
       ltype = map[type[atoml]];
-      rjl[0] = x[atomj][0]-x[atoml][0];
-      rjl[1] = x[atomj][1]-x[atoml][1];
-      rjl[2] = x[atomj][2]-x[atoml][2];
-      rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
+      bjl = REBO_bond(j,l);
+      rjlmag = REBO_bond_del(bjl,rjl);
       lamdaijl = 4.0*kronecker(jtype,1) *
         ((rho[ltype][1]-rjlmag)-(rho[itype][1]-rijmag_mod));
-      wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dS);
-      Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-        (wjl*kronecker(jtype,1));
+      wjl = bjl[4];
       cosijl = -1.0*((rij[0]*rjl[0])+(rij[1]*rjl[1])+(rij[2]*rjl[2])) /
         (rijmag*rjlmag);
       cosijl = MIN(cosijl,1.0);
@@ -2224,7 +2271,7 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
       g = gSpline(cosijl,NjiC+NjiH,jtype,&dgdc,&dgdN);
       Etmp += (wjl*g*exp(lamdaijl));
       tmp3 += (wjl*dgdN*exp(lamdaijl));
-      NconjtmpJ = NconjtmpJ+(kronecker(ltype,0)*wjl*Sp(Nlj,Nmin,Nmax,dS));
+      NconjtmpJ = NconjtmpJ+(kronecker(ltype,0)*wjl*bjl[6]);
     }
   }
 
@@ -2340,13 +2387,12 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
       ktype = map[type[atomk]];
       if (atomk != atomj) {
         lamdajik = 0.0;
-        rik[0] = x[atomi][0]-x[atomk][0];
-        rik[1] = x[atomi][1]-x[atomk][1];
-        rik[2] = x[atomi][2]-x[atomk][2];
-        rikmag = sqrt(rik[0]*rik[0] + rik[1]*rik[1] + rik[2]*rik[2]);
+        bik = REBO_bond(i,k);
+        rikmag = REBO_bond_del(bik,rik);
         lamdajik = 4.0*kronecker(itype,1) *
           ((rho[ktype][1]-rikmag)-(rho[jtype][1]-rijmag_mod));
-        wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
+        wik = bik[4];
+        dwik = bik[5];
         cosjik = (rij[0]*rik[0] + rij[1]*rik[1] + rij[2]*rik[2]) /
           (rijmag*rikmag);
         cosjik = MIN(cosjik,1.0);
@@ -2445,13 +2491,12 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
       atoml = REBO_neighs[l];
       if (atoml !=atomi) {
         ltype = map[type[atoml]];
-        rjl[0] = x[atomj][0]-x[atoml][0];
-        rjl[1] = x[atomj][1]-x[atoml][1];
-        rjl[2] = x[atomj][2]-x[atoml][2];
-        rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
+        bjl = REBO_bond(j,l);
+        rjlmag = REBO_bond_del(bjl,rjl);
         lamdaijl = 4.0*kronecker(jtype,1) *
           ((rho[ltype][1]-rjlmag)-(rho[itype][1]-rijmag_mod));
-        wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
+        wjl = bjl[4];
+        dwjl = bjl[5];
         cosijl = (-1.0*((rij[0]*rjl[0])+(rij[1]*rjl[1])+(rij[2]*rjl[2]))) /
           (rijmag*rjlmag);
         cosijl = MIN(cosijl,1.0);
@@ -2549,14 +2594,12 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
       atomk = REBO_neighs_i[k];
       if (atomk != atomj) {
         ktype = map[type[atomk]];
-        rik[0] = x[atomi][0]-x[atomk][0];
-        rik[1] = x[atomi][1]-x[atomk][1];
-        rik[2] = x[atomi][2]-x[atomk][2];
-        rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-        wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-        Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-          (wik*kronecker(itype,1));
-        SpN = Sp(Nki,Nmin,Nmax,dNki);
+        bik = REBO_bond(i,k);
+        rikmag = REBO_bond_del(bik,rik);
+        wik = bik[4];
+        dwik = bik[5];
+        SpN = bik[6];
+        dNki = bik[7];
 
         tmp2 = VA*dN3[0]*dwik/rikmag;
         f[atomi][0] -= tmp2*rik[0];
@@ -2587,12 +2630,9 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
           for (n = 0; n < REBO_numneigh[atomk]; n++) {
             atomn = REBO_neighs_k[n];
             if (atomn != atomi) {
-              ntype = map[type[atomn]];
-              rkn[0] = x[atomk][0]-x[atomn][0];
-              rkn[1] = x[atomk][1]-x[atomn][1];
-              rkn[2] = x[atomk][2]-x[atomn][2];
-              rknmag = sqrt((rkn[0]*rkn[0])+(rkn[1]*rkn[1])+(rkn[2]*rkn[2]));
-              Sp(rknmag,rcmin[ktype][ntype],rcmax[ktype][ntype],dwkn);
+              bkn = REBO_bond(atomk,n);
+              rknmag = REBO_bond_del(bkn,rkn);
+              dwkn = bkn[5];
 
               tmp2 = VA*dN3[2]*(2.0*NconjtmpI*wik*dNki*dwkn)/rknmag;
               f[atomk][0] -= tmp2*rkn[0];
@@ -2616,14 +2656,12 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
       atoml = REBO_neighs[l];
       if (atoml != atomi) {
         ltype = map[type[atoml]];
-        rjl[0] = x[atomj][0]-x[atoml][0];
-        rjl[1] = x[atomj][1]-x[atoml][1];
-        rjl[2] = x[atomj][2]-x[atoml][2];
-        rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-        wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
-        Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-          (wjl*kronecker(jtype,1));
-        SpN = Sp(Nlj,Nmin,Nmax,dNlj);
+        bjl = REBO_bond(j,l);
+        rjlmag = REBO_bond_del(bjl,rjl);
+        wjl = bjl[4];
+        dwjl = bjl[5];
+        SpN = bjl[6];
+        dNlj = bjl[7];
 
         tmp2 = VA*dN3[1]*dwjl/rjlmag;
         f[atomj][0] -= tmp2*rjl[0];
@@ -2654,12 +2692,9 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
           for (n = 0; n < REBO_numneigh[atoml]; n++) {
             atomn = REBO_neighs_l[n];
             if (atomn != atomj) {
-              ntype = map[type[atomn]];
-              rln[0] = x[atoml][0]-x[atomn][0];
-              rln[1] = x[atoml][1]-x[atomn][1];
-              rln[2] = x[atoml][2]-x[atomn][2];
-              rlnmag = sqrt((rln[0]*rln[0])+(rln[1]*rln[1])+(rln[2]*rln[2]));
-              Sp(rlnmag,rcmin[ltype][ntype],rcmax[ltype][ntype],dwln);
+              bln = REBO_bond(atoml,n);
+              rlnmag = REBO_bond_del(bln,rln);
+              dwln = bln[5];
 
               tmp2 = VA*dN3[2]*(2.0*NconjtmpJ*wjl*dNlj*dwln)/rlnmag;
               f[atoml][0] -= tmp2*rln[0];
@@ -2891,14 +2926,12 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
         atomk = REBO_neighs[k];
         if (atomk != atomj) {
           ktype = map[type[atomk]];
-          rik[0] = x[atomi][0]-x[atomk][0];
-          rik[1] = x[atomi][1]-x[atomk][1];
-          rik[2] = x[atomi][2]-x[atomk][2];
-          rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-          wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-          Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-            (wik*kronecker(itype,1));
-          SpN = Sp(Nki,Nmin,Nmax,dNki);
+          bik = REBO_bond(i,k);
+          rikmag = REBO_bond_del(bik,rik);
+          wik = bik[4];
+          dwik = bik[5];
+          SpN = bik[6];
+          dNki = bik[7];
 
           tmp2 = VA*dN3[0]*dwik*Etmp/rikmag;
           f[atomi][0] -= tmp2*rik[0];
@@ -2928,13 +2961,10 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
             REBO_neighs_k = REBO_firstneigh[atomk];
             for (n = 0; n < REBO_numneigh[atomk]; n++) {
               atomn = REBO_neighs_k[n];
-              ntype = map[type[atomn]];
               if (atomn !=atomi) {
-                rkn[0] = x[atomk][0]-x[atomn][0];
-                rkn[1] = x[atomk][1]-x[atomn][1];
-                rkn[2] = x[atomk][2]-x[atomn][2];
-                rknmag = sqrt((rkn[0]*rkn[0])+(rkn[1]*rkn[1])+(rkn[2]*rkn[2]));
-                Sp(rknmag,rcmin[ktype][ntype],rcmax[ktype][ntype],dwkn);
+                bkn = REBO_bond(atomk,n);
+                rknmag = REBO_bond_del(bkn,rkn);
+                dwkn = bkn[5];
 
                 tmp2 = VA*dN3[2]*(2.0*NconjtmpI*wik*dNki*dwkn)*Etmp/rknmag;
                 f[atomk][0] -= tmp2*rkn[0];
@@ -2958,14 +2988,12 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
         atoml = REBO_neighs[l];
         if (atoml != atomi) {
           ltype = map[type[atoml]];
-          rjl[0] = x[atomj][0]-x[atoml][0];
-          rjl[1] = x[atomj][1]-x[atoml][1];
-          rjl[2] = x[atomj][2]-x[atoml][2];
-          rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-          wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
-          Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-            (wjl*kronecker(jtype,1));
-          SpN = Sp(Nlj,Nmin,Nmax,dNlj);
+          bjl = REBO_bond(j,l);
+          rjlmag = REBO_bond_del(bjl,rjl);
+          wjl = bjl[4];
+          dwjl = bjl[5];
+          SpN = bjl[6];
+          dNlj = bjl[7];
 
           tmp2 = VA*dN3[1]*dwjl*Etmp/rjlmag;
           f[atomj][0] -= tmp2*rjl[0];
@@ -2995,13 +3023,10 @@ double PairAIREBO::bondorderLJ(int i, int j, double /* rij_mod */[3], double rij
             REBO_neighs_l = REBO_firstneigh[atoml];
             for (n = 0; n < REBO_numneigh[atoml]; n++) {
               atomn = REBO_neighs_l[n];
-              ntype = map[type[atomn]];
               if (atomn != atomj) {
-                rln[0] = x[atoml][0]-x[atomn][0];
-                rln[1] = x[atoml][1]-x[atomn][1];
-                rln[2] = x[atoml][2]-x[atomn][2];
-                rlnmag = sqrt((rln[0]*rln[0])+(rln[1]*rln[1])+(rln[2]*rln[2]));
-                Sp(rlnmag,rcmin[ltype][ntype],rcmax[ltype][ntype],dwln);
+                bln = REBO_bond(atoml,n);
+                rlnmag = REBO_bond_del(bln,rln);
+                dwln = bln[5];
 
                 tmp2 = VA*dN3[2]*(2.0*NconjtmpJ*wjl*dNlj*dwln)*Etmp/rlnmag;
                 f[atoml][0] -= tmp2*rln[0];
@@ -4458,8 +4483,13 @@ double PairAIREBO::memory_usage()
   bytes += (double)maxlocal * sizeof(int);
   bytes += (double)maxlocal * sizeof(int *);
 
-  for (int i = 0; i < comm->nthreads; i++)
+  bytes += (double)maxlocal * sizeof(double *);
+
+  for (int i = 0; i < comm->nthreads; i++) {
     bytes += ipage[i].size();
+    bytes += bpage[i].size();
+  }
+  bytes += (double)comm->nthreads * 3 * maxgcache * sizeof(double);
 
   bytes += 2.0 * maxlocal * sizeof(double);
   return bytes;
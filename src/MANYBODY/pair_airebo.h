@@ -60,6 +60,16 @@ class PairAIREBO : public Pair {
   int *REBO_numneigh;       // # of pair neighbors for each atom
   int **REBO_firstneigh;    // ptr to 1st neighbor of each atom
 
+  // per-bond data for each REBO neighbor J of I, refreshed every step
+  // delr = xi - xj (3), rij, wij, dwij, Sp(Nji), dSp(Nji)/dNji
+
+  static constexpr int NREBOBOND = 8;
+  MyPage<double> *bpage;      // bond data pages
+  double **REBO_firstbond;    // ptr to bond data of 1st neighbor of each atom
+
+  int maxgcache;      // # of neighbors gcache can hold
+  double **gcache;    // per-thread g spline values of bond being evaluated
+
   double *closestdistsq;    // closest owned atom dist to each ghost
   double *nC, *nH;          // sum of weighting fns with REBO neighs
 
@@ -94,6 +104,9 @@ class PairAIREBO : public Pair {
   double Tf[5][5][10], Tdfdx[5][5][10], Tdfdy[5][5][10], Tdfdz[5][5][10];
 
   void REBO_neigh();
+  int REBO_neigh_bonds(int, int *, double *);
+  void REBO_neigh_coord(int, int);
+  void REBO_grow_gcache(int);
   void FREBO(int);
   void FLJ(int);
   void TORSION(int);
@@ -203,6 +216,44 @@ class PairAIREBO : public Pair {
   /* kronecker delta function returning a double */
 
   inline double kronecker(const int a, const int b) const { return (a == b) ? 1.0 : 0.0; };
+
+  // ----------------------------------------------------------------------
+  // access to bond data and g spline values of REBO neighbors
+  // added to header for inlining
+  // ----------------------------------------------------------------------
+
+  /* bond data of the K-th REBO neighbor of atom I */
+
+  inline double *REBO_bond(int i, int k) const { return &REBO_firstbond[i][NREBOBOND * k]; }
+
+  /* copy separation vector of a bond into del and return its length */
+
+  inline double REBO_bond_del(const double *bond, double *del) const
+  {
+    del[0] = bond[0];
+    del[1] = bond[1];
+    del[2] = bond[2];
+    return bond[3];
+  }
+
+  /* store and retrieve g, dg/dcos and exp(lambda) of the K-th neighbor */
+
+  inline void gcache_put(double *gbuf, int k, double g, double dgdc, double explamda) const
+  {
+    double *gk = &gbuf[3 * k];
+    gk[0] = g;
+    gk[1] = dgdc;
+    gk[2] = explamda;
+  }
+
+  inline void gcache_get(const double *gbuf, int k, double &g, double &dgdc,
+                         double &explamda) const
+  {
+    const double *gk = &gbuf[3 * k];
+    g = gk[0];
+    dgdc = gk[1];
+    explamda = gk[2];
+  }
 };
 }    // namespace LAMMPS_NS
 
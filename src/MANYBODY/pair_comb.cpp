@@ -2013,7 +2013,8 @@ void PairComb::Short_neigh()
     sht_num[i] = nj;
     ipage->vgot(nj);
     if (ipage->status())
-      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage->chunkmax);
   }
 }
 
@@ -41,6 +41,7 @@ PairEAM::PairEAM(LAMMPS *lmp) : Pair(lmp)
 {
   restartinfo = 0;
   manybody_flag = 1;
+  local_energy_enable = 1;
   embedstep = -1;
   unit_convert_flag = utils::get_supported_conversions(utils::ENERGY);
 
@@ -50,6 +51,10 @@ PairEAM::PairEAM(LAMMPS *lmp) : Pair(lmp)
   numforce = nullptr;
   type2frho = nullptr;
 
+  maxshort = 0;
+  jshort = nullptr;
+  rshort = nullptr;
+
   nfuncfl = 0;
   funcfl = nullptr;
 
@@ -66,6 +71,8 @@ PairEAM::PairEAM(LAMMPS *lmp) : Pair(lmp)
   frho_spline = nullptr;
   rhor_spline = nullptr;
   z2r_spline = nullptr;
+  rhor_index = nullptr;
+  z2r_index = nullptr;
 
   // set comm size needed by this Pair
 
@@ -84,6 +91,8 @@ PairEAM::~PairEAM()
   memory->destroy(rho);
   memory->destroy(fp);
   memory->destroy(numforce);
+  memory->destroy(jshort);
+  memory->destroy(rshort);
 
   if (allocated) {
     memory->destroy(setflag);
@@ -135,16 +144,19 @@ PairEAM::~PairEAM()
   memory->destroy(frho_spline);
   memory->destroy(rhor_spline);
   memory->destroy(z2r_spline);
+  memory->destroy(rhor_index);
+  memory->destroy(z2r_index);
 }
 
 /* ---------------------------------------------------------------------- */
 
 void PairEAM::compute(int eflag, int vflag)
 {
-  int i,j,ii,jj,m,inum,jnum,itype,jtype;
+  int i,j,ii,jj,m,n,inum,jnum,itype,jtype;
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
   double rsq,r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi;
-  double *coeff;
+  double *coeff,*rlist,*scale_i,*rhor_coeff,*z2r_coeff;
+  int *rhor_i,*z2r_i;
   int *ilist,*jlist,*numneigh,**firstneigh;
 
   evdwl = 0.0;
@@ -175,6 +187,23 @@ void PairEAM::compute(int eflag, int vflag)
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
+  // spline coeffs of all type pairs are contiguous
+
+  rhor_coeff = &rhor_spline[0][0][0];
+  z2r_coeff = &z2r_spline[0][0][0];
+
+  // grow short neighbor list if necessary
+
+  n = 0;
+  for (ii = 0; ii < inum; ii++) n += numneigh[ilist[ii]];
+  if (n > maxshort) {
+    memory->destroy(jshort);
+    memory->destroy(rshort);
+    maxshort = n;
+    memory->create(jshort,maxshort,"pair:jshort");
+    memory->create(rshort,maxshort,"pair:rshort");
+  }
+
   // zero out density
 
   if (newton_pair) {
@@ -183,15 +212,20 @@ void PairEAM::compute(int eflag, int vflag)
 
   // rho = density at each atom
   // loop over neighbors of my atoms
+  // store neighbors within cutoff and their distance in short list
+  //   numforce[i] = # of them for atom I
 
+  n = 0;
   for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
     xtmp = x[i][0];
     ytmp = x[i][1];
     ztmp = x[i][2];
     itype = type[i];
+    rhor_i = rhor_index[itype];
     jlist = firstneigh[i];
     jnum = numneigh[i];
+    numforce[i] = n;
 
     for (jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
@@ -204,19 +238,24 @@ void PairEAM::compute(int eflag, int vflag)
 
       if (rsq < cutforcesq) {
         jtype = type[j];
-        p = sqrt(rsq)*rdr + 1.0;
+        r = sqrt(rsq);
+        jshort[n] = j;
+        rshort[n++] = r;
+        p = r*rdr + 1.0;
         m = static_cast<int> (p);
         m = MIN(m,nr-1);
         p -= m;
         p = MIN(p,1.0);
-        coeff = rhor_spline[type2rhor[jtype][itype]][m];
+        coeff = &rhor_coeff[rhor_i[jtype] + 7*m];
         rho[i] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
         if (newton_pair || j < nlocal) {
-          coeff = rhor_spline[type2rhor[itype][jtype]][m];
+          coeff = &rhor_coeff[rhor_index[jtype][itype] + 7*m];
           rho[j] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
         }
       }
     }
+
+    numforce[i] = n - numforce[i];
   }
 
   // communicate and sum densities
@@ -252,75 +291,75 @@ void PairEAM::compute(int eflag, int vflag)
   embedstep = update->ntimestep;
 
   // compute forces on each atom
-  // loop over neighbors of my atoms
+  // loop over short neighbor list of my atoms, in same order as it was stored
 
+  n = 0;
   for (ii = 0; ii < inum; ii++) {
     i = ilist[ii];
     xtmp = x[i][0];
     ytmp = x[i][1];
     ztmp = x[i][2];
     itype = type[i];
+    rhor_i = rhor_index[itype];
+    z2r_i = z2r_index[itype];
+    scale_i = scale[itype];
 
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
-    numforce[i] = 0;
+    jlist = &jshort[n];
+    rlist = &rshort[n];
+    jnum = numforce[i];
+    n += jnum;
 
     for (jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
-      j &= NEIGHMASK;
 
       delx = xtmp - x[j][0];
       dely = ytmp - x[j][1];
       delz = ztmp - x[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
 
-      if (rsq < cutforcesq) {
-        ++numforce[i];
-        jtype = type[j];
-        r = sqrt(rsq);
-        p = r*rdr + 1.0;
-        m = static_cast<int> (p);
-        m = MIN(m,nr-1);
-        p -= m;
-        p = MIN(p,1.0);
-
-        // rhoip = derivative of (density at atom j due to atom i)
-        // rhojp = derivative of (density at atom i due to atom j)
-        // phi = pair potential energy
-        // phip = phi'
-        // z2 = phi * r
-        // z2p = (phi * r)' = (phi' r) + phi
-        // psip needs both fp[i] and fp[j] terms since r_ij appears in two
-        //   terms of embed eng: Fi(sum rho_ij) and Fj(sum rho_ji)
-        //   hence embed' = Fi(sum rho_ij) rhojp + Fj(sum rho_ji) rhoip
-        // scale factor can be applied by thermodynamic integration
-
-        coeff = rhor_spline[type2rhor[itype][jtype]][m];
-        rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
-        coeff = rhor_spline[type2rhor[jtype][itype]][m];
-        rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
-        coeff = z2r_spline[type2z2r[itype][jtype]][m];
-        z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
-        z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
-
-        recip = 1.0/r;
-        phi = z2*recip;
-        phip = z2p*recip - phi*recip;
-        psip = fp[i]*rhojp + fp[j]*rhoip + phip;
-        fpair = -scale[itype][jtype]*psip*recip;
-
-        f[i][0] += delx*fpair;
-        f[i][1] += dely*fpair;
-        f[i][2] += delz*fpair;
-        if (newton_pair || j < nlocal) {
-          f[j][0] -= delx*fpair;
-          f[j][1] -= dely*fpair;
-          f[j][2] -= delz*fpair;
-        }
-
-        if (eflag) evdwl = scale[itype][jtype]*phi;
-        if (evflag) ev_tally(i,j,nlocal,newton_pair,evdwl,0.0,fpair,delx,dely,delz);
+      jtype = type[j];
+      r = rlist[jj];
+      p = r*rdr + 1.0;
+      m = static_cast<int> (p);
+      m = MIN(m,nr-1);
+      p -= m;
+      p = MIN(p,1.0);
+
+      // rhoip = derivative of (density at atom j due to atom i)
+      // rhojp = derivative of (density at atom i due to atom j)
+      // phi = pair potential energy
+      // phip = phi'
+      // z2 = phi * r
+      // z2p = (phi * r)' = (phi' r) + phi
+      // psip needs both fp[i] and fp[j] terms since r_ij appears in two
+      //   terms of embed eng: Fi(sum rho_ij) and Fj(sum rho_ji)
+      //   hence embed' = Fi(sum rho_ij) rhojp + Fj(sum rho_ji) rhoip
+      // scale factor can be applied by thermodynamic integration
+
+      coeff = &rhor_coeff[rhor_index[jtype][itype] + 7*m];
+      rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
+      coeff = &rhor_coeff[rhor_i[jtype] + 7*m];
+      rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
+      coeff = &z2r_coeff[z2r_i[jtype] + 7*m];
+      z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
+      z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+
+      recip = 1.0/r;
+      phi = z2*recip;
+      phip = z2p*recip - phi*recip;
+      psip = fp[i]*rhojp + fp[j]*rhoip + phip;
+      fpair = -scale_i[jtype]*psip*recip;
+
+      f[i][0] += delx*fpair;
+      f[i][1] += dely*fpair;
+      f[i][2] += delz*fpair;
+      if (newton_pair || j < nlocal) {
+        f[j][0] -= delx*fpair;
+        f[j][1] -= dely*fpair;
+        f[j][2] -= delz*fpair;
       }
+
+      if (eflag) evdwl = scale_i[jtype]*phi;
+      if (evflag) ev_tally(i,j,nlocal,newton_pair,evdwl,0.0,fpair,delx,dely,delz);
     }
   }
 
@@ -762,6 +801,20 @@ void PairEAM::array2spline()
 
   for (int i = 0; i < nz2r; i++)
     interpolate(nr,dr,z2r[i],z2r_spline[i]);
+
+  // per type pair offsets of first spline coeff, 0 for unmapped types
+
+  int n = atom->ntypes;
+  memory->destroy(rhor_index);
+  memory->destroy(z2r_index);
+  memory->create(rhor_index,n+1,n+1,"pair:rhor_index");
+  memory->create(z2r_index,n+1,n+1,"pair:z2r_index");
+
+  for (int i = 1; i <= n; i++)
+    for (int j = 1; j <= n; j++) {
+      rhor_index[i][j] = MAX(type2rhor[j][i],0) * (nr+1)*7;
+      z2r_index[i][j] = MAX(type2z2r[i][j],0) * (nr+1)*7;
+    }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -850,6 +903,76 @@ double PairEAM::single(int i, int j, int itype, int jtype,
   return phi;
 }
 
+/* ----------------------------------------------------------------------
+   energy of the atoms in a list from local_energy_list()
+   embedding energy plus half of each pair energy, from a full list
+   if eone is set, also store energy of each of the atoms
+------------------------------------------------------------------------- */
+
+double PairEAM::energy_local(NeighList *sub, double *eone)
+{
+  int i,j,ii,jj,m,jnum,itype,jtype;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq,r,p,rhoi,fpi,phi,ei;
+  double *coeff;
+  int *jlist;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  double energy = 0.0;
+
+  for (ii = 0; ii < sub->inum; ii++) {
+    i = sub->ilist[ii];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    jlist = sub->firstneigh[i];
+    jnum = sub->numneigh[i];
+    rhoi = 0.0;
+    ei = 0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cutforcesq) {
+        jtype = type[j];
+        r = sqrt(rsq);
+        p = r*rdr + 1.0;
+        m = static_cast<int> (p);
+        m = MIN(m,nr-1);
+        p -= m;
+        p = MIN(p,1.0);
+        coeff = rhor_spline[type2rhor[jtype][itype]][m];
+        rhoi += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+        coeff = z2r_spline[type2z2r[itype][jtype]][m];
+        phi = (((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6]) / r;
+        ei += 0.5*scale[itype][jtype]*phi;
+      }
+    }
+
+    p = rhoi*rdrho + 1.0;
+    m = static_cast<int> (p);
+    m = MAX(1,MIN(m,nrho-1));
+    p -= m;
+    p = MIN(p,1.0);
+    coeff = frho_spline[type2frho[itype]][m];
+    fpi = (coeff[0]*p + coeff[1])*p + coeff[2];
+    phi = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+    if (rhoi > rhomax) phi += fpi * (rhoi-rhomax);
+    ei += scale[itype][itype]*phi;
+    if (eone) eone[i] = ei;
+    energy += ei;
+  }
+
+  return energy;
+}
+
 /* ---------------------------------------------------------------------- */
 
 int PairEAM::pack_forward_comm(int n, int *list, double *buf, int /*pbc_flag*/, int * /*pbc*/)
@@ -909,6 +1032,7 @@ double PairEAM::memory_usage()
   double bytes = (double)maxeatom * sizeof(double);
   bytes += (double)maxvatom*6 * sizeof(double);
   bytes += (double)2 * nmax * sizeof(double);
+  bytes += (double)maxshort * (sizeof(int) + sizeof(double));
   return bytes;
 }
 
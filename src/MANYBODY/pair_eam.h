@@ -52,6 +52,7 @@ class PairEAM : public Pair {
   void init_style() override;
   double init_one(int, int) override;
   double single(int, int, int, int, double, double, double, double &) override;
+  double energy_local(class NeighList *, double *) override;
   void *extract(const char *, int &) override;
   void *extract_peratom(const char *, int &) override;
 
@@ -73,6 +74,18 @@ class PairEAM : public Pair {
   double *rho, *fp;
   int *numforce;
 
+  // neighbors within cutoff and their distance, found in the density
+  //   pass of compute() and reused in the force pass
+
+  int maxshort;
+  int *jshort;
+  double *rshort;
+
+  // per type pair offsets into contiguous spline coeffs, set in array2spline()
+  // rhor_index[i][j] = for density at atom of type i due to atom of type j
+
+  int **rhor_index, **z2r_index;
+
   // potentials as file data
 
   struct Funcfl {
@@ -52,6 +52,7 @@ PairSW::PairSW(LAMMPS *lmp) : Pair(lmp)
 
   maxshort = 10;
   neighshort = nullptr;
+  geomshort = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -69,6 +70,7 @@ PairSW::~PairSW()
     memory->destroy(setflag);
     memory->destroy(cutsq);
     memory->destroy(neighshort);
+    memory->destroy(geomshort);
   }
 }
 
@@ -77,11 +79,11 @@ PairSW::~PairSW()
 void PairSW::compute(int eflag, int vflag)
 {
   int i,j,k,ii,jj,kk,inum,jnum,jnumm1;
-  int itype,jtype,ktype,ijparam,ikparam,ijkparam;
+  int itype,jtype,ktype,ijparam,ijkparam;
   tagint itag,jtag;
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
-  double rsq,rsq1,rsq2;
-  double delr1[3],delr2[3],fj[3],fk[3];
+  double rsq;
+  double *delr1,*delr2,fj[3],fk[3];
   int *ilist,*jlist,*numneigh,**firstneigh;
 
   evdwl = 0.0;
@@ -132,10 +134,13 @@ void PairSW::compute(int eflag, int vflag)
       if (rsq >= params[ijparam].cutsq) {
         continue;
       } else {
+        if (!skip_threebody_flag)
+          short_geom(&params[ijparam],delx,dely,delz,rsq,geomshort[numshort]);
         neighshort[numshort++] = j;
         if (numshort >= maxshort) {
           maxshort += maxshort/2;
           memory->grow(neighshort,maxshort,"pair:neighshort");
+          memory->grow(geomshort,maxshort,NGEOM,"pair:geomshort");
         }
       }
 
@@ -174,11 +179,7 @@ void PairSW::compute(int eflag, int vflag)
     for (jj = 0; jj < jnumm1; jj++) {
       j = neighshort[jj];
       jtype = map[type[j]];
-      ijparam = elem3param[itype][jtype][jtype];
-      delr1[0] = x[j][0] - xtmp;
-      delr1[1] = x[j][1] - ytmp;
-      delr1[2] = x[j][2] - ztmp;
-      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
+      delr1 = geomshort[jj];
 
       double fjxtmp,fjytmp,fjztmp;
       fjxtmp = fjytmp = fjztmp = 0.0;
@@ -186,16 +187,10 @@ void PairSW::compute(int eflag, int vflag)
       for (kk = jj+1; kk < numshort; kk++) {
         k = neighshort[kk];
         ktype = map[type[k]];
-        ikparam = elem3param[itype][ktype][ktype];
         ijkparam = elem3param[itype][jtype][ktype];
+        delr2 = geomshort[kk];
 
-        delr2[0] = x[k][0] - xtmp;
-        delr2[1] = x[k][1] - ytmp;
-        delr2[2] = x[k][2] - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
-                  rsq1,rsq2,delr1,delr2,fj,fk,eflag,evdwl);
+        threebody(&params[ijkparam],delr1,delr2,fj,fk,eflag,evdwl);
 
         fxtmp -= fj[0] + fk[0];
         fytmp -= fj[1] + fk[1];
@@ -231,6 +226,7 @@ void PairSW::allocate()
   memory->create(setflag, np1, np1, "pair:setflag");
   memory->create(cutsq, np1, np1, "pair:cutsq");
   memory->create(neighshort, maxshort, "pair:neighshort");
+  memory->create(geomshort, maxshort, NGEOM, "pair:geomshort");
   map = new int[np1];
 }
 
@@ -555,53 +551,38 @@ void PairSW::twobody(Param *param, double rsq, double &fforce,
 
 /* ---------------------------------------------------------------------- */
 
-void PairSW::threebody(Param *paramij, Param *paramik, Param *paramijk,
-                       double rsq1, double rsq2,
-                       double *delr1, double *delr2,
+void PairSW::threebody(Param *paramijk, double *geom1, double *geom2,
                        double *fj, double *fk, int eflag, double &eng)
 {
-  double r1,rinvsq1,rainv1,gsrainv1,gsrainvsq1,expgsrainv1;
-  double r2,rinvsq2,rainv2,gsrainv2,gsrainvsq2,expgsrainv2;
   double rinv12,cs,delcs,delcssq,facexp,facrad,frad1,frad2;
   double facang,facang12,csfacang,csfac1,csfac2;
 
-  r1 = sqrt(rsq1);
-  rinvsq1 = 1.0/rsq1;
-  rainv1 = 1.0/(r1 - paramij->cut);
-  gsrainv1 = paramij->sigma_gamma * rainv1;
-  gsrainvsq1 = gsrainv1*rainv1/r1;
-  expgsrainv1 = exp(gsrainv1);
-
-  r2 = sqrt(rsq2);
-  rinvsq2 = 1.0/rsq2;
-  rainv2 = 1.0/(r2 - paramik->cut);
-  gsrainv2 = paramik->sigma_gamma * rainv2;
-  gsrainvsq2 = gsrainv2*rainv2/r2;
-  expgsrainv2 = exp(gsrainv2);
-
-  rinv12 = 1.0/(r1*r2);
+  const double *delr1 = geom1;
+  const double *delr2 = geom2;
+
+  rinv12 = 1.0/(geom1[4]*geom2[4]);
   cs = (delr1[0]*delr2[0] + delr1[1]*delr2[1] + delr1[2]*delr2[2]) * rinv12;
   delcs = cs - paramijk->costheta;
   delcssq = delcs*delcs;
 
-  facexp = expgsrainv1*expgsrainv2;
+  facexp = geom1[7]*geom2[7];
 
   // facrad = sqrt(paramij->lambda_epsilon*paramik->lambda_epsilon) *
   //          facexp*delcssq;
 
   facrad = paramijk->lambda_epsilon * facexp*delcssq;
-  frad1 = facrad*gsrainvsq1;
-  frad2 = facrad*gsrainvsq2;
+  frad1 = facrad*geom1[6];
+  frad2 = facrad*geom2[6];
   facang = paramijk->lambda_epsilon2 * facexp*delcs;
   facang12 = rinv12*facang;
   csfacang = cs*facang;
-  csfac1 = rinvsq1*csfacang;
+  csfac1 = geom1[5]*csfacang;
 
   fj[0] = delr1[0]*(frad1+csfac1)-delr2[0]*facang12;
   fj[1] = delr1[1]*(frad1+csfac1)-delr2[1]*facang12;
   fj[2] = delr1[2]*(frad1+csfac1)-delr2[2]*facang12;
 
-  csfac2 = rinvsq2*csfacang;
+  csfac2 = geom2[5]*csfacang;
 
   fk[0] = delr2[0]*(frad2+csfac2)-delr1[0]*facang12;
   fk[1] = delr2[1]*(frad2+csfac2)-delr1[1]*facang12;
@@ -22,6 +22,8 @@ PairStyle(sw,PairSW);
 
 #include "pair.h"
 
+#include <cmath>
+
 namespace LAMMPS_NS {
 
 class PairSW : public Pair {
@@ -53,6 +55,7 @@ class PairSW : public Pair {
   Param *params;              // parameter set for an I-J-K interaction
   int maxshort;               // size of short neighbor list array
   int *neighshort;            // short neighbor list array
+  double **geomshort;         // cached I-J terms for each short neighbor
   int skip_threebody_flag;    // whether to run threebody loop
   int params_mapped;          // whether parameters have been read and mapped to elements
 
@@ -61,8 +64,28 @@ class PairSW : public Pair {
   virtual void read_file(char *);
   virtual void setup_params();
   void twobody(Param *, double, double &, int, double &);
-  virtual void threebody(Param *, Param *, Param *, double, double, double *, double *, double *,
-                         double *, int, double &);
+  virtual void threebody(Param *, double *, double *, double *, double *, int, double &);
+
+  // per short neighbor: del (3), rsq, r, 1/rsq, gsrainvsq, expgsrainv
+  // the radial three-body terms only depend on the I-J pair
+
+  static constexpr int NGEOM = 8;
+
+  inline void short_geom(const Param *param, double delx, double dely, double delz, double rsq,
+                         double *g) const
+  {
+    g[0] = -delx;
+    g[1] = -dely;
+    g[2] = -delz;
+    g[3] = rsq;
+    const double r = sqrt(rsq);
+    const double rainv = 1.0 / (r - param->cut);
+    const double gsrainv = param->sigma_gamma * rainv;
+    g[4] = r;
+    g[5] = 1.0 / rsq;
+    g[6] = gsrainv * rainv / r;
+    g[7] = exp(gsrainv);
+  }
 };
 
 }    // namespace LAMMPS_NS
@@ -57,6 +57,7 @@ PairTersoff::PairTersoff(LAMMPS *lmp) : Pair(lmp)
 
   maxshort = 10;
   neighshort = nullptr;
+  geomshort = nullptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -74,6 +75,7 @@ PairTersoff::~PairTersoff()
     memory->destroy(setflag);
     memory->destroy(cutsq);
     memory->destroy(neighshort);
+    memory->destroy(geomshort);
   }
 }
 
@@ -117,8 +119,8 @@ void PairTersoff::eval()
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
   double fforce;
   double rsq,rsq1,rsq2;
-  double delr1[3],delr2[3],fi[3],fj[3],fk[3];
-  double r1_hat[3],r2_hat[3];
+  double fi[3],fj[3],fk[3];
+  double *delr1,*delr2,*r1_hat,*r2_hat;
   double zeta_ij,prefactor;
   double forceshiftfac;
   int *ilist,*jlist,*numneigh,**firstneigh;
@@ -175,10 +177,12 @@ void PairTersoff::eval()
       }
 
       if (rsq < cutshortsq) {
+        short_geom(x[j][0] - xtmp,x[j][1] - ytmp,x[j][2] - ztmp,geomshort[numshort]);
         neighshort[numshort++] = j;
         if (numshort >= maxshort) {
           maxshort += maxshort/2;
           memory->grow(neighshort,maxshort,"pair:neighshort");
+          memory->grow(geomshort,maxshort,NGEOM,"pair:geomshort");
         }
       }
 
@@ -216,6 +220,7 @@ void PairTersoff::eval()
 
     // three-body interactions
     // skip immediately if I-J is not within cutoff
+    // geometry of I-J and I-K is taken from the short neighbor list
     double fjxtmp,fjytmp,fjztmp;
 
     for (jj = 0; jj < numshort; jj++) {
@@ -223,18 +228,12 @@ void PairTersoff::eval()
       jtype = map[type[j]];
       iparam_ij = elem3param[itype][jtype][jtype];
 
-      delr1[0] = x[j][0] - xtmp;
-      delr1[1] = x[j][1] - ytmp;
-      delr1[2] = x[j][2] - ztmp;
-      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
-
-      if (SHIFT_FLAG)
-        rsq1 += shift*shift + 2*sqrt(rsq1)*shift;
-
+      delr1 = geomshort[jj];
+      rsq1 = delr1[3];
       if (rsq1 >= params[iparam_ij].cutsq) continue;
 
-      const double r1inv = 1.0/sqrt(dot3(delr1, delr1));
-      scale3(r1inv, delr1, r1_hat);
+      const double r1inv = delr1[4];
+      r1_hat = &delr1[5];
 
       // accumulate bondorder zeta for each i-j interaction via loop over k
 
@@ -247,18 +246,11 @@ void PairTersoff::eval()
         ktype = map[type[k]];
         iparam_ijk = elem3param[itype][jtype][ktype];
 
-        delr2[0] = x[k][0] - xtmp;
-        delr2[1] = x[k][1] - ytmp;
-        delr2[2] = x[k][2] - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        if (SHIFT_FLAG)
-          rsq2 += shift*shift + 2*sqrt(rsq2)*shift;
-
+        delr2 = geomshort[kk];
+        rsq2 = delr2[3];
         if (rsq2 >= params[iparam_ijk].cutsq) continue;
 
-        double r2inv = 1.0/sqrt(dot3(delr2, delr2));
-        scale3(r2inv, delr2, r2_hat);
+        r2_hat = &delr2[5];
 
         zeta_ij += zeta(&params[iparam_ijk],rsq1,rsq2,r1_hat,r2_hat);
       }
@@ -287,18 +279,11 @@ void PairTersoff::eval()
         ktype = map[type[k]];
         iparam_ijk = elem3param[itype][jtype][ktype];
 
-        delr2[0] = x[k][0] - xtmp;
-        delr2[1] = x[k][1] - ytmp;
-        delr2[2] = x[k][2] - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        if (SHIFT_FLAG)
-          rsq2 += shift*shift + 2*sqrt(rsq2)*shift;
-
+        delr2 = geomshort[kk];
+        rsq2 = delr2[3];
         if (rsq2 >= params[iparam_ijk].cutsq) continue;
 
-        double r2inv = 1.0/sqrt(dot3(delr2, delr2));
-        scale3(r2inv, delr2, r2_hat);
+        r2_hat = &delr2[5];
 
         attractive(&params[iparam_ijk],prefactor,
                    rsq1,rsq2,r1_hat,r2_hat,fi,fj,fk);
@@ -337,6 +322,7 @@ void PairTersoff::allocate()
   memory->create(setflag,n+1,n+1,"pair:setflag");
   memory->create(cutsq,n+1,n+1,"pair:cutsq");
   memory->create(neighshort,maxshort,"pair:neighshort");
+  memory->create(geomshort,maxshort,NGEOM,"pair:geomshort");
   map = new int[n+1];
 }
 
@@ -22,6 +22,8 @@ PairStyle(tersoff,PairTersoff);
 
 #include "pair.h"
 
+#include <cmath>
+
 namespace LAMMPS_NS {
 
 class PairTersoff : public Pair {
@@ -60,6 +62,7 @@ class PairTersoff : public Pair {
   double cutmax;      // max cutoff for all elements
   int maxshort;       // size of short neighbor list array
   int *neighshort;    // short neighbor list array
+  double **geomshort; // cached I-J geometry for each short neighbor
 
   int shift_flag;    // flag to turn on/off shift
   double shift;      // negative change in equilibrium bond length
@@ -84,8 +87,27 @@ class PairTersoff : public Pair {
                                double *, double *, Param *);
   void costheta_d(double *, double, double *, double, double *, double *, double *);
 
+  // per short neighbor: del (3), shifted rsq, 1/r, unit vector (3)
+
+  static constexpr int NGEOM = 8;
+
   // inlined functions for efficiency
 
+  inline void short_geom(double delx, double dely, double delz, double *g) const
+  {
+    g[0] = delx;
+    g[1] = dely;
+    g[2] = delz;
+    double rsq = delx * delx + dely * dely + delz * delz;
+    const double rinv = 1.0 / sqrt(rsq);
+    if (shift_flag) rsq += shift * shift + 2 * sqrt(rsq) * shift;
+    g[3] = rsq;
+    g[4] = rinv;
+    g[5] = rinv * delx;
+    g[6] = rinv * dely;
+    g[7] = rinv * delz;
+  }
+
   inline double ters_gijk(const double costheta, const Param *const param) const
   {
     const double ters_c = param->c * param->c;
@@ -33,6 +33,8 @@
 #include "kspace.h"
 #include "memory.h"
 #include "modify.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
 #include "neighbor.h"
 #include "pair.h"
 #include "random_park.h"
@@ -51,7 +53,7 @@ using namespace FixConst;
 
 FixAtomSwap::FixAtomSwap(LAMMPS *lmp, int narg, char **arg) :
     Fix(lmp, narg, arg), region(nullptr), idregion(nullptr), type_list(nullptr), mu(nullptr),
-    qtype(nullptr), sqrt_mass_ratio(nullptr), local_swap_iatom_list(nullptr),
+    list(nullptr), qtype(nullptr), sqrt_mass_ratio(nullptr), local_swap_iatom_list(nullptr),
     local_swap_jatom_list(nullptr), local_swap_atom_list(nullptr), random_equal(nullptr),
     random_unequal(nullptr), c_pe(nullptr)
 {
@@ -294,6 +296,26 @@ void FixAtomSwap::init()
 
     if (flagall) error->all(FLERR, "Cannot do atom/swap on atoms in atom_modify first group");
   }
+
+  // if the pair style can compute the energy of atoms near a swapped atom,
+  //   and nothing else contributes to the energy, only those atoms are recomputed
+  // requires an occasional full neighbor list
+
+  local_flag = 0;
+  Pair *pair = force->pair;
+  if (pair && pair->local_energy_enable && !pair->tail_flag && !force->kspace &&
+      (atom->molecular == Atom::ATOMIC) && !modify->n_energy_global && !modify->n_pre_force &&
+      !unequal_cutoffs)
+    local_flag = 1;
+
+  if (local_flag) neighbor->add_request(this, NeighConst::REQ_FULL | NeighConst::REQ_OCCASIONAL);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixAtomSwap::init_list(int /*id*/, NeighList *ptr)
+{
+  list = ptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -317,6 +339,7 @@ void FixAtomSwap::pre_exchange()
   if (domain->triclinic) domain->lamda2x(atom->nlocal + atom->nghost);
   if (modify->n_pre_neighbor) modify->pre_neighbor();
   neighbor->build(1);
+  if (local_flag) neighbor->build_one(list, 1);
 
   // energy_stored = energy of current state
   // will be updated after accepted swaps
@@ -362,6 +385,15 @@ int FixAtomSwap::attempt_semi_grand()
 
   int itype, jtype, jswaptype;
   int i = pick_semi_grand_atom();
+
+  // energy of atoms around the swapped atom before the swap
+
+  double energy_site = 0.0;
+  if (local_flag) {
+    set_sites(i, -1);
+    energy_site = energy_local();
+  }
+
   if (i >= 0) {
     jswaptype = static_cast<int>(nswaptypes * random_unequal->uniform());
     jtype = type_list[jswaptype];
@@ -391,7 +423,11 @@ int FixAtomSwap::attempt_semi_grand()
   // post-swap energy
 
   if (force->kspace) force->kspace->qsum_qsq();
-  double energy_after = energy_full();
+  double energy_after;
+  if (local_flag)
+    energy_after = energy_before + energy_local() - energy_site;
+  else
+    energy_after = energy_full();
 
   int success = 0;
   if (i >= 0)
@@ -425,6 +461,10 @@ int FixAtomSwap::attempt_semi_grand()
   if (i >= 0) atom->type[i] = itype;
   if (force->kspace) force->kspace->qsum_qsq();
 
+  // ghost atoms must be current for the next local energy
+
+  if (local_flag) comm->forward_comm(this);
+
   return 0;
 }
 
@@ -449,6 +489,14 @@ int FixAtomSwap::attempt_swap()
   int itype = type_list[0];
   int jtype = type_list[1];
 
+  // energy of atoms around the swapped atoms before the swap
+
+  double energy_site = 0.0;
+  if (local_flag) {
+    set_sites(i, j);
+    energy_site = energy_local();
+  }
+
   if (i >= 0) {
     atom->type[i] = jtype;
     if (atom->q_flag) atom->q[i] = qtype[1];
@@ -476,7 +524,11 @@ int FixAtomSwap::attempt_swap()
 
   // post-swap energy
 
-  double energy_after = energy_full();
+  double energy_after;
+  if (local_flag)
+    energy_after = energy_before + energy_local() - energy_site;
+  else
+    energy_after = energy_full();
 
   // swap accepted, return 1
   // if ke_flag, rescale atom velocities
@@ -513,6 +565,10 @@ int FixAtomSwap::attempt_swap()
     if (atom->q_flag) atom->q[j] = qtype[1];
   }
 
+  // ghost atoms must be current for the next local energy
+
+  if (local_flag) comm->forward_comm(this);
+
   return 0;
 }
 
@@ -546,6 +602,45 @@ double FixAtomSwap::energy_full()
   return total_energy;
 }
 
+/* ----------------------------------------------------------------------
+   set coords of swapped atoms i and j on all procs
+   i,j = -1 if not owned by this proc, j is not used by semi-grand swaps
+------------------------------------------------------------------------- */
+
+void FixAtomSwap::set_sites(int i, int j)
+{
+  double **x = atom->x;
+  double xone[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+  if (i >= 0) {
+    xone[0] = x[i][0];
+    xone[1] = x[i][1];
+    xone[2] = x[i][2];
+  }
+  if (j >= 0) {
+    xone[3] = x[j][0];
+    xone[4] = x[j][1];
+    xone[5] = x[j][2];
+  }
+
+  nsite = semi_grand_flag ? 1 : 2;
+  MPI_Allreduce(xone, xsite, 3 * nsite, MPI_DOUBLE, MPI_SUM, world);
+}
+
+/* ----------------------------------------------------------------------
+   compute energy of atoms within the pair cutoff of the swapped atoms
+   the difference before and after a swap is the change in system energy
+------------------------------------------------------------------------- */
+
+double FixAtomSwap::energy_local()
+{
+  Pair *pair = force->pair;
+  double energy_one = pair->energy_local(pair->local_energy_list(list, nsite, xsite), nullptr);
+  double energy_all;
+  MPI_Allreduce(&energy_one, &energy_all, 1, MPI_DOUBLE, MPI_SUM, world);
+  return energy_all;
+}
+
 /* ----------------------------------------------------------------------
 ------------------------------------------------------------------------- */
 
@@ -834,5 +929,9 @@ void *FixAtomSwap::extract(const char *name, int &dim)
     dim = 0;
     return (void *) &mc_active;
   }
+  if (strcmp(name,"energy_stored") == 0) {
+    dim = 0;
+    return (void *) &energy_stored;
+  }
   return nullptr;
 }
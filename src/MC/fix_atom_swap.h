@@ -30,6 +30,7 @@ class FixAtomSwap : public Fix {
   ~FixAtomSwap() override;
   int setmask() override;
   void init() override;
+  void init_list(int, class NeighList *) override;
   void pre_exchange() override;
   int pack_forward_comm(int, int *, double *, int, int *) override;
   void unpack_forward_comm(int, int, double *) override;
@@ -64,6 +65,11 @@ class FixAtomSwap : public Fix {
 
   bool unequal_cutoffs;
 
+  int local_flag;            // 1 if energy changes are computed locally by pair style
+  class NeighList *list;     // full neighbor list for pair->energy_local()
+  int nsite;                 // # of swapped atoms
+  double xsite[6];           // coords of swapped atoms
+
   int atom_swap_nmax;
   double beta;
   double *qtype;
@@ -82,6 +88,8 @@ class FixAtomSwap : public Fix {
   int attempt_semi_grand();
   int attempt_swap();
   double energy_full();
+  void set_sites(int, int);
+  double energy_local();
   int pick_semi_grand_atom();
   int pick_i_swap_atom();
   int pick_j_swap_atom();
@@ -37,6 +37,8 @@
 #include "memory.h"
 #include "modify.h"
 #include "molecule.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
 #include "neighbor.h"
 #include "pair.h"
 #include "random_park.h"
@@ -67,7 +69,7 @@ enum { NONE, MOVEATOM, MOVEMOL };    // movemode
 /* ---------------------------------------------------------------------- */
 
 FixGCMC::FixGCMC(LAMMPS *lmp, int narg, char **arg) :
-    Fix(lmp, narg, arg), region(nullptr), idregion(nullptr), full_flag(false),
+    Fix(lmp, narg, arg), region(nullptr), idregion(nullptr), full_flag(false), list(nullptr),
     groupstrings(nullptr), grouptypestrings(nullptr), grouptypebits(nullptr), grouptypes(nullptr),
     local_gas_list(nullptr), molcoords(nullptr), molq(nullptr), molimage(nullptr),
     random_equal(nullptr), random_unequal(nullptr), fixrigid(nullptr), fixshake(nullptr),
@@ -729,6 +731,26 @@ void FixGCMC::init()
     error->all(FLERR,"fix gcmc does currently not support full_energy "
                "option with molecule MC moves on more than 1 MPI process.");
 
+  // with full_energy and atom moves, if the pair style can compute
+  //   the energy of atoms near a changed position,
+  //   and nothing else contributes to the energy, only those atoms are recomputed
+  // requires an occasional full neighbor list
+
+  local_flag = 0;
+  if (full_flag && force->pair && force->pair->local_energy_enable &&
+      !force->pair->tail_flag && !force->kspace && (atom->molecular == Atom::ATOMIC) &&
+      (exchmode == EXCHATOM) && (movemode != MOVEMOL) && !overlap_flag &&
+      !modify->n_energy_global && !modify->n_pre_force)
+    local_flag = 1;
+
+  if (local_flag) neighbor->add_request(this, NeighConst::REQ_FULL | NeighConst::REQ_OCCASIONAL);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixGCMC::init_list(int /*id*/, NeighList *ptr)
+{
+  list = ptr;
 }
 
 /* ----------------------------------------------------------------------
@@ -772,6 +794,7 @@ void FixGCMC::pre_exchange()
 
   if (full_flag) {
     energy_stored = energy_full();
+    if (local_flag) neighbor->build_one(list,1);
     if (overlap_flag && energy_stored > MAXENERGYTEST)
         error->warning(FLERR,"Energy of old configuration in "
                        "fix gcmc is > MAXENERGYTEST.");
@@ -1511,13 +1534,13 @@ void FixGCMC::attempt_atomic_translation_full()
   xtmp[0] = xtmp[1] = xtmp[2] = 0.0;
 
   tagint tmptag = -1;
+  double coord[3];
 
   if (i >= 0) {
 
     double rsq = 1.1;
     double rx,ry,rz;
     rx = ry = rz = 0.0;
-    double coord[3];
     while (rsq > 1.0) {
       rx = 2*random_unequal->uniform() - 1.0;
       ry = 2*random_unequal->uniform() - 1.0;
@@ -1546,14 +1569,33 @@ void FixGCMC::attempt_atomic_translation_full()
     xtmp[0] = x[i][0];
     xtmp[1] = x[i][1];
     xtmp[2] = x[i][2];
+    tmptag = atom->tag[i];
+  }
+
+  // energy of atoms around the old and new position before the move
+
+  double energy_site = 0.0;
+  if (local_flag) {
+    double xone[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    if (i >= 0) {
+      memcpy(&xone[0],xtmp,3*sizeof(double));
+      memcpy(&xone[3],coord,3*sizeof(double));
+    }
+    set_sites(2,xone);
+    energy_site = energy_local();
+  }
+
+  if (i >= 0) {
     x[i][0] = coord[0];
     x[i][1] = coord[1];
     x[i][2] = coord[2];
-
-    tmptag = atom->tag[i];
   }
 
-  double energy_after = energy_full();
+  double energy_after;
+  if (local_flag) {
+    rebuild_local();
+    energy_after = energy_before + energy_local() - energy_site;
+  } else energy_after = energy_full();
 
   if (energy_after < MAXENERGYTEST &&
       random_equal->uniform() <
@@ -1575,6 +1617,7 @@ void FixGCMC::attempt_atomic_translation_full()
         x[i][2] = xtmp_all[2];
       }
     }
+    if (local_flag) rebuild_local();
     energy_stored = energy_before;
   }
   update_gas_atoms_list();
@@ -1596,6 +1639,16 @@ void FixGCMC::attempt_atomic_deletion_full()
 
   const int i = pick_random_gas_atom();
 
+  // energy of atoms around the deleted atom before the deletion
+
+  double energy_site = 0.0;
+  if (local_flag) {
+    double xone[3] = {0.0, 0.0, 0.0};
+    if (i >= 0) memcpy(xone,atom->x[i],3*sizeof(double));
+    set_sites(1,xone);
+    energy_site = energy_local();
+  }
+
   int tmpmask;
   if (i >= 0) {
     tmpmask = atom->mask[i];
@@ -1607,7 +1660,11 @@ void FixGCMC::attempt_atomic_deletion_full()
   }
   if (force->kspace) force->kspace->qsum_qsq();
   if (force->pair->tail_flag) force->pair->reinit();
-  double energy_after = energy_full();
+  double energy_after;
+  if (local_flag) {
+    rebuild_local();
+    energy_after = energy_before + energy_local() - energy_site;
+  } else energy_after = energy_full();
 
   if (random_equal->uniform() <
       ngas*exp(beta*(energy_before - energy_after))/(zz*volume)) {
@@ -1628,6 +1685,7 @@ void FixGCMC::attempt_atomic_deletion_full()
     if (force->pair->tail_flag) force->pair->reinit();
     energy_stored = energy_before;
   }
+  if (local_flag) rebuild_local();
   update_gas_atoms_list();
 }
 
@@ -1691,6 +1749,16 @@ void FixGCMC::attempt_atomic_insertion_full()
         lamda[2] >= sublo[2] && lamda[2] < subhi[2]) proc_flag = 1;
   }
 
+  // energy of atoms around the new position before the insertion
+  // coord is the same on all procs
+
+  double energy_site = 0.0;
+  if (local_flag) {
+    nsite = 1;
+    memcpy(xsite,coord,3*sizeof(double));
+    energy_site = energy_local();
+  }
+
   if (proc_flag) {
     atom->avec->create_atom(ngcmc_type,coord);
     int m = atom->nlocal - 1;
@@ -1722,7 +1790,11 @@ void FixGCMC::attempt_atomic_insertion_full()
   if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
   if (force->kspace) force->kspace->qsum_qsq();
   if (force->pair->tail_flag) force->pair->reinit();
-  double energy_after = energy_full();
+  double energy_after;
+  if (local_flag) {
+    rebuild_local();
+    energy_after = energy_before + energy_local() - energy_site;
+  } else energy_after = energy_full();
 
   if (energy_after < MAXENERGYTEST &&
       random_equal->uniform() <
@@ -1735,6 +1807,7 @@ void FixGCMC::attempt_atomic_insertion_full()
     if (proc_flag) atom->nlocal--;
     if (force->kspace) force->kspace->qsum_qsq();
     if (force->pair->tail_flag) force->pair->reinit();
+    if (local_flag) rebuild_local();
     energy_stored = energy_before;
   }
   update_gas_atoms_list();
@@ -2371,6 +2444,50 @@ double FixGCMC::energy_full()
   return total_energy;
 }
 
+/* ----------------------------------------------------------------------
+   set changed positions on all procs
+   xone = positions on the proc that owns the changed atom, else zero
+------------------------------------------------------------------------- */
+
+void FixGCMC::set_sites(int n, double *xone)
+{
+  nsite = n;
+  MPI_Allreduce(xone,xsite,3*nsite,MPI_DOUBLE,MPI_SUM,world);
+}
+
+/* ----------------------------------------------------------------------
+   compute energy of atoms within the pair cutoff of the changed positions
+   the difference before and after a move is the change in system energy
+   neighbor list must be current
+------------------------------------------------------------------------- */
+
+double FixGCMC::energy_local()
+{
+  Pair *pair = force->pair;
+  double energy_one = pair->energy_local(pair->local_energy_list(list,nsite,xsite),nullptr);
+  double energy_all;
+  MPI_Allreduce(&energy_one,&energy_all,1,MPI_DOUBLE,MPI_SUM,world);
+  return energy_all;
+}
+
+/* ----------------------------------------------------------------------
+   update ghost atoms and neighbor lists after a change of the system
+   same as energy_full() but without computing the energy
+------------------------------------------------------------------------- */
+
+void FixGCMC::rebuild_local()
+{
+  if (triclinic) domain->x2lamda(atom->nlocal);
+  domain->pbc();
+  comm->exchange();
+  atom->nghost = 0;
+  comm->borders();
+  if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
+  if (modify->n_pre_neighbor) modify->pre_neighbor();
+  neighbor->build(1);
+  neighbor->build_one(list,1);
+}
+
 /* ----------------------------------------------------------------------
 ------------------------------------------------------------------------- */
 
@@ -2629,5 +2746,9 @@ void *FixGCMC::extract(const char *name, int &dim)
     dim = 0;
     return (void *) &exclusion_group;
   }
+  if (strcmp(name,"energy_stored") == 0) {
+    dim = 0;
+    return (void *) &energy_stored;
+  }
   return nullptr;
 }
@@ -30,6 +30,7 @@ class FixGCMC : public Fix {
   ~FixGCMC() override;
   int setmask() override;
   void init() override;
+  void init_list(int, class NeighList *) override;
   void pre_exchange() override;
   double compute_vector(int) override;
   double memory_usage() override;
@@ -54,6 +55,10 @@ class FixGCMC : public Fix {
   bool pressure_flag;      // true if user specified reservoir pressure
   bool charge_flag;        // true if user specified atomic charge
   bool full_flag;          // true if doing full system energy calculations
+  int local_flag;          // 1 if full energy changes are computed locally by pair style
+  class NeighList *list;   // full neighbor list for pair->energy_local()
+  int nsite;               // # of changed positions
+  double xsite[6];         // changed positions
 
   int natoms_per_molecule;    // number of atoms in each inserted molecule
   int nmaxmolatoms;           // number of atoms allocated for molecule arrays
@@ -141,6 +146,9 @@ class FixGCMC : public Fix {
 
   double energy(int, int, tagint, double *);
   double energy_full();
+  void set_sites(int, double *);
+  double energy_local();
+  void rebuild_local();
   double molecule_energy(tagint);
 
   int pick_random_gas_atom();
@@ -60,7 +60,7 @@ using namespace FixConst;
  *********************************************************************/
 FixSemiGrandCanonicalMC::FixSemiGrandCanonicalMC(LAMMPS *_lmp, int narg, char **arg) :
     Fix(_lmp, narg, arg), random(nullptr), localRandom(nullptr), neighborList(nullptr),
-    pairEAM(nullptr), compute_pe(nullptr)
+    pairEAM(nullptr), pairLocal(nullptr), compute_pe(nullptr)
 {
   scalar_flag = 0;
   vector_flag = 1;
@@ -82,6 +82,7 @@ FixSemiGrandCanonicalMC::FixSemiGrandCanonicalMC(LAMMPS *_lmp, int narg, char **
   samplingWindowPosition = 5;
   nAcceptedSwaps = 0;
   nRejectedSwaps = 0;
+  deltaEnergy = 0.0;
   kappa = 0;
   serialMode = false;
 
@@ -241,9 +242,31 @@ void FixSemiGrandCanonicalMC::init()
     if (strcmp(modify->fix[i]->style,"sgcmc") == 0) count++;
   if (count > 1) error->all(FLERR, "More than one fix sgcmc defined.");
 
+  interactionRadius = force->pair->cutforce;
+  if (comm->me == 0) utils::logmesg(lmp, "  SGC - Interaction radius: {}\n", interactionRadius);
+
   // Save a pointer to the EAM potential.
   pairEAM = dynamic_cast<PairEAM*>(force->pair);
-  if (!pairEAM) {
+
+  // Otherwise use a potential that can compute the energies of the atoms near the swapped atom.
+  pairLocal = nullptr;
+  if (!pairEAM && force->pair->local_energy_enable && !force->pair->tail_flag && !force->kspace &&
+      (atom->molecular == Atom::ATOMIC) && (modify->n_energy_global == 0)) {
+    pairLocal = force->pair;
+    if (comm->me == 0)
+      utils::logmesg(lmp, "  SGC - Using local energy calculation of pair style {}\n", force->pair_style);
+
+    // The energies of ghost atoms near the sampling window depend on their own neighbors.
+    // So ghost atoms are needed up to two interaction radii from the processor cell.
+    double cutghost = 2.0 * interactionRadius + neighbor->skin;
+    if (comm->cutghostuser < cutghost) {
+      comm->cutghostuser = cutghost;
+      if (comm->me == 0)
+        error->warning(FLERR, "Increasing communication cutoff to {:.8} for fix sgcmc", cutghost);
+    }
+  }
+
+  if (!pairEAM && !pairLocal) {
     if (comm->me == 0)
       utils::logmesg(lmp, "  SGC - Using naive total energy calculation for MC -> SLOW!\n");
 
@@ -256,11 +279,13 @@ void FixSemiGrandCanonicalMC::init()
     int ipe = modify->find_compute(id_pe);
     compute_pe = modify->compute[ipe];
   }
-  interactionRadius = force->pair->cutforce;
-  if (comm->me == 0) utils::logmesg(lmp, "  SGC - Interaction radius: {}\n", interactionRadius);
 
-  // This fix needs a full neighbor list.
-  neighbor->add_request(this, NeighConst::REQ_FULL);
+  // This fix needs a full neighbor list, which includes the neighbors of ghost atoms
+  // if the energies of ghost atoms are computed.
+  if (pairLocal)
+    neighbor->add_request(this, NeighConst::REQ_FULL | NeighConst::REQ_GHOST);
+  else
+    neighbor->add_request(this, NeighConst::REQ_FULL);
 
   // Count local number of atoms from each species.
   const int *type = atom->type;
@@ -303,6 +328,14 @@ void FixSemiGrandCanonicalMC::doMC()
   // Allocate array memory.
   changedAtoms.resize(atom->nmax);
 
+  // Atom positions have changed since the last MC step, so all stored energies are out of date.
+  if (pairLocal) {
+    atomEnergies.resize(atom->nmax);
+    trialEnergies.resize(atom->nmax);
+    validEnergies.resize(atom->nmax);
+    std::fill(validEnergies.begin(), validEnergies.end(), false);
+  }
+
   // During the last MD timestep the EAM potential routine has computed the
   // electron densities for all atoms that belong to this processor.
   // They are stored in the rho array of the PairEAM class.
@@ -316,6 +349,7 @@ void FixSemiGrandCanonicalMC::doMC()
   // Reset counters.
   int nAcceptedSwapsLocal = 0;
   int nRejectedSwapsLocal = 0;
+  double deltaEnergyLocal = 0.0;
 
   int oldSpecies, newSpecies;
   std::vector<int> deltaN(atom->ntypes+1, 0);         //< Local change in number of atoms of each species.
@@ -381,6 +415,8 @@ void FixSemiGrandCanonicalMC::doMC()
         // Compute the energy difference that swapping this atom would cost or gain.
         if (pairEAM) {
           deltaE = computeEnergyChangeEAM(selectedAtom, selectedAtomNL, oldSpecies, newSpecies);
+        } else if (pairLocal) {
+          deltaE = computeEnergyChangeLocal(selectedAtom, selectedAtomNL, oldSpecies, newSpecies);
         } else {
           // Generic case:
           deltaE = computeEnergyChangeGeneric(selectedAtom, oldSpecies, newSpecies);
@@ -444,9 +480,12 @@ void FixSemiGrandCanonicalMC::doMC()
       if (selectedAtom >= 0) {
         if (pairEAM)
           flipAtomEAM(selectedAtom, selectedAtomNL, oldSpecies, newSpecies);
+        else if (pairLocal)
+          flipAtomLocal(selectedAtom, oldSpecies, newSpecies);
         else
           flipAtomGeneric(selectedAtom, oldSpecies, newSpecies);
         nAcceptedSwapsLocal++;
+        deltaEnergyLocal += deltaE;
       }
       else {
         nRejectedSwapsLocal++;
@@ -469,6 +508,7 @@ void FixSemiGrandCanonicalMC::doMC()
   // MPI sum total number of accepted/rejected swaps.
   MPI_Allreduce(&nAcceptedSwapsLocal, &nAcceptedSwaps, 1, MPI_INT, MPI_SUM, world);
   MPI_Allreduce(&nRejectedSwapsLocal, &nRejectedSwaps, 1, MPI_INT, MPI_SUM, world);
+  MPI_Allreduce(&deltaEnergyLocal, &deltaEnergy, 1, MPI_DOUBLE, MPI_SUM, world);
 
   // For (parallelized) semi-grandcanonical MC we have to determine the current concentrations now.
   // For the serial version and variance-constrained MC it has already been done in the loop.
@@ -516,6 +556,10 @@ void FixSemiGrandCanonicalMC::communicateRhoAndTypes()
   // Transfer changed atom types and electron densities of the real atoms to the ghost atoms.
   communicationStage = 3;
   comm->forward_comm(this);
+
+  // Atom types changed by other processors make stored energies near the processor border invalid.
+  if (pairLocal)
+    std::fill(validEnergies.begin(), validEnergies.end(), false);
 }
 
 /*********************************************************************
@@ -803,6 +847,80 @@ double FixSemiGrandCanonicalMC::computeEnergyChangeEAM(int flipAtom, int flipAto
   return deltaE;
 }
 
+/*********************************************************************
+ * Calculates the change in energy that swapping the given
+ * atom would produce. This routine is for potentials that can
+ * compute the energies of a subset of atoms, e.g. SNAP or MLIAP.
+ * Only the swapped atom and its neighbors within the interaction
+ * radius change their energy. Their energies for the current types
+ * are reused from earlier trial moves where possible.
+ *
+ * Parameters:
+ *
+ * flipAtom [in]
+ *   This specifies the atom to be swapped. It's an index into the local list of atoms.
+ *
+ * flipAtomNL [in]
+ *   This specifies the atom to be swapped. It's an index into the neighbor list.
+ *
+ * oldSpecies [in]
+ *   The current species of the atom before the routine is called.
+ *
+ * newSpecies [in]
+ *   The new species of the atom. The atom's type is not changed by this routine. It only computes the induced energy change.
+ *
+ * Return value:
+ *   The expected change in total potential energy.
+ *********************************************************************/
+double FixSemiGrandCanonicalMC::computeEnergyChangeLocal(int flipAtom, int flipAtomNL, int oldSpecies, int newSpecies)
+{
+  double **x = atom->x;
+  const double cutforcesq = interactionRadius * interactionRadius;
+  const double xi = x[flipAtom][0];
+  const double yi = x[flipAtom][1];
+  const double zi = x[flipAtom][2];
+
+  // Collect the atoms whose energy depends on the type of the swapped atom.
+  localAtoms.resize(0);
+  localAtoms.push_back(flipAtom);
+  int* jlist = neighborList->firstneigh[flipAtomNL];
+  int jnum = neighborList->numneigh[flipAtomNL];
+  for (int jj = 0; jj < jnum; jj++) {
+    int j = jlist[jj] & NEIGHMASK;
+
+    double delx = xi - x[j][0];
+    double dely = yi - x[j][1];
+    double delz = zi - x[j][2];
+    double rsq = delx*delx + dely*dely + delz*delz;
+    if (rsq < cutforcesq) localAtoms.push_back(j);
+  }
+
+  // Energy before the swap. Use the stored energies if all of them are up to date.
+  double oldEnergy = 0.0;
+  bool valid = true;
+  for (int i : localAtoms) {
+    if (!validEnergies[i]) {
+      valid = false;
+      break;
+    }
+    oldEnergy += atomEnergies[i];
+  }
+
+  if (!valid) {
+    NeighList *sub = pairLocal->local_energy_list(neighborList, localAtoms.size(), localAtoms.data());
+    oldEnergy = pairLocal->energy_local(sub, atomEnergies.data());
+    for (int i : localAtoms) validEnergies[i] = true;
+  }
+
+  // Energy after the swap. The energies per atom are kept for flipAtomLocal().
+  atom->type[flipAtom] = newSpecies;
+  NeighList *sub = pairLocal->local_energy_list(neighborList, localAtoms.size(), localAtoms.data());
+  double newEnergy = pairLocal->energy_local(sub, trialEnergies.data());
+  atom->type[flipAtom] = oldSpecies;
+
+  return newEnergy - oldEnergy;
+}
+
 /*********************************************************************
  * Calculates the change in energy that swapping the given atom would produce.
  * This routine is for the general case of an arbitrary potential and
@@ -964,6 +1082,31 @@ void FixSemiGrandCanonicalMC::flipAtomEAM(int flipAtom, int flipAtomNL, int oldS
   rho[flipAtom] = new_total_rho_i;
 }
 
+/*********************************************************************
+ * Flips the type of one atom and stores the energies of the
+ * atoms near it, which computeEnergyChangeLocal() has computed
+ * for the new type of the atom.
+ * This routine is for potentials that can compute the energies
+ * of a subset of atoms.
+ *
+ * Parameters:
+ *
+ * flipAtom [in]
+ *   This specifies the atom to be swapped. It's an index into the local list of atoms.
+ *
+ * oldSpecies [in]
+ *   The current species of the atom before the routine is called.
+ *
+ * newSpecies [in]
+ *   The new type to be assigned to the atom.
+ *********************************************************************/
+void FixSemiGrandCanonicalMC::flipAtomLocal(int flipAtom, int oldSpecies, int newSpecies)
+{
+  flipAtomGeneric(flipAtom, oldSpecies, newSpecies);
+
+  for (int i : localAtoms) atomEnergies[i] = trialEnergies[i];
+}
+
 /*********************************************************************
  * Flips the type of one atom.
  * This routine is for the generic case.
@@ -1008,12 +1151,26 @@ double FixSemiGrandCanonicalMC::compute_vector(int index)
   return 0.0;
 }
 
+/*********************************************************************
+ * Gives access to internal data of this fix.
+ *********************************************************************/
+void *FixSemiGrandCanonicalMC::extract(const char *name, int &dim)
+{
+  if (strcmp(name, "delta_energy") == 0) {
+    dim = 0;
+    return (void *) &deltaEnergy;
+  }
+  return nullptr;
+}
+
 /*********************************************************************
  * Reports the memory usage of this fix to LAMMPS.
  *********************************************************************/
 double FixSemiGrandCanonicalMC::memory_usage()
 {
   return (changedAtoms.size() * sizeof(bool)) +
-    (samplingWindowAtoms.size() * sizeof(int));
+    (samplingWindowAtoms.size() * sizeof(int)) +
+    ((atomEnergies.size() + trialEnergies.size()) * sizeof(double)) +
+    (validEnergies.size() * sizeof(bool)) + (localAtoms.capacity() * sizeof(int));
 }
 
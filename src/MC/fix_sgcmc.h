@@ -45,6 +45,7 @@ class FixSemiGrandCanonicalMC : public Fix {
   void init_list(int id, class NeighList *ptr) override;
   void post_force(int vflag) override;
   double compute_vector(int index) override;
+  void *extract(const char *name, int &dim) override;
 
   int pack_forward_comm(int n, int *list, double *buf, int pbc_flag, int *pbc) override;
   void unpack_forward_comm(int n, int first, double *buf) override;
@@ -68,6 +69,10 @@ class FixSemiGrandCanonicalMC : public Fix {
   // This routine is for the case of a standard EAM potential.
   double computeEnergyChangeEAM(int flipAtom, int flipAtomNL, int oldSpecies, int newSpecies);
 
+  // Calculates the change in energy that swapping the given atom would produce.
+  // This routine is for potentials that can compute the energies of a subset of atoms.
+  double computeEnergyChangeLocal(int flipAtom, int flipAtomNL, int oldSpecies, int newSpecies);
+
   // Calculates the change in energy that swapping the given atom would produce.
   // This routine is for the general case of an arbitrary potential and
   // IS VERY SLOW! It computes the total energies of the system for the unmodified state
@@ -82,6 +87,10 @@ class FixSemiGrandCanonicalMC : public Fix {
   // This routine is for the case of a standard EAM potential.
   void flipAtomEAM(int flipAtom, int flipAtomNL, int oldSpecies, int newSpecies);
 
+  // Flips the type of one atom and stores the new energies of nearby atoms.
+  // This routine is for potentials that can compute the energies of a subset of atoms.
+  void flipAtomLocal(int flipAtom, int oldSpecies, int newSpecies);
+
   // Flips the type of one atom.
   // This routine is for the generic case.
   void flipAtomGeneric(int flipAtom, int oldSpecies, int newSpecies);
@@ -169,6 +178,20 @@ class FixSemiGrandCanonicalMC : public Fix {
   // the electron density or another property at that site has been affected by one of the accepted MC swaps.
   std::vector<bool> changedAtoms;
 
+  // Pointer to a potential that can compute the energies of a subset of atoms, if it is not EAM.
+  // The full neighbor list then also contains the neighbors of ghost atoms.
+  class Pair *pairLocal;
+
+  // The atoms whose energy is changed by the current trial move: the swapped atom and its
+  // neighbors within the interaction radius.
+  std::vector<int> localAtoms;
+
+  // Energy per atom (real and ghosts) for the current atom types and the current trial move.
+  // Energies are reused while the types of all atoms within the interaction radius are unchanged.
+  std::vector<double> atomEnergies;
+  std::vector<double> trialEnergies;
+  std::vector<bool> validEnergies;
+
   // This counter indicates the current MPI communication stage to let the
   // pack/unpack routines know which data is being transmitted.
   int communicationStage;
@@ -179,6 +202,9 @@ class FixSemiGrandCanonicalMC : public Fix {
   // The total number of rejected swaps during the last MC step.
   int nRejectedSwaps;
 
+  // The total change of potential energy by the accepted swaps during the last MC step.
+  double deltaEnergy;
+
   // A compute used to compute the total potential energy of the system.
   class Compute *compute_pe;
 };
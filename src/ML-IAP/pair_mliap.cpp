@@ -49,6 +49,7 @@ PairMLIAP::PairMLIAP(LAMMPS *lmp) :
   restartinfo = 0;
   one_coeff = 1;
   manybody_flag = 1;
+  local_energy_enable = 1;
   is_child = false;
   centroidstressflag = CENTROID_NOTAVAIL;
   model=nullptr;
@@ -112,6 +113,24 @@ void PairMLIAP::compute(int eflag, int vflag)
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
+/* ----------------------------------------------------------------------
+   energy of the atoms in a list from local_energy_list()
+   descriptors and model energies only for those atoms, from a full list
+   if eone is set, also store energy of each of the atoms
+------------------------------------------------------------------------- */
+
+double PairMLIAP::energy_local(NeighList *sub, double *eone)
+{
+  data->generate_neighdata(sub, 1, 0);
+  descriptor->compute_descriptors(data);
+  model->compute_gradients(data);
+
+  if (eone)
+    for (int ii = 0; ii < data->nlistatoms; ii++) eone[data->iatoms[ii]] = data->eatoms[ii];
+
+  return data->energy;
+}
+
 /* ----------------------------------------------------------------------
    allocate all arrays
 ------------------------------------------------------------------------- */
@@ -29,6 +29,7 @@ class PairMLIAP : public Pair {
   PairMLIAP(class LAMMPS *);
   ~PairMLIAP() override;
   void compute(int, int) override;
+  double energy_local(class NeighList *, double *) override;
   void settings(int, char **) override;
   void coeff(int, char **) override;
   void e_tally(class MLIAPData *);
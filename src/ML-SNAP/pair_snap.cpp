@@ -40,6 +40,7 @@ PairSNAP::PairSNAP(LAMMPS *lmp) : Pair(lmp)
   restartinfo = 0;
   one_coeff = 1;
   manybody_flag = 1;
+  local_energy_enable = 1;
   centroidstressflag = CENTROID_NOTAVAIL;
 
   radelem = nullptr;
@@ -202,40 +203,80 @@ void PairSNAP::compute(int eflag, int vflag)
     // tally energy contribution
 
     if (eflag) {
+      evdwl = atom_energy(ii,ielem)*scale[itype][itype];
+      ev_tally_full(i,2.0*evdwl,0.0,0.0,0.0,0.0,0.0);
+    }
+
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
 
-      // evdwl = energy of atom I, sum over coeffs_k * Bi_k
+/* ----------------------------------------------------------------------
+   energy of atom ii in list, sum over coeffs_k * Bi_k
+   requires bispectrum to be computed
+------------------------------------------------------------------------- */
 
-      double* coeffi = coeffelem[ielem];
-      evdwl = coeffi[0];
-      // snaptr->copy_bi2bvec();
+double PairSNAP::atom_energy(int ii, int ielem)
+{
+  double* coeffi = coeffelem[ielem];
+  double evdwl = coeffi[0];
 
-      // E = beta.B + 0.5*B^t.alpha.B
+  // E = beta.B + 0.5*B^t.alpha.B
 
-      // linear contributions
+  // linear contributions
 
-      for (int icoeff = 0; icoeff < ncoeff; icoeff++)
-        evdwl += coeffi[icoeff+1]*bispectrum[ii][icoeff];
+  for (int icoeff = 0; icoeff < ncoeff; icoeff++)
+    evdwl += coeffi[icoeff+1]*bispectrum[ii][icoeff];
 
-      // quadratic contributions
+  // quadratic contributions
 
-      if (quadraticflag) {
-        int k = ncoeff+1;
-        for (int icoeff = 0; icoeff < ncoeff; icoeff++) {
-          double bveci = bispectrum[ii][icoeff];
-          evdwl += 0.5*coeffi[k++]*bveci*bveci;
-          for (int jcoeff = icoeff+1; jcoeff < ncoeff; jcoeff++) {
-            double bvecj = bispectrum[ii][jcoeff];
-            evdwl += coeffi[k++]*bveci*bvecj;
-          }
-        }
+  if (quadraticflag) {
+    int k = ncoeff+1;
+    for (int icoeff = 0; icoeff < ncoeff; icoeff++) {
+      double bveci = bispectrum[ii][icoeff];
+      evdwl += 0.5*coeffi[k++]*bveci*bveci;
+      for (int jcoeff = icoeff+1; jcoeff < ncoeff; jcoeff++) {
+        double bvecj = bispectrum[ii][jcoeff];
+        evdwl += coeffi[k++]*bveci*bvecj;
       }
-      evdwl *= scale[itype][itype];
-      ev_tally_full(i,2.0*evdwl,0.0,0.0,0.0,0.0,0.0);
     }
+  }
+
+  return evdwl;
+}
+
+/* ----------------------------------------------------------------------
+   energy of the atoms in a list from local_energy_list()
+   bispectrum is computed only for those atoms, from a full list
+   if eone is set, also store energy of each of the atoms
+------------------------------------------------------------------------- */
+
+double PairSNAP::energy_local(NeighList *sub, double *eone)
+{
+  if (beta_max < sub->inum) {
+    memory->grow(beta,sub->inum,ncoeff,"PairSNAP:beta");
+    memory->grow(bispectrum,sub->inum,ncoeff,"PairSNAP:bispectrum");
+    beta_max = sub->inum;
+  }
 
+  NeighList *list_save = list;
+  list = sub;
+  compute_bispectrum();
+  list = list_save;
+
+  int *type = atom->type;
+  double energy = 0.0;
+
+  for (int ii = 0; ii < sub->inum; ii++) {
+    const int i = sub->ilist[ii];
+    const int itype = type[i];
+    const double ei = atom_energy(ii,map[itype])*scale[itype][itype];
+    if (eone) eone[i] = ei;
+    energy += ei;
   }
 
-  if (vflag_fdotr) virial_fdotr_compute();
+  return energy;
 }
 
 /* ----------------------------------------------------------------------
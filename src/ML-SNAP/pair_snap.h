@@ -29,6 +29,7 @@ class PairSNAP : public Pair {
   PairSNAP(class LAMMPS *);
   ~PairSNAP() override;
   void compute(int, int) override;
+  double energy_local(class NeighList *, double *) override;
   void settings(int, char **) override;
   void coeff(int, char **) override;
   void init_style() override;
@@ -49,6 +50,7 @@ class PairSNAP : public Pair {
 
   void compute_beta();
   void compute_bispectrum();
+  double atom_energy(int, int);
 
   double rcutmax;         // max cutoff for all elements
   double *radelem;        // element radii
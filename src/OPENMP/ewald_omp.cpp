@@ -22,7 +22,6 @@
 #include "comm.h"
 #include "force.h"
 #include "math_const.h"
-#include "memory.h"
 #include "suffix.h"
 
 #include <cmath>
@@ -64,29 +63,9 @@ void EwaldOMP::compute(int eflag, int vflag)
 
   ev_init(eflag,vflag);
 
-  // extend size of per-atom arrays if necessary
-
-  if (atom->nmax > nmax) {
-    memory->destroy(ek);
-    memory->destroy3d_offset(cs,-kmax_created);
-    memory->destroy3d_offset(sn,-kmax_created);
-    nmax = atom->nmax;
-    memory->create(ek,nmax,3,"ewald:ek");
-    memory->create3d_offset(cs,-kmax,kmax,3,nmax,"ewald:cs");
-    memory->create3d_offset(sn,-kmax,kmax,3,nmax,"ewald:sn");
-    kmax_created = kmax;
-  }
-
-  // partial structure factors on each processor
-  // total structure factor by summing over procs
-
-  if (triclinic == 0)
-    eik_dot_r();
-  else
-    eik_dot_r_triclinic();
+  // total structure factors, unless already summed during pair
 
-  MPI_Allreduce(sfacrl,sfacrl_all,kcount,MPI_DOUBLE,MPI_SUM,world);
-  MPI_Allreduce(sfacim,sfacim_all,kcount,MPI_DOUBLE,MPI_SUM,world);
+  sum_structure_factors();
 
   // update qsum and qsqsum, if atom count has changed and energy needed
   // (n.b. needs to be done outside of the multi-threaded region)
@@ -282,13 +261,8 @@ void EwaldOMP::eik_dot_r()
         if (sqk <= gsqmx) {
           cstr1 = 0.0;
           sstr1 = 0.0;
+          eik_recurrence(m,ic,ifrom,ito);
           for (i = ifrom; i < ito; i++) {
-            cs[m][ic][i] = cs[m-1][ic][i]*cs[1][ic][i] -
-              sn[m-1][ic][i]*sn[1][ic][i];
-            sn[m][ic][i] = sn[m-1][ic][i]*cs[1][ic][i] +
-              cs[m-1][ic][i]*sn[1][ic][i];
-            cs[-m][ic][i] = cs[m][ic][i];
-            sn[-m][ic][i] = -sn[m][ic][i];
             cstr1 += q[i]*cs[m][ic][i];
             sstr1 += q[i]*sn[m][ic][i];
           }
@@ -481,14 +455,7 @@ void EwaldOMP::eik_dot_r_triclinic()
         unitk_lamda[ic] = 2.0*MY_PI*m;
         x2lamdaT(&unitk_lamda[0],&unitk_lamda[0]);
         sqk = unitk_lamda[ic]*unitk_lamda[ic];
-        for (i = ifrom; i < ito; i++) {
-          cs[m][ic][i] = cs[m-1][ic][i]*cs[1][ic][i] -
-            sn[m-1][ic][i]*sn[1][ic][i];
-          sn[m][ic][i] = sn[m-1][ic][i]*cs[1][ic][i] +
-            cs[m-1][ic][i]*sn[1][ic][i];
-          cs[-m][ic][i] = cs[m][ic][i];
-          sn[-m][ic][i] = -sn[m][ic][i];
-        }
+        eik_recurrence(m,ic,ifrom,ito);
       }
     }
 
@@ -34,7 +34,7 @@ class EwaldOMP : public Ewald, public ThrOMP {
 
  protected:
   void eik_dot_r() override;
-  virtual void eik_dot_r_triclinic();
+  void eik_dot_r_triclinic() override;
 };
 
 }    // namespace LAMMPS_NS
@@ -39,6 +39,7 @@
 #include "error.h"
 #include "memory.h"
 #include "neigh_list.h"
+#include "neighbor.h"
 #include "update.h"
 
 #include "pair_reaxff.h"
@@ -84,6 +85,7 @@ void FixQEqReaxFFOMP::post_constructor()
       s_hist[i][j] = t_hist[i][j] = 0;
 
   pertype_parameters(pertype_option);
+  if (dual_enabled < 0) dual_enabled = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -113,6 +115,9 @@ void FixQEqReaxFFOMP::init()
 {
   FixQEqReaxFF::init();
 
+  if (precond != JACOBI)
+    error->all(FLERR,"Fix {} only supports the jacobi preconditioner", style);
+
   // APSC setup
   if (do_aspc) {
     memory->create(aspc_b, aspc_order_max+2, "qeq/reaxff/aspc_b");
@@ -148,6 +153,14 @@ void FixQEqReaxFFOMP::compute_H()
 {
   double SMALL = 0.0001;
 
+  // with a persistent sparsity pattern only the values of H need
+  // to be updated until the neighbor lists are rebuilt
+
+  if (keep_pattern && (pattern_step == neighbor->ncalls)) {
+    update_H();
+    return;
+  }
+
   int *type = atom->type;
   tagint * tag = atom->tag;
   double **x = atom->x;
@@ -199,7 +212,7 @@ void FixQEqReaxFFOMP::compute_H()
           r_sqr = SQR(dx) + SQR(dy) + SQR(dz);
 
           flag = 0;
-          if (r_sqr <= SQR(swb)) {
+          if (keep_pattern || (r_sqr <= SQR(swb))) {
             if (j < atom->nlocal) flag = 1;
             else if (tag[i] < tag[j]) flag = 1;
             else if (tag[i] == tag[j]) {
@@ -213,7 +226,7 @@ void FixQEqReaxFFOMP::compute_H()
 
           if (flag) {
             H.jlist[mfill] = j;
-            H.val[mfill] = calculate_H(sqrt(r_sqr), shld[type[i]][type[j]]);
+            if (!keep_pattern) H.val[mfill] = calculate_H(sqrt(r_sqr), shld[type[i]][type[j]]);
             mfill++;
           }
         }
@@ -223,9 +236,27 @@ void FixQEqReaxFFOMP::compute_H()
     }
   } // omp
 
-  if (m_fill >= H.m)
+  if (m_fill > H.m)
     error->all(FLERR,fmt::format("Fix qeq/reaxff: H matrix size has been "
                                    "exceeded: m_fill={} H.m={}\n", m_fill, H.m));
+
+  if (keep_pattern) {
+    pattern_step = neighbor->ncalls;
+    update_H();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixQEqReaxFFOMP::update_H()
+{
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(guided) default(shared)
+#endif
+  for (int ii = 0; ii < nn; ii++) {
+    const int i = ilist[ii];
+    if (atom->mask[i] & groupbit) update_H_row(i);
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -270,11 +301,12 @@ void FixQEqReaxFFOMP::pre_force(int /* vflag */)
   // need to be atom->nmax in length
 
   if (atom->nmax > nmax) reallocate_storage();
-  if (atom->nlocal > n_cap*DANGER_ZONE || m_fill > m_cap*DANGER_ZONE)
-    reallocate_matrix();
+  if (matrix_too_small()) reallocate_matrix();
 
   if (efield) get_chi_field();
 
+  double time_start = platform::walltime();
+
   init_matvec();
 
   if (dual_enabled) {
@@ -286,6 +318,9 @@ void FixQEqReaxFFOMP::pre_force(int /* vflag */)
   } // if (dual_enabled)
 
   calculate_Q();
+
+  time_solve = platform::walltime() - time_start;
+  time_total += time_solve;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -639,6 +674,7 @@ int FixQEqReaxFFOMP::dual_CG(double *b1, double *b2, double *x1, double *x2)
   double sig_old_s, sig_old_t, sig_new_s, sig_new_t;
 
   double my_buf[4], buf[4];
+  int active_s, active_t;
 
   pack_flag = 5; // forward 2x d and reverse 2x q
   dual_sparse_matvec(&H, x1, x2, q);
@@ -681,7 +717,13 @@ int FixQEqReaxFFOMP::dual_CG(double *b1, double *b2, double *x1, double *x2)
   sig_new_s = buf[2];
   sig_new_t = buf[3];
 
-  for (i = 1; i < imax; ++i) {
+  // a converged system is kept fixed while iterating the other one
+
+  active_s = sqrt(sig_new_s)/b_norm_s > tolerance;
+  active_t = sqrt(sig_new_t)/b_norm_t > tolerance;
+  matvecs_s = matvecs_t = 1;
+
+  for (i = 1; i < imax && (active_s || active_t); ++i) {
     comm->forward_comm(this); //Dist_vector(d);
     dual_sparse_matvec(&H, d, q);
     comm->reverse_comm(this); //Coll_vector(q);
@@ -728,11 +770,14 @@ int FixQEqReaxFFOMP::dual_CG(double *b1, double *b2, double *x1, double *x2)
         int ii = ilist[jj];
         if (atom->mask[ii] & groupbit) {
           int indxI = 2 * ii;
-          x1[ii] += alpha_s * d[indxI];
-          x2[ii] += alpha_t * d[indxI+1];
-
-          r[indxI] -= alpha_s * q[indxI];
-          r[indxI+1] -= alpha_t * q[indxI+1];
+          if (active_s) {
+            x1[ii] += alpha_s * d[indxI];
+            r[indxI] -= alpha_s * q[indxI];
+          }
+          if (active_t) {
+            x2[ii] += alpha_t * d[indxI+1];
+            r[indxI+1] -= alpha_t * q[indxI+1];
+          }
 
           // pre-conditioning
           p[indxI] = r[indxI] * Hdia_inv[ii];
@@ -747,19 +792,20 @@ int FixQEqReaxFFOMP::dual_CG(double *b1, double *b2, double *x1, double *x2)
     my_buf[0] = tmp1;
     my_buf[1] = tmp2;
 
-    sig_old_s = sig_new_s;
-    sig_old_t = sig_new_t;
-
     MPI_Allreduce(&my_buf, &buf, 2, MPI_DOUBLE, MPI_SUM, world);
 
-    sig_new_s = buf[0];
-    sig_new_t = buf[1];
-
-    if (sqrt(sig_new_s)/b_norm_s <= tolerance
-        || sqrt(sig_new_t)/b_norm_t <= tolerance) break;
-
-    beta_s = sig_new_s / sig_old_s;
-    beta_t = sig_new_t / sig_old_t;
+    if (active_s) {
+      sig_old_s = sig_new_s;
+      sig_new_s = buf[0];
+      beta_s = sig_new_s / sig_old_s;
+      matvecs_s = i + 1;
+    } else beta_s = 0.0;
+    if (active_t) {
+      sig_old_t = sig_new_t;
+      sig_new_t = buf[1];
+      beta_t = sig_new_t / sig_old_t;
+      matvecs_t = i + 1;
+    } else beta_t = 0.0;
 
 #if defined(_OPENMP)
 #pragma omp for schedule(dynamic,50)
@@ -769,30 +815,13 @@ int FixQEqReaxFFOMP::dual_CG(double *b1, double *b2, double *x1, double *x2)
       if (atom->mask[ii] & groupbit) {
         int indxI = 2 * ii;
 
-        d[indxI] = p[indxI] + beta_s * d[indxI];
-        d[indxI+1] = p[indxI+1] + beta_t * d[indxI+1];
+        if (active_s) d[indxI] = p[indxI] + beta_s * d[indxI];
+        if (active_t) d[indxI+1] = p[indxI+1] + beta_t * d[indxI+1];
       }
     }
-  }
 
-  matvecs_s = matvecs_t = i;
-
-  // If only one was converged and there are still iterations left, converge other system
-  if ((matvecs_s < imax) && (sqrt(sig_new_s)/b_norm_s > tolerance)) {
-    pack_flag = 2;
-    comm->forward_comm(this); // x1 => s
-
-    int saved_imax = imax;
-    imax -= matvecs_s;
-    matvecs_s += CG(b1, x1);
-    imax = saved_imax;
-  } else if ((matvecs_t < imax) && (sqrt(sig_new_t)/b_norm_t > tolerance)) {
-    pack_flag = 3;
-    comm->forward_comm(this); // x2 => t
-    int saved_imax = imax;
-    imax -= matvecs_t;
-    matvecs_t += CG(b2, x2);
-    imax = saved_imax;
+    active_s = active_s && (sqrt(sig_new_s)/b_norm_s > tolerance);
+    active_t = active_t && (sqrt(sig_new_t)/b_norm_t > tolerance);
   }
 
   if ((i >= imax) && maxwarn && (comm->me == 0))
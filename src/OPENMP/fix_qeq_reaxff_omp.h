@@ -47,6 +47,7 @@ class FixQEqReaxFFOMP : public FixQEqReaxFF {
   void deallocate_storage() override;
   void init_matvec() override;
   void compute_H() override;
+  void update_H() override;
 
   int CG(double *, double *) override;
   void sparse_matvec(sparse_matrix *, double *, double *) override;
@@ -56,9 +57,9 @@ class FixQEqReaxFFOMP : public FixQEqReaxFF {
   void vector_add(double *, double, double *, int) override;
 
   // dual CG support
-  virtual int dual_CG(double *, double *, double *, double *);
-  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *, double *);
-  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *);
+  int dual_CG(double *, double *, double *, double *) override;
+  void dual_sparse_matvec(sparse_matrix *, double *, double *, double *) override;
+  void dual_sparse_matvec(sparse_matrix *, double *, double *) override;
 };
 
 }    // namespace LAMMPS_NS
@@ -315,6 +315,12 @@ void MSMOMP::direct_eval(const int nn)
   }
 }
 
+/* ----------------------------------------------------------------------
+   add the contributions of the other hemisphere to the potential.
+   each grid point gathers from the owned points it would receive
+   from in a scatter, so the grid points can be split over threads.
+------------------------------------------------------------------------- */
+
 template <int VFLAG_ATOM>
 void MSMOMP::direct_peratom(const int nn)
 {
@@ -334,7 +340,6 @@ void MSMOMP::direct_peratom(const int nn)
   const double * _noalias const v4_directn = v4_direct[nn];
   const double * _noalias const v5_directn = v5_direct[nn];
 
-
   const int alphan = alpha[nn];
   const int betaxn = betax[nn];
   const int betayn = betay[nn];
@@ -343,125 +348,244 @@ void MSMOMP::direct_peratom(const int nn)
   const int nx = nxhi_direct - nxlo_direct + 1;
   const int ny = nyhi_direct - nylo_direct + 1;
 
-  // merge three outer loops into one
-
   const int nzlo_inn = nzlo_in[nn];
   const int nylo_inn = nylo_in[nn];
   const int nxlo_inn = nxlo_in[nn];
-  const int numz = nzhi_in[nn] - nzlo_inn + 1;
-  const int numy = nyhi_in[nn] - nylo_inn + 1;
-  const int numx = nxhi_in[nn] - nxlo_inn + 1;
-  const int inum = numz*numy*numx;
+  const int nzhi_inn = nzhi_in[nn];
+  const int nyhi_inn = nyhi_in[nn];
+  const int nxhi_inn = nxhi_in[nn];
+
+  // merge the two outer loops over rows of receiving grid points into one
+
+  const int nzlo_outn = nzlo_out[nn];
+  const int nylo_outn = nylo_out[nn];
+  const int nxlo_outn = nxlo_out[nn];
+  const int nxhi_outn = nxhi_out[nn];
+  const int numy = nyhi_out[nn] - nylo_outn + 1;
+  const int inum = (nzhi_out[nn] - nzlo_outn + 1)*numy;
 
   const int zper = domain->zperiodic;
   const int yper = domain->yperiodic;
   const int xper = domain->xperiodic;
 
-  int i,icx,icy,icz,ix,iy,iz,k;
-
-
-  for (i = 0; i < inum; ++i) {
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE
+#endif
+  {
+    double esum,v0sum,v1sum,v2sum,v3sum,v4sum,v5sum;
+    int i,ifrom,ito,tid,kk,jj,ii,ix,iy,iz,k;
 
-    // infer outer loop indices icx, icy, icz from master loop index i
+    loop_setup_thr(ifrom, ito, tid, inum, comm->nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
 
-    icz = i/(numy*numx);
-    icy = (i - icz*numy*numx) / numx;
-    icx = i - icz*numy*numx - icy*numx;
-    icz += nzlo_inn;
-    icy += nylo_inn;
-    icx += nxlo_inn;
+    for (i = ifrom; i < ito; ++i) {
+      kk = i/numy + nzlo_outn;
+      jj = i%numy + nylo_outn;
+
+      const int zin = (kk >= nzlo_inn) && (kk <= nzhi_inn);
+      const int yin = (jj >= nylo_inn) && (jj <= nyhi_inn);
+
+      // range of z offsets from owned centers in the +z hemisphere
+
+      const int kmin = MAX(1,kk - nzhi_inn);
+      const int kmax = (zper || kk <= betazn) ? MIN(nzhi_direct,kk - nzlo_inn) : 0;
+      const int yok = yper || ((jj >= alphan) && (jj <= betayn));
+      const int jmin = MAX(nylo_direct,jj - nyhi_inn);
+      const int jmax = MIN(nyhi_direct,jj - nylo_inn);
+
+      for (ii = nxlo_outn; ii <= nxhi_outn; ii++) {
+        const int xok = xper || ((ii >= alphan) && (ii <= betaxn));
+        const int imin = MAX(nxlo_direct,ii - nxhi_inn);
+        const int imax = MIN(nxhi_direct,ii - nxlo_inn);
+
+        esum = 0.0;
+        if (VFLAG_ATOM)
+          v0sum = v1sum = v2sum = v3sum = v4sum = v5sum = 0.0;
+
+        // centers with iz > 0
+
+        if (yok && xok) {
+          for (iz = kmin; iz <= kmax; iz++) {
+            const int zk = (iz + nzhi_direct)*ny;
+            for (iy = jmin; iy <= jmax; iy++) {
+              const int zyk = (zk + iy + nyhi_direct)*nx;
+              const double * _noalias const qgridnkj = &qgridn[kk-iz][jj-iy][ii];
+              for (ix = imin; ix <= imax; ix++) {
+                const double qtmp = qgridnkj[-ix];
+                k = zyk + ix + nxhi_direct;
+                esum += g_directn[k] * qtmp;
+
+                if (VFLAG_ATOM) {
+                  v0sum += v0_directn[k] * qtmp;
+                  v1sum += v1_directn[k] * qtmp;
+                  v2sum += v2_directn[k] * qtmp;
+                  v3sum += v3_directn[k] * qtmp;
+                  v4sum += v4_directn[k] * qtmp;
+                  v5sum += v5_directn[k] * qtmp;
+                }
+              }
+            }
+          }
+        }
 
-    const int kmax = zper ? nzhi_direct : MIN(nzhi_direct,betazn - icz);
-    const int jmin = yper ? nylo_direct : MAX(nylo_direct,alphan - icy);
-    const int jmax = yper ? nyhi_direct : MIN(nyhi_direct,betayn - icy);
-    const int imin = xper ? nxlo_direct : MAX(nxlo_direct,alphan - icx);
-    const int imax = xper ? nxhi_direct : MIN(nxhi_direct,betaxn - icx);
+        // centers with iz = 0, iy > 0
+
+        const int zk = nzhi_direct*ny;
+        if (zin && xok && (yper || jj <= betayn)) {
+          for (iy = MAX(1,jmin); iy <= jmax; iy++) {
+            const int zyk = (zk + iy + nyhi_direct)*nx;
+            const double * _noalias const qgridnkj = &qgridn[kk][jj-iy][ii];
+            for (ix = imin; ix <= imax; ix++) {
+              const double qtmp = qgridnkj[-ix];
+              k = zyk + ix + nxhi_direct;
+              esum += g_directn[k] * qtmp;
+
+              if (VFLAG_ATOM) {
+                v0sum += v0_directn[k] * qtmp;
+                v1sum += v1_directn[k] * qtmp;
+                v2sum += v2_directn[k] * qtmp;
+                v3sum += v3_directn[k] * qtmp;
+                v4sum += v4_directn[k] * qtmp;
+                v5sum += v5_directn[k] * qtmp;
+              }
+            }
+          }
+        }
 
-    const double qtmp = qgridn[icz][icy][icx]; // charge on center grid point
+        // centers with iz = 0, iy = 0, ix > 0
+
+        const int zyk = (zk + nyhi_direct)*nx;
+        if (zin && yin) {
+          if (xper || ii <= betaxn) {
+            const double * _noalias const qgridnkj = &qgridn[kk][jj][ii];
+            for (ix = MAX(1,imin); ix <= imax; ix++) {
+              const double qtmp = qgridnkj[-ix];
+              k = zyk + ix + nxhi_direct;
+              esum += g_directn[k] * qtmp;
+
+              if (VFLAG_ATOM) {
+                v0sum += v0_directn[k] * qtmp;
+                v1sum += v1_directn[k] * qtmp;
+                v2sum += v2_directn[k] * qtmp;
+                v3sum += v3_directn[k] * qtmp;
+                v4sum += v4_directn[k] * qtmp;
+                v5sum += v5_directn[k] * qtmp;
+              }
+            }
+          }
 
+          // iz=0, iy=0, ix=0
 
-    // use hemisphere to avoid double computation of pair-wise
-    //   interactions in direct sum (no computations in -z direction)
+          if ((ii >= nxlo_inn) && (ii <= nxhi_inn))
+            esum += 0.5 * g_directn[zyk + nxhi_direct] * qgridn[kk][jj][ii];
 
-    for (iz = 1; iz <= kmax; iz++) {
-      const int kk = icz+iz;
-      const int zk = (iz + nzhi_direct)*ny;
-      for (iy = jmin; iy <= jmax; iy++) {
-        const int jj = icy+iy;
-        const int zyk = (zk + iy + nyhi_direct)*nx;
-        double * _noalias const egridnkj = &egridn[kk][jj][icx];
-        for (ix = imin; ix <= imax; ix++) {
-          k = zyk + ix + nxhi_direct;
-          const int ii = icx+ix;
-          const double gtmp = g_directn[k];
+          // virial is zero for iz=0, iy=0, ix=0
+        }
 
-          egridnkj[ix] += gtmp * qtmp;
+        egridn[kk][jj][ii] += esum;
 
-          if (VFLAG_ATOM) {
-            v0gridn[kk][jj][ii] += v0_directn[k] * qtmp;
-            v1gridn[kk][jj][ii] += v1_directn[k] * qtmp;
-            v2gridn[kk][jj][ii] += v2_directn[k] * qtmp;
-            v3gridn[kk][jj][ii] += v3_directn[k] * qtmp;
-            v4gridn[kk][jj][ii] += v4_directn[k] * qtmp;
-            v5gridn[kk][jj][ii] += v5_directn[k] * qtmp;
-          }
+        if (VFLAG_ATOM) {
+          v0gridn[kk][jj][ii] += v0sum;
+          v1gridn[kk][jj][ii] += v1sum;
+          v2gridn[kk][jj][ii] += v2sum;
+          v3gridn[kk][jj][ii] += v3sum;
+          v4gridn[kk][jj][ii] += v4sum;
+          v5gridn[kk][jj][ii] += v5sum;
         }
       }
     }
+    thr->timer(Timer::KSPACE);
+  } // end of omp parallel region
+}
 
-    // iz=0
+/* ----------------------------------------------------------------------
+   MSM restriction procedure for intermediate grid levels
+   the 1d passes are split over threads by rows or planes of grid points
+------------------------------------------------------------------------- */
 
-    const int zk = nzhi_direct*ny;
-    for (iy = 1; iy <= jmax; iy++) {
-      const int jj = icy+iy;
-      const int zyk = (zk + iy + nyhi_direct)*nx;
-      double * _noalias const egridnkj = &egridn[icz][jj][icx];
-      for (ix = imin; ix <= imax; ix++) {
-        k = zyk + ix + nxhi_direct;
-        const int ii = icx+ix;
-        const double gtmp = g_directn[k];
+void MSMOMP::restriction(int n)
+{
+  double ***qgrid2 = qgrid[n+1];
+  const Transfer1d *tr = &transfer[3*n];
 
-        egridnkj[ix] += gtmp * qtmp;
+  // zero out charge on coarser grid
 
-        if (VFLAG_ATOM) {
-          v0gridn[icz][jj][ii] += v0_directn[k] * qtmp;
-          v1gridn[icz][jj][ii] += v1_directn[k] * qtmp;
-          v2gridn[icz][jj][ii] += v2_directn[k] * qtmp;
-          v3gridn[icz][jj][ii] += v3_directn[k] * qtmp;
-          v4gridn[icz][jj][ii] += v4_directn[k] * qtmp;
-          v5gridn[icz][jj][ii] += v5_directn[k] * qtmp;
-        }
-      }
-    }
+  memset(&(qgrid2[nzlo_out[n+1]][nylo_out[n+1]][nxlo_out[n+1]]),0,ngrid[n+1]*sizeof(double));
 
-    // iz=0, iy=0
+  if (!tr[0].nc || !tr[1].nc || !tr[2].nc) return;
 
-    const int zyk = (zk + nyhi_direct)*nx;
-    double * _noalias const egridnkj = &egridn[icz][icy][icx];
-    for (ix = 1; ix <= imax; ix++) {
-      k = zyk + ix + nxhi_direct;
-      const int ii = icx+ix;
-      const double gtmp = g_directn[k];
+  const int nrow = tr[2].nf*tr[1].nf;
+  const int nplane = tr[2].nf;
+  const int ncy = tr[1].nc;
 
-      egridnkj[ix] += gtmp * qtmp;
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(n)
+#endif
+  {
+    int ifrom,ito,tid;
+    const int nthreads = comm->nthreads;
 
-      if (VFLAG_ATOM) {
-        v0gridn[icz][icy][ii] += v0_directn[k] * qtmp;
-        v1gridn[icz][icy][ii] += v1_directn[k] * qtmp;
-        v2gridn[icz][icy][ii] += v2_directn[k] * qtmp;
-        v3gridn[icz][icy][ii] += v3_directn[k] * qtmp;
-        v4gridn[icz][icy][ii] += v4_directn[k] * qtmp;
-        v5gridn[icz][icy][ii] += v5_directn[k] * qtmp;
-      }
-    }
+    loop_setup_thr(ifrom, ito, tid, nrow, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
 
-    // iz=0, iy=0, ix=0
+    restrict_x(n,ifrom,ito);
+    sync_threads();
 
-    k = zyk + nxhi_direct;
-    const double gtmp = g_directn[k];
-    egridnkj[0] += 0.5 * gtmp * qtmp;
+    loop_setup_thr(ifrom, ito, tid, nplane, nthreads);
+    restrict_y(n,ifrom,ito);
+    sync_threads();
 
-    // virial is zero for iz=0, iy=0, ix=0
+    loop_setup_thr(ifrom, ito, tid, ncy, nthreads);
+    restrict_z(n,ifrom,ito);
 
-  }
+    thr->timer(Timer::KSPACE);
+  } // end of omp parallel region
+}
+
+/* ----------------------------------------------------------------------
+   MSM prolongation procedure for intermediate grid levels
+   the 1d passes are split over threads by rows or planes of grid points
+------------------------------------------------------------------------- */
+
+void MSMOMP::prolongation(int n)
+{
+  const Transfer1d *tr = &transfer[3*n];
+  if (!tr[0].nc || !tr[1].nc || !tr[2].nc) return;
+
+  double ****grids[7] = {egrid,v0grid,v1grid,v2grid,v3grid,v4grid,v5grid};
+  const int ngrids = vflag_atom ? 7 : 1;
+
+  const int nrow = tr[2].nf*tr[1].nf;
+  const int nplane = tr[2].nf;
+  const int ncy = tr[1].nc;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(n,grids)
+#endif
+  {
+    int ifrom,ito,tid;
+    const int nthreads = comm->nthreads;
+
+    loop_setup_thr(ifrom, ito, tid, nrow, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+
+    for (int m = 0; m < ngrids; m++) {
+      loop_setup_thr(ifrom, ito, tid, ncy, nthreads);
+      prolong_z(n,grids[m][n+1],ifrom,ito);
+      sync_threads();
+
+      loop_setup_thr(ifrom, ito, tid, nplane, nthreads);
+      prolong_y(n,ifrom,ito);
+      sync_threads();
+
+      loop_setup_thr(ifrom, ito, tid, nrow, nthreads);
+      prolong_x(n,grids[m][n],ifrom,ito);
+      sync_threads();
+    }
+
+    thr->timer(Timer::KSPACE);
+  } // end of omp parallel region
 }
@@ -32,6 +32,8 @@ class MSMOMP : public MSM, public ThrOMP {
  protected:
   void direct(int) override;
   void compute(int, int) override;
+  void restriction(int) override;
+  void prolongation(int) override;
 
  private:
   template <int, int, int> void direct_eval(int);
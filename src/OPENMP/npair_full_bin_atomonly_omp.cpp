@@ -98,7 +98,8 @@ void NPairFullBinAtomonlyOmp::build(NeighList *list)
     numneigh[i] = n;
     ipage.vgot(n);
     if (ipage.status())
-      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage.chunkmax);
   }
   NPAIR_OMP_CLOSE;
   list->inum = nlocal;
@@ -136,7 +136,9 @@ void NPairFullMultiOldOmp::build(NeighList *list)
     firstneigh[i] = neighptr;
     numneigh[i] = n;
     ipage.vgot(n);
-    if (ipage.status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+    if (ipage.status())
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage.chunkmax);
   }
   NPAIR_OMP_CLOSE;
   list->inum = nlocal;
@@ -178,14 +178,16 @@ void NPairHalfRespaBinNewtoffOmp::build(NeighList *list)
     numneigh[i] = n;
     ipage.vgot(n);
     if (ipage.status())
-      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage.chunkmax);
 
     ilist_inner[i] = i;
     firstneigh_inner[i] = neighptr_inner;
     numneigh_inner[i] = n_inner;
     ipage.vgot(n_inner);
     if (ipage_inner.status())
-      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage_inner.chunkmax);
 
     if (respamiddle) {
       ilist_middle[i] = i;
@@ -193,7 +195,8 @@ void NPairHalfRespaBinNewtoffOmp::build(NeighList *list)
       numneigh_middle[i] = n_middle;
       ipage_middle->vgot(n_middle);
       if (ipage_middle->status())
-        error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+        error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                          "boost neigh_modify one", ipage_middle->chunkmax);
     }
   }
   NPAIR_OMP_CLOSE;
@@ -96,31 +96,30 @@ void PairAIREBOOMP::REBO_neigh_thr()
     maxlocal = atom->nmax;
     memory->destroy(REBO_numneigh);
     memory->sfree(REBO_firstneigh);
+    memory->sfree(REBO_firstbond);
     memory->destroy(nC);
     memory->destroy(nH);
     memory->create(REBO_numneigh,maxlocal,"AIREBO:numneigh");
     REBO_firstneigh = (int **) memory->smalloc(maxlocal*sizeof(int *),
                                                "AIREBO:firstneigh");
+    REBO_firstbond = (double **) memory->smalloc(maxlocal*sizeof(double *),
+                                                 "AIREBO:firstbond");
     memory->create(nC,maxlocal,"AIREBO:nC");
     memory->create(nH,maxlocal,"AIREBO:nH");
   }
 
+  int maxneigh = 0;
+
 #if defined(_OPENMP)
-#pragma omp parallel LMP_DEFAULT_NONE
+#pragma omp parallel LMP_DEFAULT_NONE reduction(max:maxneigh)
 #endif
   {
-    int i,j,ii,jj,n,jnum,itype,jtype;
-    double xtmp,ytmp,ztmp,delx,dely,delz,rsq,dS;
-    int *ilist,*jlist,*numneigh,**firstneigh;
-    int *neighptr;
-
-    double **x = atom->x;
-    int *type = atom->type;
+    int i,ii,n;
+    int *ilist,*neighptr;
+    double *bondptr;
 
     const int allnum = list->inum + list->gnum;
     ilist = list->ilist;
-    numneigh = list->numneigh;
-    firstneigh = list->firstneigh;
 
 #if defined(_OPENMP)
     const int tid = omp_get_thread_num();
@@ -137,47 +136,34 @@ void PairAIREBOOMP::REBO_neigh_thr()
 
     // each thread has its own page allocator
     MyPage<int> &ipg = ipage[tid];
+    MyPage<double> &bpg = bpage[tid];
     ipg.reset();
+    bpg.reset();
 
     for (ii = iifrom; ii < iito; ii++) {
       i = ilist[ii];
 
-      n = 0;
       neighptr = ipg.vget();
-
-      xtmp = x[i][0];
-      ytmp = x[i][1];
-      ztmp = x[i][2];
-      itype = map[type[i]];
-      nC[i] = nH[i] = 0.0;
-      jlist = firstneigh[i];
-      jnum = numneigh[i];
-
-      for (jj = 0; jj < jnum; jj++) {
-        j = jlist[jj];
-        j &= NEIGHMASK;
-        jtype = map[type[j]];
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
-
-        if (rsq < rcmaxsq[itype][jtype]) {
-          neighptr[n++] = j;
-          if (jtype == 0)
-            nC[i] += Sp(sqrt(rsq),rcmin[itype][jtype],rcmax[itype][jtype],dS);
-          else
-            nH[i] += Sp(sqrt(rsq),rcmin[itype][jtype],rcmax[itype][jtype],dS);
-        }
-      }
+      bondptr = bpg.vget();
+      n = REBO_neigh_bonds(i,neighptr,bondptr);
 
       REBO_firstneigh[i] = neighptr;
+      REBO_firstbond[i] = bondptr;
       REBO_numneigh[i] = n;
+      maxneigh = MAX(maxneigh,n);
       ipg.vgot(n);
-      if (ipg.status())
+      bpg.vgot(NREBOBOND*n);
+      if (ipg.status() || bpg.status())
         error->one(FLERR,"REBO list overflow, boost neigh_modify one");
     }
+
+    // coordination of each neighbor J without I, once nC and nH are complete
+
+    sync_threads();
+    REBO_neigh_coord(iifrom,iito);
   }
+
+  REBO_grow_gcache(maxneigh);
 }
 
 /* ----------------------------------------------------------------------
@@ -193,6 +179,7 @@ void PairAIREBOOMP::FREBO_thr(int ifrom, int ito, int eflag, double *pv0, ThrDat
   double Qij,Aij,alphaij,VR,pre,dVRdi,VA,term,bij,dVAdi,dVA;
   double dwij,del[3];
   int *ilist,*REBO_neighs;
+  double *bond;
 
   evdwl = 0.0;
 
@@ -231,12 +218,14 @@ void PairAIREBOOMP::FREBO_thr(int ifrom, int ito, int eflag, double *pv0, ThrDat
 
       jtype = map[type[j]];
 
-      delx = x[i][0] - x[j][0];
-      dely = x[i][1] - x[j][1];
-      delz = x[i][2] - x[j][2];
+      bond = REBO_bond(i,k);
+      delx = bond[0];
+      dely = bond[1];
+      delz = bond[2];
       rsq = delx*delx + dely*dely + delz*delz;
-      rij = sqrt(rsq);
-      wij = Sp(rij,rcmin[itype][jtype],rcmax[itype][jtype],dwij);
+      rij = bond[3];
+      wij = bond[4];
+      dwij = bond[5];
       if (wij <= TOL) continue;
 
       Qij = Q[itype][jtype];
@@ -296,6 +285,7 @@ void PairAIREBOOMP::FLJ_thr(int ifrom, int ito, int eflag, double *pv1, ThrData
   double delkm[3],rkm,deljm[3],rmj,wmj,r2inv,r6inv,scale,delscale[3];
   int *ilist,*jlist,*numneigh,**firstneigh;
   int *REBO_neighs_i,*REBO_neighs_k;
+  double *bik,*bkm;
   double delikS[3],deljkS[3],delkmS[3],deljmS[3],delimS[3];
   double rikS,rkjS,rkmS,rmjS,wikS,dwikS;
   double wkjS,dwkjS,wkmS,dwkmS,wmjS,dwmjS;
@@ -391,14 +381,12 @@ void PairAIREBOOMP::FLJ_thr(int ifrom, int ito, int eflag, double *pv1, ThrData
           if (k == j) continue;
           ktype = map[type[k]];
 
-          delik[0] = x[i][0] - x[k][0];
-          delik[1] = x[i][1] - x[k][1];
-          delik[2] = x[i][2] - x[k][2];
-          rsq = delik[0]*delik[0] + delik[1]*delik[1] + delik[2]*delik[2];
-          if (rsq < rcmaxsq[itype][ktype]) {
-            rik = sqrt(rsq);
-            wik = Sp(rik,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-          } else { dwik = wik = 0.0; rikS = rik = 1.0; }
+          bik = REBO_bond(i,kk);
+          rik = REBO_bond_del(bik,delik);
+
+          wik = bik[4];
+
+          dwik = bik[5];
 
           if (wik > best) {
             deljk[0] = x[j][0] - x[k][0];
@@ -441,14 +429,10 @@ void PairAIREBOOMP::FLJ_thr(int ifrom, int ito, int eflag, double *pv1, ThrData
               m = REBO_neighs_k[mm];
               if (m == i || m == j) continue;
               mtype = map[type[m]];
-              delkm[0] = x[k][0] - x[m][0];
-              delkm[1] = x[k][1] - x[m][1];
-              delkm[2] = x[k][2] - x[m][2];
-              rsq = delkm[0]*delkm[0] + delkm[1]*delkm[1] + delkm[2]*delkm[2];
-              if (rsq < rcmaxsq[ktype][mtype]) {
-                rkm = sqrt(rsq);
-                wkm = Sp(rkm,rcmin[ktype][mtype],rcmax[ktype][mtype],dwkm);
-              } else { dwkm = wkm = 0.0; rkmS = rkm = 1.0; }
+              bkm = REBO_bond(k,mm);
+              rkm = REBO_bond_del(bkm,delkm);
+              wkm = bkm[4];
+              dwkm = bkm[5];
 
               if (wik*wkm > best) {
                 deljm[0] = x[j][0] - x[m][0];
@@ -671,6 +655,7 @@ void PairAIREBOOMP::TORSION_thr(int ifrom, int ito, int eflag, double *pv2, ThrD
   double fi[3],fj[3],fk[3],fl[3];
   int itype,jtype,ktype,ltype,kk,ll,jj;
   int *ilist,*REBO_neighs_i,*REBO_neighs_j;
+  double *b21,*b34;
 
   const double * const * const x = atom->x;
   double * const * const f = thr->get_f();
@@ -721,11 +706,8 @@ void PairAIREBOOMP::TORSION_thr(int ifrom, int ito, int eflag, double *pv2, ThrD
         k = REBO_neighs_i[kk];
         ktype = map[type[k]];
         if (k == j) continue;
-        del21[0] = x[i][0]-x[k][0];
-        del21[1] = x[i][1]-x[k][1];
-        del21[2] = x[i][2]-x[k][2];
-        rsq = del21[0]*del21[0] + del21[1]*del21[1] + del21[2]*del21[2];
-        r21 = sqrt(rsq);
+        b21 = REBO_bond(i,kk);
+        r21 = REBO_bond_del(b21,del21);
         cos321 = - ((del21[0]*del32[0]) + (del21[1]*del32[1]) +
                     (del21[2]*del32[2])) / (r21*r32);
         cos321 = MIN(cos321,1.0);
@@ -739,7 +721,8 @@ void PairAIREBOOMP::TORSION_thr(int ifrom, int ito, int eflag, double *pv2, ThrD
         rjk2 = deljk[0]*deljk[0] + deljk[1]*deljk[1] + deljk[2]*deljk[2];
         rjk=sqrt(rjk2);
         rik2 = r21*r21;
-        w21 = Sp(r21,rcmin[itype][ktype],rcmax[itype][ktype],dw21);
+        w21 = b21[4];
+        dw21 = b21[5];
 
         rij = r32;
         rik = r21;
@@ -754,18 +737,16 @@ void PairAIREBOOMP::TORSION_thr(int ifrom, int ito, int eflag, double *pv2, ThrD
           l = REBO_neighs_j[ll];
           ltype = map[type[l]];
           if (l == i || l == k) continue;
-          del34[0] = x[j][0]-x[l][0];
-          del34[1] = x[j][1]-x[l][1];
-          del34[2] = x[j][2]-x[l][2];
-          rsq = del34[0]*del34[0] + del34[1]*del34[1] + del34[2]*del34[2];
-          r34 = sqrt(rsq);
+          b34 = REBO_bond(j,ll);
+          r34 = REBO_bond_del(b34,del34);
           cos234 = (del32[0]*del34[0] + del32[1]*del34[1] +
                     del32[2]*del34[2]) / (r32*r34);
           cos234 = MIN(cos234,1.0);
           cos234 = MAX(cos234,-1.0);
           sin234 = sqrt(1.0 - cos234*cos234);
           if (sin234 < TOL) continue;
-          w34 = Sp(r34,rcmin[jtype][ltype],rcmax[jtype][ltype],dw34);
+          w34 = b34[4];
+          dw34 = b34[5];
           delil[0] = del23[0] + del34[0];
           delil[1] = del23[1] + del34[1];
           delil[2] = del23[2] + del34[2];
@@ -1010,12 +991,13 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
                                     double VA, ThrData * const thr)
 {
   int atomi,atomj,k,n,l,atomk,atoml,atomn,atom1,atom2,atom3,atom4;
-  int itype,jtype,ktype,ltype,ntype;
+  int itype,jtype,ktype,ltype;
   double rik[3],rjl[3],rkn[3],rji[3],rki[3],rlj[3],rknmag,dNki,dwjl,bij;
   double NijC,NijH,NjiC,NjiH,wik,dwik,dwkn,wjl;
   double rikmag,rjlmag,cosjik,cosijl,g,tmp2,tmp3;
-  double Etmp,pij,tmp,wij,dwij,NconjtmpI,NconjtmpJ,Nki,Nlj,dS;
+  double Etmp,pij,tmp,wij,dwij,NconjtmpI,NconjtmpJ;
   double lamdajik,lamdaijl,dgdc,dgdN,pji,Nijconj,piRC;
+  double explamda;
   double dcosjikdri[3],dcosijldri[3],dcosjikdrk[3];
   double dN2[2],dN3[3];
   double dcosjikdrj[3],dcosijldrj[3],dcosijldrl[3];
@@ -1036,6 +1018,7 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
   double dcut321,PijS,PjiS;
   double rij2,tspjik,dtsjik,tspijl,dtsijl,costmp;
   int *REBO_neighs,*REBO_neighs_i,*REBO_neighs_j,*REBO_neighs_k,*REBO_neighs_l;
+  double *bik,*bjl,*bkn,*bln;
 
   const double * const * const x = atom->x;
   double * const * const f = thr->get_f();
@@ -1043,6 +1026,7 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
 
   atomi = i;
   atomj = j;
+  double *gbuf = gcache[thr->get_tid()];
   itype = map[type[i]];
   jtype = map[type[j]];
   wij = Sp(rijmag,rcmin[itype][jtype],rcmax[itype][jtype],dwij);
@@ -1065,15 +1049,11 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
     atomk = REBO_neighs[k];
     if (atomk != atomj) {
       ktype = map[type[atomk]];
-      rik[0] = x[atomi][0]-x[atomk][0];
-      rik[1] = x[atomi][1]-x[atomk][1];
-      rik[2] = x[atomi][2]-x[atomk][2];
-      rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
+      bik = REBO_bond(i,k);
+      rikmag = REBO_bond_del(bik,rik);
       lamdajik = 4.0*kronecker(itype,1) *
         ((rho[ktype][1]-rikmag)-(rho[jtype][1]-rijmag));
-      wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dS);
-      Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-        (wik*kronecker(itype,1));
+      wik = bik[4];
       cosjik = ((rij[0]*rik[0])+(rij[1]*rik[1])+(rij[2]*rik[2])) /
         (rijmag*rikmag);
       cosjik = MIN(cosjik,1.0);
@@ -1082,9 +1062,11 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
       // evaluate splines g and derivatives dg
 
       g = gSpline(cosjik,(NijC+NijH),itype,&dgdc,&dgdN);
-      Etmp = Etmp+(wik*g*exp(lamdajik));
-      tmp3 = tmp3+(wik*dgdN*exp(lamdajik));
-      NconjtmpI = NconjtmpI+(kronecker(ktype,0)*wik*Sp(Nki,Nmin,Nmax,dS));
+      explamda = exp(lamdajik);
+      gcache_put(gbuf,k,g,dgdc,explamda);
+      Etmp = Etmp+(wik*g*explamda);
+      tmp3 = tmp3+(wik*dgdN*explamda);
+      NconjtmpI = NconjtmpI+(kronecker(ktype,0)*wik*bik[6]);
     }
   }
 
@@ -1105,13 +1087,10 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
     atomk = REBO_neighs[k];
     if (atomk != atomj) {
       ktype = map[type[atomk]];
-      rik[0] = x[atomi][0]-x[atomk][0];
-      rik[1] = x[atomi][1]-x[atomk][1];
-      rik[2] = x[atomi][2]-x[atomk][2];
-      rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-      lamdajik = 4.0*kronecker(itype,1) *
-        ((rho[ktype][1]-rikmag)-(rho[jtype][1]-rijmag));
-      wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
+      bik = REBO_bond(i,k);
+      rikmag = REBO_bond_del(bik,rik);
+      wik = bik[4];
+      dwik = bik[5];
 
       const double invrikm = 1.0/rikmag;
       const double invrijkm = invrijm*invrikm;
@@ -1134,8 +1113,8 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
       dcosjikdrj[1] = (-rik[1]*invrijkm) + (cosjik*(rij[1]*invrijm2));
       dcosjikdrj[2] = (-rik[2]*invrijkm) + (cosjik*(rij[2]*invrijm2));
 
-      g = gSpline(cosjik,(NijC+NijH),itype,&dgdc,&dgdN);
-      tmp2 = VA*.5*(tmp*wik*dgdc*exp(lamdajik));
+      gcache_get(gbuf,k,g,dgdc,explamda);
+      tmp2 = VA*.5*(tmp*wik*dgdc*explamda);
       fj[0] = -tmp2*dcosjikdrj[0];
       fj[1] = -tmp2*dcosjikdrj[1];
       fj[2] = -tmp2*dcosjikdrj[2];
@@ -1146,7 +1125,7 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
       fk[1] = -tmp2*dcosjikdrk[1];
       fk[2] = -tmp2*dcosjikdrk[2];
 
-      tmp2 = VA*.5*(tmp*wik*g*exp(lamdajik)*4.0*kronecker(itype,1));
+      tmp2 = VA*.5*(tmp*wik*g*explamda*4.0*kronecker(itype,1));
       fj[0] -= tmp2*(-rij[0]*invrijm);
       fj[1] -= tmp2*(-rij[1]*invrijm);
       fj[2] -= tmp2*(-rij[2]*invrijm);
@@ -1161,7 +1140,7 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
 
       // dwik forces
 
-      tmp2 = VA*.5*(tmp*dwik*g*exp(lamdajik))*invrikm;
+      tmp2 = VA*.5*(tmp*dwik*g*explamda)*invrikm;
       fi[0] -= tmp2*rik[0];
       fi[1] -= tmp2*rik[1];
       fi[2] -= tmp2*rik[2];
@@ -1211,15 +1190,11 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
     atoml = REBO_neighs[l];
     if (atoml != atomi) {
       ltype = map[type[atoml]];
-      rjl[0] = x[atomj][0]-x[atoml][0];
-      rjl[1] = x[atomj][1]-x[atoml][1];
-      rjl[2] = x[atomj][2]-x[atoml][2];
-      rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
+      bjl = REBO_bond(j,l);
+      rjlmag = REBO_bond_del(bjl,rjl);
       lamdaijl = 4.0*kronecker(jtype,1) *
         ((rho[ltype][1]-rjlmag)-(rho[itype][1]-rijmag));
-      wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dS);
-      Nlj = nC[atoml]-(wjl*kronecker(jtype,0)) +
-        nH[atoml]-(wjl*kronecker(jtype,1));
+      wjl = bjl[4];
       cosijl = -1.0*((rij[0]*rjl[0])+(rij[1]*rjl[1])+(rij[2]*rjl[2])) /
         (rijmag*rjlmag);
       cosijl = MIN(cosijl,1.0);
@@ -1228,9 +1203,11 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
       // evaluate splines g and derivatives dg
 
       g = gSpline(cosijl,NjiC+NjiH,jtype,&dgdc,&dgdN);
-      Etmp = Etmp+(wjl*g*exp(lamdaijl));
-      tmp3 = tmp3+(wjl*dgdN*exp(lamdaijl));
-      NconjtmpJ = NconjtmpJ+(kronecker(ltype,0)*wjl*Sp(Nlj,Nmin,Nmax,dS));
+      explamda = exp(lamdaijl);
+      gcache_put(gbuf,l,g,dgdc,explamda);
+      Etmp = Etmp+(wjl*g*explamda);
+      tmp3 = tmp3+(wjl*dgdN*explamda);
+      NconjtmpJ = NconjtmpJ+(kronecker(ltype,0)*wjl*bjl[6]);
     }
   }
 
@@ -1246,13 +1223,10 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
     atoml = REBO_neighs[l];
     if (atoml != atomi) {
       ltype = map[type[atoml]];
-      rjl[0] = x[atomj][0]-x[atoml][0];
-      rjl[1] = x[atomj][1]-x[atoml][1];
-      rjl[2] = x[atomj][2]-x[atoml][2];
-      rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-      lamdaijl = 4.0*kronecker(jtype,1) *
-        ((rho[ltype][1]-rjlmag)-(rho[itype][1]-rijmag));
-      wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
+      bjl = REBO_bond(j,l);
+      rjlmag = REBO_bond_del(bjl,rjl);
+      wjl = bjl[4];
+      dwjl = bjl[5];
 
       const double invrjlm = 1.0/rjlmag;
       const double invrijlm = invrijm*invrjlm;
@@ -1279,8 +1253,8 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
 
       // evaluate splines g and derivatives dg
 
-      g = gSpline(cosijl,NjiC+NjiH,jtype,&dgdc,&dgdN);
-      tmp2 = VA*.5*(tmp*wjl*dgdc*exp(lamdaijl));
+      gcache_get(gbuf,l,g,dgdc,explamda);
+      tmp2 = VA*.5*(tmp*wjl*dgdc*explamda);
       fi[0] = -tmp2*dcosijldri[0];
       fi[1] = -tmp2*dcosijldri[1];
       fi[2] = -tmp2*dcosijldri[2];
@@ -1291,7 +1265,7 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
       fl[1] = -tmp2*dcosijldrl[1];
       fl[2] = -tmp2*dcosijldrl[2];
 
-      tmp2 = VA*.5*(tmp*wjl*g*exp(lamdaijl)*4.0*kronecker(jtype,1));
+      tmp2 = VA*.5*(tmp*wjl*g*explamda*4.0*kronecker(jtype,1));
       fi[0] -= tmp2*(rij[0]*invrijm);
       fi[1] -= tmp2*(rij[1]*invrijm);
       fi[2] -= tmp2*(rij[2]*invrijm);
@@ -1306,7 +1280,7 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
 
       // dwik forces
 
-      tmp2 = VA*.5*(tmp*dwjl*g*exp(lamdaijl))*invrjlm;
+      tmp2 = VA*.5*(tmp*dwjl*g*explamda)*invrjlm;
       fj[0] -= tmp2*rjl[0];
       fj[1] -= tmp2*rjl[1];
       fj[2] -= tmp2*rjl[2];
@@ -1357,14 +1331,12 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
     atomk = REBO_neighs_i[k];
     if (atomk !=atomj) {
       ktype = map[type[atomk]];
-      rik[0] = x[atomi][0]-x[atomk][0];
-      rik[1] = x[atomi][1]-x[atomk][1];
-      rik[2] = x[atomi][2]-x[atomk][2];
-      rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-      wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-      Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-        (wik*kronecker(itype,1));
-      SpN = Sp(Nki,Nmin,Nmax,dNki);
+      bik = REBO_bond(i,k);
+      rikmag = REBO_bond_del(bik,rik);
+      wik = bik[4];
+      dwik = bik[5];
+      SpN = bik[6];
+      dNki = bik[7];
 
       tmp2 = VA*dN3[0]*dwik/rikmag;
       f[atomi][0] -= tmp2*rik[0];
@@ -1395,12 +1367,9 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
         for (n = 0; n < REBO_numneigh[atomk]; n++) {
           atomn = REBO_neighs_k[n];
           if (atomn != atomi) {
-            ntype = map[type[atomn]];
-            rkn[0] = x[atomk][0]-x[atomn][0];
-            rkn[1] = x[atomk][1]-x[atomn][1];
-            rkn[2] = x[atomk][2]-x[atomn][2];
-            rknmag = sqrt((rkn[0]*rkn[0])+(rkn[1]*rkn[1])+(rkn[2]*rkn[2]));
-            Sp(rknmag,rcmin[ktype][ntype],rcmax[ktype][ntype],dwkn);
+            bkn = REBO_bond(atomk,n);
+            rknmag = REBO_bond_del(bkn,rkn);
+            dwkn = bkn[5];
 
             tmp2 = VA*dN3[2]*(2.0*NconjtmpI*wik*dNki*dwkn)/rknmag;
             f[atomk][0] -= tmp2*rkn[0];
@@ -1424,14 +1393,12 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
     atoml = REBO_neighs[l];
     if (atoml !=atomi) {
       ltype = map[type[atoml]];
-      rjl[0] = x[atomj][0]-x[atoml][0];
-      rjl[1] = x[atomj][1]-x[atoml][1];
-      rjl[2] = x[atomj][2]-x[atoml][2];
-      rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-      wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
-      Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-        (wjl*kronecker(jtype,1));
-      SpN = Sp(Nlj,Nmin,Nmax,dNlj);
+      bjl = REBO_bond(j,l);
+      rjlmag = REBO_bond_del(bjl,rjl);
+      wjl = bjl[4];
+      dwjl = bjl[5];
+      SpN = bjl[6];
+      dNlj = bjl[7];
 
       tmp2 = VA*dN3[1]*dwjl/rjlmag;
       f[atomj][0] -= tmp2*rjl[0];
@@ -1462,12 +1429,9 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
         for (n = 0; n < REBO_numneigh[atoml]; n++) {
           atomn = REBO_neighs_l[n];
           if (atomn != atomj) {
-            ntype = map[type[atomn]];
-            rln[0] = x[atoml][0]-x[atomn][0];
-            rln[1] = x[atoml][1]-x[atomn][1];
-            rln[2] = x[atoml][2]-x[atomn][2];
-            rlnmag = sqrt((rln[0]*rln[0])+(rln[1]*rln[1])+(rln[2]*rln[2]));
-            Sp(rlnmag,rcmin[ltype][ntype],rcmax[ltype][ntype],dwln);
+            bln = REBO_bond(atoml,n);
+            rlnmag = REBO_bond_del(bln,rln);
+            dwln = bln[5];
 
             tmp2 = VA*dN3[2]*(2.0*NconjtmpJ*wjl*dNlj*dwln)/rlnmag;
             f[atoml][0] -= tmp2*rln[0];
@@ -1708,14 +1672,12 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
       atomk = REBO_neighs[k];
       if (atomk != atomj) {
         ktype = map[type[atomk]];
-        rik[0] = x[atomi][0]-x[atomk][0];
-        rik[1] = x[atomi][1]-x[atomk][1];
-        rik[2] = x[atomi][2]-x[atomk][2];
-        rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-        wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-        Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-          (wik*kronecker(itype,1));
-        SpN = Sp(Nki,Nmin,Nmax,dNki);
+        bik = REBO_bond(i,k);
+        rikmag = REBO_bond_del(bik,rik);
+        wik = bik[4];
+        dwik = bik[5];
+        SpN = bik[6];
+        dNki = bik[7];
 
         tmp2 = VA*dN3[0]*dwik*Etmp/rikmag;
         f[atomi][0] -= tmp2*rik[0];
@@ -1745,13 +1707,10 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
           REBO_neighs_k = REBO_firstneigh[atomk];
           for (n = 0; n < REBO_numneigh[atomk]; n++) {
             atomn = REBO_neighs_k[n];
-            ntype = map[type[atomn]];
             if (atomn != atomi) {
-              rkn[0] = x[atomk][0]-x[atomn][0];
-              rkn[1] = x[atomk][1]-x[atomn][1];
-              rkn[2] = x[atomk][2]-x[atomn][2];
-              rknmag = sqrt((rkn[0]*rkn[0])+(rkn[1]*rkn[1])+(rkn[2]*rkn[2]));
-              Sp(rknmag,rcmin[ktype][ntype],rcmax[ktype][ntype],dwkn);
+              bkn = REBO_bond(atomk,n);
+              rknmag = REBO_bond_del(bkn,rkn);
+              dwkn = bkn[5];
 
               tmp2 = VA*dN3[2]*(2.0*NconjtmpI*wik*dNki*dwkn)*Etmp/rknmag;
               f[atomk][0] -= tmp2*rkn[0];
@@ -1775,14 +1734,12 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
       atoml = REBO_neighs[l];
       if (atoml != atomi) {
         ltype = map[type[atoml]];
-        rjl[0] = x[atomj][0]-x[atoml][0];
-        rjl[1] = x[atomj][1]-x[atoml][1];
-        rjl[2] = x[atomj][2]-x[atoml][2];
-        rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-        wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
-        Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-          (wjl*kronecker(jtype,1));
-        SpN = Sp(Nlj,Nmin,Nmax,dNlj);
+        bjl = REBO_bond(j,l);
+        rjlmag = REBO_bond_del(bjl,rjl);
+        wjl = bjl[4];
+        dwjl = bjl[5];
+        SpN = bjl[6];
+        dNlj = bjl[7];
 
         tmp2 = VA*dN3[1]*dwjl*Etmp/rjlmag;
         f[atomj][0] -= tmp2*rjl[0];
@@ -1812,13 +1769,10 @@ double PairAIREBOOMP::bondorder_thr(int i, int j, double rij[3], double rijmag,
           REBO_neighs_l = REBO_firstneigh[atoml];
           for (n = 0; n < REBO_numneigh[atoml]; n++) {
             atomn = REBO_neighs_l[n];
-            ntype = map[type[atomn]];
             if (atomn !=atomj) {
-              rln[0] = x[atoml][0]-x[atomn][0];
-              rln[1] = x[atoml][1]-x[atomn][1];
-              rln[2] = x[atoml][2]-x[atomn][2];
-              rlnmag = sqrt((rln[0]*rln[0])+(rln[1]*rln[1])+(rln[2]*rln[2]));
-              Sp(rlnmag,rcmin[ltype][ntype],rcmax[ltype][ntype],dwln);
+              bln = REBO_bond(atoml,n);
+              rlnmag = REBO_bond_del(bln,rln);
+              dwln = bln[5];
 
               tmp2 = VA*dN3[2]*(2.0*NconjtmpJ*wjl*dNlj*dwln)*Etmp/rlnmag;
               f[atoml][0] -= tmp2*rln[0];
@@ -1869,11 +1823,11 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
                                       double VA, double rij[3], double rijmag, ThrData * const thr)
 {
   int atomi,atomj,k,n,l,atomk,atoml,atomn,atom1,atom2,atom3,atom4;
-  int itype,jtype,ktype,ltype,ntype;
+  int itype,jtype,ktype,ltype;
   double rik[3],rjl[3],rkn[3],rji[3],rki[3],rlj[3],rknmag,dNki,dwjl,bij;
   double NijC,NijH,NjiC,NjiH,wik,dwik,dwkn,wjl;
   double rikmag,rjlmag,cosjik,cosijl,g,tmp2,tmp3;
-  double Etmp,pij,tmp,wij,dwij,NconjtmpI,NconjtmpJ,Nki,Nlj,dS;
+  double Etmp,pij,tmp,wij,dwij,NconjtmpI,NconjtmpJ;
   double lamdajik,lamdaijl,dgdc,dgdN,pji,Nijconj,piRC;
   double dcosjikdri[3],dcosijldri[3],dcosjikdrk[3];
   double dN2[2],dN3[3];
@@ -1895,6 +1849,7 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
   double PijS,PjiS;
   double rij2,tspjik,dtsjik,tspijl,dtsijl,costmp;
   int *REBO_neighs,*REBO_neighs_i,*REBO_neighs_j,*REBO_neighs_k,*REBO_neighs_l;
+  double *bik,*bjl,*bkn,*bln;
   double tmppij,tmppji,dN2PIJ[2],dN2PJI[2],dN3piRC[3],dN3Tij[3];
   double tmp3pij,tmp3pji,Stb,dStb;
 
@@ -1928,15 +1883,11 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
     atomk = REBO_neighs[k];
     if (atomk != atomj) {
       ktype = map[type[atomk]];
-      rik[0] = x[atomi][0]-x[atomk][0];
-      rik[1] = x[atomi][1]-x[atomk][1];
-      rik[2] = x[atomi][2]-x[atomk][2];
-      rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
+      bik = REBO_bond(i,k);
+      rikmag = REBO_bond_del(bik,rik);
       lamdajik = 4.0*kronecker(itype,1) *
         ((rho[ktype][1]-rikmag)-(rho[jtype][1]-rijmag_mod));
-      wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dS);
-      Nki = nC[atomk]-(wik*kronecker(itype,0))+
-        nH[atomk]-(wik*kronecker(itype,1));
+      wik = bik[4];
       cosjik = ((rij[0]*rik[0])+(rij[1]*rik[1])+(rij[2]*rik[2])) /
         (rijmag*rikmag);
       cosjik = MIN(cosjik,1.0);
@@ -1947,7 +1898,7 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
       g = gSpline(cosjik,(NijC+NijH),itype,&dgdc,&dgdN);
       Etmp += (wik*g*exp(lamdajik));
       tmp3 += (wik*dgdN*exp(lamdajik));
-      NconjtmpI = NconjtmpI+(kronecker(ktype,0)*wik*Sp(Nki,Nmin,Nmax,dS));
+      NconjtmpI = NconjtmpI+(kronecker(ktype,0)*wik*bik[6]);
     }
   }
 
@@ -1969,15 +1920,11 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
     atoml = REBO_neighs[l];
     if (atoml != atomi) {
       ltype = map[type[atoml]];
-      rjl[0] = x[atomj][0]-x[atoml][0];
-      rjl[1] = x[atomj][1]-x[atoml][1];
-      rjl[2] = x[atomj][2]-x[atoml][2];
-      rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
+      bjl = REBO_bond(j,l);
+      rjlmag = REBO_bond_del(bjl,rjl);
       lamdaijl = 4.0*kronecker(jtype,1) *
         ((rho[ltype][1]-rjlmag)-(rho[itype][1]-rijmag_mod));
-      wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dS);
-      Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-        (wjl*kronecker(jtype,1));
+      wjl = bjl[4];
       cosijl = -1.0*((rij[0]*rjl[0])+(rij[1]*rjl[1])+(rij[2]*rjl[2])) /
         (rijmag*rjlmag);
       cosijl = MIN(cosijl,1.0);
@@ -1988,7 +1935,7 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
       g = gSpline(cosijl,NjiC+NjiH,jtype,&dgdc,&dgdN);
       Etmp += (wjl*g*exp(lamdaijl));
       tmp3 += (wjl*dgdN*exp(lamdaijl));
-      NconjtmpJ = NconjtmpJ+(kronecker(ltype,0)*wjl*Sp(Nlj,Nmin,Nmax,dS));
+      NconjtmpJ = NconjtmpJ+(kronecker(ltype,0)*wjl*bjl[6]);
     }
   }
 
@@ -2104,13 +2051,12 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
       ktype = map[type[atomk]];
       if (atomk != atomj) {
         lamdajik = 0.0;
-        rik[0] = x[atomi][0]-x[atomk][0];
-        rik[1] = x[atomi][1]-x[atomk][1];
-        rik[2] = x[atomi][2]-x[atomk][2];
-        rikmag = sqrt(rik[0]*rik[0] + rik[1]*rik[1] + rik[2]*rik[2]);
+        bik = REBO_bond(i,k);
+        rikmag = REBO_bond_del(bik,rik);
         lamdajik = 4.0*kronecker(itype,1) *
           ((rho[ktype][1]-rikmag)-(rho[jtype][1]-rijmag_mod));
-        wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
+        wik = bik[4];
+        dwik = bik[5];
         cosjik = (rij[0]*rik[0] + rij[1]*rik[1] + rij[2]*rik[2]) /
           (rijmag*rikmag);
         cosjik = MIN(cosjik,1.0);
@@ -2209,13 +2155,12 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
       atoml = REBO_neighs[l];
       if (atoml !=atomi) {
         ltype = map[type[atoml]];
-        rjl[0] = x[atomj][0]-x[atoml][0];
-        rjl[1] = x[atomj][1]-x[atoml][1];
-        rjl[2] = x[atomj][2]-x[atoml][2];
-        rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
+        bjl = REBO_bond(j,l);
+        rjlmag = REBO_bond_del(bjl,rjl);
         lamdaijl = 4.0*kronecker(jtype,1) *
           ((rho[ltype][1]-rjlmag)-(rho[itype][1]-rijmag_mod));
-        wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
+        wjl = bjl[4];
+        dwjl = bjl[5];
         cosijl = (-1.0*((rij[0]*rjl[0])+(rij[1]*rjl[1])+(rij[2]*rjl[2]))) /
           (rijmag*rjlmag);
         cosijl = MIN(cosijl,1.0);
@@ -2313,14 +2258,12 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
       atomk = REBO_neighs_i[k];
       if (atomk != atomj) {
         ktype = map[type[atomk]];
-        rik[0] = x[atomi][0]-x[atomk][0];
-        rik[1] = x[atomi][1]-x[atomk][1];
-        rik[2] = x[atomi][2]-x[atomk][2];
-        rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-        wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-        Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-          (wik*kronecker(itype,1));
-        SpN = Sp(Nki,Nmin,Nmax,dNki);
+        bik = REBO_bond(i,k);
+        rikmag = REBO_bond_del(bik,rik);
+        wik = bik[4];
+        dwik = bik[5];
+        SpN = bik[6];
+        dNki = bik[7];
 
         tmp2 = VA*dN3[0]*dwik/rikmag;
         f[atomi][0] -= tmp2*rik[0];
@@ -2351,12 +2294,9 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
           for (n = 0; n < REBO_numneigh[atomk]; n++) {
             atomn = REBO_neighs_k[n];
             if (atomn != atomi) {
-              ntype = map[type[atomn]];
-              rkn[0] = x[atomk][0]-x[atomn][0];
-              rkn[1] = x[atomk][1]-x[atomn][1];
-              rkn[2] = x[atomk][2]-x[atomn][2];
-              rknmag = sqrt((rkn[0]*rkn[0])+(rkn[1]*rkn[1])+(rkn[2]*rkn[2]));
-              Sp(rknmag,rcmin[ktype][ntype],rcmax[ktype][ntype],dwkn);
+              bkn = REBO_bond(atomk,n);
+              rknmag = REBO_bond_del(bkn,rkn);
+              dwkn = bkn[5];
 
               tmp2 = VA*dN3[2]*(2.0*NconjtmpI*wik*dNki*dwkn)/rknmag;
               f[atomk][0] -= tmp2*rkn[0];
@@ -2380,14 +2320,12 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
       atoml = REBO_neighs[l];
       if (atoml != atomi) {
         ltype = map[type[atoml]];
-        rjl[0] = x[atomj][0]-x[atoml][0];
-        rjl[1] = x[atomj][1]-x[atoml][1];
-        rjl[2] = x[atomj][2]-x[atoml][2];
-        rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-        wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
-        Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-          (wjl*kronecker(jtype,1));
-        SpN = Sp(Nlj,Nmin,Nmax,dNlj);
+        bjl = REBO_bond(j,l);
+        rjlmag = REBO_bond_del(bjl,rjl);
+        wjl = bjl[4];
+        dwjl = bjl[5];
+        SpN = bjl[6];
+        dNlj = bjl[7];
 
         tmp2 = VA*dN3[1]*dwjl/rjlmag;
         f[atomj][0] -= tmp2*rjl[0];
@@ -2418,12 +2356,9 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
           for (n = 0; n < REBO_numneigh[atoml]; n++) {
             atomn = REBO_neighs_l[n];
             if (atomn != atomj) {
-              ntype = map[type[atomn]];
-              rln[0] = x[atoml][0]-x[atomn][0];
-              rln[1] = x[atoml][1]-x[atomn][1];
-              rln[2] = x[atoml][2]-x[atomn][2];
-              rlnmag = sqrt((rln[0]*rln[0])+(rln[1]*rln[1])+(rln[2]*rln[2]));
-              Sp(rlnmag,rcmin[ltype][ntype],rcmax[ltype][ntype],dwln);
+              bln = REBO_bond(atoml,n);
+              rlnmag = REBO_bond_del(bln,rln);
+              dwln = bln[5];
 
               tmp2 = VA*dN3[2]*(2.0*NconjtmpJ*wjl*dNlj*dwln)/rlnmag;
               f[atoml][0] -= tmp2*rln[0];
@@ -2655,14 +2590,12 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
         atomk = REBO_neighs[k];
         if (atomk != atomj) {
           ktype = map[type[atomk]];
-          rik[0] = x[atomi][0]-x[atomk][0];
-          rik[1] = x[atomi][1]-x[atomk][1];
-          rik[2] = x[atomi][2]-x[atomk][2];
-          rikmag = sqrt((rik[0]*rik[0])+(rik[1]*rik[1])+(rik[2]*rik[2]));
-          wik = Sp(rikmag,rcmin[itype][ktype],rcmax[itype][ktype],dwik);
-          Nki = nC[atomk]-(wik*kronecker(itype,0))+nH[atomk] -
-            (wik*kronecker(itype,1));
-          SpN = Sp(Nki,Nmin,Nmax,dNki);
+          bik = REBO_bond(i,k);
+          rikmag = REBO_bond_del(bik,rik);
+          wik = bik[4];
+          dwik = bik[5];
+          SpN = bik[6];
+          dNki = bik[7];
 
           tmp2 = VA*dN3[0]*dwik*Etmp/rikmag;
           f[atomi][0] -= tmp2*rik[0];
@@ -2692,13 +2625,10 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
             REBO_neighs_k = REBO_firstneigh[atomk];
             for (n = 0; n < REBO_numneigh[atomk]; n++) {
               atomn = REBO_neighs_k[n];
-              ntype = map[type[atomn]];
               if (atomn !=atomi) {
-                rkn[0] = x[atomk][0]-x[atomn][0];
-                rkn[1] = x[atomk][1]-x[atomn][1];
-                rkn[2] = x[atomk][2]-x[atomn][2];
-                rknmag = sqrt((rkn[0]*rkn[0])+(rkn[1]*rkn[1])+(rkn[2]*rkn[2]));
-                Sp(rknmag,rcmin[ktype][ntype],rcmax[ktype][ntype],dwkn);
+                bkn = REBO_bond(atomk,n);
+                rknmag = REBO_bond_del(bkn,rkn);
+                dwkn = bkn[5];
 
                 tmp2 = VA*dN3[2]*(2.0*NconjtmpI*wik*dNki*dwkn)*Etmp/rknmag;
                 f[atomk][0] -= tmp2*rkn[0];
@@ -2722,14 +2652,12 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
         atoml = REBO_neighs[l];
         if (atoml != atomi) {
           ltype = map[type[atoml]];
-          rjl[0] = x[atomj][0]-x[atoml][0];
-          rjl[1] = x[atomj][1]-x[atoml][1];
-          rjl[2] = x[atomj][2]-x[atoml][2];
-          rjlmag = sqrt((rjl[0]*rjl[0])+(rjl[1]*rjl[1])+(rjl[2]*rjl[2]));
-          wjl = Sp(rjlmag,rcmin[jtype][ltype],rcmax[jtype][ltype],dwjl);
-          Nlj = nC[atoml]-(wjl*kronecker(jtype,0))+nH[atoml] -
-            (wjl*kronecker(jtype,1));
-          SpN = Sp(Nlj,Nmin,Nmax,dNlj);
+          bjl = REBO_bond(j,l);
+          rjlmag = REBO_bond_del(bjl,rjl);
+          wjl = bjl[4];
+          dwjl = bjl[5];
+          SpN = bjl[6];
+          dNlj = bjl[7];
 
           tmp2 = VA*dN3[1]*dwjl*Etmp/rjlmag;
           f[atomj][0] -= tmp2*rjl[0];
@@ -2759,13 +2687,10 @@ double PairAIREBOOMP::bondorderLJ_thr(int i, int j, double /* rij_mod */[3], dou
             REBO_neighs_l = REBO_firstneigh[atoml];
             for (n = 0; n < REBO_numneigh[atoml]; n++) {
               atomn = REBO_neighs_l[n];
-              ntype = map[type[atomn]];
               if (atomn != atomj) {
-                rln[0] = x[atoml][0]-x[atomn][0];
-                rln[1] = x[atoml][1]-x[atomn][1];
-                rln[2] = x[atoml][2]-x[atomn][2];
-                rlnmag = sqrt((rln[0]*rln[0])+(rln[1]*rln[1])+(rln[2]*rln[2]));
-                Sp(rlnmag,rcmin[ltype][ntype],rcmax[ltype][ntype],dwln);
+                bln = REBO_bond(atoml,n);
+                rlnmag = REBO_bond_del(bln,rln);
+                dwln = bln[5];
 
                 tmp2 = VA*dN3[2]*(2.0*NconjtmpJ*wjl*dNlj*dwln)*Etmp/rlnmag;
                 f[atoml][0] -= tmp2*rln[0];
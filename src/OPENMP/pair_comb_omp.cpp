@@ -629,7 +629,8 @@ void PairCombOMP::Short_neigh_thr()
       sht_num[i] = nj;
       ipg.vgot(nj);
       if (ipg.status())
-        error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+        error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                          "boost neigh_modify one", ipg.chunkmax);
     }
   }
 }
@@ -311,6 +311,7 @@ void PairReaxFFOMP::compute(int eflag, int vflag)
     pvector[11] = api->data->my_en.e_ele;
     pvector[12] = 0.0;
     pvector[13] = api->data->my_en.e_pol;
+    screen_stats(pvector[14], pvector[15]);
   }
 
   if (vflag_fdotr) virial_fdotr_compute();
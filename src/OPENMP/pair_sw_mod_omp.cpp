@@ -56,31 +56,16 @@ void PairSWMODOMP::settings(int narg, char **arg)
 
 /* ---------------------------------------------------------------------- */
 
-void PairSWMODOMP::threebody(Param *paramij, Param *paramik, Param *paramijk,
-                            double rsq1, double rsq2,
-                            double *delr1, double *delr2,
-                            double *fj, double *fk, int eflag, double &eng)
+void PairSWMODOMP::threebody(Param *paramijk, double *geom1, double *geom2,
+                             double *fj, double *fk, int eflag, double &eng)
 {
-  double r1,rinvsq1,rainv1,gsrainv1,gsrainvsq1,expgsrainv1;
-  double r2,rinvsq2,rainv2,gsrainv2,gsrainvsq2,expgsrainv2;
   double rinv12,cs,delcs,delcssq,facexp,facrad,frad1,frad2;
   double facang,facang12,csfacang,csfac1,csfac2,factor;
 
-  r1 = sqrt(rsq1);
-  rinvsq1 = 1.0/rsq1;
-  rainv1 = 1.0/(r1 - paramij->cut);
-  gsrainv1 = paramij->sigma_gamma * rainv1;
-  gsrainvsq1 = gsrainv1*rainv1/r1;
-  expgsrainv1 = exp(gsrainv1);
-
-  r2 = sqrt(rsq2);
-  rinvsq2 = 1.0/rsq2;
-  rainv2 = 1.0/(r2 - paramik->cut);
-  gsrainv2 = paramik->sigma_gamma * rainv2;
-  gsrainvsq2 = gsrainv2*rainv2/r2;
-  expgsrainv2 = exp(gsrainv2);
-
-  rinv12 = 1.0/(r1*r2);
+  const double *delr1 = geom1;
+  const double *delr2 = geom2;
+
+  rinv12 = 1.0/(geom1[4]*geom2[4]);
   cs = (delr1[0]*delr2[0] + delr1[1]*delr2[1] + delr1[2]*delr2[2]) * rinv12;
   delcs = cs - paramijk->costheta;
 
@@ -92,24 +77,24 @@ void PairSWMODOMP::threebody(Param *paramij, Param *paramik, Param *paramijk,
   }
   delcssq = delcs*delcs;
 
-  facexp = expgsrainv1*expgsrainv2;
+  facexp = geom1[7]*geom2[7];
 
   // facrad = sqrt(paramij->lambda_epsilon*paramik->lambda_epsilon) *
   //          facexp*delcssq;
 
   facrad = paramijk->lambda_epsilon * facexp*delcssq;
-  frad1 = facrad*gsrainvsq1;
-  frad2 = facrad*gsrainvsq2;
+  frad1 = facrad*geom1[6];
+  frad2 = facrad*geom2[6];
   facang = paramijk->lambda_epsilon2 * facexp*delcs;
   facang12 = rinv12*facang;
   csfacang = cs*facang;
-  csfac1 = rinvsq1*csfacang;
+  csfac1 = geom1[5]*csfacang;
 
   fj[0] = delr1[0]*(frad1+csfac1)-delr2[0]*facang12;
   fj[1] = delr1[1]*(frad1+csfac1)-delr2[1]*facang12;
   fj[2] = delr1[2]*(frad1+csfac1)-delr2[2]*facang12;
 
-  csfac2 = rinvsq2*csfacang;
+  csfac2 = geom2[5]*csfacang;
 
   fk[0] = delr2[0]*(frad2+csfac2)-delr1[0]*facang12;
   fk[1] = delr2[1]*(frad2+csfac2)-delr1[1]*facang12;
@@ -38,8 +38,7 @@ class PairSWMODOMP : public PairSWOMP {
   double delta2;
 
   void settings(int, char **) override;
-  void threebody(Param *, Param *, Param *, double, double, double *, double *, double *, double *,
-                 int, double &) override;
+  void threebody(Param *, double *, double *, double *, double *, int, double &) override;
 };
 
 }    // namespace LAMMPS_NS
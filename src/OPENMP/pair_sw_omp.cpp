@@ -72,11 +72,12 @@ void PairSWOMP::eval(int iifrom, int iito, ThrData * const thr)
 {
   int i,j,k,ii,jj,kk,jnum,jnumm1,maxshort_thr;
   tagint itag,jtag;
-  int itype,jtype,ktype,ijparam,ikparam,ijkparam;
+  int itype,jtype,ktype,ijparam,ijkparam;
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
-  double rsq,rsq1,rsq2;
-  double delr1[3],delr2[3],fj[3],fk[3];
+  double rsq;
+  double *delr1,*delr2,fj[3],fk[3];
   int *ilist,*jlist,*numneigh,**firstneigh,*neighshort_thr;
+  double **geomshort_thr;
 
   evdwl = 0.0;
 
@@ -91,6 +92,7 @@ void PairSWOMP::eval(int iifrom, int iito, ThrData * const thr)
   firstneigh = list->firstneigh;
   maxshort_thr = maxshort;
   memory->create(neighshort_thr,maxshort_thr,"pair_thr:neighshort_thr");
+  memory->create(geomshort_thr,maxshort_thr,NGEOM,"pair_thr:geomshort_thr");
 
   double fxtmp,fytmp,fztmp;
 
@@ -126,10 +128,13 @@ void PairSWOMP::eval(int iifrom, int iito, ThrData * const thr)
       if (rsq >= params[ijparam].cutsq) {
         continue;
       } else {
+        if (!skip_threebody_flag)
+          short_geom(&params[ijparam],delx,dely,delz,rsq,geomshort_thr[numshort]);
         neighshort_thr[numshort++] = j;
         if (numshort >= maxshort_thr) {
           maxshort_thr += maxshort_thr/2;
           memory->grow(neighshort_thr,maxshort_thr,"pair:neighshort_thr");
+          memory->grow(geomshort_thr,maxshort_thr,NGEOM,"pair:geomshort_thr");
         }
       }
 
@@ -166,11 +171,7 @@ void PairSWOMP::eval(int iifrom, int iito, ThrData * const thr)
     for (jj = 0; jj < jnumm1; jj++) {
       j = neighshort_thr[jj];
       jtype = map[type[j]];
-      ijparam = elem3param[itype][jtype][jtype];
-      delr1[0] = x[j].x - xtmp;
-      delr1[1] = x[j].y - ytmp;
-      delr1[2] = x[j].z - ztmp;
-      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
+      delr1 = geomshort_thr[jj];
 
       double fjxtmp,fjytmp,fjztmp;
       fjxtmp = fjytmp = fjztmp = 0.0;
@@ -178,16 +179,10 @@ void PairSWOMP::eval(int iifrom, int iito, ThrData * const thr)
       for (kk = jj+1; kk < numshort; kk++) {
         k = neighshort_thr[kk];
         ktype = map[type[k]];
-        ikparam = elem3param[itype][ktype][ktype];
         ijkparam = elem3param[itype][jtype][ktype];
+        delr2 = geomshort_thr[kk];
 
-        delr2[0] = x[k].x - xtmp;
-        delr2[1] = x[k].y - ytmp;
-        delr2[2] = x[k].z - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        threebody(&params[ijparam],&params[ikparam],&params[ijkparam],
-                  rsq1,rsq2,delr1,delr2,fj,fk,EFLAG,evdwl);
+        threebody(&params[ijkparam],delr1,delr2,fj,fk,EFLAG,evdwl);
 
         fxtmp -= fj[0] + fk[0];
         fytmp -= fj[1] + fk[1];
@@ -210,6 +205,7 @@ void PairSWOMP::eval(int iifrom, int iito, ThrData * const thr)
     f[i].z += fztmp;
   }
   memory->destroy(neighshort_thr);
+  memory->destroy(geomshort_thr);
 }
 
 /* ---------------------------------------------------------------------- */
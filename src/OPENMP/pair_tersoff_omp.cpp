@@ -96,11 +96,12 @@ void PairTersoffOMP::eval(int iifrom, int iito, ThrData * const thr)
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
   double fforce;
   double rsq,rsq1,rsq2;
-  double delr1[3],delr2[3],fi[3],fj[3],fk[3];
-  double r1_hat[3],r2_hat[3];
+  double fi[3],fj[3],fk[3];
+  double *delr1,*delr2,*r1_hat,*r2_hat;
   double zeta_ij,prefactor;
   double forceshiftfac;
   int *ilist,*jlist,*numneigh,**firstneigh,*neighshort_thr;
+  double **geomshort_thr;
 
   evdwl = 0.0;
 
@@ -116,6 +117,7 @@ void PairTersoffOMP::eval(int iifrom, int iito, ThrData * const thr)
   firstneigh = list->firstneigh;
   maxshort_thr = maxshort;
   memory->create(neighshort_thr,maxshort_thr,"pair_thr:neighshort_thr");
+  memory->create(geomshort_thr,maxshort_thr,NGEOM,"pair_thr:geomshort_thr");
 
   double fxtmp,fytmp,fztmp;
 
@@ -155,10 +157,12 @@ void PairTersoffOMP::eval(int iifrom, int iito, ThrData * const thr)
       }
 
       if (rsq < cutshortsq) {
+        short_geom(x[j].x - xtmp,x[j].y - ytmp,x[j].z - ztmp,geomshort_thr[numshort]);
         neighshort_thr[numshort++] = j;
         if (numshort >= maxshort_thr) {
           maxshort_thr += maxshort_thr/2;
           memory->grow(neighshort_thr,maxshort_thr,"pair_thr:neighshort_thr");
+          memory->grow(geomshort_thr,maxshort_thr,NGEOM,"pair_thr:geomshort_thr");
         }
       }
 
@@ -196,6 +200,7 @@ void PairTersoffOMP::eval(int iifrom, int iito, ThrData * const thr)
 
     // three-body interactions
     // skip immediately if I-J is not within cutoff
+    // geometry of I-J and I-K is taken from the short neighbor list
     double fjxtmp,fjytmp,fjztmp;
 
     for (jj = 0; jj < numshort; jj++) {
@@ -203,18 +208,12 @@ void PairTersoffOMP::eval(int iifrom, int iito, ThrData * const thr)
       jtype = map[type[j]];
       iparam_ij = elem3param[itype][jtype][jtype];
 
-      delr1[0] = x[j].x - xtmp;
-      delr1[1] = x[j].y - ytmp;
-      delr1[2] = x[j].z - ztmp;
-      rsq1 = delr1[0]*delr1[0] + delr1[1]*delr1[1] + delr1[2]*delr1[2];
-
-      if (SHIFT_FLAG)
-        rsq1 += shift*shift + 2*sqrt(rsq1)*shift;
-
+      delr1 = geomshort_thr[jj];
+      rsq1 = delr1[3];
       if (rsq1 >= params[iparam_ij].cutsq) continue;
 
-      const double r1inv = 1.0/sqrt(dot3(delr1, delr1));
-      scale3(r1inv, delr1, r1_hat);
+      const double r1inv = delr1[4];
+      r1_hat = &delr1[5];
 
       // accumulate bondorder zeta for each i-j interaction via loop over k
 
@@ -227,18 +226,11 @@ void PairTersoffOMP::eval(int iifrom, int iito, ThrData * const thr)
         ktype = map[type[k]];
         iparam_ijk = elem3param[itype][jtype][ktype];
 
-        delr2[0] = x[k].x - xtmp;
-        delr2[1] = x[k].y - ytmp;
-        delr2[2] = x[k].z - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        if (SHIFT_FLAG)
-          rsq2 += shift*shift + 2*sqrt(rsq2)*shift;
-
+        delr2 = geomshort_thr[kk];
+        rsq2 = delr2[3];
         if (rsq2 >= params[iparam_ijk].cutsq) continue;
 
-        const double r2inv = 1.0/sqrt(dot3(delr2, delr2));
-        scale3(r2inv, delr2, r2_hat);
+        r2_hat = &delr2[5];
 
         zeta_ij += zeta(&params[iparam_ijk],rsq1,rsq2,r1_hat,r2_hat);
       }
@@ -267,18 +259,11 @@ void PairTersoffOMP::eval(int iifrom, int iito, ThrData * const thr)
         ktype = map[type[k]];
         iparam_ijk = elem3param[itype][jtype][ktype];
 
-        delr2[0] = x[k].x - xtmp;
-        delr2[1] = x[k].y - ytmp;
-        delr2[2] = x[k].z - ztmp;
-        rsq2 = delr2[0]*delr2[0] + delr2[1]*delr2[1] + delr2[2]*delr2[2];
-
-        if (SHIFT_FLAG)
-          rsq2 += shift*shift + 2*sqrt(rsq2)*shift;
-
+        delr2 = geomshort_thr[kk];
+        rsq2 = delr2[3];
         if (rsq2 >= params[iparam_ijk].cutsq) continue;
 
-        const double r2inv = 1.0/sqrt(dot3(delr2, delr2));
-        scale3(r2inv, delr2, r2_hat);
+        r2_hat = &delr2[5];
 
         attractive(&params[iparam_ijk],prefactor,
                    rsq1,rsq2,r1_hat,r2_hat,fi,fj,fk);
@@ -304,6 +289,7 @@ void PairTersoffOMP::eval(int iifrom, int iito, ThrData * const thr)
     f[i].z += fztmp;
   }
   memory->destroy(neighshort_thr);
+  memory->destroy(geomshort_thr);
 }
 
 /* ---------------------------------------------------------------------- */
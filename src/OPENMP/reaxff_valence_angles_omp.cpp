@@ -111,12 +111,14 @@ namespace ReaxFF {
     double total_Eang = 0;
     double total_Epen = 0;
     double total_Ecoa = 0;
+    double total_Escr = 0;
+    double max_Escr = 0;
 
     int  nthreads = control->nthreads;
     int  num_thb_intrs = 0;
     int  TWICE = 2;
 #if defined(_OPENMP)
-#pragma omp parallel default(shared) reduction(+:total_Eang, total_Epen, total_Ecoa, num_thb_intrs)
+#pragma omp parallel default(shared) reduction(+:total_Eang, total_Epen, total_Ecoa, num_thb_intrs, total_Escr) reduction(max: max_Escr)
 #endif
     {
       int i, j, pi, k, pk, t;
@@ -138,7 +140,7 @@ namespace ReaxFF {
       double Cf7ij, Cf7jk, Cf8j, Cf9j;
       double f7_ij, f7_jk, f8_Dj, f9_Dj;
       double Ctheta_0, theta_0, theta_00, theta, cos_theta, sin_theta;
-      double BOA_ij, BOA_jk;
+      double BOA_ij, BOA_jk, e_bound;
 
       // Tallying variables
       double eng_tmp, fi_tmp[3], fj_tmp[3], fk_tmp[3];
@@ -342,6 +344,8 @@ namespace ReaxFF {
                   p_ijk->thb = bonds->select.bond_list[pk].nbr;
                   p_ijk->pthb  = pk;
                   p_ijk->theta = p_kji->theta;
+                  p_ijk->cos_theta = p_kji->cos_theta;
+                  p_ijk->sin_theta = p_kji->sin_theta;
                   rvec_Copy(p_ijk->dcos_di, p_kji->dcos_dk);
                   rvec_Copy(p_ijk->dcos_dj, p_kji->dcos_dj);
                   rvec_Copy(p_ijk->dcos_dk, p_kji->dcos_di);
@@ -379,6 +383,8 @@ namespace ReaxFF {
               p_ijk->theta = theta;
 
               sin_theta = sin(theta);
+              p_ijk->cos_theta = cos(theta);
+              p_ijk->sin_theta = sin_theta;
               if (sin_theta < 1.0e-5)
                 sin_theta = 1.0e-5;
 
@@ -396,6 +402,17 @@ namespace ReaxFF {
                   if (fabs(thbh->prm[cnt].p_val1) > 0.001) {
                     thbp = &(thbh->prm[cnt]);
 
+                    /* skip the angle if its energy is bound to be below
+                       the screening tolerance */
+                    if (control->screen_tol > 0.0) {
+                      e_bound = Valence_Angle_Bound(system, thbp, p_val3, p_val5, BOA_ij, BOA_jk);
+                      if (e_bound < control->screen_tol) {
+                        total_Escr += e_bound;
+                        max_Escr = MAX(max_Escr, e_bound);
+                        continue;
+                      }
+                    }
+
                     /* ANGLE ENERGY */
                     p_val1 = thbp->p_val1;
                     p_val2 = thbp->p_val2;
@@ -557,6 +574,8 @@ namespace ReaxFF {
     data->my_en.e_ang = total_Eang;
     data->my_en.e_pen = total_Epen;
     data->my_en.e_coa = total_Ecoa;
+    data->my_en.e_scr += total_Escr;
+    data->my_en.e_scr_max = MAX(data->my_en.e_scr_max, max_Escr);
 
     if (num_thb_intrs >= thb_intrs->num_intrs * DANGER_ZONE) {
       workspace->realloc.num_3body = num_thb_intrs * TWICE;
@@ -75,6 +75,9 @@ FixACKS2ReaxFF::FixACKS2ReaxFF(LAMMPS *lmp, int narg, char **arg) :
   // Update comm sizes for this fix
   comm_forward = comm_reverse = 2;
 
+  // no per-system iteration counts or timings
+  vector_flag = 0;
+
   s_hist_X = s_hist_last = nullptr;
 
   last_rows_rank = 0;
@@ -116,8 +119,11 @@ void FixACKS2ReaxFF::post_constructor()
       s_hist[i][j] = s_hist_X[i][j] = 0.0;
 
   pertype_parameters(pertype_option);
-  if (dual_enabled)
-    error->all(FLERR,"Dual keyword only supported with fix qeq/reax/omp");
+  if (dual_enabled > 0)
+    error->all(FLERR,"Dual keyword not supported with fix {}", style);
+  dual_enabled = 0;
+  if (precond != JACOBI)
+    error->all(FLERR,"Fix {} only supports the jacobi preconditioner", style);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -349,8 +355,7 @@ void FixACKS2ReaxFF::pre_force(int /*vflag*/)
   // need to be atom->nmax in length
 
   if (atom->nmax > nmax) reallocate_storage();
-  if (atom->nlocal > n_cap*DANGER_ZONE || m_fill > m_cap*DANGER_ZONE)
-    reallocate_matrix();
+  if (matrix_too_small()) reallocate_matrix();
 
   if (efield) get_chi_field();
 
@@ -476,7 +481,7 @@ void FixACKS2ReaxFF::compute_X()
     }
   }
 
-  if (m_fill >= X.m)
+  if (m_fill > X.m)
     error->all(FLERR,"Fix acks2/reaxff has insufficient ACKS2 X matrix size: m_fill={} X.m={}\n",m_fill,X.m);
 }
 
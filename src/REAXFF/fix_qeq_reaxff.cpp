@@ -71,10 +71,13 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
 {
   scalar_flag = 1;
   extscalar = 0;
+  vector_flag = 1;
+  size_vector = 4;
+  extvector = 0;
   imax = 200;
   maxwarn = 1;
 
-  if ((narg < 8) || (narg > 12)) error->all(FLERR,"Illegal fix qeq/reaxff command");
+  if (narg < 8) error->all(FLERR,"Illegal fix qeq/reaxff command");
 
   nevery = utils::inumeric(FLERR,arg[3],false,lmp);
   if (nevery <= 0) error->all(FLERR,"Illegal fix qeq/reaxff command");
@@ -84,15 +87,34 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   tolerance = utils::numeric(FLERR,arg[6],false,lmp);
   pertype_option = utils::strdup(arg[7]);
 
-  // dual CG support only available for OPENMP variant
-  // check for compatibility is in Fix::post_constructor()
+  // the S and T systems are solved one after the other by default
+  // the fused dual CG solve is enabled with "dual"
+  // -1 = not set, resolved in post_constructor(), so derived classes
+  //   can reject an explicit setting they do not support
 
-  dual_enabled = 0;
+  dual_enabled = -1;
+  precond = JACOBI;
+  keep_pattern = 0;
 
   int iarg = 8;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"dual") == 0) dual_enabled = 1;
+    else if (strcmp(arg[iarg],"nodual") == 0) dual_enabled = 0;
     else if (strcmp(arg[iarg],"nowarn") == 0) maxwarn = 0;
+    else if (strcmp(arg[iarg],"precond") == 0) {
+      if (iarg+1 > narg-1) utils::missing_cmd_args(FLERR, std::string("fix ")+style+" precond", error);
+      if (strcmp(arg[iarg+1],"jacobi") == 0) precond = JACOBI;
+      else if (strcmp(arg[iarg+1],"bjacobi") == 0) precond = BJACOBI;
+      else if (strcmp(arg[iarg+1],"ic") == 0) precond = ICHOL;
+      else error->all(FLERR,"Unknown fix {} precond setting {}", style, arg[iarg+1]);
+      iarg++;
+    } else if (strcmp(arg[iarg],"pattern") == 0) {
+      if (iarg+1 > narg-1) utils::missing_cmd_args(FLERR, std::string("fix ")+style+" pattern", error);
+      if (strcmp(arg[iarg+1],"keep") == 0) keep_pattern = 1;
+      else if (strcmp(arg[iarg+1],"rebuild") == 0) keep_pattern = 0;
+      else error->all(FLERR,"Unknown fix {} pattern setting {}", style, arg[iarg+1]);
+      iarg++;
+    }
     else if (strcmp(arg[iarg],"maxiter") == 0) {
       if (iarg+1 > narg-1)
         error->all(FLERR,"Illegal fix {} command", style);
@@ -131,13 +153,28 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   H.numnbrs = nullptr;
   H.jlist = nullptr;
   H.val = nullptr;
+  pattern_step = -1;
+
+  // preconditioner
+
+  P.firstnbr = nullptr;
+  P.numnbrs = nullptr;
+  P.jlist = nullptr;
+  P.val = nullptr;
+  Pdia = nullptr;
+  Ppos = nullptr;
+  Pwork = nullptr;
+  P_cap = 0;
 
   // dual CG support
   // Update comm sizes for this fix
 
-  if (dual_enabled) comm_forward = comm_reverse = 2;
+  if (dual_enabled > 0) comm_forward = comm_reverse = 2;
   else comm_forward = comm_reverse = 1;
 
+  matvecs_s = matvecs_t = 0;
+  time_solve = time_total = 0.0;
+
   // perform initial allocation of atom-based arrays
   // register with Atom class
 
@@ -164,6 +201,8 @@ FixQEqReaxFF::~FixQEqReaxFF()
 
   FixQEqReaxFF::deallocate_storage();
   FixQEqReaxFF::deallocate_matrix();
+  memory->destroy(P.jlist);
+  memory->destroy(P.val);
 
   memory->destroy(shld);
 
@@ -186,8 +225,7 @@ void FixQEqReaxFF::post_constructor()
       s_hist[i][j] = t_hist[i][j] = 0;
 
   pertype_parameters(pertype_option);
-  if (dual_enabled)
-    error->all(FLERR,"Dual keyword only supported with fix qeq/reaxff/omp");
+  if (dual_enabled < 0) dual_enabled = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -284,6 +322,15 @@ void FixQEqReaxFF::allocate_storage()
   memory->create(q,size,"qeq:q");
   memory->create(r,size,"qeq:r");
   memory->create(d,size,"qeq:d");
+
+  if (precond != JACOBI) {
+    memory->create(P.firstnbr,nmax,"qeq:P.firstnbr");
+    memory->create(P.numnbrs,nmax,"qeq:P.numnbrs");
+    memory->create(Pdia,nmax,"qeq:Pdia");
+    memory->create(Ppos,nmax,"qeq:Ppos");
+    memory->create(Pwork,nmax,"qeq:Pwork");
+    for (int i = 0; i < nmax; i++) Pwork[i] = 0.0;
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -304,6 +351,12 @@ void FixQEqReaxFF::deallocate_storage()
   memory->destroy(q);
   memory->destroy(r);
   memory->destroy(d);
+
+  memory->destroy(P.firstnbr);
+  memory->destroy(P.numnbrs);
+  memory->destroy(Pdia);
+  memory->destroy(Ppos);
+  memory->destroy(Pwork);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -345,6 +398,7 @@ void FixQEqReaxFF::allocate_matrix()
 
   H.n = n_cap;
   H.m = m_cap;
+  pattern_step = -1;
   memory->create(H.firstnbr,n_cap,"qeq:H.firstnbr");
   memory->create(H.numnbrs,n_cap,"qeq:H.numnbrs");
   memory->create(H.jlist,m_cap,"qeq:H.jlist");
@@ -369,6 +423,21 @@ void FixQEqReaxFF::reallocate_matrix()
   allocate_matrix();
 }
 
+/* ----------------------------------------------------------------------
+   check if the matrix storage can hold all neighbors of the local atoms.
+   this is an upper bound for the number of entries in H, so the matrix
+   cannot overflow and only needs to grow after a neighbor list build.
+------------------------------------------------------------------------- */
+
+int FixQEqReaxFF::matrix_too_small()
+{
+  if (atom->nlocal > n_cap) return 1;
+
+  bigint m = 0;
+  for (int ii = 0; ii < nn; ii++) m += numneigh[ilist[ii]];
+  return (m > m_cap) ? 1 : 0;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReaxFF::init()
@@ -379,6 +448,11 @@ void FixQEqReaxFF::init()
   if (group->count(igroup) == 0)
     error->all(FLERR,"Fix {} group has no atoms", style);
 
+  // the neighbor list build count restarts with every run,
+  // so a kept H matrix pattern cannot be reused across runs
+
+  pattern_step = -1;
+
   // compute net charge and print warning if too large
 
   double qsum_local = 0.0, qsum = 0.0;
@@ -433,6 +507,18 @@ double FixQEqReaxFF::compute_scalar()
   return matvecs/2.0;
 }
 
+/* ----------------------------------------------------------------------
+   iterations for s and t and walltime of the last and of all QEq solves
+------------------------------------------------------------------------- */
+
+double FixQEqReaxFF::compute_vector(int n)
+{
+  if (n == 0) return matvecs_s;
+  if (n == 1) return matvecs_t;
+  if (n == 2) return time_solve;
+  return time_total;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReaxFF::init_list(int /*id*/, NeighList *ptr)
@@ -554,8 +640,6 @@ void FixQEqReaxFF::pre_force(int /*vflag*/)
 {
   if (update->ntimestep % nevery) return;
 
-  int n = atom->nlocal;
-
   if (reaxff) {
     nn = reaxff->list->inum;
     ilist = reaxff->list->ilist;
@@ -572,18 +656,26 @@ void FixQEqReaxFF::pre_force(int /*vflag*/)
   // need to be atom->nmax in length
 
   if (atom->nmax > nmax) reallocate_storage();
-  if (n > n_cap*DANGER_ZONE || m_fill > m_cap*DANGER_ZONE)
-    reallocate_matrix();
+  if (matrix_too_small()) reallocate_matrix();
 
   if (efield) get_chi_field();
 
+  double time_start = platform::walltime();
+
   init_matvec();
 
-  matvecs_s = CG(b_s, s);       // CG on s - parallel
-  matvecs_t = CG(b_t, t);       // CG on t - parallel
-  matvecs = matvecs_s + matvecs_t;
+  if (dual_enabled) {
+    matvecs = dual_CG(b_s, b_t, s, t);
+  } else {
+    matvecs_s = CG(b_s, s);     // CG on s - parallel
+    matvecs_t = CG(b_t, t);     // CG on t - parallel
+    matvecs = matvecs_s + matvecs_t;
+  }
 
   calculate_Q();
+
+  time_solve = platform::walltime() - time_start;
+  time_total += time_solve;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -627,6 +719,8 @@ void FixQEqReaxFF::init_matvec()
     }
   }
 
+  build_precond();
+
   pack_flag = 2;
   comm->forward_comm(this); //Dist_vector(s);
   pack_flag = 3;
@@ -642,12 +736,24 @@ void FixQEqReaxFF::compute_H()
   double dx, dy, dz, r_sqr;
   constexpr double EPSILON = 0.0001;
 
+  // with a persistent sparsity pattern only the values of H need
+  // to be updated until the neighbor lists are rebuilt
+
+  if (keep_pattern && (pattern_step == neighbor->ncalls)) {
+    update_H();
+    return;
+  }
+
   int *type = atom->type;
   tagint *tag = atom->tag;
   double **x = atom->x;
   int *mask = atom->mask;
 
   // fill in the H matrix
+  // a persistent pattern must include all pairs that may come within
+  // the cutoff before the next neighbor list build. their value is 0.0
+  // while they are outside the cutoff.
+
   m_fill = 0;
   r_sqr = 0;
   for (ii = 0; ii < nn; ii++) {
@@ -667,7 +773,7 @@ void FixQEqReaxFF::compute_H()
         r_sqr = SQR(dx) + SQR(dy) + SQR(dz);
 
         flag = 0;
-        if (r_sqr <= SQR(swb)) {
+        if (keep_pattern || (r_sqr <= SQR(swb))) {
           if (j < atom->nlocal) flag = 1;
           else if (tag[i] < tag[j]) flag = 1;
           else if (tag[i] == tag[j]) {
@@ -682,7 +788,7 @@ void FixQEqReaxFF::compute_H()
 
         if (flag) {
           H.jlist[m_fill] = j;
-          H.val[m_fill] = calculate_H(sqrt(r_sqr), shld[type[i]][type[j]]);
+          if (!keep_pattern) H.val[m_fill] = calculate_H(sqrt(r_sqr), shld[type[i]][type[j]]);
           m_fill++;
         }
       }
@@ -690,9 +796,77 @@ void FixQEqReaxFF::compute_H()
     }
   }
 
-  if (m_fill >= H.m)
+  if (m_fill > H.m)
     error->all(FLERR,fmt::format("Fix qeq/reaxff H matrix size has been "
                                  "exceeded: m_fill={} H.m={}\n", m_fill, H.m));
+
+  if (keep_pattern) {
+    pattern_step = neighbor->ncalls;
+    update_H();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixQEqReaxFF::update_H()
+{
+  const int *mask = atom->mask;
+
+  for (int ii = 0; ii < nn; ii++) {
+    const int i = ilist[ii];
+    if (mask[i] & groupbit) update_H_row(i);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   recompute the values of row i of H for the current positions.
+   same math as calculate_H(), but written as a loop over the contiguous
+   row, so that the taper polynomial can be vectorized. pairs beyond swb
+   are zeroed before any sqrt() or pow() is evaluated.
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::update_H_row(int i)
+{
+  const double *const *const x = atom->x;
+  const int *_noalias const type = atom->type;
+  const double *_noalias const shldi = shld[type[i]];
+  const int *_noalias const hjlist = H.jlist + H.firstnbr[i];
+  double *_noalias const hval = H.val + H.firstnbr[i];
+  const int jnum = H.numnbrs[i];
+
+  const double xtmp = x[i][0];
+  const double ytmp = x[i][1];
+  const double ztmp = x[i][2];
+  const double swb2 = SQR(swb);
+  const double t0 = Tap[0], t1 = Tap[1], t2 = Tap[2], t3 = Tap[3];
+  const double t4 = Tap[4], t5 = Tap[5], t6 = Tap[6], t7 = Tap[7];
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+  for (int jj = 0; jj < jnum; jj++) {
+    const int j = hjlist[jj];
+    const double dx = x[j][0] - xtmp;
+    const double dy = x[j][1] - ytmp;
+    const double dz = x[j][2] - ztmp;
+    const double r_sqr = dx*dx + dy*dy + dz*dz;
+    if (r_sqr > swb2) {
+      hval[jj] = 0.0;
+      continue;
+    }
+    const double r = sqrt(r_sqr);
+
+    double Taper = t7 * r + t6;
+    Taper = Taper * r + t5;
+    Taper = Taper * r + t4;
+    Taper = Taper * r + t3;
+    Taper = Taper * r + t2;
+    Taper = Taper * r + t1;
+    Taper = Taper * r + t0;
+
+    const double denom = pow(r * r * r + shldi[type[j]], 1.0/3.0);
+    hval[jj] = Taper * EV_TO_KCAL_PER_MOL / denom;
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -719,23 +893,17 @@ double FixQEqReaxFF::calculate_H(double r, double gamma)
 
 int FixQEqReaxFF::CG(double *b, double *x)
 {
-  int  i, j;
+  int  i;
   double tmp, alpha, beta, b_norm;
   double sig_old, sig_new;
 
-  int jj;
-
   pack_flag = 1;
   sparse_matvec(&H, x, q);
   comm->reverse_comm(this); //Coll_Vector(q);
 
   vector_sum(r , 1.,  b, -1., q, nn);
 
-  for (jj = 0; jj < nn; ++jj) {
-    j = ilist[jj];
-    if (atom->mask[j] & groupbit)
-      d[j] = r[j] * Hdia_inv[j]; //pre-condition
-  }
+  apply_precond(r, d, 1); //pre-condition
 
   b_norm = parallel_norm(b, nn);
   sig_new = parallel_dot(r, d, nn);
@@ -752,11 +920,7 @@ int FixQEqReaxFF::CG(double *b, double *x)
     vector_add(r, -alpha, q, nn);
 
     // pre-conditioning
-    for (jj = 0; jj < nn; ++jj) {
-      j = ilist[jj];
-      if (atom->mask[j] & groupbit)
-        p[j] = r[j] * Hdia_inv[j];
-    }
+    apply_precond(r, p, 1);
 
     sig_old = sig_new;
     sig_new = parallel_dot(r, p, nn);
@@ -803,6 +967,387 @@ void FixQEqReaxFF::sparse_matvec(sparse_matrix *A, double *x, double *b)
 
 }
 
+/* ----------------------------------------------------------------------
+   set up the preconditioner from the block of H that couples local atoms
+   BJACOBI: keep the full local block for a symmetric Gauss-Seidel sweep
+   ICHOL: incomplete Cholesky factorization w/o fill-in of the local block
+   atoms are ordered by their position in ilist
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::build_precond()
+{
+  if (precond == JACOBI) return;
+
+  int i, j, ii, k, m, mm, itr_j;
+  const int nlocal = atom->nlocal;
+  const int *mask = atom->mask;
+  const int *type = atom->type;
+
+  for (i = 0; i < nlocal; i++) {
+    Ppos[i] = -1;
+    P.numnbrs[i] = 0;
+  }
+  for (ii = 0; ii < nn; ii++) {
+    i = ilist[ii];
+    if ((i < nlocal) && (mask[i] & groupbit)) Ppos[i] = ii;
+  }
+
+  // count entries per row. H only stores each pair once.
+
+  for (ii = 0; ii < nn; ii++) {
+    i = ilist[ii];
+    if ((i >= nlocal) || (Ppos[i] < 0)) continue;
+    for (itr_j = H.firstnbr[i]; itr_j < H.firstnbr[i] + H.numnbrs[i]; itr_j++) {
+      j = H.jlist[itr_j];
+      if ((j >= nlocal) || (Ppos[j] < 0)) continue;
+      if (precond == BJACOBI) {
+        P.numnbrs[i]++;
+        P.numnbrs[j]++;
+      } else if (Ppos[j] < Ppos[i]) P.numnbrs[i]++;
+      else P.numnbrs[j]++;
+    }
+  }
+
+  m = 0;
+  for (ii = 0; ii < nn; ii++) {
+    i = ilist[ii];
+    if ((i >= nlocal) || (Ppos[i] < 0)) continue;
+    P.firstnbr[i] = m;
+    m += P.numnbrs[i];
+    P.numnbrs[i] = 0;
+  }
+
+  if (m > P_cap) {
+    P_cap = MAX(m, (int) (1.2 * P_cap));
+    memory->destroy(P.jlist);
+    memory->destroy(P.val);
+    memory->create(P.jlist,P_cap,"qeq:P.jlist");
+    memory->create(P.val,P_cap,"qeq:P.val");
+  }
+  P.n = nlocal;
+  P.m = m;
+
+  // fill rows
+
+  for (ii = 0; ii < nn; ii++) {
+    i = ilist[ii];
+    if ((i >= nlocal) || (Ppos[i] < 0)) continue;
+    Pdia[i] = eta[type[i]];
+    for (itr_j = H.firstnbr[i]; itr_j < H.firstnbr[i] + H.numnbrs[i]; itr_j++) {
+      j = H.jlist[itr_j];
+      if ((j >= nlocal) || (Ppos[j] < 0)) continue;
+      if ((precond == BJACOBI) || (Ppos[j] < Ppos[i])) {
+        m = P.firstnbr[i] + P.numnbrs[i]++;
+        P.jlist[m] = j;
+        P.val[m] = H.val[itr_j];
+      }
+      if ((precond == BJACOBI) || (Ppos[j] > Ppos[i])) {
+        m = P.firstnbr[j] + P.numnbrs[j]++;
+        P.jlist[m] = i;
+        P.val[m] = H.val[itr_j];
+      }
+    }
+  }
+
+  if (precond == BJACOBI) return;
+
+  // IC(0): sort each row of the lower triangle by column position,
+  // then factorize row by row using a scatter array for the current row.
+  // on breakdown the diagonal of H is used for the pivot.
+
+  for (ii = 0; ii < nn; ii++) {
+    i = ilist[ii];
+    if ((i >= nlocal) || (Ppos[i] < 0)) continue;
+    const int first = P.firstnbr[i];
+    const int last = first + P.numnbrs[i];
+    for (m = first+1; m < last; m++) {
+      const int jtmp = P.jlist[m];
+      const double vtmp = P.val[m];
+      for (mm = m; (mm > first) && (Ppos[P.jlist[mm-1]] > Ppos[jtmp]); mm--) {
+        P.jlist[mm] = P.jlist[mm-1];
+        P.val[mm] = P.val[mm-1];
+      }
+      P.jlist[mm] = jtmp;
+      P.val[mm] = vtmp;
+    }
+  }
+
+  for (ii = 0; ii < nn; ii++) {
+    i = ilist[ii];
+    if ((i >= nlocal) || (Ppos[i] < 0)) continue;
+    const int first = P.firstnbr[i];
+    const int last = first + P.numnbrs[i];
+    for (m = first; m < last; m++) Pwork[P.jlist[m]] = P.val[m];
+
+    double diag = eta[type[i]];
+    for (m = first; m < last; m++) {
+      k = P.jlist[m];
+      double sum = Pwork[k];
+      for (mm = P.firstnbr[k]; mm < P.firstnbr[k] + P.numnbrs[k]; mm++)
+        sum -= Pwork[P.jlist[mm]] * P.val[mm];
+      sum /= Pdia[k];
+      Pwork[k] = P.val[m] = sum;
+      diag -= sum*sum;
+    }
+    for (m = first; m < last; m++) Pwork[P.jlist[m]] = 0.0;
+
+    if (diag > SMALL * eta[type[i]]) Pdia[i] = sqrt(diag);
+    else Pdia[i] = sqrt(eta[type[i]]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   apply the preconditioner: z = M^-1 r
+   nv = 1 for a single vector, 2 for the interleaved vectors of dual CG
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::apply_precond(double *rr, double *zz, int nv)
+{
+  int i, j, ii, k, m;
+  const int *mask = atom->mask;
+
+  if (precond == JACOBI) {
+    for (ii = 0; ii < nn; ++ii) {
+      i = ilist[ii];
+      if (mask[i] & groupbit)
+        for (k = 0; k < nv; k++) zz[nv*i+k] = rr[nv*i+k] * Hdia_inv[i];
+    }
+    return;
+  }
+
+  // forward substitution with the lower triangle
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (!(mask[i] & groupbit)) continue;
+    for (k = 0; k < nv; k++) zz[nv*i+k] = rr[nv*i+k];
+    if (Ppos[i] < 0) {
+      for (k = 0; k < nv; k++) zz[nv*i+k] *= Hdia_inv[i];
+      continue;
+    }
+    for (m = P.firstnbr[i]; m < P.firstnbr[i] + P.numnbrs[i]; m++) {
+      j = P.jlist[m];
+      if (Ppos[j] < ii)
+        for (k = 0; k < nv; k++) zz[nv*i+k] -= P.val[m] * zz[nv*j+k];
+    }
+    for (k = 0; k < nv; k++) zz[nv*i+k] /= Pdia[i];
+  }
+
+  // backward substitution with the upper triangle
+
+  for (ii = nn-1; ii >= 0; --ii) {
+    i = ilist[ii];
+    if (!(mask[i] & groupbit) || (Ppos[i] < 0)) continue;
+    if (precond == BJACOBI) {
+      for (m = P.firstnbr[i]; m < P.firstnbr[i] + P.numnbrs[i]; m++) {
+        j = P.jlist[m];
+        if (Ppos[j] > ii)
+          for (k = 0; k < nv; k++) zz[nv*i+k] -= P.val[m] * zz[nv*j+k] / Pdia[i];
+      }
+    } else {
+      for (k = 0; k < nv; k++) zz[nv*i+k] /= Pdia[i];
+      for (m = P.firstnbr[i]; m < P.firstnbr[i] + P.numnbrs[i]; m++) {
+        j = P.jlist[m];
+        for (k = 0; k < nv; k++) zz[nv*j+k] -= P.val[m] * zz[nv*i+k];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   dual CG support: solve for s and t with one matvec and one
+   forward/reverse communication per iteration using interleaved vectors.
+   a system that has converged is kept fixed, so the iterates are the
+   same as from two separate CG solves.
+------------------------------------------------------------------------- */
+
+int FixQEqReaxFF::dual_CG(double *b1, double *b2, double *x1, double *x2)
+{
+  int i, ii, jj, k, indxI;
+  double alpha[2], beta[2], b_norm[2], sig_old[2], sig_new[2];
+  double my_buf[4], buf[4];
+  int active[2], niter[2];
+
+  const int *mask = atom->mask;
+  double *x[2] = {x1, x2};
+
+  pack_flag = 5; // forward 2x d and reverse 2x q
+  dual_sparse_matvec(&H, x1, x2, q);
+  comm->reverse_comm(this); //Coll_Vector(q);
+
+  for (jj = 0; jj < nn; ++jj) {
+    ii = ilist[jj];
+    if (mask[ii] & groupbit) {
+      indxI = 2 * ii;
+      r[indxI] = b1[ii] - q[indxI];
+      r[indxI+1] = b2[ii] - q[indxI+1];
+    }
+  }
+
+  apply_precond(r, d, 2); //pre-condition
+
+  my_buf[0] = my_buf[1] = my_buf[2] = my_buf[3] = 0.0;
+  for (jj = 0; jj < nn; ++jj) {
+    ii = ilist[jj];
+    if (mask[ii] & groupbit) {
+      indxI = 2 * ii;
+      my_buf[0] += SQR(b1[ii]);
+      my_buf[1] += SQR(b2[ii]);
+      my_buf[2] += r[indxI] * d[indxI];
+      my_buf[3] += r[indxI+1] * d[indxI+1];
+    }
+  }
+  MPI_Allreduce(my_buf, buf, 4, MPI_DOUBLE, MPI_SUM, world);
+
+  for (k = 0; k < 2; k++) {
+    b_norm[k] = sqrt(buf[k]);
+    sig_new[k] = buf[2+k];
+    active[k] = sqrt(sig_new[k]) / b_norm[k] > tolerance;
+    niter[k] = 1;
+  }
+
+  for (i = 1; i < imax && (active[0] || active[1]); ++i) {
+    comm->forward_comm(this); //Dist_vector(d);
+    dual_sparse_matvec(&H, d, q);
+    comm->reverse_comm(this); //Coll_vector(q);
+
+    my_buf[0] = my_buf[1] = 0.0;
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        my_buf[0] += d[indxI] * q[indxI];
+        my_buf[1] += d[indxI+1] * q[indxI+1];
+      }
+    }
+    MPI_Allreduce(my_buf, buf, 2, MPI_DOUBLE, MPI_SUM, world);
+
+    for (k = 0; k < 2; k++) {
+      if (!active[k]) continue;
+      alpha[k] = sig_new[k] / buf[k];
+      for (jj = 0; jj < nn; ++jj) {
+        ii = ilist[jj];
+        if (mask[ii] & groupbit) {
+          indxI = 2 * ii + k;
+          x[k][ii] += alpha[k] * d[indxI];
+          r[indxI] -= alpha[k] * q[indxI];
+        }
+      }
+    }
+
+    // pre-conditioning
+    apply_precond(r, p, 2);
+
+    my_buf[0] = my_buf[1] = 0.0;
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        my_buf[0] += r[indxI] * p[indxI];
+        my_buf[1] += r[indxI+1] * p[indxI+1];
+      }
+    }
+    MPI_Allreduce(my_buf, buf, 2, MPI_DOUBLE, MPI_SUM, world);
+
+    for (k = 0; k < 2; k++) {
+      if (!active[k]) continue;
+      sig_old[k] = sig_new[k];
+      sig_new[k] = buf[k];
+      beta[k] = sig_new[k] / sig_old[k];
+      for (jj = 0; jj < nn; ++jj) {
+        ii = ilist[jj];
+        if (mask[ii] & groupbit) {
+          indxI = 2 * ii + k;
+          d[indxI] = p[indxI] + beta[k] * d[indxI];
+        }
+      }
+      niter[k] = i + 1;
+      active[k] = sqrt(sig_new[k]) / b_norm[k] > tolerance;
+    }
+  }
+
+  matvecs_s = niter[0];
+  matvecs_t = niter[1];
+
+  if ((i >= imax) && maxwarn && (comm->me == 0))
+    error->warning(FLERR,fmt::format("Fix qeq/reaxff CG convergence failed "
+                                     "after {} iterations at step {}",
+                                     i,update->ntimestep));
+  return matvecs_s + matvecs_t;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixQEqReaxFF::dual_sparse_matvec(sparse_matrix *A, double *x1, double *x2, double *b)
+{
+  int i, j, itr_j;
+  int ii, indxI, indxJ;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      b[indxI] = eta[atom->type[i]] * x1[i];
+      b[indxI+1] = eta[atom->type[i]] * x2[i];
+    }
+  }
+
+  int nall = atom->nlocal + atom->nghost;
+  for (i = 2*atom->nlocal; i < 2*nall; ++i)
+    b[i] = 0;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      for (itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        indxJ = 2 * j;
+        b[indxI] += A->val[itr_j] * x1[j];
+        b[indxI+1] += A->val[itr_j] * x2[j];
+        b[indxJ] += A->val[itr_j] * x1[i];
+        b[indxJ+1] += A->val[itr_j] * x2[i];
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixQEqReaxFF::dual_sparse_matvec(sparse_matrix *A, double *x, double *b)
+{
+  int i, j, itr_j;
+  int ii, indxI, indxJ;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      b[indxI] = eta[atom->type[i]] * x[indxI];
+      b[indxI+1] = eta[atom->type[i]] * x[indxI+1];
+    }
+  }
+
+  int nall = atom->nlocal + atom->nghost;
+  for (i = 2*atom->nlocal; i < 2*nall; ++i)
+    b[i] = 0;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      for (itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        indxJ = 2 * j;
+        b[indxI] += A->val[itr_j] * x[indxJ];
+        b[indxI+1] += A->val[itr_j] * x[indxJ+1];
+        b[indxJ] += A->val[itr_j] * x[indxI];
+        b[indxJ+1] += A->val[itr_j] * x[indxI+1];
+      }
+    }
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReaxFF::calculate_Q()
@@ -941,6 +1486,12 @@ double FixQEqReaxFF::memory_usage()
   if (dual_enabled)
     bytes += (double)atom->nmax*4 * sizeof(double); // double size for q, d, r, and p
 
+  if (precond != JACOBI) {
+    bytes += (double)nmax*3 * sizeof(int); // P.firstnbr, P.numnbrs, Ppos
+    bytes += (double)nmax*2 * sizeof(double); // Pdia, Pwork
+    bytes += (double)P_cap * (sizeof(int) + sizeof(double));
+  }
+
   return bytes;
 }
 
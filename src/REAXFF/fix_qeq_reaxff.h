@@ -55,6 +55,7 @@ class FixQEqReaxFF : public Fix {
   void min_pre_force(int) override;
 
   double compute_scalar() override;
+  double compute_vector(int) override;
 
  protected:
   int nevery, reaxflag;
@@ -109,16 +110,37 @@ class FixQEqReaxFF : public Fix {
   virtual void allocate_matrix();
   virtual void deallocate_matrix();
   void reallocate_matrix();
+  int matrix_too_small();
 
   virtual void init_matvec();
   void init_H();
   virtual void compute_H();
+  virtual void update_H();
+  void update_H_row(int);
   double calculate_H(double, double);
+
+  // keep the sparsity pattern of H between neighbor list builds
+
+  int keep_pattern;            // 1 if only the values of H are updated between builds
+  bigint pattern_step;         // count of the neighbor list build the pattern is from
   virtual void calculate_Q();
 
   virtual int CG(double *, double *);
   virtual void sparse_matvec(sparse_matrix *, double *, double *);
 
+  // optional preconditioners from the local block of H
+
+  enum { JACOBI, BJACOBI, ICHOL };
+  int precond;                 // preconditioner type
+  sparse_matrix P;             // local block of H (BJACOBI) or its IC(0) factor (ICHOL)
+  double *Pdia;                // diagonal of local block or of its IC(0) factor
+  int *Ppos;                   // position of local atom in ilist, -1 if not in block
+  double *Pwork;               // scatter array for the IC(0) factorization
+  int P_cap;                   // allocated size of P.jlist and P.val
+
+  virtual void build_precond();
+  void apply_precond(double *, double *, int);
+
   int pack_forward_comm(int, int *, double *, int, int *) override;
   void unpack_forward_comm(int, int, double *) override;
   int pack_reverse_comm(int, int, double *) override;
@@ -141,6 +163,12 @@ class FixQEqReaxFF : public Fix {
   // dual CG support
   int dual_enabled;            // 0: Original, separate s & t optimization; 1: dual optimization
   int matvecs_s, matvecs_t;    // Iteration count for each system
+  double time_solve;           // walltime of the last QEq solve
+  double time_total;           // accumulated walltime of all QEq solves
+
+  virtual int dual_CG(double *, double *, double *, double *);
+  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *, double *);
+  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *);
 };
 
 }    // namespace LAMMPS_NS
@@ -105,7 +105,7 @@ PairReaxFF::PairReaxFF(LAMMPS *lmp) : Pair(lmp)
   tmpid = nullptr;
   tmpbo = nullptr;
 
-  nextra = 14;
+  nextra = 16;
   pvector = new double[nextra];
 
   setup_flag = 0;
@@ -215,6 +215,7 @@ void PairReaxFF::settings(int narg, char **arg)
   qeqflag = 1;
   api->control->lgflag = 0;
   api->control->enobondsflag = 1;
+  api->control->screen_tol = 0.0;
   api->system->mincap = REAX_MIN_CAP;
   api->system->minhbonds = REAX_MIN_HBONDS;
   api->system->safezone = REAX_SAFE_ZONE;
@@ -266,6 +267,12 @@ void PairReaxFF::settings(int narg, char **arg)
       if (api->control->tabulate < 0)
         error->all(FLERR,"Illegal pair_style reaxff tabulate command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"screen") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal pair_style reaxff command");
+      api->control->screen_tol = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if (api->control->screen_tol < 0.0)
+        error->all(FLERR,"Illegal pair_style reaxff screen command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal pair_style reaxff command");
   }
 }
@@ -501,6 +508,7 @@ void PairReaxFF::compute(int eflag, int vflag)
     pvector[11] = api->data->my_en.e_ele;
     pvector[12] = 0.0;
     pvector[13] = api->data->my_en.e_pol;
+    screen_stats(pvector[14], pvector[15]);
   }
 
   if (vflag_fdotr) virial_fdotr_compute();
@@ -669,6 +677,23 @@ int PairReaxFF::write_reax_lists()
   return num_nbrs;
 }
 
+/* ----------------------------------------------------------------------
+   energy bounds of the angle and torsion terms skipped by screening
+   sum is local and summed by compute pair, largest bound is global
+   and stored on proc 0 only, so that the sum over procs is still the max
+------------------------------------------------------------------------- */
+
+void PairReaxFF::screen_stats(double &sum, double &max)
+{
+  sum = max = 0.0;
+  if (api->control->screen_tol <= 0.0) return;
+
+  double max_all;
+  sum = api->data->my_en.e_scr;
+  MPI_Reduce(&api->data->my_en.e_scr_max,&max_all,1,MPI_DOUBLE,MPI_MAX,0,world);
+  if (comm->me == 0) max = max_all;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairReaxFF::read_reax_forces(int /*vflag*/)
@@ -79,6 +79,7 @@ class PairReaxFF : public Pair {
   int estimate_reax_lists();
   int write_reax_lists();
   void read_reax_forces(int);
+  void screen_stats(double &, double &);
 
   int nmax;
   void FindBond();
@@ -115,6 +115,40 @@ namespace ReaxFF {
       sfree(workspace->forceReduction);
     if (workspace->valence_angle_atom_myoffset)
       sfree(workspace->valence_angle_atom_myoffset);
+
+    /* valence angle bonds */
+
+    Free_Angle_Bonds(workspace);
+  }
+
+  void Free_Angle_Bonds(storage *workspace)
+  {
+    sfree(workspace->angle_bond);
+    sfree(workspace->angle_d);
+    sfree(workspace->angle_dx);
+    sfree(workspace->angle_dy);
+    sfree(workspace->angle_dz);
+    sfree(workspace->angle_cos);
+    sfree(workspace->angle_pBO7);
+    workspace->angle_bond = nullptr;
+    workspace->angle_d = workspace->angle_dx = workspace->angle_dy = nullptr;
+    workspace->angle_dz = workspace->angle_cos = workspace->angle_pBO7 = nullptr;
+    workspace->angle_bond_cap = 0;
+  }
+
+  void Grow_Angle_Bonds(storage *workspace, LAMMPS_NS::Error *error, int n)
+  {
+    Free_Angle_Bonds(workspace);
+
+    int cap = MAX(n, 2*workspace->angle_bond_cap);
+    workspace->angle_bond = (int *) smalloc(error, cap * sizeof(int), "angle_bond");
+    workspace->angle_d = (double *) smalloc(error, cap * sizeof(double), "angle_d");
+    workspace->angle_dx = (double *) smalloc(error, cap * sizeof(double), "angle_dx");
+    workspace->angle_dy = (double *) smalloc(error, cap * sizeof(double), "angle_dy");
+    workspace->angle_dz = (double *) smalloc(error, cap * sizeof(double), "angle_dz");
+    workspace->angle_cos = (double *) smalloc(error, cap * sizeof(double), "angle_cos");
+    workspace->angle_pBO7 = (double *) smalloc(error, cap * sizeof(double), "angle_pBO7");
+    workspace->angle_bond_cap = cap;
   }
 
   void Allocate_Workspace(control_params *control, storage *workspace, int total_cap)
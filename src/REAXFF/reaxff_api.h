@@ -42,6 +42,8 @@ struct API {
 extern void Allocate_Workspace(control_params *, storage *, int);
 extern void DeAllocate_System(reax_system *);
 extern void DeAllocate_Workspace(storage *);
+extern void Free_Angle_Bonds(storage *);
+extern void Grow_Angle_Bonds(storage *, LAMMPS_NS::Error *, int);
 extern void PreAllocate_Space(reax_system *, storage *);
 extern void ReAllocate(reax_system *, control_params *, simulation_data *, storage *, reax_list **);
 
@@ -156,6 +158,8 @@ extern void Torsion_Angles(reax_system *, control_params *, simulation_data *, s
 
 extern void Calculate_Theta(rvec, double, rvec, double, double *, double *);
 extern void Calculate_dCos_Theta(rvec, double, rvec, double, rvec *, rvec *, rvec *);
+extern double Valence_Angle_Bound(reax_system *, three_body_parameters *, double, double, double,
+                                  double);
 extern void Valence_Angles(reax_system *, control_params *, simulation_data *, storage *,
                            reax_list **);
 
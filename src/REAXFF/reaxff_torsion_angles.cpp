@@ -45,10 +45,10 @@ namespace ReaxFF {
     double arg, poem, tel;
     rvec cross_jk_kl;
 
-    sin_ijk = sin(p_ijk->theta);
-    cos_ijk = cos(p_ijk->theta);
-    sin_jkl = sin(p_jkl->theta);
-    cos_jkl = cos(p_jkl->theta);
+    sin_ijk = p_ijk->sin_theta;
+    cos_ijk = p_ijk->cos_theta;
+    sin_jkl = p_jkl->sin_theta;
+    cos_jkl = p_jkl->cos_theta;
 
     if (sin_ijk >= 0 && sin_ijk <= MIN_SINE) sin_ijk = MIN_SINE;
     else if (sin_ijk <= 0 && sin_ijk >= -MIN_SINE) sin_ijk = -MIN_SINE;
@@ -128,7 +128,6 @@ namespace ReaxFF {
     double exp_tor1, exp_tor3_DjDk, exp_tor4_DjDk, exp_tor34_inv;
     double exp_cot2_jk, exp_cot2_ij, exp_cot2_kl;
     double fn10, f11_DjDk, dfn11, fn12;
-    double theta_ijk, theta_jkl;
     double sin_ijk, sin_jkl;
     double cos_ijk, cos_jkl;
     double tan_ijk_i, tan_jkl_i;
@@ -138,7 +137,7 @@ namespace ReaxFF {
     double CEtors5, CEtors6, CEtors7, CEtors8, CEtors9;
     double Cconj, CEconj1, CEconj2, CEconj3;
     double CEconj4, CEconj5, CEconj6;
-    double e_tor, e_con;
+    double e_tor, e_con, e_bound;
     rvec dvec_li;
     four_body_header *fbh;
     four_body_parameters *fbp;
@@ -213,9 +212,8 @@ namespace ReaxFF {
                 r_ij = pbond_ij->d;
                 BOA_ij = bo_ij->BO - control->thb_cut;
 
-                theta_ijk = p_ijk->theta;
-                sin_ijk = sin(theta_ijk);
-                cos_ijk = cos(theta_ijk);
+                sin_ijk = p_ijk->sin_theta;
+                cos_ijk = p_ijk->cos_theta;
                 //tan_ijk_i = 1. / tan(theta_ijk);
                 if (sin_ijk >= 0 && sin_ijk <= MIN_SINE)
                   tan_ijk_i = cos_ijk / MIN_SINE;
@@ -244,9 +242,28 @@ namespace ReaxFF {
                     r_kl = pbond_kl->d;
                     BOA_kl = bo_kl->BO - control->thb_cut;
 
-                    theta_jkl = p_jkl->theta;
-                    sin_jkl = sin(theta_jkl);
-                    cos_jkl = cos(theta_jkl);
+                    exp_tor1 = exp(fbp->p_tor1 *
+                                    SQR(2.0 - bo_jk->BO_pi - f11_DjDk));
+                    exp_tor2_kl = exp(-p_tor2 * BOA_kl);
+                    exp_cot2_kl = exp(-p_cot2 * SQR(BOA_kl - 1.5));
+                    fn10 = (1.0 - exp_tor2_ij) * (1.0 - exp_tor2_jk) *
+                      (1.0 - exp_tor2_kl);
+                    fn12 = exp_cot2_ij * exp_cot2_jk * exp_cot2_kl;
+
+                    /* skip the omega calculation if |e_tor| + |e_con|
+                       is bound to be below the screening tolerance */
+                    if (control->screen_tol > 0.0) {
+                      e_bound = fabs(fn10) * (fabs(fbp->V1) + fabs(fbp->V2) * exp_tor1 +
+                                              fabs(fbp->V3)) + fabs(fbp->p_cot1) * fn12;
+                      if (e_bound < control->screen_tol) {
+                        data->my_en.e_scr += e_bound;
+                        data->my_en.e_scr_max = MAX(data->my_en.e_scr_max, e_bound);
+                        continue;
+                      }
+                    }
+
+                    sin_jkl = p_jkl->sin_theta;
+                    cos_jkl = p_jkl->cos_theta;
                     //tan_jkl_i = 1. / tan(theta_jkl);
                     if (sin_jkl >= 0 && sin_jkl <= MIN_SINE)
                       tan_jkl_i = cos_jkl / MIN_SINE;
@@ -274,13 +291,6 @@ namespace ReaxFF {
                     /* end omega calculations */
 
                     /* torsion energy */
-                    exp_tor1 = exp(fbp->p_tor1 *
-                                    SQR(2.0 - bo_jk->BO_pi - f11_DjDk));
-                    exp_tor2_kl = exp(-p_tor2 * BOA_kl);
-                    exp_cot2_kl = exp(-p_cot2 * SQR(BOA_kl - 1.5));
-                    fn10 = (1.0 - exp_tor2_ij) * (1.0 - exp_tor2_jk) *
-                      (1.0 - exp_tor2_kl);
-
                     CV = 0.5 * (fbp->V1 * (1.0 + cos_omega) +
                                  fbp->V2 * exp_tor1 * (1.0 - cos2omega) +
                                  fbp->V3 * (1.0 + cos3omega));
@@ -316,7 +326,6 @@ namespace ReaxFF {
                     /* end  of torsion energy */
 
                     /* 4-body conjugation energy */
-                    fn12 = exp_cot2_ij * exp_cot2_jk * exp_cot2_kl;
                     data->my_en.e_con += e_con =
                       fbp->p_cot1 * fn12 *
                       (1.0 + (SQR(cos_omega) - 1.0) * sin_ijk * sin_jkl);
@@ -232,6 +232,7 @@ struct control_params {
 
   int lgflag;
   int enobondsflag;
+  double screen_tol;    // skip angles and torsions with smaller energy bound
   LAMMPS_NS::Error *error_ptr;
   LAMMPS_NS::LAMMPS *lmp_ptr;
   int me;
@@ -251,6 +252,8 @@ struct energy_data {
   double e_vdW;     // Total van der Waals energy
   double e_ele;     // Total electrostatics energy
   double e_pol;     // Polarization energy
+  double e_scr;     // Sum of energy bounds of screened out terms
+  double e_scr_max; // Largest energy bound of a screened out term
 };
 
 struct simulation_data {
@@ -261,7 +264,7 @@ struct simulation_data {
 struct three_body_interaction_data {
   int thb;
   int pthb;    // pointer to the third body on the central atom's nbrlist
-  double theta, cos_theta;
+  double theta, cos_theta, sin_theta;
   rvec dcos_di, dcos_dj, dcos_dk;
 };
 
@@ -336,6 +339,13 @@ struct storage {
   double *CdDelta;    // coefficient of dDelta
   rvec *f;
 
+  /* valence angles: bonds of the current central atom as arrays */
+  int angle_bond_cap;
+  int *angle_bond;                     // index of bonds with BO > thb_cut
+  double *angle_d, *angle_dx, *angle_dy, *angle_dz;
+  double *angle_cos;                   // cos of angles with the current bond
+  double *angle_pBO7;                  // BO^7 of all bonds
+
   /* omp */
   rvec *forceReduction;
   double *CdDeltaReduction;
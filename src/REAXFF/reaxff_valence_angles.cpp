@@ -67,15 +67,41 @@ namespace ReaxFF {
   }
 
 
+  /* upper bound of |e_ang| + |e_pen| + |e_coa| of one angle term.
+     uses 1 - exp(-x) <= x for the f7 factors, |f8_Dj| <= max(|p_val5|,|2 - p_val5|),
+     0 <= 1 - exp(-p_val2 * dtheta^2) <= 1, f9_Dj <= 2 and drops the coalition
+     factors that are <= 1. parameters for which these do not hold return
+     HUGE_VAL, so that the angle is always evaluated exactly */
+  double Valence_Angle_Bound(reax_system *system, three_body_parameters *thbp,
+                             double p_val3, double p_val5, double BOA_ij, double BOA_jk)
+  {
+    double p_pen2 = system->reax_param.gp.l[19];
+    double p_coa3 = system->reax_param.gp.l[38];
+    double p_coa4 = system->reax_param.gp.l[30];
+    double e_bound;
+
+    if (thbp->p_val2 < 0.0 || p_val3 < 0.0 || p_coa3 < 0.0) return HUGE_VAL;
+
+    e_bound = fabs(thbp->p_val1) * MAX(fabs(p_val5), fabs(2.0 - p_val5)) *
+      SQR(p_val3) * pow(BOA_ij * BOA_jk, thbp->p_val4);
+    if (thbp->p_pen1 != 0.0)
+      e_bound += 2.0 * fabs(thbp->p_pen1) *
+        exp(-p_pen2 * (SQR(BOA_ij - 2.0) + SQR(BOA_jk - 2.0)));
+    if (thbp->p_coa1 != 0.0)
+      e_bound += fabs(thbp->p_coa1) *
+        exp(-p_coa4 * (SQR(BOA_ij - 1.5) + SQR(BOA_jk - 1.5)));
+    return e_bound;
+  }
+
   void Valence_Angles(reax_system *system, control_params *control, simulation_data *data,
                       storage *workspace, reax_list **lists)
   {
-    int i, j, pi, k, pk, t;
+    int i, j, pi, k, pk, t, a, b;
     int type_i, type_j, type_k;
-    int start_j, end_j, start_pk, end_pk;
-    int cnt, num_thb_intrs;
+    int start_j, end_j, nbonds_j, narm, offset;
+    int cnt, num_thb_intrs, found;
 
-    double temp, temp_bo_jt, pBOjt7;
+    double temp, CEval5_sum, CEval6_sum, e_bound;
     double p_val1, p_val2, p_val3, p_val4, p_val5;
     double p_val6, p_val7, p_val8, p_val9, p_val10;
     double p_pen1, p_pen2, p_pen3, p_pen4;
@@ -104,6 +130,14 @@ namespace ReaxFF {
     reax_list *bonds = (*lists) + BONDS;
     reax_list *thb_intrs =  (*lists) + THREE_BODIES;
 
+    /* bonds of the current central atom with BO > thb_cut ("arms") as
+       arrays, so that the angle cosines of one arm with all others are
+       computed in a single vectorizable loop. only arms ever have
+       three-body entries that are used, by the angle energy here and by
+       the torsions, so entries with weaker bonds are skipped. */
+    int *arm;
+    double *arm_d, *arm_dx, *arm_dy, *arm_dz, *arm_cos, *pBO7;
+
     /* global parameters used in these calculations */
     p_val6 = system->reax_param.gp.l[14];
     p_val8 = system->reax_param.gp.l[33];
@@ -118,17 +152,43 @@ namespace ReaxFF {
       start_j = Start_Index(j, bonds);
       end_j = End_Index(j, bonds);
 
+      nbonds_j = end_j - start_j;
+
       p_val3 = system->reax_param.sbp[type_j].p_val3;
       p_val5 = system->reax_param.sbp[type_j].p_val5;
 
+      if (nbonds_j > workspace->angle_bond_cap)
+        Grow_Angle_Bonds(workspace, control->error_ptr, nbonds_j);
+      arm = workspace->angle_bond;
+      arm_d = workspace->angle_d;
+      arm_dx = workspace->angle_dx;
+      arm_dy = workspace->angle_dy;
+      arm_dz = workspace->angle_dz;
+      arm_cos = workspace->angle_cos;
+      pBO7 = workspace->angle_pBO7;
+
       SBOp = 0, prod_SBO = 1;
+      narm = 0;
       for (t = start_j; t < end_j; ++t) {
-        bo_jt = &(bonds->select.bond_list[t].bo_data);
+        pbond_jt = &(bonds->select.bond_list[t]);
+        bo_jt = &(pbond_jt->bo_data);
         SBOp += (bo_jt->BO_pi + bo_jt->BO_pi2);
         temp = SQR(bo_jt->BO);
         temp *= temp;
         temp *= temp;
         prod_SBO *= exp(-temp);
+
+        temp = CUBE(bo_jt->BO);
+        pBO7[t - start_j] = temp * temp * bo_jt->BO;
+
+        if (bo_jt->BO - control->thb_cut > 0.0) {
+          arm[narm] = t;
+          arm_d[narm] = pbond_jt->d;
+          arm_dx[narm] = pbond_jt->dvec[0];
+          arm_dy[narm] = pbond_jt->dvec[1];
+          arm_dz[narm] = pbond_jt->dvec[2];
+          ++narm;
+        }
       }
 
       if (workspace->vlpex[j] >= 0) {
@@ -157,40 +217,55 @@ namespace ReaxFF {
 
       expval6 = exp(p_val6 * workspace->Delta_boc[j]);
 
+      CEval5_sum = CEval6_sum = 0.0;
+      found = 0;
+      a = 0;
+
       for (pi = start_j; pi < end_j; ++pi) {
         Set_Start_Index(pi, num_thb_intrs, thb_intrs);
         pbond_ij = &(bonds->select.bond_list[pi]);
         bo_ij = &(pbond_ij->bo_data);
         BOA_ij = bo_ij->BO - control->thb_cut;
 
+        // pi is arm a-1. the lists of the arms before it end with one
+        // entry for each later arm, so the entry for pi is at a fixed offset
+        if (BOA_ij > 0.0) ++a;
+        offset = a - 1 - narm;
 
         if (BOA_ij/*bo_ij->BO*/ > 0.0 &&
              (j < system->n || pbond_ij->nbr < system->n)) {
           i = pbond_ij->nbr;
           type_i = system->my_atoms[i].type;
 
-          for (pk = start_j; pk < pi; ++pk) {
-            start_pk = Start_Index(pk, thb_intrs);
-            end_pk = End_Index(pk, thb_intrs);
+          for (b = 0; b < a-1; ++b) {
+            pk = arm[b];
+            if (Num_Entries(pk, thb_intrs) == 0) continue;
 
-            for (t = start_pk; t < end_pk; ++t)
-              if (thb_intrs->select.three_body_list[t].thb == i) {
-                p_ijk = &(thb_intrs->select.three_body_list[num_thb_intrs]);
-                p_kji = &(thb_intrs->select.three_body_list[t]);
+            p_ijk = &(thb_intrs->select.three_body_list[num_thb_intrs]);
+            p_kji = &(thb_intrs->select.three_body_list[End_Index(pk, thb_intrs) + offset]);
 
-                p_ijk->thb = bonds->select.bond_list[pk].nbr;
-                p_ijk->pthb  = pk;
-                p_ijk->theta = p_kji->theta;
-                rvec_Copy(p_ijk->dcos_di, p_kji->dcos_dk);
-                rvec_Copy(p_ijk->dcos_dj, p_kji->dcos_dj);
-                rvec_Copy(p_ijk->dcos_dk, p_kji->dcos_di);
+            p_ijk->thb = bonds->select.bond_list[pk].nbr;
+            p_ijk->pthb  = pk;
+            p_ijk->theta = p_kji->theta;
+            p_ijk->cos_theta = p_kji->cos_theta;
+            p_ijk->sin_theta = p_kji->sin_theta;
+            rvec_Copy(p_ijk->dcos_di, p_kji->dcos_dk);
+            rvec_Copy(p_ijk->dcos_dj, p_kji->dcos_dj);
+            rvec_Copy(p_ijk->dcos_dk, p_kji->dcos_di);
 
-                ++num_thb_intrs;
-                break;
-              }
+            ++num_thb_intrs;
+          }
+
+          for (b = a; b < narm; ++b) {
+            cos_theta = (arm_dx[a-1] * arm_dx[b] + arm_dy[a-1] * arm_dy[b] +
+                         arm_dz[a-1] * arm_dz[b]) / (arm_d[a-1] * arm_d[b]);
+            if (cos_theta > 1.) cos_theta = 1.0;
+            if (cos_theta < -1.) cos_theta = -1.0;
+            arm_cos[b] = cos_theta;
           }
 
-          for (pk = pi+1; pk < end_j; ++pk) {
+          for (b = a; b < narm; ++b) {
+            pk       = arm[b];
             pbond_jk = &(bonds->select.bond_list[pk]);
             bo_jk    = &(pbond_jk->bo_data);
             BOA_jk   = bo_jk->BO - control->thb_cut;
@@ -198,9 +273,7 @@ namespace ReaxFF {
             type_k   = system->my_atoms[k].type;
             p_ijk    = &(thb_intrs->select.three_body_list[num_thb_intrs]);
 
-            Calculate_Theta(pbond_ij->dvec, pbond_ij->d,
-                             pbond_jk->dvec, pbond_jk->d,
-                             &theta, &cos_theta);
+            theta = acos(arm_cos[b]);
 
             Calculate_dCos_Theta(pbond_ij->dvec, pbond_ij->d,
                                   pbond_jk->dvec, pbond_jk->d,
@@ -211,14 +284,14 @@ namespace ReaxFF {
             p_ijk->theta = theta;
 
             sin_theta = sin(theta);
+            p_ijk->cos_theta = cos(theta);
+            p_ijk->sin_theta = sin_theta;
             if (sin_theta < 1.0e-5)
               sin_theta = 1.0e-5;
 
             ++num_thb_intrs;
 
-            if ((j < system->n) && (BOA_jk > 0.0) &&
-                (bo_ij->BO > control->thb_cut) &&
-                (bo_jk->BO > control->thb_cut) &&
+            if ((j < system->n) &&
                 (bo_ij->BO * bo_jk->BO > control->thb_cutsq)) {
               thbh = &(system->reax_param.thbp[type_i][type_j][type_k]);
 
@@ -226,6 +299,17 @@ namespace ReaxFF {
                 if (fabs(thbh->prm[cnt].p_val1) > 0.001) {
                   thbp = &(thbh->prm[cnt]);
 
+                  /* skip the angle if its energy is bound to be below
+                     the screening tolerance */
+                  if (control->screen_tol > 0.0) {
+                    e_bound = Valence_Angle_Bound(system, thbp, p_val3, p_val5, BOA_ij, BOA_jk);
+                    if (e_bound < control->screen_tol) {
+                      data->my_en.e_scr += e_bound;
+                      data->my_en.e_scr_max = MAX(data->my_en.e_scr_max, e_bound);
+                      continue;
+                    }
+                  }
+
                   /* ANGLE ENERGY */
                   p_val1 = thbp->p_val1;
                   p_val2 = thbp->p_val2;
@@ -332,17 +416,10 @@ namespace ReaxFF {
                   workspace->CdDelta[i] += CEcoa4;
                   workspace->CdDelta[k] += CEcoa5;
 
-                  for (t = start_j; t < end_j; ++t) {
-                    pbond_jt = &(bonds->select.bond_list[t]);
-                    bo_jt = &(pbond_jt->bo_data);
-                    temp_bo_jt = bo_jt->BO;
-                    temp = CUBE(temp_bo_jt);
-                    pBOjt7 = temp * temp * temp_bo_jt;
-
-                    bo_jt->Cdbo += (CEval6 * pBOjt7);
-                    bo_jt->Cdbopi += CEval5;
-                    bo_jt->Cdbopi2 += CEval5;
-                  }
+                  // contributions to all bonds of j are summed up first
+                  CEval5_sum += CEval5;
+                  CEval6_sum += CEval6;
+                  found = 1;
 
                   rvec_ScaledAdd(workspace->f[i], CEval8, p_ijk->dcos_di);
                   rvec_ScaledAdd(workspace->f[j], CEval8, p_ijk->dcos_dj);
@@ -373,6 +450,15 @@ namespace ReaxFF {
 
         Set_End_Index(pi, num_thb_intrs, thb_intrs);
       }
+
+      if (found) {
+        for (t = start_j; t < end_j; ++t) {
+          bo_jt = &(bonds->select.bond_list[t].bo_data);
+          bo_jt->Cdbo += (CEval6_sum * pBO7[t - start_j]);
+          bo_jt->Cdbopi += CEval5_sum;
+          bo_jt->Cdbopi2 += CEval5_sum;
+        }
+      }
     }
 
     if (num_thb_intrs >= thb_intrs->num_intrs * DANGER_ZONE) {
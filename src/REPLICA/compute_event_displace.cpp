@@ -91,51 +91,7 @@ double ComputeEventDisplace::compute_scalar()
   if (id_event == nullptr) return 0.0;
 
   double event = 0.0;
-  double **xevent = fix_event->array_atom;
-
-  double **x = atom->x;
-  int *mask = atom->mask;
-  imageint *image = atom->image;
-  int nlocal = atom->nlocal;
-
-  double *h = domain->h;
-  double xprd = domain->xprd;
-  double yprd = domain->yprd;
-  double zprd = domain->zprd;
-  int xbox,ybox,zbox;
-  double dx,dy,dz,rsq;
-
-  if (triclinic == 0) {
-    for (int i = 0; i < nlocal; i++)
-      if (mask[i] & groupbit) {
-        xbox = (image[i] & IMGMASK) - IMGMAX;
-        ybox = (image[i] >> IMGBITS & IMGMASK) - IMGMAX;
-        zbox = (image[i] >> IMG2BITS) - IMGMAX;
-        dx = x[i][0] + xbox*xprd - xevent[i][0];
-        dy = x[i][1] + ybox*yprd - xevent[i][1];
-        dz = x[i][2] + zbox*zprd - xevent[i][2];
-        rsq = dx*dx + dy*dy + dz*dz;
-        if (rsq >= displace_distsq) {
-          event = 1.0;
-          break;
-        }
-      }
-  } else {
-    for (int i = 0; i < nlocal; i++)
-      if (mask[i] & groupbit) {
-        xbox = (image[i] & IMGMASK) - IMGMAX;
-        ybox = (image[i] >> IMGBITS & IMGMASK) - IMGMAX;
-        zbox = (image[i] >> IMG2BITS) - IMGMAX;
-        dx = x[i][0] + h[0]*xbox + h[5]*ybox + h[4]*zbox - xevent[i][0];
-        dy = x[i][1] + h[1]*ybox + h[3]*zbox - xevent[i][1];
-        dz = x[i][2] + h[2]*zbox - xevent[i][2];
-        rsq = dx*dx + dy*dy + dz*dz;
-        if (rsq >= displace_distsq) {
-          event = 1.0;
-          break;
-        }
-      }
-  }
+  if (displaced(displace_distsq,0)) event = 1.0;
 
   MPI_Allreduce(&event,&scalar,1,MPI_DOUBLE,MPI_SUM,world);
 
@@ -152,6 +108,39 @@ int ComputeEventDisplace::all_events()
 
   if (id_event == nullptr) return 0.0;
 
+  int event = displaced(displace_distsq,1);
+
+  int allevents;
+  MPI_Allreduce(&event,&allevents,1,MPI_INT,MPI_SUM,world);
+
+  return allevents;
+}
+
+/* ----------------------------------------------------------------------
+   return non-zero if any atom has moved >= dist since last event
+   applied to unquenched coords as cheap pre-check before a quench
+   does not set invoked_scalar, since it is not the compute value
+------------------------------------------------------------------------- */
+
+int ComputeEventDisplace::screen(double dist)
+{
+  if (id_event == nullptr) return 0;
+
+  int flag = displaced(dist*dist,0);
+
+  int flagall;
+  MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,world);
+
+  return flagall;
+}
+
+/* ----------------------------------------------------------------------
+   count owned atoms in group that moved >= sqrt(distsq) since last event
+   if allflag = 0, stop at first such atom
+------------------------------------------------------------------------- */
+
+int ComputeEventDisplace::displaced(double distsq, int allflag)
+{
   int event = 0;
   double **xevent = fix_event->array_atom;
 
@@ -167,36 +156,28 @@ int ComputeEventDisplace::all_events()
   int xbox,ybox,zbox;
   double dx,dy,dz,rsq;
 
-  if (triclinic == 0) {
-    for (int i = 0; i < nlocal; i++)
-      if (mask[i] & groupbit) {
-        xbox = (image[i] & IMGMASK) - IMGMAX;
-        ybox = (image[i] >> IMGBITS & IMGMASK) - IMGMAX;
-        zbox = (image[i] >> IMG2BITS) - IMGMAX;
+  for (int i = 0; i < nlocal; i++)
+    if (mask[i] & groupbit) {
+      xbox = (image[i] & IMGMASK) - IMGMAX;
+      ybox = (image[i] >> IMGBITS & IMGMASK) - IMGMAX;
+      zbox = (image[i] >> IMG2BITS) - IMGMAX;
+      if (triclinic == 0) {
         dx = x[i][0] + xbox*xprd - xevent[i][0];
         dy = x[i][1] + ybox*yprd - xevent[i][1];
         dz = x[i][2] + zbox*zprd - xevent[i][2];
-        rsq = dx*dx + dy*dy + dz*dz;
-        if (rsq >= displace_distsq) event++;
-      }
-  } else {
-    for (int i = 0; i < nlocal; i++)
-      if (mask[i] & groupbit) {
-        xbox = (image[i] & IMGMASK) - IMGMAX;
-        ybox = (image[i] >> IMGBITS & IMGMASK) - IMGMAX;
-        zbox = (image[i] >> IMG2BITS) - IMGMAX;
+      } else {
         dx = x[i][0] + h[0]*xbox + h[5]*ybox + h[4]*zbox - xevent[i][0];
         dy = x[i][1] + h[1]*ybox + h[3]*zbox - xevent[i][1];
         dz = x[i][2] + h[2]*zbox - xevent[i][2];
-        rsq = dx*dx + dy*dy + dz*dz;
-        if (rsq >= displace_distsq) event++;
       }
-  }
-
-  int allevents;
-  MPI_Allreduce(&event,&allevents,1,MPI_INT,MPI_SUM,world);
+      rsq = dx*dx + dy*dy + dz*dz;
+      if (rsq >= distsq) {
+        event++;
+        if (!allflag) break;
+      }
+    }
 
-  return allevents;
+  return event;
 }
 
 /* ---------------------------------------------------------------------- */
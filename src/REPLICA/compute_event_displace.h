@@ -32,6 +32,7 @@ class ComputeEventDisplace : public Compute {
   double compute_scalar() override;
 
   int all_events();
+  int screen(double);
   void reset_extra_compute_fix(const char *) override;
 
  private:
@@ -39,6 +40,8 @@ class ComputeEventDisplace : public Compute {
   double displace_distsq;
   char *id_event;
   class FixEvent *fix_event;
+
+  int displaced(double, int);
 };
 
 }    // namespace LAMMPS_NS
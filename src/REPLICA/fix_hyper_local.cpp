@@ -49,7 +49,7 @@ enum{IGNORE,WARN,ERROR};
 FixHyperLocal::FixHyperLocal(LAMMPS *lmp, int narg, char **arg) :
   FixHyper(lmp, narg, arg), blist(nullptr), biascoeff(nullptr), numbond(nullptr),
   maxhalf(nullptr), eligible(nullptr), maxhalfstrain(nullptr), old2now(nullptr),
-  tagold(nullptr), xold(nullptr), maxstrain(nullptr), maxstrain_domain(nullptr),
+  tagold(nullptr), xold(nullptr), strainold(nullptr), maxstrain(nullptr), maxstrain_domain(nullptr),
   biasflag(nullptr), bias(nullptr), cpage(nullptr), clist(nullptr), numcoeff(nullptr)
 {
   // error checks
@@ -65,8 +65,8 @@ FixHyperLocal::FixHyperLocal(LAMMPS *lmp, int narg, char **arg) :
   scalar_flag = 1;
   energy_global_flag = 1;
   vector_flag = 1;
-  size_vector = 26;
-  //size_vector = 28;   // can add 2 for debugging
+  size_vector = 31;
+  //size_vector = 33;   // can add 2 for debugging
   local_flag = 1;
   size_local_rows = 0;
   size_local_cols = 0;
@@ -152,6 +152,8 @@ FixHyperLocal::FixHyperLocal(LAMMPS *lmp, int narg, char **arg) :
   xold = nullptr;
   tagold = nullptr;
   old2now = nullptr;
+  strainold = nullptr;
+  ghostflag = 1;
 
   nbias = maxbias = 0;
   bias = nullptr;
@@ -222,6 +224,7 @@ FixHyperLocal::~FixHyperLocal()
   memory->destroy(xold);
   memory->destroy(tagold);
   memory->destroy(old2now);
+  memory->destroy(strainold);
 
   memory->destroy(bias);
 
@@ -260,6 +263,7 @@ void FixHyperLocal::init_hyper()
 
   nbondbuild = 0;
   time_bondbuild = 0.0;
+  time_remap = time_strain = time_domain = time_bias = time_comm = 0.0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -322,11 +326,6 @@ void FixHyperLocal::init()
 
   req = neighbor->add_request(this, NeighConst::REQ_OCCASIONAL);
   req->set_id(2);
-
-  // extra timing output
-
-  //timefirst = timesecond = timethird = timefourth = timefifth =
-  //  timesixth = timeseventh = timetotal = 0.0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -378,6 +377,8 @@ void FixHyperLocal::pre_neighbor()
   //   drift = displacement from quenched coord while event has not yet occurred
   // NOTE: drift calc is now done in bond_build(), between 2 quenched states
 
+  double time1 = platform::walltime();
+
   for (i = 0; i < nall_old; i++) old2now[i] = -1;
 
   for (m = 0; m < nblocal; m++) {
@@ -425,6 +426,21 @@ void FixHyperLocal::pre_neighbor()
     old2now[iold] = ilocal;
     if (ilocal < 0) ghost_toofar++;
   }
+
+  // ghostflag = 1 if any old owned atom is now a ghost atom on any proc
+  // only then can stage 2 of pre_reverse() set maxstrain_domain of a ghost,
+  //   otherwise its reverse comm can be skipped
+
+  int nlocal = atom->nlocal;
+  int flag = 0;
+  for (iold = 0; iold < nlocal_old; iold++)
+    if (old2now[iold] >= nlocal) {
+      flag = 1;
+      break;
+    }
+  MPI_Allreduce(&flag,&ghostflag,1,MPI_INT,MPI_MAX,world);
+
+  time_remap += platform::walltime() - time1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -437,8 +453,8 @@ void FixHyperLocal::pre_reverse(int /* eflag */, int /* vflag */)
   double halfstrain,selfstrain;
   int *ilist,*jlist,*numneigh,**firstneigh;
 
-  //double time1,time2,time3,time4,time5,time6,time7,time8;
-  //time1 = platform::walltime();
+  double time1,time2,time3,time4,time5,time6;
+  time1 = platform::walltime();
 
   nostrainyet = 0;
 
@@ -511,18 +527,23 @@ void FixHyperLocal::pre_reverse(int /* eflag */, int /* vflag */)
     maxhalfstrain[iold] = halfstrain;
   }
 
-  //time2 = platform::walltime();
+  time2 = platform::walltime();
+  time_strain += time2 - time1;
 
   // reverse comm acquires maxstrain of all current owned atoms
   //   needed b/c only saw half the bonds of each atom
   //   also needed b/c bond list may refer to old owned atoms that are now ghost
   // forward comm acquires maxstrain of all current ghost atoms
+  // cannot be packed with the STRAINDOMAIN comm below,
+  //   b/c stage 2 needs maxstrain of ghost atoms to compute maxstrain_domain
+  // bias coeffs are only communicated when the bond list is built
 
   commflag = STRAIN;
   comm->reverse_comm(this);
   comm->forward_comm(this);
 
-  //time3 = platform::walltime();
+  time3 = platform::walltime();
+  time_comm += time3 - time2;
 
   // -------------------------------------------------------------
   // stage 2:
@@ -545,6 +566,15 @@ void FixHyperLocal::pre_reverse(int /* eflag */, int /* vflag */)
 
   for (i = 0; i < nall; i++) maxstrain_domain[i] = 0.0;
 
+  // gather maxstrain of old atoms once, so the loop over Dcut neighbors
+  //   needs neither old2now[] nor a test for a drifted J atom
+
+  for (iold = 0; iold < nall_old; iold++) {
+    j = old2now[iold];
+    if (j < 0) strainold[iold] = qfactor;
+    else strainold[iold] = maxstrain[j];
+  }
+
   inum = listfull->inum;
   ilist = listfull->ilist;
   numneigh = listfull->numneigh;
@@ -581,24 +611,17 @@ void FixHyperLocal::pre_reverse(int /* eflag */, int /* vflag */)
 
     for (jj = 0; jj < jnum; jj++) {
       jold = jlist[jj];
-      j = old2now[jold];
-
-      // special case for missing (drifted) J atom
-
-      if (j < 0) {
-        emax = MAX(emax,qfactor);
-        if (selfstrain == qfactor) ncount++;
-        continue;
-      }
+      estrain = strainold[jold];
 
-      emax = MAX(emax,maxstrain[j]);
-      if (selfstrain == maxstrain[j]) ncount++;
+      emax = MAX(emax,estrain);
+      if (selfstrain == estrain) ncount++;
 
       // optional diagnostic
       // tally largest distance from subbox that a ghost atom is (rmaxbig)
       // and the largest distance if strain < qfactor (rmax)
 
       if (checkghost) {
+        j = old2now[jold];
         if (j >= nlocal) {
           if (x[j][0] < sublo[0]) rmaxbig = MAX(rmaxbig,sublo[0]-x[j][0]);
           if (x[j][1] < sublo[1]) rmaxbig = MAX(rmaxbig,sublo[1]-x[j][1]);
@@ -627,17 +650,20 @@ void FixHyperLocal::pre_reverse(int /* eflag */, int /* vflag */)
     maxstrain_domain[i] = emax;
   }
 
-  //time4 = platform::walltime();
+  time4 = platform::walltime();
+  time_domain += time4 - time3;
 
   // reverse comm to acquire maxstrain_domain from ghost atoms
   //   needed b/c neigh list may refer to old owned atoms that are now ghost
+  //   skipped if there are none, see pre_neighbor()
   // forward comm acquires maxstrain_domain of all current ghost atoms
 
   commflag = STRAINDOMAIN;
-  comm->reverse_comm(this);
+  if (ghostflag) comm->reverse_comm(this);
   comm->forward_comm(this);
 
-  //time5 = platform::walltime();
+  time5 = platform::walltime();
+  time_comm += time5 - time4;
 
   // -------------------------------------------------------------
   // stage 3:
@@ -663,8 +689,6 @@ void FixHyperLocal::pre_reverse(int /* eflag */, int /* vflag */)
     bias[nbias++] = maxhalf[iold];
   }
 
-  //time6 = platform::walltime();
-
   // -------------------------------------------------------------
   // stage 4:
   // apply bias force to bonds with locally max strain
@@ -715,7 +739,8 @@ void FixHyperLocal::pre_reverse(int /* eflag */, int /* vflag */)
     // myboost += exp(beta * biascoeff[m]*vbias);
   }
 
-  //time7 = platform::walltime();
+  time6 = platform::walltime();
+  time_bias += time6 - time5;
 
   // -------------------------------------------------------------
   // stage 5:
@@ -775,6 +800,8 @@ void FixHyperLocal::pre_reverse(int /* eflag */, int /* vflag */)
     sumboost_me += boost_domain;
   }
 
+  time_bias += platform::walltime() - time6;
+
   // -------------------------------------------------------------
   // diagnostics, some optional
   // -------------------------------------------------------------
@@ -1038,10 +1065,12 @@ void FixHyperLocal::build_bond_list(int natom)
     memory->destroy(xold);
     memory->destroy(tagold);
     memory->destroy(old2now);
+    memory->destroy(strainold);
     maxall = atom->nmax;
     memory->create(xold,maxall,3,"hyper/local:xold");
     memory->create(tagold,maxall,"hyper/local:tagold");
     memory->create(old2now,maxall,"hyper/local:old2now");
+    memory->create(strainold,maxall,"hyper/local:strainold");
   }
 
   // nlocal_old = value of nlocal at time bonds are built
@@ -1052,6 +1081,7 @@ void FixHyperLocal::build_bond_list(int natom)
 
   nlocal_old = nlocal;
   nall_old = nall;
+  ghostflag = 1;
 
   memcpy(&xold[0][0],&x[0][0],3*nall*sizeof(double));
   for (i = 0; i < nall; i++) tagold[i] = 0;
@@ -1463,7 +1493,7 @@ double FixHyperLocal::compute_scalar()
 
 double FixHyperLocal::compute_vector(int i)
 {
-  // 26 vector outputs returned for i = 0-25
+  // 31 vector outputs returned for i = 0-30
   // can add 2 more for debugging
 
   // i = 0 = average boost for all bonds on this step
@@ -1499,9 +1529,16 @@ double FixHyperLocal::compute_vector(int i)
   // i = 24 = cumulative # of atoms in events since fix created
   // i = 25 = cumulative # of new bonds formed since fix created
 
+  // i = 26 = wall time remapping bonds on reneighbor steps during this run
+  // i = 27 = wall time computing bond strains during this run
+  // i = 28 = wall time computing max strain within Dcut during this run
+  // i = 29 = wall time computing bias and boostostat during this run
+  // i = 30 = wall time communicating strains during this run
+  // all 5 times are max over procs
+
   // these 2 can be added for debugging
-  // i = 26 = average boost for biased bonds on this step
-  // i = 27 = current count of bonds with strain >= q
+  // i = 31 = average boost for biased bonds on this step
+  // i = 32 = current count of bonds with strain >= q
 
   if (i == 0) {
     if (allbonds) return sumboost/allbonds;
@@ -1656,10 +1693,22 @@ double FixHyperLocal::compute_vector(int i)
     return (double) allnewbond;
   }
 
+  if (i >= 26 && i <= 30) {
+    double time;
+    if (i == 26) time = time_remap;
+    else if (i == 27) time = time_strain;
+    else if (i == 28) time = time_domain;
+    else if (i == 29) time = time_bias;
+    else time = time_comm;
+    double timeall;
+    MPI_Allreduce(&time,&timeall,1,MPI_DOUBLE,MPI_MAX,world);
+    return timeall;
+  }
+
   // these two options can be added for debugging
 
   /*
-  if (i == 26) {
+  if (i == 31) {
     double allboost;
     MPI_Allreduce(&myboost,&allboost,1,MPI_DOUBLE,MPI_SUM,world);
     int nbiasall;
@@ -1668,7 +1717,7 @@ double FixHyperLocal::compute_vector(int i)
     return 1.0;
   }
 
-  if (i == 27) {
+  if (i == 32) {
     int allovercount;
     MPI_Allreduce(&overcount,&allovercount,1,MPI_INT,MPI_SUM,world);
     return (double) allovercount;
@@ -96,6 +96,12 @@ class FixHyperLocal : public FixHyper {
   int nbondbuild;           // # of rebuilds of bond list
   double time_bondbuild;    // CPU time for bond builds
 
+  double time_remap;     // wall time to remap bond atoms on reneighbor
+  double time_strain;    // wall time for bond strains (stage 1)
+  double time_domain;    // wall time for maxstrain within Dcut (stage 2)
+  double time_bias;      // wall time for bias forces and boostostat
+  double time_comm;      // wall time for forward/reverse comm in pre_reverse
+
   bigint allbonds;       // current total # of bonds
   int maxbondperatom;    // max # of bonds any atom ever has
   int nevent;            // # of events that trigger bond rebuild
@@ -165,6 +171,9 @@ class FixHyperLocal : public FixHyper {
   tagint *tagold;    // IDs of atoms when bonds were formed
                      // 0 if a ghost atom is not in Dcut neigh list
   double **xold;     // coords of atoms when bonds were formed
+  double *strainold;    // maxstrain of old atoms on this step
+                        // qfactor if a ghost atom has drifted
+  int ghostflag;        // 1 if any old owned atom is now a ghost on any proc
 
   // vectors used to find maxstrain bonds within a local domain
 
@@ -190,11 +199,6 @@ class FixHyperLocal : public FixHyper {
   int *numcoeff;                   // # of bias coeffs per atom (one per bond)
   int maxcoeff;                    // allocate sized of clist and numcoeff
 
-  // extra timers
-
-  //double timefirst,timesecond,timethird,timefourth;
-  //double timefifth,timesixth,timeseventh,timetotal;
-
   // private methods
 
   void grow_bond();
@@ -27,6 +27,7 @@
 #include "math_const.h"
 #include "memory.h"
 #include "modify.h"
+#include "neighbor.h"
 #include "universe.h"
 #include "update.h"
 
@@ -40,16 +41,17 @@ using namespace MathConst;
 enum { SINGLE_PROC_DIRECT, SINGLE_PROC_MAP, MULTI_PROC };
 enum { NEIGHBOR, IDEAL, EQUAL };
 
-#define BUFSIZE 8
+#define BUFSIZE 10
 
 /* ---------------------------------------------------------------------- */
 
 FixNEB::FixNEB(LAMMPS *lmp, int narg, char **arg) :
     Fix(lmp, narg, arg), id_pe(nullptr), pe(nullptr), nlenall(nullptr), vengall(nullptr),
     xprev(nullptr), xnext(nullptr), fnext(nullptr), springF(nullptr), tangent(nullptr),
-    xsend(nullptr), xrecv(nullptr), fsend(nullptr), frecv(nullptr), tagsend(nullptr),
-    tagrecv(nullptr), xsendall(nullptr), xrecvall(nullptr), fsendall(nullptr), frecvall(nullptr),
-    tagsendall(nullptr), tagrecvall(nullptr), counts(nullptr), displacements(nullptr)
+    xsend(nullptr), fsend(nullptr), tagsend(nullptr), xsendall(nullptr), fsendall(nullptr),
+    tagsendall(nullptr), xprevall(nullptr), xnextall(nullptr), fnextall(nullptr),
+    tagprevall(nullptr), tagnextall(nullptr), counts(nullptr), displacements(nullptr),
+    mapprev(nullptr), mapnext(nullptr)
 {
 
   if (narg < 4) error->all(FLERR, "Illegal fix neb command");
@@ -158,10 +160,16 @@ FixNEB::FixNEB(LAMMPS *lmp, int narg, char **arg) :
   id_pe = utils::strdup(std::string(id) + "_pe");
   modify->add_compute(std::string(id_pe) + " all pe");
 
+  MPI_Type_contiguous(3, MPI_DOUBLE, &vec3type);
+  MPI_Type_commit(&vec3type);
+
   // initialize local storage
 
   maxlocal = -1;
   ntotal = -1;
+  nrequests = 0;
+  nlocal_requests = -1;
+  x_requests = f_requests = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -177,21 +185,25 @@ FixNEB::~FixNEB()
   memory->destroy(fnext);
   memory->destroy(springF);
   memory->destroy(xsend);
-  memory->destroy(xrecv);
   memory->destroy(fsend);
-  memory->destroy(frecv);
   memory->destroy(tagsend);
-  memory->destroy(tagrecv);
 
   memory->destroy(xsendall);
-  memory->destroy(xrecvall);
   memory->destroy(fsendall);
-  memory->destroy(frecvall);
   memory->destroy(tagsendall);
-  memory->destroy(tagrecvall);
+  memory->destroy(xprevall);
+  memory->destroy(xnextall);
+  memory->destroy(fnextall);
+  memory->destroy(tagprevall);
+  memory->destroy(tagnextall);
 
   memory->destroy(counts);
   memory->destroy(displacements);
+  memory->destroy(mapprev);
+  memory->destroy(mapnext);
+
+  for (int i = 0; i < nrequests; i++) MPI_Request_free(&requests[i]);
+  MPI_Type_free(&vec3type);
 
   if ((neb_mode == IDEAL) || (neb_mode == EQUAL)) {
     if (rootworld != MPI_COMM_NULL) MPI_Comm_free(&rootworld);
@@ -243,15 +255,19 @@ void FixNEB::init()
 
   if (atom->nmax > maxlocal) reallocate();
 
-  if ((cmode == MULTI_PROC) && (counts == nullptr)) {
-    memory->create(xsendall, ntotal, 3, "neb:xsendall");
-    memory->create(xrecvall, ntotal, 3, "neb:xrecvall");
+  if ((cmode != SINGLE_PROC_DIRECT) && (counts == nullptr)) {
+    memory->create(xsendall, ntotal + 1, 3, "neb:xsendall");
     memory->create(fsendall, ntotal, 3, "neb:fsendall");
-    memory->create(frecvall, ntotal, 3, "neb:frecvall");
     memory->create(tagsendall, ntotal, "neb:tagsendall");
-    memory->create(tagrecvall, ntotal, "neb:tagrecvall");
+    memory->create(xprevall, ntotal + 1, 3, "neb:xprevall");
+    memory->create(xnextall, ntotal + 1, 3, "neb:xnextall");
+    memory->create(fnextall, ntotal, 3, "neb:fnextall");
+    memory->create(tagprevall, ntotal, "neb:tagprevall");
+    memory->create(tagnextall, ntotal, "neb:tagnextall");
     memory->create(counts, nprocs, "neb:counts");
     memory->create(displacements, nprocs, "neb:displacements");
+    memory->create(mapprev, ntotal, 2, "neb:mapprev");
+    memory->create(mapnext, ntotal, 2, "neb:mapnext");
   }
 }
 
@@ -259,6 +275,10 @@ void FixNEB::init()
 
 void FixNEB::min_setup(int vflag)
 {
+  // send atom IDs to adjacent replicas with first exchange
+
+  tagstamp = -1;
+
   min_post_force(vflag);
 
   // trigger potential energy computation on next timestep
@@ -276,17 +296,27 @@ void FixNEB::min_post_force(int /*vflag*/)
 
   vprev = vnext = veng = pe->compute_scalar();
 
-  if (ireplica < nreplica - 1 && me == 0) MPI_Send(&veng, 1, MPI_DOUBLE, procnext, 0, uworld);
-  if (ireplica > 0 && me == 0)
-    MPI_Recv(&vprev, 1, MPI_DOUBLE, procprev, 0, uworld, MPI_STATUS_IGNORE);
+  // exchange energies with both adjacent replicas at once
 
-  if (ireplica > 0 && me == 0) MPI_Send(&veng, 1, MPI_DOUBLE, procprev, 0, uworld);
-  if (ireplica < nreplica - 1 && me == 0)
-    MPI_Recv(&vnext, 1, MPI_DOUBLE, procnext, 0, uworld, MPI_STATUS_IGNORE);
+  if (me == 0) {
+    MPI_Request vrequests[4];
+    int nvrequests = 0;
+    if (ireplica > 0) {
+      MPI_Irecv(&vprev, 1, MPI_DOUBLE, procprev, 0, uworld, &vrequests[nvrequests++]);
+      MPI_Isend(&veng, 1, MPI_DOUBLE, procprev, 0, uworld, &vrequests[nvrequests++]);
+    }
+    if (ireplica < nreplica - 1) {
+      MPI_Irecv(&vnext, 1, MPI_DOUBLE, procnext, 0, uworld, &vrequests[nvrequests++]);
+      MPI_Isend(&veng, 1, MPI_DOUBLE, procnext, 0, uworld, &vrequests[nvrequests++]);
+    }
+    MPI_Waitall(nvrequests, vrequests, MPI_STATUSES_IGNORE);
+  }
 
   if (cmode == MULTI_PROC) {
-    MPI_Bcast(&vprev, 1, MPI_DOUBLE, 0, world);
-    MPI_Bcast(&vnext, 1, MPI_DOUBLE, 0, world);
+    double vbuf[2] = {vprev, vnext};
+    MPI_Bcast(vbuf, 2, MPI_DOUBLE, 0, world);
+    vprev = vbuf[0];
+    vnext = vbuf[1];
   }
 
   if (FreeEndFinal && (ireplica == nreplica - 1) && (update->ntimestep == 0)) EFinalIni = veng;
@@ -329,6 +359,7 @@ void FixNEB::min_post_force(int /*vflag*/)
   nlen = 0.0;
   double tlen = 0.0;
   double gradnextlen = 0.0;
+  double dotSpringTangent = 0.0;
 
   dotgrad = gradlen = dotpath = dottangrad = 0.0;
 
@@ -432,9 +463,14 @@ void FixNEB::min_post_force(int /*vflag*/)
         springF[i][0] = kspringPerp * (delxn - delxp);
         springF[i][1] = kspringPerp * (delyn - delyp);
         springF[i][2] = kspringPerp * (delzn - delzp);
+        dotSpringTangent += springF[i][0] * tangent[i][0] + springF[i][1] * tangent[i][1] +
+            springF[i][2] * tangent[i][2];
       }
   }
 
+  // sum all per-atom terms with one reduction
+  // projections on the tangent are divided by its length below
+
   double bufin[BUFSIZE], bufout[BUFSIZE];
   bufin[0] = nlen;
   bufin[1] = plen;
@@ -444,6 +480,8 @@ void FixNEB::min_post_force(int /*vflag*/)
   bufin[5] = dotpath;
   bufin[6] = dottangrad;
   bufin[7] = dotgrad;
+  bufin[8] = dot;
+  bufin[9] = dotSpringTangent;
   MPI_Allreduce(bufin, bufout, BUFSIZE, MPI_DOUBLE, MPI_SUM, world);
   nlen = sqrt(bufout[0]);
   plen = sqrt(bufout[1]);
@@ -453,8 +491,11 @@ void FixNEB::min_post_force(int /*vflag*/)
   dotpath = bufout[5];
   dottangrad = bufout[6];
   dotgrad = bufout[7];
+  dot = bufout[8];
+  dotSpringTangent = bufout[9];
 
   // normalize tangent vector
+  // for other than first or last replica, dot = force projected on tangent
 
   if (tlen > 0.0) {
     double tleninv = 1.0 / tlen;
@@ -464,6 +505,10 @@ void FixNEB::min_post_force(int /*vflag*/)
         tangent[i][1] *= tleninv;
         tangent[i][2] *= tleninv;
       }
+    if (ireplica > 0 && ireplica < nreplica - 1) {
+      dot = dottangrad * tleninv;
+      dotSpringTangent *= tleninv;
+    }
   }
 
   // first or last replica has no change to forces, just return
@@ -475,9 +520,7 @@ void FixNEB::min_post_force(int /*vflag*/)
 
   if (FreeEndIni && ireplica == 0) {
     if (tlen > 0.0) {
-      double dotall;
-      MPI_Allreduce(&dot, &dotall, 1, MPI_DOUBLE, MPI_SUM, world);
-      dot = dotall / tlen;
+      dot /= tlen;
 
       if (dot < 0)
         prefactor = -dot - kspringIni * (veng - EIniIni);
@@ -495,9 +538,7 @@ void FixNEB::min_post_force(int /*vflag*/)
 
   if (FreeEndFinal && ireplica == nreplica - 1) {
     if (tlen > 0.0) {
-      double dotall;
-      MPI_Allreduce(&dot, &dotall, 1, MPI_DOUBLE, MPI_SUM, world);
-      dot = dotall / tlen;
+      dot /= tlen;
 
       if (veng < EFinalIni) {
         if (dot < 0)
@@ -516,9 +557,7 @@ void FixNEB::min_post_force(int /*vflag*/)
 
   if (FreeEndFinalWithRespToEIni && ireplica == nreplica - 1) {
     if (tlen > 0.0) {
-      double dotall;
-      MPI_Allreduce(&dot, &dotall, 1, MPI_DOUBLE, MPI_SUM, world);
-      dot = dotall / tlen;
+      dot /= tlen;
       if (veng < vIni) {
         if (dot < 0)
           prefactor = -dot - kspringFinal * (veng - vIni);
@@ -542,24 +581,6 @@ void FixNEB::min_post_force(int /*vflag*/)
   dotpath = dotpath / (plen * nlen);
   AngularContr = 0.5 * (1 + cos(MY_PI * dotpath));
 
-  double dotSpringTangent;
-  dotSpringTangent = 0;
-
-  for (int i = 0; i < nlocal; i++) {
-    if (mask[i] & groupbit) {
-      dot += f[i][0] * tangent[i][0] + f[i][1] * tangent[i][1] + f[i][2] * tangent[i][2];
-      dotSpringTangent += springF[i][0] * tangent[i][0] + springF[i][1] * tangent[i][1] +
-          springF[i][2] * tangent[i][2];
-    }
-  }
-
-  double dotSpringTangentall;
-  MPI_Allreduce(&dotSpringTangent, &dotSpringTangentall, 1, MPI_DOUBLE, MPI_SUM, world);
-  dotSpringTangent = dotSpringTangentall;
-  double dotall;
-  MPI_Allreduce(&dot, &dotall, 1, MPI_DOUBLE, MPI_SUM, world);
-  dot = dotall;
-
   if (ireplica == rclimber)
     prefactor = -2.0 * dot;
   else {
@@ -601,9 +622,6 @@ void FixNEB::min_post_force(int /*vflag*/)
 void FixNEB::inter_replica_comm()
 {
   int i, m;
-  MPI_Request request;
-  MPI_Request requests[2];
-  MPI_Status statuses[2];
 
   // reallocate memory if necessary
 
@@ -622,99 +640,35 @@ void FixNEB::inter_replica_comm()
 
   // single proc per replica
   // all atoms are NEB atoms and no atom sorting
-  // direct comm of x -> xprev and x -> xnext
+  // direct comm of x -> xprev and x -> xnext, f -> fnext
+  // with persistent requests for both adjacent replicas
 
   if (cmode == SINGLE_PROC_DIRECT) {
-    if (ireplica > 0) MPI_Irecv(xprev[0], 3 * nlocal, MPI_DOUBLE, procprev, 0, uworld, &request);
-    if (ireplica < nreplica - 1) MPI_Send(x[0], 3 * nlocal, MPI_DOUBLE, procnext, 0, uworld);
-    if (ireplica > 0) MPI_Wait(&request, MPI_STATUS_IGNORE);
-    if (ireplica < nreplica - 1)
-      MPI_Irecv(xnext[0], 3 * nlocal, MPI_DOUBLE, procnext, 0, uworld, &request);
-    if (ireplica > 0) MPI_Send(x[0], 3 * nlocal, MPI_DOUBLE, procprev, 0, uworld);
-    if (ireplica < nreplica - 1) MPI_Wait(&request, MPI_STATUS_IGNORE);
-
-    if (ireplica < nreplica - 1)
-      MPI_Irecv(fnext[0], 3 * nlocal, MPI_DOUBLE, procnext, 0, uworld, &request);
-    if (ireplica > 0) MPI_Send(f[0], 3 * nlocal, MPI_DOUBLE, procprev, 0, uworld);
-    if (ireplica < nreplica - 1) MPI_Wait(&request, MPI_STATUS_IGNORE);
-
+    if ((nlocal != nlocal_requests) || (x[0] != x_requests) || (f[0] != f_requests))
+      init_requests();
+    MPI_Startall(nrequests, requests);
+    MPI_Waitall(nrequests, requests, MPI_STATUSES_IGNORE);
     return;
   }
 
   // single proc per replica
   // but only some atoms are NEB atoms or atom sorting is enabled
-  // send atom IDs and coords of only NEB atoms to prev/next proc
-  // recv procs use atom->map() to match received coords to owned atoms
-
-  if (cmode == SINGLE_PROC_MAP) {
-    m = 0;
-    for (i = 0; i < nlocal; i++)
-      if (mask[i] & groupbit) {
-        tagsend[m] = tag[i];
-        xsend[m][0] = x[i][0];
-        xsend[m][1] = x[i][1];
-        xsend[m][2] = x[i][2];
-        fsend[m][0] = f[i][0];
-        fsend[m][1] = f[i][1];
-        fsend[m][2] = f[i][2];
-        m++;
-      }
-
-    if (ireplica > 0) {
-      MPI_Irecv(xrecv[0], 3 * nebatoms, MPI_DOUBLE, procprev, 0, uworld, &requests[0]);
-      MPI_Irecv(tagrecv, nebatoms, MPI_LMP_TAGINT, procprev, 0, uworld, &requests[1]);
-    }
-    if (ireplica < nreplica - 1) {
-      MPI_Send(xsend[0], 3 * nebatoms, MPI_DOUBLE, procnext, 0, uworld);
-      MPI_Send(tagsend, nebatoms, MPI_LMP_TAGINT, procnext, 0, uworld);
-    }
-
-    if (ireplica > 0) {
-      MPI_Waitall(2, requests, statuses);
-      for (i = 0; i < nebatoms; i++) {
-        m = atom->map(tagrecv[i]);
-        xprev[m][0] = xrecv[i][0];
-        xprev[m][1] = xrecv[i][1];
-        xprev[m][2] = xrecv[i][2];
-      }
-    }
-    if (ireplica < nreplica - 1) {
-      MPI_Irecv(xrecv[0], 3 * nebatoms, MPI_DOUBLE, procnext, 0, uworld, &requests[0]);
-      MPI_Irecv(frecv[0], 3 * nebatoms, MPI_DOUBLE, procnext, 0, uworld, &requests[0]);
-      MPI_Irecv(tagrecv, nebatoms, MPI_LMP_TAGINT, procnext, 0, uworld, &requests[1]);
-    }
-    if (ireplica > 0) {
-      MPI_Send(xsend[0], 3 * nebatoms, MPI_DOUBLE, procprev, 0, uworld);
-      MPI_Send(fsend[0], 3 * nebatoms, MPI_DOUBLE, procprev, 0, uworld);
-      MPI_Send(tagsend, nebatoms, MPI_LMP_TAGINT, procprev, 0, uworld);
-    }
-
-    if (ireplica < nreplica - 1) {
-      MPI_Waitall(2, requests, statuses);
-      for (i = 0; i < nebatoms; i++) {
-        m = atom->map(tagrecv[i]);
-        xnext[m][0] = xrecv[i][0];
-        xnext[m][1] = xrecv[i][1];
-        xnext[m][2] = xrecv[i][2];
-        fnext[m][0] = frecv[i][0];
-        fnext[m][1] = frecv[i][1];
-        fnext[m][2] = frecv[i][2];
-      }
-    }
-
-    return;
-  }
-
-  // multiple procs per replica
-  // MPI_Gather all coords and atom IDs to root proc of each replica
-  // send to root of adjacent replicas
-  // bcast within each replica
-  // each proc extracts info for atoms it owns via atom->map()
+  // send coords of only NEB atoms to prev/next proc
+  // or multiple procs per replica
+  // MPI_Gather all coords to root proc of each replica
+  // send to root of adjacent replicas, bcast within each replica
+  // atom IDs are only sent when the order of my NEB atoms may have changed,
+  //   i.e. after a neighbor list build, flagged in the extra row of coords
+  // recv procs use atom->map() to match received coords to owned atoms,
+  //   maps are kept until the sent atom IDs or my own atom order change
+
+  const int newtags = (neighbor->ncalls != tagstamp) ? 1 : 0;
+  tagstamp = neighbor->ncalls;
 
   m = 0;
   for (i = 0; i < nlocal; i++)
     if (mask[i] & groupbit) {
-      tagsend[m] = tag[i];
+      if (newtags) tagsend[m] = tag[i];
       xsend[m][0] = x[i][0];
       xsend[m][1] = x[i][1];
       xsend[m][2] = x[i][2];
@@ -724,80 +678,149 @@ void FixNEB::inter_replica_comm()
       m++;
     }
 
-  MPI_Gather(&m, 1, MPI_INT, counts, 1, MPI_INT, 0, world);
-  displacements[0] = 0;
-  for (i = 0; i < nprocs - 1; i++) displacements[i + 1] = displacements[i] + counts[i];
-  MPI_Gatherv(tagsend, m, MPI_LMP_TAGINT, tagsendall, counts, displacements, MPI_LMP_TAGINT, 0,
-              world);
-  for (i = 0; i < nprocs; i++) counts[i] *= 3;
-  for (i = 0; i < nprocs - 1; i++) displacements[i + 1] = displacements[i] + counts[i];
-  if (xsend) {
-    MPI_Gatherv(xsend[0], 3 * m, MPI_DOUBLE, xsendall[0], counts, displacements, MPI_DOUBLE, 0,
-                world);
-    MPI_Gatherv(fsend[0], 3 * m, MPI_DOUBLE, fsendall[0], counts, displacements, MPI_DOUBLE, 0,
-                world);
-  } else {
-    MPI_Gatherv(nullptr, 3 * m, MPI_DOUBLE, xsendall[0], counts, displacements, MPI_DOUBLE, 0,
-                world);
-    MPI_Gatherv(nullptr, 3 * m, MPI_DOUBLE, fsendall[0], counts, displacements, MPI_DOUBLE, 0,
-                world);
-  }
+  double **xsendptr = xsend;
+  double **fsendptr = fsend;
+  tagint *tagsendptr = tagsend;
 
-  if (ireplica > 0 && me == 0) {
-    MPI_Irecv(xrecvall[0], 3 * nebatoms, MPI_DOUBLE, procprev, 0, uworld, &requests[0]);
-    MPI_Irecv(tagrecvall, nebatoms, MPI_LMP_TAGINT, procprev, 0, uworld, &requests[1]);
-  }
-  if (ireplica < nreplica - 1 && me == 0) {
-    MPI_Send(xsendall[0], 3 * nebatoms, MPI_DOUBLE, procnext, 0, uworld);
-    MPI_Send(tagsendall, nebatoms, MPI_LMP_TAGINT, procnext, 0, uworld);
+  if (cmode == MULTI_PROC) {
+    if (newtags) {
+      MPI_Gather(&m, 1, MPI_INT, counts, 1, MPI_INT, 0, world);
+      displacements[0] = 0;
+      for (i = 0; i < nprocs - 1; i++) displacements[i + 1] = displacements[i] + counts[i];
+      MPI_Gatherv(tagsend, m, MPI_LMP_TAGINT, tagsendall, counts, displacements, MPI_LMP_TAGINT,
+                  0, world);
+    }
+    MPI_Gatherv(xsend[0], m, vec3type, xsendall[0], counts, displacements, vec3type, 0, world);
+    MPI_Gatherv(fsend[0], m, vec3type, fsendall[0], counts, displacements, vec3type, 0, world);
+    xsendptr = xsendall;
+    fsendptr = fsendall;
+    tagsendptr = tagsendall;
   }
 
-  if (ireplica > 0) {
-    if (me == 0) MPI_Waitall(2, requests, statuses);
+  // exchange between roots of adjacent replicas
+  // atom IDs are recv after the flag has arrived, so wait for their sends last
 
-    MPI_Bcast(tagrecvall, nebatoms, MPI_INT, 0, world);
-    MPI_Bcast(xrecvall[0], 3 * nebatoms, MPI_DOUBLE, 0, world);
+  const int nx = 3 * (nebatoms + 1);
+  int nflagprev = 0, nflagnext = 0;
 
-    for (i = 0; i < nebatoms; i++) {
-      m = atom->map(tagrecvall[i]);
-      if (m < 0 || m >= nlocal) continue;
-      xprev[m][0] = xrecvall[i][0];
-      xprev[m][1] = xrecvall[i][1];
-      xprev[m][2] = xrecvall[i][2];
+  if (me == 0) {
+    MPI_Request xrequests[6], tagrequests[2];
+    int nxrequests = 0, ntagrequests = 0;
+    xsendptr[nebatoms][0] = newtags;
+
+    if (ireplica > 0) {
+      MPI_Irecv(xprevall[0], nx, MPI_DOUBLE, procprev, 0, uworld, &xrequests[nxrequests++]);
+      MPI_Isend(xsendptr[0], nx, MPI_DOUBLE, procprev, 1, uworld, &xrequests[nxrequests++]);
+      MPI_Isend(fsendptr[0], nebatoms, vec3type, procprev, 2, uworld, &xrequests[nxrequests++]);
+      if (newtags)
+        MPI_Isend(tagsendptr, nebatoms, MPI_LMP_TAGINT, procprev, 4, uworld,
+                  &tagrequests[ntagrequests++]);
     }
+    if (ireplica < nreplica - 1) {
+      MPI_Irecv(xnextall[0], nx, MPI_DOUBLE, procnext, 1, uworld, &xrequests[nxrequests++]);
+      MPI_Irecv(fnextall[0], nebatoms, vec3type, procnext, 2, uworld, &xrequests[nxrequests++]);
+      MPI_Isend(xsendptr[0], nx, MPI_DOUBLE, procnext, 0, uworld, &xrequests[nxrequests++]);
+      if (newtags)
+        MPI_Isend(tagsendptr, nebatoms, MPI_LMP_TAGINT, procnext, 3, uworld,
+                  &tagrequests[ntagrequests++]);
+    }
+    MPI_Waitall(nxrequests, xrequests, MPI_STATUSES_IGNORE);
+
+    if (ireplica > 0) nflagprev = static_cast<int>(xprevall[nebatoms][0]);
+    if (ireplica < nreplica - 1) nflagnext = static_cast<int>(xnextall[nebatoms][0]);
+    if (nflagprev)
+      MPI_Recv(tagprevall, nebatoms, MPI_LMP_TAGINT, procprev, 3, uworld, MPI_STATUS_IGNORE);
+    if (nflagnext)
+      MPI_Recv(tagnextall, nebatoms, MPI_LMP_TAGINT, procnext, 4, uworld, MPI_STATUS_IGNORE);
+    MPI_Waitall(ntagrequests, tagrequests, MPI_STATUSES_IGNORE);
   }
 
-  if (ireplica < nreplica - 1 && me == 0) {
-    MPI_Irecv(xrecvall[0], 3 * nebatoms, MPI_DOUBLE, procnext, 0, uworld, &requests[0]);
-    MPI_Irecv(frecvall[0], 3 * nebatoms, MPI_DOUBLE, procnext, 0, uworld, &requests[0]);
-    MPI_Irecv(tagrecvall, nebatoms, MPI_LMP_TAGINT, procnext, 0, uworld, &requests[1]);
+  if (cmode == MULTI_PROC) {
+    if (ireplica > 0) {
+      MPI_Bcast(xprevall[0], nx, MPI_DOUBLE, 0, world);
+      nflagprev = static_cast<int>(xprevall[nebatoms][0]);
+      if (nflagprev) MPI_Bcast(tagprevall, nebatoms, MPI_LMP_TAGINT, 0, world);
+    }
+    if (ireplica < nreplica - 1) {
+      MPI_Bcast(xnextall[0], nx, MPI_DOUBLE, 0, world);
+      MPI_Bcast(fnextall[0], nebatoms, vec3type, 0, world);
+      nflagnext = static_cast<int>(xnextall[nebatoms][0]);
+      if (nflagnext) MPI_Bcast(tagnextall, nebatoms, MPI_LMP_TAGINT, 0, world);
+    }
   }
-  if (ireplica > 0 && me == 0) {
-    MPI_Send(xsendall[0], 3 * nebatoms, MPI_DOUBLE, procprev, 0, uworld);
-    MPI_Send(fsendall[0], 3 * nebatoms, MPI_DOUBLE, procprev, 0, uworld);
-    MPI_Send(tagsendall, nebatoms, MPI_LMP_TAGINT, procprev, 0, uworld);
+
+  if (ireplica > 0) {
+    if (newtags || nflagprev) map_replica(tagprevall, nmapprev, mapprev);
+    for (int n = 0; n < nmapprev; n++) {
+      i = mapprev[n][0];
+      m = mapprev[n][1];
+      xprev[m][0] = xprevall[i][0];
+      xprev[m][1] = xprevall[i][1];
+      xprev[m][2] = xprevall[i][2];
+    }
   }
 
   if (ireplica < nreplica - 1) {
-    if (me == 0) MPI_Waitall(2, requests, statuses);
-
-    MPI_Bcast(tagrecvall, nebatoms, MPI_INT, 0, world);
-    MPI_Bcast(xrecvall[0], 3 * nebatoms, MPI_DOUBLE, 0, world);
-    MPI_Bcast(frecvall[0], 3 * nebatoms, MPI_DOUBLE, 0, world);
-
-    for (i = 0; i < nebatoms; i++) {
-      m = atom->map(tagrecvall[i]);
-      if (m < 0 || m >= nlocal) continue;
-      xnext[m][0] = xrecvall[i][0];
-      xnext[m][1] = xrecvall[i][1];
-      xnext[m][2] = xrecvall[i][2];
-      fnext[m][0] = frecvall[i][0];
-      fnext[m][1] = frecvall[i][1];
-      fnext[m][2] = frecvall[i][2];
+    if (newtags || nflagnext) map_replica(tagnextall, nmapnext, mapnext);
+    for (int n = 0; n < nmapnext; n++) {
+      i = mapnext[n][0];
+      m = mapnext[n][1];
+      xnext[m][0] = xnextall[i][0];
+      xnext[m][1] = xnextall[i][1];
+      xnext[m][2] = xnextall[i][2];
+      fnext[m][0] = fnextall[i][0];
+      fnext[m][1] = fnextall[i][1];
+      fnext[m][2] = fnextall[i][2];
     }
   }
 }
 
+/* ----------------------------------------------------------------------
+   create persistent requests for direct exchange of all atoms
+   recreated when the number of atoms or a buffer has changed
+------------------------------------------------------------------------- */
+
+void FixNEB::init_requests()
+{
+  for (int i = 0; i < nrequests; i++) MPI_Request_free(&requests[i]);
+  nrequests = 0;
+
+  nlocal_requests = atom->nlocal;
+  x_requests = atom->x[0];
+  f_requests = atom->f[0];
+  const int n = 3 * nlocal_requests;
+
+  if (ireplica > 0) {
+    MPI_Recv_init(xprev[0], n, MPI_DOUBLE, procprev, 0, uworld, &requests[nrequests++]);
+    MPI_Send_init(x_requests, n, MPI_DOUBLE, procprev, 1, uworld, &requests[nrequests++]);
+    MPI_Send_init(f_requests, n, MPI_DOUBLE, procprev, 2, uworld, &requests[nrequests++]);
+  }
+  if (ireplica < nreplica - 1) {
+    MPI_Recv_init(xnext[0], n, MPI_DOUBLE, procnext, 1, uworld, &requests[nrequests++]);
+    MPI_Recv_init(fnext[0], n, MPI_DOUBLE, procnext, 2, uworld, &requests[nrequests++]);
+    MPI_Send_init(x_requests, n, MPI_DOUBLE, procnext, 0, uworld, &requests[nrequests++]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   match atom IDs recv from an adjacent replica to my owned atoms
+   store index in recv buffer and local index of each owned atom
+------------------------------------------------------------------------- */
+
+void FixNEB::map_replica(tagint *tagrecv, int &nmap, int **map)
+{
+  int nlocal = atom->nlocal;
+
+  nmap = 0;
+  for (int i = 0; i < nebatoms; i++) {
+    int m = atom->map(tagrecv[i]);
+    if (m < 0 || m >= nlocal) continue;
+    map[nmap][0] = i;
+    map[nmap][1] = m;
+    nmap++;
+  }
+}
+
 /*
 Calculate ideal positions for parallel "ideal" or "equal"
 */
@@ -873,19 +896,19 @@ void FixNEB::reallocate()
   memory->create(fnext, maxlocal, 3, "neb:fnext");
   memory->create(springF, maxlocal, 3, "neb:springF");
 
+  // persistent requests refer to the old arrays
+
+  nlocal_requests = -1;
+
+  // extra row of xsend for flag that atom IDs are sent
+
   if (cmode != SINGLE_PROC_DIRECT) {
     memory->destroy(xsend);
     memory->destroy(fsend);
-    memory->destroy(xrecv);
-    memory->destroy(frecv);
     memory->destroy(tagsend);
-    memory->destroy(tagrecv);
-    memory->create(xsend, maxlocal, 3, "neb:xsend");
+    memory->create(xsend, maxlocal + 1, 3, "neb:xsend");
     memory->create(fsend, maxlocal, 3, "neb:fsend");
-    memory->create(xrecv, maxlocal, 3, "neb:xrecv");
-    memory->create(frecv, maxlocal, 3, "neb:frecv");
     memory->create(tagsend, maxlocal, "neb:tagsend");
-    memory->create(tagrecv, maxlocal, "neb:tagrecv");
   }
 
   if ((neb_mode == IDEAL) || (neb_mode == EQUAL)) {
@@ -56,18 +56,34 @@ class FixNEB : public Fix {
   double *nlenall, *vengall;
   double **xprev, **xnext, **fnext, **springF;
   double **tangent;
-  double **xsend, **xrecv;      // coords to send/recv to/from other replica
-  double **fsend, **frecv;      // coords to send/recv to/from other replica
-  tagint *tagsend, *tagrecv;    // ditto for atom IDs
+  double **xsend, **fsend;    // coords and forces of my NEB atoms
+  tagint *tagsend;            // ditto for atom IDs
 
-  // info gathered from all procs in my replica
-  double **xsendall, **xrecvall;      // coords to send/recv to/from other replica
-  double **fsendall, **frecvall;      // force to send/recv to/from other replica
-  tagint *tagsendall, *tagrecvall;    // ditto for atom IDs
+  // info gathered from all procs in my replica or recv from adjacent replicas
+  // coords have an extra row with a flag that atom IDs are sent as well
+
+  double **xsendall, **fsendall;      // coords and forces to send to other replicas
+  tagint *tagsendall;                 // ditto for atom IDs
+  double **xprevall, **xnextall;      // coords recv from prev/next replica
+  double **fnextall;                  // forces recv from next replica
+  tagint *tagprevall, *tagnextall;    // atom IDs last recv from prev/next replica
 
   int *counts, *displacements;    // used for MPI_Gather
+  MPI_Datatype vec3type;          // coords or forces of one atom
+
+  bigint tagstamp;             // neighbor->ncalls when atom IDs were last sent
+  int nmapprev, nmapnext;      // # of atoms recv from prev/next replica that I own
+  int **mapprev, **mapnext;    // their index in recv buffers and local index
+
+  // persistent requests for direct exchange with adjacent replicas
+
+  MPI_Request requests[6];
+  int nrequests, nlocal_requests;
+  double *x_requests, *f_requests;
 
   void inter_replica_comm();
+  void init_requests();
+  void map_replica(tagint *, int &, int **);
   void calculate_ideal_positions();
   void reallocate();
 };
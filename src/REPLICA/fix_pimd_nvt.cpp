@@ -31,6 +31,7 @@
 #include "math_const.h"
 #include "math_special.h"
 #include "memory.h"
+#include "neighbor.h"
 #include "universe.h"
 #include "update.h"
 
@@ -49,20 +50,22 @@ enum { PIMD, NMPIMD, CMD };
 
 FixPIMDNVT::FixPIMDNVT(LAMMPS *lmp, int narg, char **arg) : Fix(lmp, narg, arg)
 {
+  comm_bead = MPI_COMM_NULL;
+  bead_flag = nullptr;
+  bead_info = bead_stamp = nullptr;
+  sendcounts = sdispls = recvcounts = rdispls = nullptr;
+
   max_nsend = 0;
-  tag_send = nullptr;
+  tag_recv = nullptr;
+  index_send = nullptr;
   buf_send = nullptr;
 
   max_nlocal = 0;
   buf_recv = nullptr;
   buf_beads = nullptr;
 
-  size_plan = 0;
-  plan_send = plan_recv = nullptr;
-
   M_x2xp = M_xp2x = M_f2fp = M_fp2f = nullptr;
   lam = nullptr;
-  mode_index = nullptr;
 
   mass = nullptr;
 
@@ -155,14 +158,18 @@ FixPIMDNVT::~FixPIMDNVT()
   memory->destroy(M_fp2f);
   memory->sfree(lam);
 
-  if (buf_beads)
-    for (int i = 0; i < np; i++) memory->sfree(buf_beads[i]);
-  delete[] buf_beads;
-  delete[] plan_send;
-  delete[] plan_recv;
-  delete[] mode_index;
+  if (comm_bead != MPI_COMM_NULL) MPI_Comm_free(&comm_bead);
+  delete[] bead_flag;
+  delete[] bead_info;
+  delete[] bead_stamp;
+  delete[] sendcounts;
+  delete[] sdispls;
+  delete[] recvcounts;
+  delete[] rdispls;
 
-  memory->sfree(tag_send);
+  delete[] buf_beads;
+  memory->sfree(tag_recv);
+  memory->sfree(index_send);
   memory->sfree(buf_send);
   memory->sfree(buf_recv);
 
@@ -520,15 +527,19 @@ void FixPIMDNVT::nmpimd_fill(double **ptr)
 
 void FixPIMDNVT::nmpimd_transform(double **src, double **des, double *vector)
 {
-  int n = atom->nlocal;
-  int m = 0;
+  // only the mode of this bead is needed, a single row of the transform
+  // accumulate one bead at a time to stream through contiguous memory
 
-  for (int i = 0; i < n; i++)
-    for (int d = 0; d < 3; d++) {
-      des[i][d] = 0.0;
-      for (int j = 0; j < np; j++) { des[i][d] += (src[j][m] * vector[j]); }
-      m++;
-    }
+  int n = 3 * atom->nlocal;
+  double *out = &des[0][0];
+
+  for (int m = 0; m < n; m++) out[m] = 0.0;
+
+  for (int j = 0; j < np; j++) {
+    const double c = vector[j];
+    const double *in = src[j];
+    for (int m = 0; m < n; m++) out[m] += in[m] * c;
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -583,133 +594,154 @@ void FixPIMDNVT::spring_force()
 
 void FixPIMDNVT::comm_init()
 {
-  if (size_plan) {
-    delete[] plan_send;
-    delete[] plan_recv;
+  // comm_bead = communicator between procs with same rank in each partition
+  // rank in comm_bead = partition = bead index
+
+  if (comm_bead != MPI_COMM_NULL) MPI_Comm_free(&comm_bead);
+  MPI_Comm_split(universe->uworld, comm->me, universe->iworld, &comm_bead);
+
+  x_next = (universe->iworld + 1 + universe->nworlds) % (universe->nworlds);
+  x_last = (universe->iworld - 1 + universe->nworlds) % (universe->nworlds);
+
+  if (!bead_flag) {
+    bead_flag = new int[np];
+    bead_info = new bigint[2 * np];
+    bead_stamp = new bigint[np];
+    sendcounts = new int[np];
+    sdispls = new int[np];
+    recvcounts = new int[np];
+    rdispls = new int[np];
+    buf_beads = new double *[np];
   }
 
-  if (method == PIMD) {
-    size_plan = 2;
-    plan_send = new int[2];
-    plan_recv = new int[2];
-    mode_index = new int[2];
-
-    int rank_last = universe->me - comm->nprocs;
-    int rank_next = universe->me + comm->nprocs;
-    if (rank_last < 0) rank_last += universe->nprocs;
-    if (rank_next >= universe->nprocs) rank_next -= universe->nprocs;
-
-    plan_send[0] = rank_next;
-    plan_send[1] = rank_last;
-    plan_recv[0] = rank_last;
-    plan_recv[1] = rank_next;
-
-    mode_index[0] = 0;
-    mode_index[1] = 1;
-    x_last = 1;
-    x_next = 0;
-  } else {
-    size_plan = np - 1;
-    plan_send = new int[size_plan];
-    plan_recv = new int[size_plan];
-    mode_index = new int[size_plan];
-
-    for (int i = 0; i < size_plan; i++) {
-      plan_send[i] = universe->me + comm->nprocs * (i + 1);
-      if (plan_send[i] >= universe->nprocs) plan_send[i] -= universe->nprocs;
-
-      plan_recv[i] = universe->me - comm->nprocs * (i + 1);
-      if (plan_recv[i] < 0) plan_recv[i] += universe->nprocs;
-
-      mode_index[i] = (universe->iworld + i + 1) % (universe->nworlds);
-    }
+  // PIMD only needs the neighbor beads along the ring polymer
+  // normal-mode methods need all beads
 
-    x_next = (universe->iworld + 1 + universe->nworlds) % (universe->nworlds);
-    x_last = (universe->iworld - 1 + universe->nworlds) % (universe->nworlds);
-  }
-
-  if (buf_beads) {
-    for (int i = 0; i < np; i++) delete[] buf_beads[i];
-    delete[] buf_beads;
+  for (int i = 0; i < np; i++) {
+    if (i == universe->iworld)
+      bead_flag[i] = 0;
+    else if (method == PIMD)
+      bead_flag[i] = (i == x_last || i == x_next) ? 1 : 0;
+    else
+      bead_flag[i] = 1;
+    bead_stamp[i] = -1;
   }
 
-  buf_beads = new double *[np];
-  for (int i = 0; i < np; i++) buf_beads[i] = nullptr;
+  for (int i = 0; i < np; i++) buf_beads[i] = buf_recv + (bigint) 3 * max_nlocal * i;
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   recv atom IDs owned by the other beads, in their order
+   convert them to local indices for packing coords to send to each bead
+------------------------------------------------------------------------- */
 
-void FixPIMDNVT::comm_exec(double **ptr)
+void FixPIMDNVT::comm_plan()
 {
   int nlocal = atom->nlocal;
+  int nsend = 0;
 
-  if (nlocal > max_nlocal) {
-    max_nlocal = nlocal + 200;
-    int size = sizeof(double) * max_nlocal * 3;
-    buf_recv = (double *) memory->srealloc(buf_recv, size, "FixPIMDNVT:x_recv");
+  for (int i = 0; i < np; i++) {
+    sendcounts[i] = bead_flag[i] ? nlocal : 0;
+    sdispls[i] = 0;
+    recvcounts[i] = bead_flag[i] ? (int) bead_info[2 * i] : 0;
+    rdispls[i] = nsend;
+    nsend += recvcounts[i];
+  }
 
-    for (int i = 0; i < np; i++)
-      buf_beads[i] = (double *) memory->srealloc(buf_beads[i], size, "FixPIMDNVT:x_beads[i]");
+  if (nsend > max_nsend) {
+    max_nsend = nsend + 200;
+    tag_recv =
+        (tagint *) memory->srealloc(tag_recv, sizeof(tagint) * max_nsend, "FixPIMDNVT:tag_recv");
+    index_send =
+        (int *) memory->srealloc(index_send, sizeof(int) * max_nsend, "FixPIMDNVT:index_send");
+    buf_send =
+        (double *) memory->srealloc(buf_send, sizeof(double) * max_nsend * 3, "FixPIMDNVT:x_send");
   }
 
-  // copy local positions
+  MPI_Alltoallv(atom->tag, sendcounts, sdispls, MPI_LMP_TAGINT, tag_recv, recvcounts, rdispls,
+                MPI_LMP_TAGINT, comm_bead);
 
-  memcpy(buf_beads[universe->iworld], &(ptr[0][0]), sizeof(double) * nlocal * 3);
+  for (int i = 0; i < np; i++) {
+    if (!bead_flag[i]) continue;
+    for (int k = rdispls[i]; k < rdispls[i] + recvcounts[i]; k++) {
+      int index = atom->map(tag_recv[k]);
 
-  // go over comm plans
+      if (index < 0) {
+        auto mesg = fmt::format("Atom {} is missing at world [{}] rank [{}] "
+                                "required by world [{}] ({}, {}, {}).\n",
+                                tag_recv[k], universe->iworld, comm->me, i, atom->tag[0],
+                                atom->tag[1], atom->tag[2]);
+        error->universe_one(FLERR, mesg);
+      }
 
-  for (int iplan = 0; iplan < size_plan; iplan++) {
-    // sendrecv nlocal
+      index_send[k] = index;
+    }
+  }
 
-    int nsend;
+  // data send plan in doubles, in the same order as the received atom IDs
 
-    MPI_Sendrecv(&(nlocal), 1, MPI_INT, plan_send[iplan], 0, &(nsend), 1, MPI_INT, plan_recv[iplan],
-                 0, universe->uworld, MPI_STATUS_IGNORE);
+  for (int i = 0; i < np; i++) {
+    sendcounts[i] = 3 * recvcounts[i];
+    sdispls[i] = 3 * rdispls[i];
+    bead_stamp[i] = bead_info[2 * i + 1];
+  }
+}
 
-    // allocate arrays
+/* ----------------------------------------------------------------------
+   gather per-atom vector ptr of the needed beads into buf_beads
+   each bead receives directly into its slot in its own atom order
+   send plan is reused until a bead reneighbors and may reorder its atoms
+------------------------------------------------------------------------- */
 
-    if (nsend > max_nsend) {
-      max_nsend = nsend + 200;
-      tag_send =
-          (tagint *) memory->srealloc(tag_send, sizeof(tagint) * max_nsend, "FixPIMDNVT:tag_send");
-      buf_send = (double *) memory->srealloc(buf_send, sizeof(double) * max_nsend * 3,
-                                             "FixPIMDNVT:x_send");
-    }
+void FixPIMDNVT::comm_exec(double **ptr)
+{
+  int nlocal = atom->nlocal;
 
-    // send tags
+  if (nlocal > max_nlocal) {
+    max_nlocal = nlocal + 200;
+    bigint size = sizeof(double) * max_nlocal * 3 * np;
+    buf_recv = (double *) memory->srealloc(buf_recv, size, "FixPIMDNVT:x_beads");
+    for (int i = 0; i < np; i++) buf_beads[i] = buf_recv + (bigint) 3 * max_nlocal * i;
+  }
 
-    MPI_Sendrecv(atom->tag, nlocal, MPI_LMP_TAGINT, plan_send[iplan], 0, tag_send, nsend,
-                 MPI_LMP_TAGINT, plan_recv[iplan], 0, universe->uworld, MPI_STATUS_IGNORE);
+  // copy local positions
 
-    // wrap positions
+  memcpy(buf_beads[universe->iworld], &(ptr[0][0]), sizeof(double) * nlocal * 3);
 
-    double *wrap_ptr = buf_send;
-    int ncpy = sizeof(double) * 3;
+  // exchange nlocal and reneighbor stamps, update plan if any bead changed
 
-    for (int i = 0; i < nsend; i++) {
-      int index = atom->map(tag_send[i]);
+  bigint info[2];
+  info[0] = nlocal;
+  info[1] = neighbor->ncalls;
+  MPI_Allgather(info, 2, MPI_LMP_BIGINT, bead_info, 2, MPI_LMP_BIGINT, comm_bead);
 
-      if (index < 0) {
-        auto mesg = fmt::format("Atom {} is missing at world [{}] rank [{}] "
-                                "required by rank [{}] ({}, {}, {}).\n",
-                                tag_send[i], universe->iworld, comm->me, plan_recv[iplan],
-                                atom->tag[0], atom->tag[1], atom->tag[2]);
-        error->universe_one(FLERR, mesg);
-      }
+  int flag = 0;
+  for (int i = 0; i < np; i++)
+    if (bead_info[2 * i + 1] != bead_stamp[i]) flag = 1;
+  if (flag) comm_plan();
 
-      memcpy(wrap_ptr, ptr[index], ncpy);
-      wrap_ptr += 3;
-    }
+  // pack coords in the atom order of each receiving bead
 
-    // sendrecv x
+  int nsend = (sdispls[np - 1] + sendcounts[np - 1]) / 3;
+  double *wrap_ptr = buf_send;
 
-    MPI_Sendrecv(buf_send, nsend * 3, MPI_DOUBLE, plan_recv[iplan], 0, buf_recv, nlocal * 3,
-                 MPI_DOUBLE, plan_send[iplan], 0, universe->uworld, MPI_STATUS_IGNORE);
+  for (int k = 0; k < nsend; k++) {
+    const double *src = ptr[index_send[k]];
+    wrap_ptr[0] = src[0];
+    wrap_ptr[1] = src[1];
+    wrap_ptr[2] = src[2];
+    wrap_ptr += 3;
+  }
 
-    // copy x
+  // recv coords of other beads directly into their buf_beads slot
 
-    memcpy(buf_beads[mode_index[iplan]], buf_recv, sizeof(double) * nlocal * 3);
+  for (int i = 0; i < np; i++) {
+    recvcounts[i] = bead_flag[i] ? 3 * nlocal : 0;
+    rdispls[i] = 3 * max_nlocal * i;
   }
+
+  MPI_Alltoallv(buf_send, sendcounts, sdispls, MPI_DOUBLE, buf_recv, recvcounts, rdispls,
+                MPI_DOUBLE, comm_bead);
 }
 
 /* ---------------------------------------------------------------------- */
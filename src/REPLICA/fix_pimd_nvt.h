@@ -71,24 +71,29 @@ class FixPIMDNVT : public Fix {
 
   /* inter-partition communication */
 
+  MPI_Comm comm_bead;      // procs with same rank in all partitions, rank = bead
+  int *bead_flag;          // 1 if coords of this bead are needed, 0 if not
+  bigint *bead_info;       // nlocal and reneighbor stamp of each bead
+  bigint *bead_stamp;      // stamp of each bead when send plan was made
+
+  int *sendcounts, *sdispls, *recvcounts, *rdispls;
+
   int max_nsend;
-  tagint *tag_send;
+  tagint *tag_recv;        // atom IDs owned by other beads, in their order
+  int *index_send;         // local index of each atom sent to other beads
   double *buf_send;
 
   int max_nlocal;
   double *buf_recv, **buf_beads;
-
-  int size_plan;
-  int *plan_send, *plan_recv;
   double **comm_ptr;
 
   void comm_init();
+  void comm_plan();
   void comm_exec(double **);
 
   /* normal-mode operations */
 
   double *lam, **M_x2xp, **M_xp2x, **M_f2fp, **M_fp2f;
-  int *mode_index;
 
   void nmpimd_init();
   void nmpimd_fill(double **);
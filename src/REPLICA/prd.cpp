@@ -21,6 +21,7 @@
 #include "atom.h"
 #include "comm.h"
 #include "compute.h"
+#include "compute_event_displace.h"
 #include "domain.h"
 #include "error.h"
 #include "finish.h"
@@ -45,6 +46,8 @@ using namespace LAMMPS_NS;
 
 enum{SINGLE_PROC_DIRECT,SINGLE_PROC_MAP,MULTI_PROC};
 
+static constexpr int NOTICE_TAG = 1;
+
 /* ---------------------------------------------------------------------- */
 
 PRD::PRD(LAMMPS *lmp) : Command(lmp) {}
@@ -186,6 +189,12 @@ void PRD::command(int narg, char **arg)
   compute_event = modify->compute[icompute];
   compute_event->reset_extra_compute_fix("prd_event");
 
+  // displacement screening requires compute event/displace
+
+  compute_displace = dynamic_cast<ComputeEventDisplace *>(compute_event);
+  if (screen_flag && !compute_displace)
+    error->all(FLERR,"PRD screen keyword requires compute event/displace");
+
   // reset reneighboring criteria since will perform minimizations
 
   neigh_every = neighbor->every;
@@ -287,6 +296,7 @@ void PRD::command(int narg, char **arg)
   // (3) share and record event
 
   nbuild = ndanger = 0;
+  nquench = nscreened = 0;
   time_dephase = time_dynamics = time_quench = time_comm = time_output = 0.0;
   bigint clock = 0;
 
@@ -302,28 +312,34 @@ void PRD::command(int narg, char **arg)
     if (stepmode == 0) istep = update->ntimestep - update->beginstep;
     else istep = clock;
 
+    // both searches check for the end of the run before each interval
+
     ireplica = -1;
-    while (istep < nsteps) {
-      dynamics(t_event,time_dynamics);
-      fix_event->store_state_quench();
-      quench();
-      clock += (bigint)t_event*universe->nworlds;
-      ireplica = check_event();
-      if (ireplica >= 0) break;
-      fix_event->restore_state_quench();
-      if (stepmode == 0) istep = update->ntimestep - update->beginstep;
-      else istep = clock;
+    if (async_flag) {
+      if (istep < nsteps) ireplica = search_async(nsteps,clock);
+    } else {
+      while (istep < nsteps) {
+        dynamics(t_event,time_dynamics);
+        int worldflag = quench_event();
+        clock += (bigint)t_event*universe->nworlds;
+        ireplica = check_event(worldflag);
+        if (ireplica >= 0) break;
+        fix_event->restore_state_quench();
+        if (stepmode == 0) istep = update->ntimestep - update->beginstep;
+        else istep = clock;
+      }
     }
     if (ireplica < 0) break;
 
     // decrement clock by random time at which 1 or more events occurred
+    // async search: only the replicas with an event lose part of their last interval
 
     int frac_t_event = t_event;
     for (int i = 0; i < fix_event->ncoincident; i++) {
       int frac_rand = static_cast<int> (random_clock->uniform() * t_event);
       frac_t_event = MIN(frac_t_event,frac_rand);
     }
-    int decrement = (t_event - frac_t_event)*universe->nworlds;
+    int decrement = (t_event - frac_t_event)*(async_flag ? ncoincident : universe->nworlds);
     clock -= decrement;
 
     // share event across replicas
@@ -354,10 +370,9 @@ void PRD::command(int narg, char **arg)
         break;
       }
       dynamics(t_event,time_dynamics);
-      fix_event->store_state_quench();
-      quench();
+      int worldflag = quench_event();
       clock += t_event;
-      int corr_event_check = check_event(ireplica);
+      int corr_event_check = check_event(worldflag,ireplica);
       if (corr_event_check >= 0) {
         share_event(ireplica,2,0);
         log_event();
@@ -421,7 +436,11 @@ void PRD::command(int narg, char **arg)
     if (universe->ulogfile) fmt::print(universe->ulogfile, mesg);
   }
 
-  if (me == 0) utils::logmesg(lmp,"\nPRD done\n");
+  if (me == 0) {
+    utils::logmesg(lmp,"\nPRD done\n");
+    if (screen_flag)
+      utils::logmesg(lmp,"Quenches skipped by screening = {} of {}\n",nscreened,nquench);
+  }
 
   finish->end(2);
 
@@ -581,20 +600,41 @@ void PRD::quench()
     if (modify->compute[i]->timeflag) modify->compute[i]->clearstep();
 }
 
+/* ----------------------------------------------------------------------
+   store hot state, quench, and check for an event in this replica
+   with screening, skip the quench if no atom has moved far enough
+     from the last event coords to possibly end in a new basin
+   return 1 if event, 0 if not
+------------------------------------------------------------------------- */
+
+int PRD::quench_event()
+{
+  fix_event->store_state_quench();
+  nquench++;
+
+  if (screen_flag && !compute_displace->screen(screen_dist)) {
+    nscreened++;
+    return 0;
+  }
+
+  quench();
+  if (compute_event->compute_scalar() > 0.0) return 1;
+  return 0;
+}
+
 /* ----------------------------------------------------------------------
    check for an event in any replica
+   worldflag = 1 if event in this replica, 0 if not
    if replica_num is non-negative only check for event on replica_num
    if multiple events, choose one at random
    return -1 if no event
    else return ireplica = world in which event occurred
 ------------------------------------------------------------------------- */
 
-int PRD::check_event(int replica_num)
+int PRD::check_event(int worldflag, int replica_num)
 {
-  int worldflag,universeflag,scanflag,replicaflag,ireplica;
+  int universeflag,scanflag,replicaflag,ireplica;
 
-  worldflag = 0;
-  if (compute_event->compute_scalar() > 0.0) worldflag = 1;
   if (replica_num >= 0 && replica_num != universe->iworld) worldflag = 0;
 
   timer->barrier_start();
@@ -639,6 +679,132 @@ int PRD::check_event(int replica_num)
   return ireplica;
 }
 
+/* ----------------------------------------------------------------------
+   asynchronous search for an event on all replicas
+   each replica runs dynamics and checks for events on its own schedule,
+     without any communication between replicas
+   a replica which finds an event or runs out of time notifies the others
+     via non-blocking messages between the replica root procs,
+     the others stop at the end of their current t_event interval
+   advance clock by steps run on all replicas, sync timestep to event replica
+   return -1 if no event
+   else return ireplica = world in which event occurred
+------------------------------------------------------------------------- */
+
+int PRD::search_async(int nsteps, bigint &clock)
+{
+  int nworlds = universe->nworlds;
+  int iworld = universe->iworld;
+  int notice_in, notice_out, notified;
+  MPI_Request request_in;
+  MPI_Request *request_out = nullptr;
+
+  notified = 0;
+  if (me == 0)
+    MPI_Irecv(&notice_in,1,MPI_INT,MPI_ANY_SOURCE,NOTICE_TAG,comm_replica,&request_in);
+
+  // run until event, out of time, or notified by another replica
+  // root proc polls for a notice, result is bcast within replica
+
+  bigint nlocal_steps = 0;
+  bigint istep;
+  int worldflag,doneflag;
+
+  while (true) {
+    dynamics(t_event,time_dynamics);
+    nlocal_steps += t_event;
+    worldflag = quench_event();
+
+    if (stepmode == 0) istep = update->ntimestep - update->beginstep;
+    else istep = clock + nlocal_steps*nworlds;
+    doneflag = (istep >= nsteps) ? 1 : 0;
+    if (worldflag || doneflag) break;
+
+    if (me == 0) MPI_Test(&request_in,&notified,MPI_STATUS_IGNORE);
+    MPI_Bcast(&notified,1,MPI_INT,0,world);
+    if (notified) break;
+
+    fix_event->restore_state_quench();
+  }
+
+  timer->barrier_start();
+
+  // replica which stopped on its own sends notice to all other replicas
+  // then sum event count, notices sent, and steps run over replicas
+  // each root proc receives all notices not sent by itself
+
+  int sentflag = notified ? 0 : 1;
+  bigint info[3],allinfo[3];
+  info[0] = worldflag;
+  info[1] = sentflag;
+  info[2] = nlocal_steps;
+  bigint ntimestep = update->ntimestep;
+  bigint ntimestep_max;
+
+  if (me == 0) {
+    if (sentflag && nworlds > 1) {
+      notice_out = iworld;
+      request_out = new MPI_Request[nworlds-1];
+      int n = 0;
+      for (int iw = 0; iw < nworlds; iw++)
+        if (iw != iworld)
+          MPI_Isend(&notice_out,1,MPI_INT,iw,NOTICE_TAG,comm_replica,&request_out[n++]);
+    }
+
+    MPI_Allreduce(info,allinfo,3,MPI_LMP_BIGINT,MPI_SUM,comm_replica);
+    MPI_Allreduce(&ntimestep,&ntimestep_max,1,MPI_LMP_BIGINT,MPI_MAX,comm_replica);
+
+    int nexpect = allinfo[1] - sentflag;
+    if (nexpect == 0) {
+      MPI_Cancel(&request_in);
+      MPI_Wait(&request_in,MPI_STATUS_IGNORE);
+    } else {
+      if (!notified) MPI_Wait(&request_in,MPI_STATUS_IGNORE);
+      for (int i = 1; i < nexpect; i++)
+        MPI_Recv(&notice_in,1,MPI_INT,MPI_ANY_SOURCE,NOTICE_TAG,comm_replica,
+                 MPI_STATUS_IGNORE);
+    }
+
+    if (request_out) {
+      MPI_Waitall(nworlds-1,request_out,MPI_STATUSES_IGNORE);
+      delete[] request_out;
+    }
+  }
+
+  MPI_Bcast(allinfo,3,MPI_LMP_BIGINT,0,world);
+  MPI_Bcast(&ntimestep_max,1,MPI_LMP_BIGINT,0,world);
+
+  timer->barrier_stop();
+  time_comm += timer->get_wall(Timer::TOTAL);
+
+  nsteps_async = allinfo[2];
+  clock += nsteps_async;
+
+  // no event: all replicas continue from their pre-quench state
+  //   at the latest timestep
+  // event: choose event replica, all replicas continue from its timestep
+
+  int ireplica = -1;
+  if (allinfo[0] == 0) {
+    fix_event->restore_state_quench();
+    ntimestep = ntimestep_max;
+  } else {
+    ireplica = check_event(worldflag);
+    if (me == 0) MPI_Bcast(&ntimestep,1,MPI_LMP_BIGINT,ireplica,comm_replica);
+    MPI_Bcast(&ntimestep,1,MPI_LMP_BIGINT,0,world);
+  }
+
+  // clear timestep storage from computes, since now invalid
+
+  if (ntimestep != update->ntimestep) {
+    update->ntimestep = ntimestep;
+    for (int i = 0; i < modify->ncompute; i++)
+      if (modify->compute[i]->timeflag) modify->compute[i]->clearstep();
+  }
+
+  return ireplica;
+}
+
 /* ----------------------------------------------------------------------
    share quenched and hot coords owned by ireplica with all replicas
    all replicas store event in fix_event
@@ -665,12 +831,14 @@ void PRD::share_event(int ireplica, int flag, int decrement)
   if (fix_event->event_number < 1 || flag == 2) corr_adjust = 0;
 
   // delta = time since last correlated event check
+  // async search has summed the steps run on each replica
 
   int delta = update->ntimestep - fix_event->event_timestep - corr_adjust;
 
   // if this is a correlated event, time elapsed only on one partition
 
-  if (flag != 2) delta *= universe->nworlds;
+  if (async_flag && flag == 1) delta = nsteps_async;
+  else if (flag != 2) delta *= universe->nworlds;
   if (delta > 0 && flag != 2) delta -= decrement;
   delta += corr_adjust;
 
@@ -852,6 +1020,9 @@ void PRD::options(int narg, char **arg)
   maxeval = 50;
   temp_flag = 0;
   stepmode = 0;
+  async_flag = 0;
+  screen_flag = 0;
+  screen_dist = 0.0;
 
   loop_setting = utils::strdup("geom");
   dist_setting = utils::strdup("gaussian");
@@ -899,6 +1070,18 @@ void PRD::options(int narg, char **arg)
       else error->all(FLERR,"Illegal prd command");
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal prd command");
+      async_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+
+    } else if (strcmp(arg[iarg],"screen") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal prd command");
+      screen_dist = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if (screen_dist < 0.0) error->all(FLERR,"Illegal prd command");
+      screen_flag = (screen_dist > 0.0) ? 1 : 0;
+      iarg += 2;
+
     } else error->all(FLERR,"Illegal prd command");
   }
 }
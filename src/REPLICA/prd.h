@@ -35,6 +35,8 @@ class PRD : public Command {
   int t_event, n_dephase, t_dephase, t_corr;
   double etol, ftol, temp_dephase;
   int maxiter, maxeval, temp_flag, stepmode, cmode;
+  int async_flag, screen_flag;
+  double screen_dist;
   char *loop_setting, *dist_setting;
 
   int equal_size_replicas, natoms;
@@ -52,10 +54,13 @@ class PRD : public Command {
   imageint *imageall;
 
   int ncoincident;
+  bigint nsteps_async;
+  bigint nquench, nscreened;
 
   class RanPark *random_select, *random_clock;
   class RanMars *random_dephase;
   class Compute *compute_event;
+  class ComputeEventDisplace *compute_displace;
   class FixEventPRD *fix_event;
   class Velocity *velocity;
   class Compute *temperature;
@@ -64,7 +69,9 @@ class PRD : public Command {
   void dephase();
   void dynamics(int, double &);
   void quench();
-  int check_event(int replica = -1);
+  int quench_event();
+  int check_event(int, int replica = -1);
+  int search_async(int, bigint &);
   void share_event(int, int, int);
   void log_event();
   void replicate(int);
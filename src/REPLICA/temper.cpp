@@ -39,9 +39,14 @@ using namespace LAMMPS_NS;
 
 // #define TEMPER_DEBUG 1
 
+enum { TAG_PE = 1, TAG_SWAP, TAG_BORDER, TAG_RELAY };
+
 /* ---------------------------------------------------------------------- */
 
-Temper::Temper(LAMMPS *lmp) : Command(lmp) {}
+Temper::Temper(LAMMPS *lmp) :
+    Command(lmp), nattempt(nullptr), naccept(nullptr), history(nullptr)
+{
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -54,6 +59,9 @@ Temper::~Temper()
   delete [] temp2world;
   delete [] world2temp;
   delete [] world2root;
+  delete [] nattempt;
+  delete [] naccept;
+  delete [] history;
 }
 
 /* ----------------------------------------------------------------------
@@ -66,8 +74,7 @@ void Temper::command(int narg, char **arg)
     error->all(FLERR,"Must have more than one processor partition to temper");
   if (domain->box_exist == 0)
     error->all(FLERR,"Temper command before simulation box is defined");
-  if (narg != 6 && narg != 7)
-    error->universe_all(FLERR,"Illegal temper command");
+  if (narg < 6) utils::missing_cmd_args(FLERR,"temper",error);
 
   int nsteps = utils::inumeric(FLERR,arg[0],false,lmp);
   nevery = utils::inumeric(FLERR,arg[1],false,lmp);
@@ -86,10 +93,38 @@ void Temper::command(int narg, char **arg)
   seed_boltz = utils::inumeric(FLERR,arg[5],false,lmp);
 
   my_set_temp = universe->iworld;
-  if (narg == 7) my_set_temp = utils::inumeric(FLERR,arg[6],false,lmp);
+  int indexflag = 0;
+  int iarg = 6;
+  if ((narg > 6) && utils::is_integer(arg[6])) {
+    my_set_temp = utils::inumeric(FLERR,arg[6],false,lmp);
+    indexflag = 1;
+    iarg = 7;
+  }
   if ((my_set_temp < 0) || (my_set_temp >= universe->nworlds))
     error->universe_one(FLERR,"Illegal temperature index");
 
+  // optional keywords
+
+  pairflag = 0;
+  asyncflag = 0;
+
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"exchange") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"temper exchange",error);
+      if (strcmp(arg[iarg+1],"all") == 0) pairflag = 0;
+      else if (strcmp(arg[iarg+1],"pair") == 0) pairflag = 1;
+      else error->universe_all(FLERR,fmt::format("Unknown temper exchange value: {}",arg[iarg+1]));
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"temper async",error);
+      asyncflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else error->universe_all(FLERR,fmt::format("Unknown temper keyword: {}",arg[iarg]));
+  }
+
+  if (asyncflag && !pairflag)
+    error->universe_all(FLERR,"Temper async yes requires exchange pair");
+
   // swap frequency must evenly divide total # of timesteps
 
   if (nevery <= 0)
@@ -179,9 +214,30 @@ void Temper::command(int narg, char **arg)
   }
   MPI_Bcast(temp2world,nworlds,MPI_INT,0,world);
 
+  // left/right = root procs of worlds with next lower/higher set temp
+  // only root procs use them, to find the partner for a pairwise swap
+
+  left = right = -1;
+  if (my_set_temp > 0) left = world2root[temp2world[my_set_temp-1]];
+  if (my_set_temp < nworlds-1) right = world2root[temp2world[my_set_temp+1]];
+
+  // per-pair swap statistics, tallied by the proc that decides on the swap
+
+  nattempt = new int[nworlds-1];
+  naccept = new int[nworlds-1];
+  for (int i = 0; i < nworlds-1; i++) nattempt[i] = naccept[i] = 0;
+
+  if (asyncflag) history = new int[nswaps];
+  status_request = MPI_REQUEST_NULL;
+
+  // only check for a timeout across all worlds if any world can have one
+
+  int flag = timer->has_timeout() ? 1 : 0;
+  MPI_Allreduce(&flag,&timeoutflag,1,MPI_INT,MPI_MAX,universe->uworld);
+
   // if restarting tempering, reset temp target of Fix to current my_set_temp
 
-  if (narg == 7) {
+  if (indexflag) {
     double new_temp = set_temp[my_set_temp];
     modify->fix[whichfix]->reset_target(new_temp);
   }
@@ -189,7 +245,7 @@ void Temper::command(int narg, char **arg)
   // setup tempering runs
 
   int i,which,partner,swap,partner_set_temp,partner_world;
-  double pe,pe_partner,boltz_factor,new_temp;
+  double pe,pe_partner,new_temp;
 
   if (me_universe == 0 && universe->uscreen)
     fprintf(universe->uscreen,"Setting up tempering ...\n");
@@ -209,12 +265,15 @@ void Temper::command(int narg, char **arg)
         fprintf(universe->ulogfile," T%d",i);
       fprintf(universe->ulogfile,"\n");
     }
-    print_status();
+    print_status(update->ntimestep);
   }
 
   timer->init();
   timer->barrier_start();
 
+  bigint step0 = update->ntimestep;
+  int nswaps_done = 0;
+
   for (int iswap = 0; iswap < nswaps; iswap++) {
 
     // run for nevery timesteps
@@ -223,14 +282,18 @@ void Temper::command(int narg, char **arg)
     update->integrate->run(nevery);
 
     // check for timeout across all procs
-
-    int my_timeout=0;
-    int any_timeout=0;
-    if (timer->is_timeout()) my_timeout=1;
-    MPI_Allreduce(&my_timeout, &any_timeout, 1, MPI_INT, MPI_SUM, universe->uworld);
-    if (any_timeout) {
-      timer->force_timeout();
-      break;
+    // skipped if no world has a timeout, so that exchange pair
+    //   does not synchronize all worlds
+
+    if (!pairflag || timeoutflag) {
+      int my_timeout=0;
+      int any_timeout=0;
+      if (timer->is_timeout()) my_timeout=1;
+      MPI_Allreduce(&my_timeout, &any_timeout, 1, MPI_INT, MPI_SUM, universe->uworld);
+      if (any_timeout) {
+        timer->force_timeout();
+        break;
+      }
     }
 
     // compute PE
@@ -259,7 +322,7 @@ void Temper::command(int narg, char **arg)
     // if partner = -1, then I am not a proc that swaps
 
     partner = -1;
-    if (me == 0 && partner_set_temp >= 0 && partner_set_temp < nworlds) {
+    if (!pairflag && me == 0 && partner_set_temp >= 0 && partner_set_temp < nworlds) {
       partner_world = temp2world[partner_set_temp];
       partner = world2root[partner_world];
     }
@@ -276,13 +339,7 @@ void Temper::command(int narg, char **arg)
       else
         MPI_Recv(&pe_partner,1,MPI_DOUBLE,partner,0,universe->uworld,MPI_STATUS_IGNORE);
 
-      if (me_universe < partner) {
-        boltz_factor = (pe - pe_partner) *
-          (1.0/(boltz*set_temp[my_set_temp]) -
-           1.0/(boltz*set_temp[partner_set_temp]));
-        if (boltz_factor >= 0.0) swap = 1;
-        else if (ranboltz->uniform() < exp(boltz_factor)) swap = 1;
-      }
+      if (me_universe < partner) swap = metropolis(pe,pe_partner,partner_set_temp);
 
       if (me_universe < partner)
         MPI_Send(&swap,1,MPI_INT,partner,0,universe->uworld);
@@ -291,13 +348,17 @@ void Temper::command(int narg, char **arg)
 
 #ifdef TEMPER_DEBUG
       if (me_universe < partner)
-        printf("SWAP %d & %d: yes = %d,Ts = %d %d, PEs = %g %g, Bz = %g %g\n",
+        printf("SWAP %d & %d: yes = %d,Ts = %d %d, PEs = %g %g\n",
                me_universe,partner,swap,my_set_temp,partner_set_temp,
-               pe,pe_partner,boltz_factor,exp(boltz_factor));
+               pe,pe_partner);
 #endif
 
     }
 
+    // pairwise swap, only root procs of worlds with adjacent set temps communicate
+
+    if (pairflag && me == 0) swap = swap_pair(pe,partner_set_temp);
+
     // bcast swap result to other procs in my world
 
     MPI_Bcast(&swap,1,MPI_INT,0,world);
@@ -319,6 +380,27 @@ void Temper::command(int narg, char **arg)
     // bcast within my world
 
     if (swap) my_set_temp = partner_set_temp;
+    nswaps_done++;
+
+    if (pairflag) {
+
+      // exchange pair with async yes: store status for output at end of run
+      // else gather status on world 0 without waiting for it,
+      //   output it when the gather of the next swap is started
+
+      if (me == 0) {
+        if (asyncflag) history[iswap] = my_set_temp;
+        else {
+          MPI_Wait(&status_request,MPI_STATUS_IGNORE);
+          if ((me_universe == 0) && (iswap > 0)) print_status(status_step);
+          status_temp = my_set_temp;
+          status_step = update->ntimestep;
+          MPI_Igather(&status_temp,1,MPI_INT,world2temp,1,MPI_INT,0,roots,&status_request);
+        }
+      }
+      continue;
+    }
+
     if (me == 0) {
       MPI_Allgather(&my_set_temp,1,MPI_INT,world2temp,1,MPI_INT,roots);
       for (i = 0; i < nworlds; i++) temp2world[world2temp[i]] = i;
@@ -327,7 +409,45 @@ void Temper::command(int narg, char **arg)
 
     // print out current swap status
 
-    if (me_universe == 0) print_status();
+    if (me_universe == 0) print_status(update->ntimestep);
+  }
+
+  // output pending or stored swap status of exchange pair
+
+  if (pairflag && me == 0) {
+    if (asyncflag) {
+      int *all = nullptr;
+      if (me_universe == 0) all = new int[nworlds*nswaps_done];
+      MPI_Gather(history,nswaps_done,MPI_INT,all,nswaps_done,MPI_INT,0,roots);
+      if (me_universe == 0) {
+        for (int iswap = 0; iswap < nswaps_done; iswap++) {
+          for (i = 0; i < nworlds; i++) world2temp[i] = all[i*nswaps_done+iswap];
+          print_status(step0 + (bigint) (iswap+1)*nevery);
+        }
+      }
+      delete[] all;
+    } else {
+      MPI_Wait(&status_request,MPI_STATUS_IGNORE);
+      if ((me_universe == 0) && (nswaps_done > 0)) print_status(status_step);
+    }
+  }
+
+  // output per-pair swap statistics
+
+  if (me == 0) {
+    int *allattempt = new int[nworlds-1];
+    int *allaccept = new int[nworlds-1];
+    MPI_Reduce(nattempt,allattempt,nworlds-1,MPI_INT,MPI_SUM,0,roots);
+    MPI_Reduce(naccept,allaccept,nworlds-1,MPI_INT,MPI_SUM,0,roots);
+    if (me_universe == 0) {
+      for (i = 0; i < nworlds-1; i++) {
+        nattempt[i] = allattempt[i];
+        naccept[i] = allaccept[i];
+      }
+      print_stats();
+    }
+    delete[] allattempt;
+    delete[] allaccept;
   }
 
   timer->barrier_stop();
@@ -342,6 +462,112 @@ void Temper::command(int narg, char **arg)
   update->beginstep = update->endstep = 0;
 }
 
+/* ----------------------------------------------------------------------
+   Boltzmann decision on whether to swap with world at partner set temp
+   also tally attempted and accepted swaps for this pair of set temps
+------------------------------------------------------------------------- */
+
+int Temper::metropolis(double pe, double pe_partner, int partner_set_temp)
+{
+  int swap = 0;
+  double boltz_factor = (pe - pe_partner) *
+    (1.0/(boltz*set_temp[my_set_temp]) -
+     1.0/(boltz*set_temp[partner_set_temp]));
+  if (boltz_factor >= 0.0) swap = 1;
+  else if (ranboltz->uniform() < exp(boltz_factor)) swap = 1;
+
+  int ipair = MIN(my_set_temp,partner_set_temp);
+  nattempt[ipair]++;
+  if (swap) naccept[ipair]++;
+
+  return swap;
+}
+
+/* ----------------------------------------------------------------------
+   swap with world at partner set temp via messages between root procs
+     of worlds with adjacent set temps only, called by root procs
+   hi proc sends PE to lo proc, lo proc decides and returns the result,
+     same as the swap with all root procs
+   each world also tells the world at the adjacent set temp on the other
+     side (outer neighbor) which root proc holds its old set temp now,
+     a world that swapped relays this to its partner,
+     so that left/right are correct for the next swap
+   returns 1 if the swap was accepted
+------------------------------------------------------------------------- */
+
+int Temper::swap_pair(double pe, int partner_set_temp)
+{
+  MPI_Comm uworld = universe->uworld;
+  MPI_Request requests[5];
+  int nrequest = 0;
+
+  int partner = -1;
+  int pside = -1;
+  if (partner_set_temp >= 0 && partner_set_temp < nworlds) {
+    if (partner_set_temp > my_set_temp) {
+      partner = right;
+      pside = 1;
+    } else {
+      partner = left;
+      pside = 0;
+    }
+  }
+
+  // outer[0,1] = left/right neighbor that is not my partner, else -1
+  // border[0,1] = root proc that holds its set temp after this swap
+
+  int outer[2] = {left,right};
+  if (pside >= 0) outer[pside] = -1;
+
+  int border[2] = {-1,-1};
+  for (int m = 0; m < 2; m++)
+    if (outer[m] >= 0)
+      MPI_Irecv(&border[m],1,MPI_INT,outer[m],TAG_BORDER,uworld,&requests[nrequest++]);
+  int nrecv = nrequest;
+
+  int swap = 0;
+  if (partner >= 0) {
+    if (me_universe > partner) {
+      MPI_Isend(&pe,1,MPI_DOUBLE,partner,TAG_PE,uworld,&requests[nrequest++]);
+      MPI_Recv(&swap,1,MPI_INT,partner,TAG_SWAP,uworld,MPI_STATUS_IGNORE);
+    } else {
+      double pe_partner;
+      MPI_Recv(&pe_partner,1,MPI_DOUBLE,partner,TAG_PE,uworld,MPI_STATUS_IGNORE);
+      swap = metropolis(pe,pe_partner,partner_set_temp);
+      MPI_Isend(&swap,1,MPI_INT,partner,TAG_SWAP,uworld,&requests[nrequest++]);
+    }
+  }
+
+  int hold = swap ? partner : me_universe;
+  for (int m = 0; m < 2; m++)
+    if (outer[m] >= 0)
+      MPI_Isend(&hold,1,MPI_INT,outer[m],TAG_BORDER,uworld,&requests[nrequest++]);
+  MPI_Waitall(nrecv,requests,MPI_STATUSES_IGNORE);
+
+  // after a swap, my neighbor on the side of my old set temp is my partner
+  // the other one is the outer neighbor of my partner, relayed by it
+
+  if (swap) {
+    int relay = border[1-pside];
+    int relay_partner;
+    MPI_Sendrecv(&relay,1,MPI_INT,partner,TAG_RELAY,&relay_partner,1,MPI_INT,partner,
+                 TAG_RELAY,uworld,MPI_STATUS_IGNORE);
+    if (pside == 1) {
+      left = partner;
+      right = relay_partner;
+    } else {
+      right = partner;
+      left = relay_partner;
+    }
+  } else {
+    if (outer[0] >= 0) left = border[0];
+    if (outer[1] >= 0) right = border[1];
+  }
+
+  MPI_Waitall(nrequest-nrecv,&requests[nrecv],MPI_STATUSES_IGNORE);
+  return swap;
+}
+
 /* ----------------------------------------------------------------------
    scale kinetic energy via velocities a la Sugita
 ------------------------------------------------------------------------- */
@@ -364,9 +590,9 @@ void Temper::scale_velocities(int t_partner, int t_me)
    proc 0 prints current tempering status
 ------------------------------------------------------------------------- */
 
-void Temper::print_status()
+void Temper::print_status(bigint step)
 {
-  std::string status = std::to_string(update->ntimestep);
+  std::string status = std::to_string(step);
   for (int i = 0; i < nworlds; i++)
     status += " " + std::to_string(world2temp[i]);
 
@@ -378,3 +604,22 @@ void Temper::print_status()
     fflush(universe->ulogfile);
   }
 }
+
+/* ----------------------------------------------------------------------
+   proc 0 prints swap statistics for each pair of adjacent set temps
+------------------------------------------------------------------------- */
+
+void Temper::print_stats()
+{
+  std::string mesg = "Tempering swap statistics:\n  Temps  Attempts  Accepted  Ratio\n";
+  for (int i = 0; i < nworlds-1; i++) {
+    double ratio = nattempt[i] ? (double) naccept[i]/nattempt[i] : 0.0;
+    mesg += fmt::format("  {} {}  {}  {}  {:.4f}\n",i,i+1,nattempt[i],naccept[i],ratio);
+  }
+
+  if (universe->uscreen) fputs(mesg.c_str(), universe->uscreen);
+  if (universe->ulogfile) {
+    fputs(mesg.c_str(), universe->ulogfile);
+    fflush(universe->ulogfile);
+  }
+}
@@ -49,8 +49,22 @@ class Temper : public Command {
   int *world2temp;     // world2temp[i] = temp simulated by world i
   int *world2root;     // world2root[i] = root proc of world i
 
+  int pairflag;           // 1 if swaps only communicate between adjacent temps
+  int asyncflag;          // 1 if swap status is only output at end of run
+  int timeoutflag;        // 1 if any world has a timeout to check
+  int left, right;        // root procs of worlds with adjacent set temps
+  int *nattempt;          // # of swap attempts between set temps i and i+1
+  int *naccept;           // # of accepted swaps between set temps i and i+1
+  int *history;           // my set temp after each swap, for async output
+  int status_temp;        // my set temp sent to world 0 for status output
+  bigint status_step;     // timestep of pending status output
+  MPI_Request status_request;
+
+  int metropolis(double, double, int);
+  int swap_pair(double, int);
   void scale_velocities(int, int);
-  void print_status();
+  void print_status(bigint);
+  void print_stats();
 };
 
 }    // namespace LAMMPS_NS
@@ -300,6 +300,60 @@ int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag,
 
 /* ---------------------------------------------------------------------- */
 
+int MPI_Send_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag,
+                  MPI_Comm comm, MPI_Request *request)
+{
+  static int callcount = 0;
+  if (callcount == 0) {
+    printf("MPI Stub WARNING: Should not send message to self\n");
+    ++callcount;
+  }
+  *request = MPI_REQUEST_NULL;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+                  MPI_Request *request)
+{
+  static int callcount = 0;
+  if (callcount == 0) {
+    printf("MPI Stub WARNING: Should not recv message from self\n");
+    ++callcount;
+  }
+  *request = MPI_REQUEST_NULL;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/* nothing to start, all requests are null */
+
+int MPI_Startall(int n, MPI_Request *request)
+{
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+/* with a single rank, every request is complete */
+
+int MPI_Test(MPI_Request *request, int *flag, MPI_Status *status)
+{
+  *flag = 1;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Cancel(MPI_Request *request)
+{
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
 int MPI_Wait(MPI_Request *request, MPI_Status *status)
 {
   static int callcount = 0;
@@ -434,6 +488,81 @@ int MPI_Group_free(MPI_Group *group)
 
 /* ---------------------------------------------------------------------- */
 
+int MPI_Group_translate_ranks(MPI_Group group1, int n, const int *ranks1, MPI_Group group2,
+                              int *ranks2)
+{
+  for (int i = 0; i < n; i++) ranks2[i] = ranks1[i];
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Comm_split_type(MPI_Comm comm, int split_type, int key, MPI_Info info,
+                        MPI_Comm *newcomm)
+{
+  *newcomm = comm + 1;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Win_allocate_shared(MPI_Aint size, int disp_unit, MPI_Info info, MPI_Comm comm,
+                            void *baseptr, MPI_Win *win)
+{
+  MPI_Win w = (MPI_Win) malloc(sizeof(struct _MPI_Win));
+  w->base = malloc(size > 0 ? size : 1);
+  w->size = size;
+  w->disp_unit = disp_unit;
+  *(void **) baseptr = w->base;
+  *win = w;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Win_shared_query(MPI_Win win, int rank, MPI_Aint *size, int *disp_unit, void *baseptr)
+{
+  *size = win->size;
+  *disp_unit = win->disp_unit;
+  *(void **) baseptr = win->base;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Win_free(MPI_Win *win)
+{
+  if (*win) {
+    free((*win)->base);
+    free(*win);
+  }
+  *win = MPI_WIN_NULL;
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Win_lock_all(int assert, MPI_Win win)
+{
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Win_unlock_all(MPI_Win win)
+{
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MPI_Win_sync(MPI_Win win)
+{
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
 int MPI_Cart_create(MPI_Comm comm_old, int ndims, int *dims, int *periods, int reorder,
                     MPI_Comm *comm_cart)
 {
@@ -556,6 +685,17 @@ int MPI_Allreduce(void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype
 
 /* ---------------------------------------------------------------------- */
 
+/* copy values from data1 to data2, request is complete immediately */
+
+int MPI_Iallreduce(void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                   MPI_Comm comm, MPI_Request *request)
+{
+  *request = MPI_REQUEST_NULL;
+  return MPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+/* ---------------------------------------------------------------------- */
+
 /* copy values from data1 to data2 */
 
 int MPI_Reduce(void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
@@ -638,6 +778,15 @@ int MPI_Gather(void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbu
 
 /* ---------------------------------------------------------------------- */
 
+int MPI_Igather(void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request)
+{
+  *request = MPI_REQUEST_NULL;
+  return MPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+/* ---------------------------------------------------------------------- */
+
 /* copy values from data1 to data2 */
 
 int MPI_Gatherv(void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int *recvcounts,
@@ -708,3 +857,16 @@ int MPI_Alltoallv(void *sendbuf, int *sendcounts, int *sdispls, MPI_Datatype sen
 }
 
 /* ---------------------------------------------------------------------- */
+
+/* copy values from data1 to data2, request is complete immediately */
+
+int MPI_Ialltoallv(void *sendbuf, int *sendcounts, int *sdispls, MPI_Datatype sendtype,
+                   void *recvbuf, int *recvcounts, int *rdispls, MPI_Datatype recvtype,
+                   MPI_Comm comm, MPI_Request *request)
+{
+  *request = MPI_REQUEST_NULL;
+  return MPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls,
+                       recvtype, comm);
+}
+
+/* ---------------------------------------------------------------------- */
@@ -38,6 +38,10 @@
 
 #include <algorithm>
 #include <cstring>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifdef LMP_GPU
 #include "fix_gpu.h"
@@ -102,8 +106,12 @@ Atom::Atom(LAMMPS *_lmp) : Pointers(_lmp)
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
+  sortorder = SORT_XYZ;
+  sortthresh = 0.0;
   maxbin = maxnext = 0;
   binhead = nullptr;
+  binorder = nullptr;
+  binorderflag = 0;
   next = permute = nullptr;
 
   // --------------------------------------------------------------------
@@ -295,6 +303,7 @@ Atom::~Atom()
 
   delete[] firstgroupname;
   memory->destroy(binhead);
+  memory->destroy(binorder);
   memory->destroy(next);
   memory->destroy(permute);
 
@@ -376,6 +385,8 @@ void Atom::settings(Atom *old)
   map_style = old->map_style;
   sortfreq = old->sortfreq;
   userbinsize = old->userbinsize;
+  sortorder = old->sortorder;
+  sortthresh = old->sortthresh;
   if (old->firstgroupname)
     firstgroupname = utils::strdup(old->firstgroupname);
 }
@@ -848,6 +859,19 @@ void Atom::modify_params(int narg, char **arg)
       if ((sortfreq >= 0) && firstgroupname)
         error->all(FLERR,"Atom_modify sort and first options cannot be used together");
       iarg += 3;
+    } else if (strcmp(arg[iarg],"sort/order") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "atom_modify sort/order", error);
+      if (strcmp(arg[iarg+1],"xyz") == 0) sortorder = SORT_XYZ;
+      else if (strcmp(arg[iarg+1],"morton") == 0) sortorder = SORT_MORTON;
+      else if (strcmp(arg[iarg+1],"hilbert") == 0) sortorder = SORT_HILBERT;
+      else error->all(FLERR,"Illegal atom_modify sort/order argument {}", arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"sort/adaptive") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "atom_modify sort/adaptive", error);
+      sortthresh = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      if (sortthresh < 0.0 || sortthresh > 1.0)
+        error->all(FLERR,"Illegal atom_modify sort/adaptive fraction {}", sortthresh);
+      iarg += 2;
     } else error->all(FLERR,"Illegal atom_modify command argument: {}", arg[iarg]);
   }
 }
@@ -2242,7 +2266,7 @@ void Atom::first_reorder()
 
 void Atom::sort()
 {
-  int i,m,n,ix,iy,iz,ibin,empty;
+  int i,empty;
 
   // set next timestep for sorting to take place
 
@@ -2267,45 +2291,139 @@ void Atom::sort()
 
   if (nlocal == nmax) avec->grow(0);
 
-  // bin atoms in reverse order so linked list will be in forward order
-
-  for (i = 0; i < nbins; i++) binhead[i] = -1;
+  // assign each atom to its bin and count atoms out of bin order
+  // bin index is position of bin along the sort curve
+  // each thread handles one contiguous chunk of atoms
 
   // for triclinic, atoms must be in box coords (not lamda) to match bbox
 
   if (domain->triclinic) domain->lamda2x(nlocal);
 
-  for (i = nlocal-1; i >= 0; i--) {
-    ix = static_cast<int> ((x[i][0]-bboxlo[0])*bininvx);
-    iy = static_cast<int> ((x[i][1]-bboxlo[1])*bininvy);
-    iz = static_cast<int> ((x[i][2]-bboxlo[2])*bininvz);
-    ix = MAX(ix,0);
-    iy = MAX(iy,0);
-    iz = MAX(iz,0);
-    ix = MIN(ix,nbinx-1);
-    iy = MIN(iy,nbiny-1);
-    iz = MIN(iz,nbinz-1);
-    ibin = iz*nbiny*nbinx + iy*nbinx + ix;
-    next[i] = binhead[ibin];
-    binhead[ibin] = i;
+  const int nthreads = MAX(comm->nthreads,1);
+  int unsorted = 0;
+
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(nthreads) default(shared) reduction(+:unsorted)
+#endif
+  {
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+    const int nthr = omp_get_num_threads();
+#else
+    const int tid = 0;
+    const int nthr = 1;
+#endif
+    const int idelta = 1 + nlocal/nthr;
+    const int ifrom = MIN(tid*idelta,nlocal);
+    const int ito = MIN(ifrom+idelta,nlocal);
+    int ix,iy,iz,ibin;
+
+    for (int i = ifrom; i < ito; i++) {
+      ix = static_cast<int> ((x[i][0]-bboxlo[0])*bininvx);
+      iy = static_cast<int> ((x[i][1]-bboxlo[1])*bininvy);
+      iz = static_cast<int> ((x[i][2]-bboxlo[2])*bininvz);
+      ix = MAX(ix,0);
+      iy = MAX(iy,0);
+      iz = MAX(iz,0);
+      ix = MIN(ix,nbinx-1);
+      iy = MIN(iy,nbiny-1);
+      iz = MIN(iz,nbinz-1);
+      ibin = iz*nbiny*nbinx + iy*nbinx + ix;
+      if (binorderflag > 0) ibin = binorder[ibin];
+      next[i] = ibin;
+    }
+
+#if defined(_OPENMP)
+#pragma omp barrier
+#endif
+    for (int i = MAX(ifrom,1); i < ito; i++)
+      if (next[i] < next[i-1]) unsorted++;
   }
 
   // convert back to lamda coords
 
   if (domain->triclinic) domain->x2lamda(nlocal);
 
+  // adaptive sorting: skip sort while few atoms are out of bin order
+
+  if (unsorted <= sortthresh*nlocal) return;
+
+  // counting sort with per-thread bin counts over the same atom chunks
+  // bins are split into one block per thread for the prefix sum
+  // binhead[M] = offset of 1st atom in bin M
+  // bincount[T][M] = offset of 1st atom of thread T's chunk in bin M
   // permute = desired permutation of atoms
   // permute[I] = J means Ith new atom will be Jth old atom
+  // atoms in same bin keep their relative order
+
+  int **bincount,*blockoffset;
+  memory->create(bincount,nthreads,nbins,"atom:bincount");
+  memory->create(blockoffset,nthreads+1,"atom:blockoffset");
 
-  n = 0;
-  for (m = 0; m < nbins; m++) {
-    i = binhead[m];
-    while (i >= 0) {
-      permute[n++] = i;
-      i = next[i];
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(nthreads) default(shared)
+#endif
+  {
+#if defined(_OPENMP)
+    const int tid = omp_get_thread_num();
+    const int nthr = omp_get_num_threads();
+#else
+    const int tid = 0;
+    const int nthr = 1;
+#endif
+    const int idelta = 1 + nlocal/nthr;
+    const int ifrom = MIN(tid*idelta,nlocal);
+    const int ito = MIN(ifrom+idelta,nlocal);
+    const int mdelta = 1 + nbins/nthr;
+    const int mfrom = MIN(tid*mdelta,nbins);
+    const int mto = MIN(mfrom+mdelta,nbins);
+    int *count = bincount[tid];
+    int m,t,n,offset;
+
+    for (m = 0; m < nbins; m++) count[m] = 0;
+    for (int i = ifrom; i < ito; i++) count[next[i]]++;
+
+#if defined(_OPENMP)
+#pragma omp barrier
+#endif
+
+    // # of atoms in my block of bins
+
+    n = 0;
+    for (m = mfrom; m < mto; m++)
+      for (t = 0; t < nthr; t++) n += bincount[t][m];
+    blockoffset[tid+1] = n;
+
+#if defined(_OPENMP)
+#pragma omp barrier
+#pragma omp single
+#endif
+    {
+      blockoffset[0] = 0;
+      for (t = 0; t < nthr; t++) blockoffset[t+1] += blockoffset[t];
     }
+
+    // convert counts in my block of bins to offsets
+
+    offset = blockoffset[tid];
+    for (m = mfrom; m < mto; m++) {
+      binhead[m] = offset;
+      for (t = 0; t < nthr; t++) {
+        n = bincount[t][m];
+        bincount[t][m] = offset;
+        offset += n;
+      }
+    }
+
+#if defined(_OPENMP)
+#pragma omp barrier
+#endif
+    for (int i = ifrom; i < ito; i++) permute[count[next[i]]++] = i;
   }
 
+  memory->destroy(bincount);
+  memory->destroy(blockoffset);
+
   // current = current permutation, just reuse next vector
   // current[I] = J means Ith current atom is Jth old atom
 
@@ -2482,9 +2600,101 @@ void Atom::setup_sort_bins()
 
   if (nbins > maxbin) {
     memory->destroy(binhead);
+    memory->destroy(binorder);
     maxbin = nbins;
     memory->create(binhead,maxbin,"atom:binhead");
   }
+
+  // position of each bin along a space-filling curve
+  // fall back to xyz order for the current bins if curve keys would not fit into 64 bits
+  // sortorder is kept, so the curve is used again once the bins allow it
+
+  if (sortorder == SORT_XYZ) {
+    binorderflag = 0;
+  } else {
+    int ndim = (domain->dimension == 2) ? 2 : 3;
+    int maxn = MAX(nbinx,MAX(nbiny,nbinz));
+    int bits = 1;
+    while ((1 << bits) < maxn) bits++;
+    if (bits*ndim > 63) {
+      if ((binorderflag >= 0) && (comm->me == 0))
+        error->warning(FLERR,"Too many atom sorting bins for space-filling curve. "
+                       "Using xyz sort order.");
+      binorderflag = -1;
+      return;
+    }
+
+    if (binorder == nullptr) memory->create(binorder,maxbin,"atom:binorder");
+
+    std::vector<std::pair<uint64_t,int>> keys(nbins);
+    unsigned int coord[3];
+    for (int iz = 0; iz < nbinz; iz++)
+      for (int iy = 0; iy < nbiny; iy++)
+        for (int ix = 0; ix < nbinx; ix++) {
+          int ibin = iz*nbiny*nbinx + iy*nbinx + ix;
+          coord[0] = ix;
+          coord[1] = iy;
+          coord[2] = iz;
+          if (sortorder == SORT_HILBERT) keys[ibin].first = hilbert_key(coord,ndim,bits);
+          else keys[ibin].first = morton_key(coord,ndim,bits);
+          keys[ibin].second = ibin;
+        }
+    std::sort(keys.begin(),keys.end());
+    for (int i = 0; i < nbins; i++) binorder[keys[i].second] = i;
+    binorderflag = 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Morton (Z-order) key of a grid point with coords of N bits each
+------------------------------------------------------------------------- */
+
+uint64_t Atom::morton_key(unsigned int *coord, int ndim, int bits)
+{
+  uint64_t key = 0;
+  for (int b = bits-1; b >= 0; b--)
+    for (int i = ndim-1; i >= 0; i--) key = (key << 1) | ((coord[i] >> b) & 1);
+  return key;
+}
+
+/* ----------------------------------------------------------------------
+   Hilbert curve key of a grid point with coords of N bits each
+   coords are converted in place to the transposed Hilbert index,
+     following J. Skilling, AIP Conf. Proc. 707, 381 (2004)
+   the bits of the transposed index are then interleaved into one key
+------------------------------------------------------------------------- */
+
+uint64_t Atom::hilbert_key(unsigned int *coord, int ndim, int bits)
+{
+  unsigned int m = 1U << (bits-1);
+  unsigned int p,q,t;
+
+  // inverse undo of excess work
+
+  for (q = m; q > 1; q >>= 1) {
+    p = q - 1;
+    for (int i = 0; i < ndim; i++) {
+      if (coord[i] & q) coord[0] ^= p;
+      else {
+        t = (coord[0] ^ coord[i]) & p;
+        coord[0] ^= t;
+        coord[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+
+  for (int i = 1; i < ndim; i++) coord[i] ^= coord[i-1];
+  t = 0;
+  for (q = m; q > 1; q >>= 1)
+    if (coord[ndim-1] & q) t ^= q - 1;
+  for (int i = 0; i < ndim; i++) coord[i] ^= t;
+
+  uint64_t key = 0;
+  for (int b = bits-1; b >= 0; b--)
+    for (int i = 0; i < ndim; i++) key = (key << 1) | ((coord[i] >> b) & 1);
+  return key;
 }
 
 /* ----------------------------------------------------------------------
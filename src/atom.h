@@ -36,6 +36,7 @@ class Atom : protected Pointers {
   enum { ATOM = 0, BOND = 1, ANGLE = 2, DIHEDRAL = 3, IMPROPER = 4 };
   enum { NUMERIC = 0, LABELS = 1 };
   enum { MAP_NONE = 0, MAP_ARRAY = 1, MAP_HASH = 2, MAP_YES = 3 };
+  enum { SORT_XYZ = 0, SORT_MORTON = 1, SORT_HILBERT = 2 };
 
   // atom counts
 
@@ -283,6 +284,9 @@ class Atom : protected Pointers {
   int sortfreq;          // sort atoms every this many steps, 0 = off
   bigint nextsort;       // next timestep to sort on
   double userbinsize;    // requested sort bin size
+  int sortorder;         // order of sort bins: SORT_XYZ, SORT_MORTON, SORT_HILBERT
+  double sortthresh;     // only sort if fraction of atoms out of bin order exceeds this
+                         // 0.0 = always sort every sortfreq steps
 
   // indices of atoms with same ID
 
@@ -427,14 +431,19 @@ class Atom : protected Pointers {
   int nbinx, nbiny, nbinz;             // bins in each dimension
   int maxbin;                          // max # of bins
   int maxnext;                         // max size of next,permute
-  int *binhead;                        // 1st atom in each bin
-  int *next;                           // next atom in bin
+  int *binhead;                        // # of atoms in each bin, then 1st atom offset
+  int *binorder;                       // position of each xyz bin along sort curve
+  int binorderflag;                    // 1 if current sort bins are traversed via binorder
+                                       // -1 if xyz order is used as fallback for sortorder
+  int *next;                           // sort bin of each atom
   int *permute;                        // permutation vector
   double bininvx, bininvy, bininvz;    // inverse actual bin sizes
   double bboxlo[3], bboxhi[3];         // bounding box of my sub-domain
 
   void set_atomflag_defaults();
   void setup_sort_bins();
+  static uint64_t morton_key(unsigned int *, int, int);
+  static uint64_t hilbert_key(unsigned int *, int, int);
   int next_prime(int);
 };
 
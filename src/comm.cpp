@@ -62,6 +62,7 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   ncollections = 0;
   ncollections_cutoff = 0;
   ghost_velocity = 0;
+  shmemflag = 0;
 
   user_procgrid[0] = user_procgrid[1] = user_procgrid[2] = 0;
   coregrid[0] = coregrid[1] = coregrid[2] = 1;
@@ -392,6 +393,10 @@ void Comm::modify_params(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify vel", error);
       ghost_velocity = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"shmem") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify shmem", error);
+      shmemflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else error->all(FLERR,"Unknown comm_modify keyword: {}", arg[iarg]);
   }
 }
@@ -35,6 +35,8 @@ class Comm : protected Pointers {
 
   int me, nprocs;               // proc info
   int ghost_velocity;           // 1 if ghost atoms have velocity, 0 if not
+  int shmemflag;                // 1 if forward/reverse comm between procs on the
+                                //   same node uses a shared-memory window, 0 if not
   double cutghost[3];           // cutoffs used for acquiring ghost atoms
   double cutghostuser;          // user-specified ghost cutoff (mode == SINGLE)
   double *cutusermulti;         // per collection user ghost cutoff (mode == MULTI)
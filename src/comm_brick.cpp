@@ -48,7 +48,8 @@ CommBrick::CommBrick(LAMMPS *lmp) :
   slablo(nullptr), slabhi(nullptr), multilo(nullptr), multihi(nullptr),
   multioldlo(nullptr), multioldhi(nullptr), cutghostmulti(nullptr), cutghostmultiold(nullptr),
   pbc_flag(nullptr), pbc(nullptr), firstrecv(nullptr), sendlist(nullptr),
-  localsendlist(nullptr), maxsendlist(nullptr), buf_send(nullptr), buf_recv(nullptr)
+  localsendlist(nullptr), maxsendlist(nullptr), buf_send(nullptr), buf_recv(nullptr),
+  shmpeer(nullptr), shmsendrank(nullptr), shmrecvrank(nullptr)
 {
   style = Comm::BRICK;
   layout = Comm::LAYOUT_UNIFORM;
@@ -78,6 +79,8 @@ CommBrick::~CommBrick()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+
+  free_shm();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -115,6 +118,12 @@ void CommBrick::init_buffers()
   CommBrick::grow_send(maxsend,2);
   memory->create(buf_recv,maxrecv,"comm:buf_recv");
 
+  nodecomm = MPI_COMM_NULL;
+  shmwin = MPI_WIN_NULL;
+  shmpeer = nullptr;
+  menode = nodeprocs = maxshm = shmslot = 0;
+  shmsendrank = shmrecvrank = nullptr;
+
   nswap = 0;
   maxswap = 6;
   CommBrick::allocate_swap(maxswap);
@@ -137,6 +146,12 @@ void CommBrick::init()
   init_exchange();
   if (bufextra > bufextra_old) grow_send(maxsend+bufextra,2);
 
+  // shared-memory comm is set up in setup(), release it if no longer requested
+
+  if (shmemflag && lmp->kokkos)
+    error->all(FLERR,"Comm_modify shmem yes is not supported with the KOKKOS package");
+  if (!shmemflag) free_shm();
+
   // memory for multi style communication
   // allocate in setup
 
@@ -480,6 +495,8 @@ void CommBrick::setup()
       iswap++;
     }
   }
+
+  if (shmemflag) setup_shm();
 }
 
 /* ----------------------------------------------------------------------
@@ -537,6 +554,11 @@ int CommBrick::updown(int dim, int dir, int loc, double prd, int periodicity, do
 
 void CommBrick::forward_comm(int /*dummy*/)
 {
+  if (shmwin != MPI_WIN_NULL) {
+    forward_comm_shm();
+    return;
+  }
+
   int n;
   MPI_Request request;
   AtomVec *avec = atom->avec;
@@ -597,6 +619,11 @@ void CommBrick::forward_comm(int /*dummy*/)
 
 void CommBrick::reverse_comm()
 {
+  if (shmwin != MPI_WIN_NULL) {
+    reverse_comm_shm();
+    return;
+  }
+
   int n;
   MPI_Request request;
   AtomVec *avec = atom->avec;
@@ -638,6 +665,234 @@ void CommBrick::reverse_comm()
   }
 }
 
+/* ----------------------------------------------------------------------
+   forward communication of atom coords with comm_modify shmem yes
+   a proc on the same node as its recvproc reads ghost data directly from
+     the comm slot of recvproc in the shared-memory window
+   only swaps with procs on other nodes use MPI messages
+   all procs on a node must call sync_shm() once per swap
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_shm()
+{
+  int n;
+  MPI_Request request;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+  double *buf,*slot;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (sendproc[iswap] == me) {
+      if (comm_x_only) {
+        if (sendnum[iswap])
+          avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                          x[firstrecv[iswap]],pbc_flag[iswap],pbc[iswap]);
+      } else if (ghost_velocity) {
+        avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+        avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],buf_send);
+      } else {
+        avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+        avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_send);
+      }
+      sync_shm();
+      continue;
+    }
+
+    // post receive from an off-node recvproc
+
+    int recvoff = (shmrecvrank[iswap] < 0) && size_forward_recv[iswap];
+    if (recvoff) {
+      if (comm_x_only) buf = x[firstrecv[iswap]];
+      else buf = buf_recv;
+      MPI_Irecv(buf,size_forward_recv[iswap],MPI_DOUBLE,recvproc[iswap],0,world,&request);
+    }
+
+    // pack into my comm slot for an on-node sendproc, else send message
+
+    if (shmsendrank[iswap] >= 0) buf = shmpeer[menode] + shmslot*maxshm;
+    else buf = buf_send;
+    if (ghost_velocity)
+      n = avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],buf,pbc_flag[iswap],pbc[iswap]);
+    else
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf,pbc_flag[iswap],pbc[iswap]);
+    if (n && shmsendrank[iswap] < 0)
+      MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
+
+    sync_shm();
+
+    // unpack from comm slot of an on-node recvproc, else from message
+
+    if (shmrecvrank[iswap] >= 0) {
+      slot = shmpeer[shmrecvrank[iswap]] + shmslot*maxshm;
+      if (comm_x_only) {
+        if (size_forward_recv[iswap])
+          memcpy(x[firstrecv[iswap]],slot,size_forward_recv[iswap]*sizeof(double));
+      } else if (ghost_velocity) avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],slot);
+      else avec->unpack_comm(recvnum[iswap],firstrecv[iswap],slot);
+    } else {
+      if (recvoff) MPI_Wait(&request,MPI_STATUS_IGNORE);
+      if (ghost_velocity) avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],buf_recv);
+      else if (!comm_x_only) avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_recv);
+    }
+    shmslot ^= 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reverse communication of forces with comm_modify shmem yes
+   same as forward_comm_shm() with roles of sendproc and recvproc swapped
+------------------------------------------------------------------------- */
+
+void CommBrick::reverse_comm_shm()
+{
+  int n;
+  MPI_Request request;
+  AtomVec *avec = atom->avec;
+  double **f = atom->f;
+  double *buf;
+
+  for (int iswap = nswap-1; iswap >= 0; iswap--) {
+    if (sendproc[iswap] == me) {
+      if (comm_f_only) {
+        if (sendnum[iswap])
+          avec->unpack_reverse(sendnum[iswap],sendlist[iswap],f[firstrecv[iswap]]);
+      } else {
+        avec->pack_reverse(recvnum[iswap],firstrecv[iswap],buf_send);
+        avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_send);
+      }
+      sync_shm();
+      continue;
+    }
+
+    // post receive from an off-node sendproc
+
+    int recvoff = (shmsendrank[iswap] < 0) && size_reverse_recv[iswap];
+    if (recvoff)
+      MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,sendproc[iswap],0,world,&request);
+
+    // copy into my comm slot for an on-node recvproc, else send message
+
+    if (shmrecvrank[iswap] >= 0) {
+      buf = shmpeer[menode] + shmslot*maxshm;
+      if (comm_f_only) {
+        if (size_reverse_send[iswap])
+          memcpy(buf,f[firstrecv[iswap]],size_reverse_send[iswap]*sizeof(double));
+      } else avec->pack_reverse(recvnum[iswap],firstrecv[iswap],buf);
+    } else {
+      if (comm_f_only) {
+        if (size_reverse_send[iswap])
+          MPI_Send(f[firstrecv[iswap]],size_reverse_send[iswap],MPI_DOUBLE,
+                   recvproc[iswap],0,world);
+      } else {
+        n = avec->pack_reverse(recvnum[iswap],firstrecv[iswap],buf_send);
+        if (n) MPI_Send(buf_send,n,MPI_DOUBLE,recvproc[iswap],0,world);
+      }
+    }
+
+    sync_shm();
+
+    // unpack from comm slot of an on-node sendproc, else from message
+
+    if (shmsendrank[iswap] >= 0)
+      avec->unpack_reverse(sendnum[iswap],sendlist[iswap],
+                           shmpeer[shmsendrank[iswap]] + shmslot*maxshm);
+    else {
+      if (recvoff) MPI_Wait(&request,MPI_STATUS_IGNORE);
+      avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_recv);
+    }
+    shmslot ^= 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   create node communicator and shared-memory window on first call
+   determine which sendproc/recvproc of each swap are on my node
+   called from setup() after the swap pattern is set
+------------------------------------------------------------------------- */
+
+void CommBrick::setup_shm()
+{
+  if (nodecomm == MPI_COMM_NULL) {
+    MPI_Comm_split_type(world,MPI_COMM_TYPE_SHARED,me,MPI_INFO_NULL,&nodecomm);
+    MPI_Comm_rank(nodecomm,&menode);
+    MPI_Comm_size(nodecomm,&nodeprocs);
+    shmpeer = new double*[nodeprocs];
+    grow_shm(BUFMIN);
+  }
+
+  MPI_Group worldgroup,nodegroup;
+  MPI_Comm_group(world,&worldgroup);
+  MPI_Comm_group(nodecomm,&nodegroup);
+  MPI_Group_translate_ranks(worldgroup,nswap,sendproc,nodegroup,shmsendrank);
+  MPI_Group_translate_ranks(worldgroup,nswap,recvproc,nodegroup,shmrecvrank);
+  MPI_Group_free(&worldgroup);
+  MPI_Group_free(&nodegroup);
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (shmsendrank[iswap] == MPI_UNDEFINED) shmsendrank[iswap] = -1;
+    if (shmrecvrank[iswap] == MPI_UNDEFINED) shmrecvrank[iswap] = -1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reallocate shared-memory window if any proc on my node needs larger slots
+   n = # of doubles this proc needs in one comm slot
+   collective over nodecomm
+------------------------------------------------------------------------- */
+
+void CommBrick::grow_shm(int n)
+{
+  int nmax;
+  MPI_Allreduce(&n,&nmax,1,MPI_INT,MPI_MAX,nodecomm);
+  if (nmax <= maxshm) return;
+
+  if (shmwin != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(shmwin);
+    MPI_Win_free(&shmwin);
+  }
+
+  maxshm = static_cast<int> (BUFFACTOR * nmax);
+  double *base;
+  MPI_Win_allocate_shared((MPI_Aint) 2*maxshm*sizeof(double),sizeof(double),
+                          MPI_INFO_NULL,nodecomm,&base,&shmwin);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK,shmwin);
+
+  MPI_Aint size;
+  int dispunit;
+  for (int i = 0; i < nodeprocs; i++)
+    MPI_Win_shared_query(shmwin,i,&size,&dispunit,&shmpeer[i]);
+  shmslot = 0;
+}
+
+/* ----------------------------------------------------------------------
+   release shared-memory window and node communicator
+------------------------------------------------------------------------- */
+
+void CommBrick::free_shm()
+{
+  if (shmwin != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(shmwin);
+    MPI_Win_free(&shmwin);
+  }
+  if (nodecomm != MPI_COMM_NULL) MPI_Comm_free(&nodecomm);
+  delete[] shmpeer;
+  nodecomm = MPI_COMM_NULL;
+  shmwin = MPI_WIN_NULL;
+  shmpeer = nullptr;
+  menode = nodeprocs = maxshm = shmslot = 0;
+}
+
+/* ----------------------------------------------------------------------
+   make writes to my comm slot visible to all procs on my node
+------------------------------------------------------------------------- */
+
+void CommBrick::sync_shm()
+{
+  MPI_Win_sync(shmwin);
+  MPI_Barrier(nodecomm);
+  MPI_Win_sync(shmwin);
+}
+
 /* ----------------------------------------------------------------------
    exchange: move atoms to correct processors
    atoms exchanged with all 6 stencil neighbors
@@ -973,6 +1228,10 @@ void CommBrick::borders()
   max = MAX(maxforward*rmax,maxreverse*smax);
   if (max > maxrecv) grow_recv(max);
 
+  // ensure shared-memory comm slots are long enough for forward & reverse comm
+
+  if (shmwin != MPI_WIN_NULL) grow_shm(MAX(size_forward*smax,size_reverse*rmax));
+
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
@@ -1533,6 +1792,8 @@ void CommBrick::grow_swap(int n)
 
 void CommBrick::allocate_swap(int n)
 {
+  memory->create(shmsendrank,n,"comm:shmsendrank");
+  memory->create(shmrecvrank,n,"comm:shmrecvrank");
   memory->create(sendnum,n,"comm:sendnum");
   memory->create(recvnum,n,"comm:recvnum");
   memory->create(sendproc,n,"comm:sendproc");
@@ -1574,6 +1835,8 @@ void CommBrick::allocate_multiold(int n)
 
 void CommBrick::free_swap()
 {
+  memory->destroy(shmsendrank);
+  memory->destroy(shmrecvrank);
   memory->destroy(sendnum);
   memory->destroy(recvnum);
   memory->destroy(sendproc);
@@ -1651,5 +1914,6 @@ double CommBrick::memory_usage()
     bytes += memory->usage(sendlist[i],maxsendlist[i]);
   bytes += memory->usage(buf_send,maxsend+bufextra);
   bytes += memory->usage(buf_recv,maxrecv);
+  if (shmemflag) bytes += 2.0 * maxshm * sizeof(double);
   return bytes;
 }
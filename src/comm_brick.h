@@ -77,6 +77,27 @@ class CommBrick : public Comm {
   int maxsend, maxrecv;    // current size of send/recv buffer
   int smax, rmax;          // max size in atoms of single borders send/recv
 
+  // node-level shared memory for forward/reverse comm, used if shmemflag is set
+  // each proc owns 2 slots of maxshm doubles in shmwin and alternates between them,
+  //   so a single node barrier per swap is enough to avoid overwriting a slot
+  //   before the proc on the same node has read it
+
+  MPI_Comm nodecomm;        // communicator of procs on my shared-memory node
+  MPI_Win shmwin;           // shared-memory window with comm slots of all node procs
+  double **shmpeer;         // pointer to comm slots of each proc in nodecomm
+  int menode, nodeprocs;    // my rank and # of procs in nodecomm
+  int maxshm;               // size of one comm slot in doubles, same on all node procs
+  int shmslot;              // which of the 2 slots to use in next swap
+  int *shmsendrank;         // rank of sendproc in nodecomm for each swap, -1 if off-node
+  int *shmrecvrank;         // rank of recvproc in nodecomm for each swap, -1 if off-node
+
+  void forward_comm_shm();
+  void reverse_comm_shm();
+  void setup_shm();
+  void grow_shm(int);
+  void free_shm();
+  void sync_shm();
+
   // NOTE: init_buffers is called from a constructor and must not be made virtual
   void init_buffers();
 
@@ -117,6 +117,9 @@ void CommTiled::init()
 {
   Comm::init();
 
+  if (shmemflag)
+    error->all(FLERR,"Comm_modify shmem yes is only supported by comm_style brick");
+
   // cannot set nswap in init_buffers() b/c
   // dimension command can be after comm_style command
 
@@ -230,6 +230,10 @@ void Finish::end(int flag)
 
   if (force->pair) force->pair->finish();
 
+  // kspace_style stats if provided
+
+  if (force->kspace) force->kspace->finish();
+
   // PRD stats
 
   if (prdflag) {
@@ -529,6 +533,13 @@ void Finish::end(int flag)
       MPI_Allreduce(&tmp,&nspec_all,1,MPI_DOUBLE,MPI_SUM,world);
     }
 
+    // report if neighbor pages had to grow past the neigh_modify one setting
+
+    int pagemax, pagegrow, pagemax_all, pagegrow_all;
+    neighbor->page_stats(pagemax,pagegrow);
+    MPI_Allreduce(&pagemax,&pagemax_all,1,MPI_INT,MPI_MAX,world);
+    MPI_Allreduce(&pagegrow,&pagegrow_all,1,MPI_INT,MPI_SUM,world);
+
     if (me == 0) {
       std::string mesg;
 
@@ -541,6 +552,9 @@ void Finish::end(int flag)
       if (neighbor->dist_check)
         mesg += fmt::format("Dangerous builds = {}\n",neighbor->ndanger);
       else mesg += "Dangerous builds not checked\n";
+      if (pagegrow_all)
+        mesg += fmt::format("Neighbor pages grew to {} neighbors/atom, "
+                            "larger than neigh_modify one {}\n", pagemax_all, neighbor->oneatom);
       utils::logmesg(lmp,mesg);
     }
   }
@@ -43,6 +43,7 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   ewaldflag = pppmflag = msmflag = dispersionflag = tip4pflag =
     dipoleflag = spinflag = 0;
   compute_flag = 1;
+  prepare_flag = 0;
   group_group_enable = 0;
   stagger_flag = 0;
 
@@ -94,6 +94,7 @@ class KSpace : protected Pointers {
   int copymode;
 
   int compute_flag;       // 0 if skip compute()
+  int prepare_flag;       // 1 if compute_prepare() is called before pair
   int fftbench;           // 0 if skip FFT timing
   int collective_flag;    // 1 if use MPI collectives for FFT/remap
   int stagger_flag;       // 1 if using staggered PPPM grids
@@ -125,6 +126,7 @@ class KSpace : protected Pointers {
   virtual void setup() = 0;
   virtual void reset_grid(){};
   virtual void compute(int, int) = 0;
+  virtual void compute_prepare(int, int){};
   virtual void compute_group_group(int, int, int){};
 
   virtual void pack_forward_grid(int, void *, int, int *){};
@@ -138,6 +140,7 @@ class KSpace : protected Pointers {
 
   virtual int modify_param(int, char **) { return 0; }
   virtual double memory_usage() { return 0.0; }
+  virtual void finish() {}
 
   /* ----------------------------------------------------------------------
    compute gamma for MSM and pair styles
@@ -29,7 +29,8 @@ using namespace LAMMPS_NS;
  * The purpose of this class is to replace many small memory allocations
  * via malloc() with a few large ones.  Since the pages are never freed
  * until the class is re-initialized, they can be re-used without having
- * to re-allocate them by calling the reset() method.
+ * to re-allocate them by calling the reset() method.  Calling init()
+ * again with the same page size also keeps the existing pages.
  *
  * The settings *maxchunk*, *pagesize*, and *pagedelta* control
  * the memory allocation strategy.  The *maxchunk* value represents
@@ -40,8 +41,13 @@ using namespace LAMMPS_NS;
  * chunks of size *maxchunk*.  The combination of these two
  * parameters determines how much memory is wasted by either switching
  * to the next page too soon or allocating too large pages that never
- * get properly used.  It is an error, if a requested chunk is larger
- * than *maxchunk*.  The *pagedelta* parameter determines how many
+ * get properly used.  Each page is allocated with a reserve of the
+ * initial *maxchunk* items beyond *pagesize*, so that a chunk that turns
+ * out to be larger than *maxchunk* after it was filled (see vgot()) does
+ * not overflow the page.  In that case *maxchunk* is increased for all
+ * following chunks, up to *pagesize*.  It is only an error, if a chunk
+ * does not fit into the current page and its reserve or a requested
+ * chunk is larger than *pagesize*.  The *pagedelta* parameter determines how many
  * pages are allocated in one go.  In combination with the *pagesize*
  * setting, this determines how often blocks of memory get allocated
  * (fewer allocations will result in faster execution).
@@ -58,8 +64,8 @@ using namespace LAMMPS_NS;
 
 template <class T>
 MyPage<T>::MyPage() :
-    ndatum(0), nchunk(0), pages(nullptr), page(nullptr), npage(0), ipage(-1), index(-1),
-    maxchunk(-1), pagesize(-1), pagedelta(1), errorflag(0){};
+    ndatum(0), nchunk(0), chunkmax(0), ngrow(0), pages(nullptr), page(nullptr), npage(0),
+    ipage(-1), index(-1), maxchunk(-1), pagesize(-1), pagedelta(1), reserve(0), errorflag(0){};
 
 template <class T> MyPage<T>::~MyPage()
 {
@@ -68,8 +74,9 @@ template <class T> MyPage<T>::~MyPage()
 
 /** (Re-)initialize the set of pages and allocation parameters.
  *
- * This also frees all previously allocated storage and allocates
- * the first page(s).
+ * If the page layout changed, this also frees all previously allocated
+ * storage and allocates the first page(s), otherwise the existing pages
+ * are recycled.
  *
  * \param  user_maxchunk   Expected maximum number of items for one chunk
  * \param  user_pagesize   Number of items on a single memory page
@@ -78,16 +85,25 @@ template <class T> MyPage<T>::~MyPage()
 
 template <class T> int MyPage<T>::init(int user_maxchunk, int user_pagesize, int user_pagedelta)
 {
+  if (user_maxchunk <= 0 || user_pagesize <= 0 || user_pagedelta <= 0) return 1;
+  if (user_maxchunk > user_pagesize) return 1;
+
+  chunkmax = ngrow = 0;
   maxchunk = user_maxchunk;
-  pagesize = user_pagesize;
   pagedelta = user_pagedelta;
 
-  if (maxchunk <= 0 || pagesize <= 0 || pagedelta <= 0) return 1;
-  if (maxchunk > pagesize) return 1;
+  // recycle existing pages if their layout is unchanged
+
+  if (pages && (pagesize == user_pagesize) && (reserve == user_maxchunk)) {
+    reset();
+    return 0;
+  }
 
   // free storage if re-initialized
 
   deallocate();
+  pagesize = user_pagesize;
+  reserve = user_maxchunk;
 
   // initial page allocation
 
@@ -100,7 +116,8 @@ template <class T> int MyPage<T>::init(int user_maxchunk, int user_pagesize, int
 /** Pointer to location that can store N items.
  *
  * This will allocate more pages as needed.
- * If the parameter *N* is larger than the *maxchunk*
+ * If the parameter *N* is larger than the *maxchunk* setting,
+ * *maxchunk* is increased.  If it is larger than the *pagesize*
  * setting an error is flagged.
  *
  * \param  n  number of items for which storage is requested
@@ -109,9 +126,13 @@ template <class T> int MyPage<T>::init(int user_maxchunk, int user_pagesize, int
 template <class T> T *MyPage<T>::get(int n)
 {
   if (n > maxchunk) {
-    errorflag = 1;
-    return nullptr;
+    if (n > pagesize) {
+      errorflag = 1;
+      return nullptr;
+    }
+    grow(n);
   }
+  if (n > chunkmax) chunkmax = n;
   ndatum += n;
   nchunk++;
 
@@ -157,15 +178,29 @@ template <class T> void MyPage<T>::allocate()
   for (int i = npage - pagedelta; i < npage; i++) {
 #if defined(LAMMPS_MEMALIGN)
     void *ptr;
-    if (posix_memalign(&ptr, LAMMPS_MEMALIGN, pagesize * sizeof(T))) errorflag = 2;
+    if (posix_memalign(&ptr, LAMMPS_MEMALIGN, (pagesize + reserve) * sizeof(T))) errorflag = 2;
     pages[i] = (T *) ptr;
 #else
-    pages[i] = (T *) malloc(pagesize * sizeof(T));
+    pages[i] = (T *) malloc((pagesize + reserve) * sizeof(T));
     if (!pages[i]) errorflag = 2;
 #endif
   }
 }
 
+/** Increase *maxchunk* after a chunk of *N* items was requested or stored
+ *
+ * The pages are not touched here, so that with OpenMP threading each
+ * page is first written to, and thus placed in memory, by the thread
+ * that owns this instance.
+ *
+ * \param  n  size of the chunk that was larger than *maxchunk* */
+
+template <class T> void MyPage<T>::grow(int n)
+{
+  maxchunk = (n < pagesize) ? n : pagesize;
+  ngrow++;
+}
+
 /** Free all allocated pages of this class instance */
 
 template <class T> void MyPage<T>::deallocate()
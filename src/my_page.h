@@ -29,8 +29,10 @@ struct HyperOneCoeff {
 
 template <class T> class MyPage {
  public:
-  int ndatum;    // total # of stored datums
-  int nchunk;    // total # of stored chunks
+  int ndatum;      // total # of stored datums
+  int nchunk;      // total # of stored chunks
+  int chunkmax;    // largest stored chunk since init()
+  int ngrow;       // # of times maxchunk was increased since init()
   MyPage();
   virtual ~MyPage();
 
@@ -64,13 +66,19 @@ template <class T> class MyPage {
    * This will advance the internal pointer inside the current memory page.
    * It is not necessary to call this function for *N* = 0, that is the reserved
    * storage was not used.  A following call to vget() will then reserve the
-   * same location again.  It is an error if *N* > *maxchunk*.
+   * same location again.  If *N* > *maxchunk* but the chunk still fits into
+   * the current page including its reserve, *maxchunk* is increased so that
+   * following calls to vget() reserve more storage.  Otherwise it is an error.
    *
    * \param  n  Number of items used in previously reserved chunk */
 
   void vgot(int n)
   {
-    if (n > maxchunk) errorflag = 1;
+    if (n > maxchunk) {
+      if (index + n > pagesize + reserve) errorflag = 1;
+      else grow(n);
+    }
+    if (n > chunkmax) chunkmax = n;
     ndatum += n;
     nchunk++;
     index += n;
@@ -82,7 +90,7 @@ template <class T> class MyPage {
    *
    * \return total storage used in bytes */
 
-  double size() const { return (double) npage * pagesize * sizeof(T); }
+  double size() const { return (double) npage * (pagesize + reserve) * sizeof(T); }
 
   /** Return error status
    *
@@ -100,12 +108,14 @@ template <class T> class MyPage {
   int maxchunk;     // max # of datums in one requested chunk
   int pagesize;     // # of datums in one page, default = 1024
   int pagedelta;    // # of pages to allocate at once, default = 1
+  int reserve;      // # of extra datums at end of each page, = initial maxchunk
 
   int errorflag;    // flag > 0 if error has occurred
                     // 1 = chunk size exceeded maxchunk
                     // 2 = memory allocation error
   void allocate();
   void deallocate();
+  void grow(int);
 };
 
 }    // namespace LAMMPS_NS
@@ -198,6 +198,25 @@ void NeighList::setup_pages(int pgsize_caller, int oneatom_caller)
   }
 }
 
+/* ----------------------------------------------------------------------
+   accumulate largest chunk and # of growths of maxchunk beyond
+   oneatom for all pages of this list
+------------------------------------------------------------------------- */
+
+void NeighList::page_stats(int &chunkmax, int &ngrow)
+{
+  int nmypage = comm->nthreads;
+  MyPage<int> *mypages[3] = {ipage, ipage_inner, ipage_middle};
+
+  for (auto &mypage : mypages) {
+    if (!mypage) continue;
+    for (int i = 0; i < nmypage; i++) {
+      chunkmax = MAX(chunkmax, mypage[i].chunkmax);
+      ngrow += mypage[i].ngrow;
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    grow per-atom data to allow for nlocal/nall atoms
    triggered by neighbor list build
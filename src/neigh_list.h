@@ -110,6 +110,7 @@ class NeighList : protected Pointers {
   void print_attributes();       // debug routine
   int get_maxlocal() { return maxatom; }
   double memory_usage();
+  void page_stats(int &, int &);    // largest chunk and growth of pages
 };
 
 }    // namespace LAMMPS_NS
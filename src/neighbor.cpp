@@ -2957,6 +2957,18 @@ void Neighbor::add_temporary_bond(int i1, int i2, int btype)
   neigh_bond->add_temporary_bond(i1, i2, btype);
 }
 
+/* ----------------------------------------------------------------------
+   largest # of neighbors of one atom and # of times pages grew past
+   oneatom, accumulated over all perpetual and occasional lists
+------------------------------------------------------------------------- */
+
+void Neighbor::page_stats(int &chunkmax, int &ngrow)
+{
+  chunkmax = ngrow = 0;
+  for (int i = 0; i < nlist; i++)
+    if (lists[i] && !lists[i]->copy) lists[i]->page_stats(chunkmax,ngrow);
+}
+
 /* ----------------------------------------------------------------------
    return # of bytes of allocated memory
 ------------------------------------------------------------------------- */
@@ -111,7 +111,8 @@ void NPairSkipSizeOff2onOneside::build(NeighList *list)
     n = numneigh[i];
     firstneigh[i] = ipage->get(n);
     if (ipage->status())
-      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+      error->one(FLERR, "Neighbor list overflow for {} neighbors of one atom, "
+                        "boost neigh_modify one", ipage->chunkmax);
   }
 
   // second loop over atoms in other list to store neighbors
@@ -28,6 +28,7 @@
 #include "math_const.h"
 #include "math_special.h"
 #include "memory.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "suffix.h"
 #include "update.h"
@@ -60,7 +61,8 @@ Pair::Pair(LAMMPS *lmp) :
     drdisptable(nullptr), fdisptable(nullptr), dfdisptable(nullptr), edisptable(nullptr),
     dedisptable(nullptr), pvector(nullptr), svector(nullptr), list(nullptr), listhalf(nullptr),
     listfull(nullptr), list_tally_compute(nullptr), elements(nullptr), elem1param(nullptr),
-    elem2param(nullptr), elem3param(nullptr), map(nullptr)
+    elem2param(nullptr), elem3param(nullptr), map(nullptr), list_local(nullptr),
+    ilist_local(nullptr)
 {
   instance_me = instance_total++;
 
@@ -70,6 +72,8 @@ Pair::Pair(LAMMPS *lmp) :
 
   single_enable = 1;
   born_matrix_enable = 0;
+  local_energy_enable = 0;
+  maxlocal = 0;
   single_hessian_enable = 0;
   restartinfo = 1;
   respa_enable = 0;
@@ -144,6 +148,9 @@ Pair::~Pair()
   memory->destroy(eatom);
   memory->destroy(vatom);
   memory->destroy(cvatom);
+
+  delete list_local;
+  memory->destroy(ilist_local);
 }
 
 // clang-format off
@@ -2000,6 +2007,84 @@ void Pair::hessian_twobody(double fforce, double dfac, double delr[3], double ph
     }
   }
 }
+
+/* ----------------------------------------------------------------------
+   list of atoms in full neighbor list whose energy may change
+     when atoms at nsite positions xsite are changed, inserted or removed
+   these are all atoms within cutforce of a site, so that
+     sum of their energies before and after the change is the energy change
+   owned atoms only, with minimum image distances to the sites,
+     unless the full list also stores neighbors of ghost atoms,
+     then owned and ghost atoms, with direct distances
+   returned list shares the neighbors of the full list
+   used by energy_local() of manybody styles for Monte Carlo moves
+------------------------------------------------------------------------- */
+
+NeighList *Pair::local_energy_list(NeighList *full, int nsite, double *xsite)
+{
+  const int ghostflag = full->ghost;
+  const int nlist = ghostflag ? full->inum + full->gnum : full->inum;
+  grow_local_list(full, nlist);
+
+  double **x = atom->x;
+  const double cutforcesq = cutforce * cutforce;
+  double delx, dely, delz;
+  int n = 0;
+
+  for (int ii = 0; ii < nlist; ii++) {
+    const int i = full->ilist[ii];
+    for (int m = 0; m < nsite; m++) {
+      delx = x[i][0] - xsite[3 * m];
+      dely = x[i][1] - xsite[3 * m + 1];
+      delz = x[i][2] - xsite[3 * m + 2];
+      if (!ghostflag) domain->minimum_image(delx, dely, delz);
+      if (delx * delx + dely * dely + delz * delz < cutforcesq) {
+        ilist_local[n++] = i;
+        break;
+      }
+    }
+  }
+
+  list_local->inum = n;
+  return list_local;
+}
+
+/* ----------------------------------------------------------------------
+   list of n given atoms in full neighbor list, e.g. a changed atom and
+     its neighbors within cutforce, when the caller already knows them
+   returned list shares the neighbors of the full list
+------------------------------------------------------------------------- */
+
+NeighList *Pair::local_energy_list(NeighList *full, int n, int *atoms)
+{
+  grow_local_list(full, n);
+  for (int ii = 0; ii < n; ii++) ilist_local[ii] = atoms[ii];
+  list_local->inum = n;
+  return list_local;
+}
+
+/* ----------------------------------------------------------------------
+   allocate list for local_energy_list() with room for n atoms
+------------------------------------------------------------------------- */
+
+void Pair::grow_local_list(NeighList *full, int n)
+{
+  if (list_local == nullptr) {
+    list_local = new NeighList(lmp);
+    list_local->copymode = 1;
+  }
+  if (n > maxlocal) {
+    maxlocal = n;
+    memory->destroy(ilist_local);
+    memory->create(ilist_local, maxlocal, "pair:ilist_local");
+  }
+
+  list_local->gnum = 0;
+  list_local->ilist = ilist_local;
+  list_local->numneigh = full->numneigh;
+  list_local->firstneigh = full->firstneigh;
+}
+
 /* ---------------------------------------------------------------------- */
 
 double Pair::memory_usage()
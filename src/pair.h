@@ -53,6 +53,7 @@ class Pair : protected Pointers {
 
   int single_enable;              // 1 if single() routine exists
   int born_matrix_enable;         // 1 if born_matrix() routine exists
+  int local_energy_enable;        // 1 if energy_local() routine exists
   int single_hessian_enable;      // 1 if single_hessian() routine exists
   int restartinfo;                // 1 if pair style writes restart info
   int respa_enable;               // 1 if inner/middle/outer rRESPA routines
@@ -179,6 +180,13 @@ class Pair : protected Pointers {
     du = du2 = 0.0;
   }
 
+  // energy of the atoms in a list from local_energy_list()
+  // optionally also stored per atom in last argument
+
+  virtual double energy_local(class NeighList *, double *) { return 0.0; }
+  class NeighList *local_energy_list(class NeighList *, int, double *);
+  class NeighList *local_energy_list(class NeighList *, int, int *);
+
   virtual void finish() {}
   virtual void settings(int, char **) = 0;
   virtual void coeff(int, char **) = 0;
@@ -262,6 +270,13 @@ class Pair : protected Pointers {
   int maxparam;         // max # of parameter sets
   void map_element2type(int, char **, bool update_setflag = true);
 
+  // atoms near the sites of a local change, for energy_local()
+
+  class NeighList *list_local;
+  int *ilist_local;
+  int maxlocal;
+  void grow_local_list(class NeighList *, int);
+
  public:
   // custom data type for accessing Coulomb tables
 
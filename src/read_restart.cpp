@@ -43,7 +43,8 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-ReadRestart::ReadRestart(LAMMPS *lmp) : Command(lmp), mpiio(nullptr) {}
+ReadRestart::ReadRestart(LAMMPS *lmp) :
+  Command(lmp), mpiio(nullptr), chunk_size(nullptr), chunk_box(nullptr) {}
 
 /* ---------------------------------------------------------------------- */
 
@@ -206,7 +207,10 @@ void ReadRestart::command(int narg, char **arg)
 
   // input of single native file
   // nprocs_file = # of chunks in file
-  // proc 0 reads a chunk and bcasts it to other procs
+  // if file has a chunk index:
+  //   each proc opens the file and reads only the chunks
+  //   whose atom bounding box overlaps its sub-domain
+  // else proc 0 reads a chunk and bcasts it to other procs
   // each proc unpacks the atoms, saving ones in it's sub-domain
   // if remapflag set, remap the atom to box before checking sub-domain
   // check for atom in sub-domain differs for orthogonal vs triclinic box
@@ -225,17 +229,50 @@ void ReadRestart::command(int narg, char **arg)
       subhi = domain->subhi_lamda;
     }
 
+    if (chunk_size) {
+      if (me == 0) fclose(fp);
+      fp = fopen(file,"rb");
+      if (fp == nullptr)
+        error->one(FLERR,"Cannot open restart file {}: {}", file, utils::getsyserror());
+    }
+
+    bigint offset = chunk_offset;
     for (int iproc = 0; iproc < nprocs_file; iproc++) {
-      if (read_int() != PERPROC)
-        error->all(FLERR,"Invalid flag in peratom section of restart file");
-
-      n = read_int();
-      if (n > maxbuf) {
-        maxbuf = n;
-        memory->destroy(buf);
-        memory->create(buf,maxbuf,"read_restart:buf");
+      if (chunk_size) {
+        n = chunk_size[iproc];
+        bigint next = offset + 2*sizeof(int) + (bigint) n*sizeof(double);
+        if (!chunk_overlap(&chunk_box[6*iproc],remapflag)) {
+          offset = next;
+          continue;
+        }
+
+        platform::fseek(fp,offset);
+        offset = next;
+        utils::sfread(FLERR,&flag,sizeof(int),1,fp,nullptr,error);
+        if (flag != PERPROC)
+          error->one(FLERR,"Invalid flag in peratom section of restart file");
+        utils::sfread(FLERR,&n,sizeof(int),1,fp,nullptr,error);
+        if (n != chunk_size[iproc])
+          error->one(FLERR,"Inconsistent chunk size in peratom section of restart file");
+        if (n > maxbuf) {
+          maxbuf = n;
+          memory->destroy(buf);
+          memory->create(buf,maxbuf,"read_restart:buf");
+        }
+        utils::sfread(FLERR,buf,sizeof(double),n,fp,nullptr,error);
+
+      } else {
+        if (read_int() != PERPROC)
+          error->all(FLERR,"Invalid flag in peratom section of restart file");
+
+        n = read_int();
+        if (n > maxbuf) {
+          maxbuf = n;
+          memory->destroy(buf);
+          memory->create(buf,maxbuf,"read_restart:buf");
+        }
+        read_double_vec(n,buf);
       }
-      read_double_vec(n,buf);
 
       m = 0;
       while (m < n) {
@@ -258,10 +295,12 @@ void ReadRestart::command(int narg, char **arg)
       }
     }
 
-    if (me == 0) {
+    if (fp) {
       fclose(fp);
       fp = nullptr;
     }
+    memory->destroy(chunk_size);
+    memory->destroy(chunk_box);
   }
 
   // input of multiple native files with procs <= files
@@ -1091,6 +1130,15 @@ void ReadRestart::file_layout()
         memory->destroy(nproc_chunk_sizes);
         memory->destroy(nproc_chunk_offsets);
       }
+
+    } else if (flag == CHUNKINDEX) {
+      int nchunk = read_int();
+      if (nchunk != nprocs_file)
+        error->all(FLERR,"Invalid chunk index in restart file");
+      memory->create(chunk_size,nchunk,"read_restart:chunk_size");
+      memory->create(chunk_box,6*nchunk,"read_restart:chunk_box");
+      read_int_vec(nchunk,chunk_size);
+      read_double_vec(6*nchunk,chunk_box);
     }
 
     flag = read_int();
@@ -1103,6 +1151,48 @@ void ReadRestart::file_layout()
     if (me == 0) headerOffset = platform::ftell(fp);
     MPI_Bcast(&headerOffset,1,MPI_LMP_BIGINT,0,world);
   }
+
+  // same for a single native file with a chunk index
+
+  if (chunk_size) {
+    if (me == 0) chunk_offset = platform::ftell(fp);
+    MPI_Bcast(&chunk_offset,1,MPI_LMP_BIGINT,0,world);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   check if bounding box of a per-proc chunk of atoms overlaps my sub-domain
+   box = xlo,xhi,ylo,yhi,zlo,zhi of atom coords, lamda coords if triclinic
+   if remapflag set, atoms outside a periodic box dim may be remapped
+     into any sub-domain, so box must be treated as unbounded in that dim
+   return 1 if chunk must be read, 0 if it can be skipped
+------------------------------------------------------------------------- */
+
+int ReadRestart::chunk_overlap(double *box, int remapflag)
+{
+  double *lo,*hi,*sublo,*subhi;
+  if (domain->triclinic == 0) {
+    lo = domain->boxlo;
+    hi = domain->boxhi;
+    sublo = domain->sublo;
+    subhi = domain->subhi;
+  } else {
+    lo = domain->boxlo_lamda;
+    hi = domain->boxhi_lamda;
+    sublo = domain->sublo_lamda;
+    subhi = domain->subhi_lamda;
+  }
+
+  int periodic[3] = {domain->xperiodic, domain->yperiodic, domain->zperiodic};
+
+  for (int idim = 0; idim < 3; idim++) {
+    double bmin = box[2*idim];
+    double bmax = box[2*idim+1];
+    if (bmin > bmax) return 0;
+    if (remapflag && periodic[idim] && (bmin < lo[idim] || bmax >= hi[idim])) continue;
+    if (bmin >= subhi[idim] || bmax < sublo[idim]) return 0;
+  }
+  return 1;
 }
 
 // ----------------------------------------------------------------------
@@ -46,6 +46,12 @@ class ReadRestart : public Command {
   bigint assignedChunkSize;
   MPI_Offset assignedChunkOffset, headerOffset;
 
+  // chunk index of single native files
+
+  int *chunk_size;        // # of doubles in each per-proc chunk
+  double *chunk_box;      // bounding box of atoms in each chunk, 6 values per chunk
+  bigint chunk_offset;    // file offset of first per-proc chunk
+
   std::string file_search(const std::string &);
   void header();
   void type_arrays();
@@ -56,6 +62,7 @@ class ReadRestart : public Command {
   void format_revision();
   void check_eof_magic();
   void file_layout();
+  int chunk_overlap(double *, int);
 
   int read_int();
   bigint read_bigint();
@@ -24,6 +24,7 @@ class Thermo : protected Pointers {
   friend class DumpNetCDF;         // accesses thermo properties
   friend class DumpNetCDFMPIIO;    // accesses thermo properties
   friend class DumpYAML;           // accesses thermo properties
+  friend class DumpColumnar;       // accesses thermo properties
 
  public:
   char *style;
@@ -312,6 +312,13 @@ void Verlet::run(int n)
       timer->stamp(Timer::MODIFY);
     }
 
+    // let KSpace start work that can overlap with the pair computation
+
+    if (kspace_compute_flag && force->kspace->prepare_flag) {
+      force->kspace->compute_prepare(eflag,vflag);
+      timer->stamp(Timer::KSPACE);
+    }
+
     if (pair_compute_flag) {
       force->pair->compute(eflag,vflag);
       timer->stamp(Timer::PAIR);
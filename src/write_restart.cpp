@@ -42,6 +42,8 @@
 
 using namespace LAMMPS_NS;
 
+static constexpr double BIG = 1.0e20;
+
 /* ---------------------------------------------------------------------- */
 
 WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
@@ -270,35 +272,6 @@ void WriteRestart::write(const std::string &file)
   memory->create(buf,max_size,"write_restart:buf");
   memset(buf,0,max_size*sizeof(double));
 
-  // all procs write file layout info which may include per-proc sizes
-
-  file_layout(send_size);
-
-  // header info is complete
-  // if multiproc output:
-  //   close header file, open multiname file on each writing proc,
-  //   write PROCSPERFILE into new file
-
-  int io_error = 0;
-  if (multiproc) {
-    if (me == 0 && fp) {
-      magic_string();
-      if (ferror(fp)) io_error = 1;
-      fclose(fp);
-      fp = nullptr;
-    }
-
-    std::string multiname = file;
-    multiname.replace(multiname.find('%'),1,fmt::format("{}",icluster));
-
-    if (filewriter) {
-      fp = fopen(multiname.c_str(),"wb");
-      if (fp == nullptr)
-        error->one(FLERR, "Cannot open restart file {}: {}", multiname, utils::getsyserror());
-      write_int(PROCSPERFILE,nclusterprocs);
-    }
-  }
-
   // pack my atom data into buf
 
   AtomVec *avec = atom->avec;
@@ -354,6 +327,35 @@ void WriteRestart::write(const std::string &file)
     }
   }
 
+  // all procs write file layout info which may include per-proc sizes
+
+  file_layout(send_size,buf);
+
+  // header info is complete
+  // if multiproc output:
+  //   close header file, open multiname file on each writing proc,
+  //   write PROCSPERFILE into new file
+
+  int io_error = 0;
+  if (multiproc) {
+    if (me == 0 && fp) {
+      magic_string();
+      if (ferror(fp)) io_error = 1;
+      fclose(fp);
+      fp = nullptr;
+    }
+
+    std::string multiname = file;
+    multiname.replace(multiname.find('%'),1,fmt::format("{}",icluster));
+
+    if (filewriter) {
+      fp = fopen(multiname.c_str(),"wb");
+      if (fp == nullptr)
+        error->one(FLERR, "Cannot open restart file {}: {}", multiname, utils::getsyserror());
+      write_int(PROCSPERFILE,nclusterprocs);
+    }
+  }
+
   // MPI-IO output to single file
 
   if (mpiioflag) {
@@ -574,9 +576,10 @@ void WriteRestart::force_fields()
 /* ----------------------------------------------------------------------
    proc 0 writes out file layout info
    all procs call this method, only proc 0 writes to file
+   buf = packed per-atom data of this proc, send_size = its length
 ------------------------------------------------------------------------- */
 
-void WriteRestart::file_layout(int send_size)
+void WriteRestart::file_layout(int send_size, double *buf)
 {
   if (me == 0) {
     write_int(MULTIPROC,multiproc);
@@ -591,6 +594,50 @@ void WriteRestart::file_layout(int send_size)
     memory->destroy(all_send_sizes);
   }
 
+  // single native file: write an index with the size of each per-proc chunk
+  //   and the bounding box of the atoms it contains (in lamda coords if triclinic)
+  // allows each reading proc to seek to and read only the chunks
+  //   which overlap its sub-domain, instead of proc 0 broadcasting all chunks
+
+  if (!multiproc && !mpiioflag) {
+    double bbox[6];
+    bbox[0] = bbox[2] = bbox[4] = BIG;
+    bbox[1] = bbox[3] = bbox[5] = -BIG;
+
+    int triclinic = domain->triclinic;
+    double *x,lamda[3];
+    int m = 0;
+    while (m < send_size) {
+      x = &buf[m+1];
+      if (triclinic) {
+        domain->x2lamda(x,lamda);
+        x = lamda;
+      }
+      bbox[0] = MIN(bbox[0],x[0]);
+      bbox[1] = MAX(bbox[1],x[0]);
+      bbox[2] = MIN(bbox[2],x[1]);
+      bbox[3] = MAX(bbox[3],x[1]);
+      bbox[4] = MIN(bbox[4],x[2]);
+      bbox[5] = MAX(bbox[5],x[2]);
+      m += static_cast<int> (buf[m]);
+    }
+
+    int *all_send_sizes = nullptr;
+    double *all_bbox = nullptr;
+    if (me == 0) {
+      memory->create(all_send_sizes,nprocs,"write_restart:all_send_sizes");
+      memory->create(all_bbox,6*nprocs,"write_restart:all_bbox");
+    }
+    MPI_Gather(&send_size,1,MPI_INT,all_send_sizes,1,MPI_INT,0,world);
+    MPI_Gather(bbox,6,MPI_DOUBLE,all_bbox,6,MPI_DOUBLE,0,world);
+    if (me == 0) {
+      write_int_vec(CHUNKINDEX,nprocs,all_send_sizes);
+      fwrite(all_bbox,sizeof(double),6*nprocs,fp);
+    }
+    memory->destroy(all_send_sizes);
+    memory->destroy(all_bbox);
+  }
+
   // -1 flag signals end of file layout info
 
   if (me == 0) {
@@ -211,6 +211,34 @@ TEST_F(KimCommandsTest, kim_interactions)
     END_HIDE_OUTPUT();
 }
 
+TEST_F(KimCommandsTest, kim_interactions_molecular)
+{
+    if (!LAMMPS::is_installed_pkg("KIM")) GTEST_SKIP();
+    if (!LAMMPS::is_installed_pkg("MOLECULE")) GTEST_SKIP();
+
+    // with a molecular atom style, neighbor lists are copied without special bits
+    // per-atom neighbor lists may be longer than neigh_modify one
+
+    BEGIN_HIDE_OUTPUT();
+    command("kim init LennardJones_Ar real");
+    command("atom_style bond");
+    command("lattice fcc 4.4300");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box bond/types 1");
+    command("create_atoms 1 box");
+    command("kim interactions Ar");
+    command("mass 1 39.95");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    double pe = variable->compute_equal("pe");
+
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify one 50");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_DOUBLE_EQ(variable->compute_equal("pe"), pe);
+}
+
 TEST_F(KimCommandsTest, kim_param)
 {
     if (!LAMMPS::is_installed_pkg("KIM")) GTEST_SKIP();
@@ -0,0 +1,125 @@
+// unit tests for forward and reverse ghost atom comm through shared memory
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "input.h"
+#include "lammps.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPICommShmemTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // run a short LJ trajectory with the given processor grid and comm settings
+    // return final positions and velocities ordered by atom ID on all procs
+
+    std::vector<double> run(const std::string &grid, const std::string &comm, bool triclinic)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        command("processors " + grid);
+        command("units lj");
+        command("atom_style atomic");
+        command("lattice fcc 0.8442");
+        command("region box block 0 5 0 5 0 5");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 3.0 87287 loop geom");
+        if (triclinic) command("change_box all triclinic xy final 0.8 yz final -0.5");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff 1 1 1.0 1.0");
+        command("neighbor 0.3 bin");
+        command("neigh_modify every 5 delay 0 check no");
+        command("comm_modify " + comm);
+        command("fix 1 all nve");
+        command("run 40 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        auto atom        = lmp->atom;
+        const int natoms = atom->natoms;
+        std::vector<double> mine(6 * natoms, 0.0), all(6 * natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i) {
+            double *row = &mine[6 * (atom->tag[i] - 1)];
+            for (int k = 0; k < 3; ++k) {
+                row[k]     = atom->x[i][k];
+                row[3 + k] = atom->v[i][k];
+            }
+        }
+        MPI_Allreduce(mine.data(), all.data(), 6 * natoms, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        return all;
+    }
+
+    // shared-memory comm must reproduce message passing comm exactly
+
+    void compare(const std::string &grid, const std::string &comm, bool triclinic)
+    {
+        auto ref  = run(grid, comm + " shmem no", triclinic);
+        auto data = run(grid, comm + " shmem yes", triclinic);
+        ASSERT_EQ(lmp->comm->shmemflag, 1);
+        ASSERT_EQ(data.size(), ref.size());
+        for (std::size_t i = 0; i < data.size(); ++i)
+            ASSERT_DOUBLE_EQ(data[i], ref[i]);
+    }
+};
+
+TEST_F(MPICommShmemTest, orthogonal)
+{
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("2 2 1", "mode single", false);
+    compare("1 1 4", "mode single", false);
+}
+
+TEST_F(MPICommShmemTest, triclinic)
+{
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("2 1 2", "mode single", true);
+}
+
+TEST_F(MPICommShmemTest, ghost_velocity)
+{
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("2 2 1", "vel yes", false);
+}
+
+TEST_F(MPICommShmemTest, multiple_swaps)
+{
+    // ghost cutoff larger than a sub-domain requires multiple swaps per direction
+
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("4 1 1", "cutoff 4.0", false);
+    compare("4 1 1", "cutoff 4.0 vel yes", true);
+}
+} // namespace LAMMPS_NS
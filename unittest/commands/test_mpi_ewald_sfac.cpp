@@ -0,0 +1,168 @@
+// unit tests for overlapping the Ewald structure factor sum with the pair forces
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "exceptions.h"
+#include "input.h"
+#include "lammps.h"
+#include "output.h"
+#include "thermo.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+using ::testing::HasSubstr;
+
+namespace LAMMPS_NS {
+
+class MPIEwaldSfacTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // run a short trajectory of a charged LJ system with Ewald
+    // return the final forces and energy ordered by atom ID on all procs
+
+    std::vector<double> run(const std::string &package, const std::string &kspace,
+                            const std::string &settings)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        if (!package.empty()) command("package " + package);
+        command("units lj");
+        command("atom_style charge");
+        command("lattice fcc 0.8442");
+        command("region box block 0 4 0 4 0 4");
+        command("create_box 2 box");
+        command("create_atoms 1 box");
+        command("set type 1 type/fraction 2 0.5 6743");
+        command("set type 1 charge 0.5");
+        command("set type 2 charge -0.5");
+        command("mass * 1.0");
+        command("velocity all create 1.5 4928459 loop geom");
+        command("pair_style lj/cut/coul/long 2.5");
+        command("pair_coeff * * 1.0 1.0");
+        command("kspace_style " + kspace + " 1.0e-5");
+        command("kspace_modify " + settings);
+        command("fix 1 all nve");
+        command("thermo_style custom step pe press");
+        command("run 10 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        auto atom        = lmp->atom;
+        const int natoms = atom->natoms;
+        std::vector<double> mine(3 * natoms + 2, 0.0), all(3 * natoms + 2, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                mine[3 * (atom->tag[i] - 1) + k] = atom->f[i][k];
+        MPI_Allreduce(mine.data(), all.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        lmp->output->thermo->evaluate_keyword("pe", &all[3 * natoms]);
+        lmp->output->thermo->evaluate_keyword("press", &all[3 * natoms + 1]);
+        return all;
+    }
+
+    // the overlapped sum must give the same result as the blocking sum
+
+    void compare(const std::string &kspace, const std::string &package = "")
+    {
+        auto ref  = run(package, kspace, "sfac/overlap no");
+        auto data = run(package, kspace, "sfac/overlap yes");
+        ASSERT_EQ(data.size(), ref.size());
+        for (std::size_t i = 0; i < data.size(); ++i)
+            EXPECT_DOUBLE_EQ(data[i], ref[i]);
+    }
+
+    // return the error message of a command or an empty string
+
+    std::string error_message(const std::string &line)
+    {
+        std::string mesg;
+        if (!verbose) ::testing::internal::CaptureStdout();
+        try {
+            command(line);
+        } catch (LAMMPSException &e) {
+            mesg = e.what();
+        }
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        return mesg;
+    }
+};
+
+TEST_F(MPIEwaldSfacTest, ewald)
+{
+    if (!LAMMPS::is_installed_pkg("KSPACE")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("ewald");
+}
+
+TEST_F(MPIEwaldSfacTest, ewald_omp)
+{
+    if (!LAMMPS::is_installed_pkg("KSPACE")) GTEST_SKIP();
+    if (!LAMMPS::is_installed_pkg("OPENMP")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("ewald/omp", "omp 2");
+}
+
+TEST_F(MPIEwaldSfacTest, ewald_dipole)
+{
+    if (!LAMMPS::is_installed_pkg("KSPACE")) GTEST_SKIP();
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("atom_style charge");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box");
+    command("create_atoms 1 random 20 87287 NULL overlap 0.8");
+    command("mass 1 1.0");
+    command("pair_style coul/long 1.5");
+    command("pair_coeff * *");
+    command("kspace_style ewald/dipole 1.0e-4");
+    command("kspace_modify sfac/overlap yes");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    EXPECT_THAT(error_message("run 0 post no"),
+                HasSubstr("Cannot use kspace_modify sfac/overlap with EwaldDipole"));
+}
+
+TEST_F(MPIEwaldSfacTest, ewald_electrode)
+{
+    if (!LAMMPS::is_installed_pkg("ELECTRODE")) GTEST_SKIP();
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("atom_style charge");
+    command("region box block 0 4 0 4 0 4");
+    command("create_box 1 box");
+    command("create_atoms 1 random 20 87287 NULL overlap 0.8");
+    command("mass 1 1.0");
+    command("pair_style coul/long 1.5");
+    command("pair_coeff * *");
+    command("kspace_style ewald/electrode 1.0e-4");
+    command("kspace_modify sfac/overlap yes");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    EXPECT_THAT(error_message("run 0 post no"),
+                HasSubstr("Cannot use kspace_modify sfac/overlap with ewald/electrode"));
+}
+} // namespace LAMMPS_NS
@@ -0,0 +1,157 @@
+// unit tests for 3d FFTs with batched remaps in parallel
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "input.h"
+#include "lammps.h"
+#include "output.h"
+#include "thermo.h"
+#include "utils.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+using ::testing::ContainsRegex;
+using ::testing::HasSubstr;
+
+namespace LAMMPS_NS {
+
+class MPIFFTBatchTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // run a short trajectory of a charged LJ system with PPPM
+    // return the PPPM settings output on proc 0 and the final forces
+    // and energy ordered by atom ID on all procs
+
+    std::string run(const std::string &settings, std::vector<double> &data)
+    {
+        ::testing::internal::CaptureStdout();
+        command("clear");
+        command("processors 2 2 1");
+        command("units lj");
+        command("atom_style charge");
+        command("lattice fcc 0.8442");
+        command("region box block 0 6 0 5 0 4");
+        command("create_box 2 box");
+        command("create_atoms 1 box");
+        command("set type 1 type/fraction 2 0.5 6743");
+        command("set type 1 charge 0.5");
+        command("set type 2 charge -0.5");
+        command("mass * 1.0");
+        command("velocity all create 1.5 4928459 loop geom");
+        command("pair_style lj/cut/coul/long 2.5");
+        command("pair_coeff * * 1.0 1.0");
+        command("kspace_style pppm 1.0e-5");
+        command("kspace_modify " + settings);
+        command("fix 1 all nve");
+        command("thermo_style custom step pe");
+        command("run 10 post no");
+        auto output = ::testing::internal::GetCapturedStdout();
+        if (verbose) std::cout << output;
+
+        auto atom        = lmp->atom;
+        const int natoms = atom->natoms;
+        std::vector<double> mine(3 * natoms + 1, 0.0);
+        data.assign(3 * natoms + 1, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                mine[3 * (atom->tag[i] - 1) + k] = atom->f[i][k];
+        MPI_Allreduce(mine.data(), data.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        lmp->output->thermo->evaluate_keyword("pe", &data[3 * natoms]);
+        return output;
+    }
+
+    // batched FFTs must reproduce the unbatched FFTs up to round-off
+    // of the differently sized 1d FFT plans
+
+    void compare(const std::string &collective, int nbatch)
+    {
+        std::vector<double> ref, data;
+        run("collective " + collective + " fft/batch 1", ref);
+        auto output = run("collective " + collective + " fft/batch " + std::to_string(nbatch), data);
+        if (lmp->comm->me == 0)
+            ASSERT_THAT(output, HasSubstr("FFT remap batches = " + std::to_string(nbatch)));
+        ASSERT_EQ(data.size(), ref.size());
+        for (std::size_t i = 0; i < data.size(); ++i)
+            EXPECT_NEAR(data[i], ref[i], 1.0e-12);
+    }
+};
+
+TEST_F(MPIFFTBatchTest, pppm_point_to_point)
+{
+    if (!LAMMPS::is_installed_pkg("KSPACE")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("no", 2);
+    compare("no", 4);
+}
+
+TEST_F(MPIFFTBatchTest, pppm_collective)
+{
+    if (!LAMMPS::is_installed_pkg("KSPACE")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("yes", 3);
+}
+
+TEST_F(MPIFFTBatchTest, pppm_auto)
+{
+    if (!LAMMPS::is_installed_pkg("KSPACE")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    std::vector<double> ref, data;
+    run("fft/batch 1", ref);
+    auto output = run("fft/batch auto", data);
+    if (lmp->comm->me == 0) ASSERT_THAT(output, ContainsRegex("FFT remap batches = [1248]\n"));
+    for (std::size_t i = 0; i < data.size(); ++i)
+        EXPECT_NEAR(data[i], ref[i], 1.0e-12);
+}
+
+TEST_F(MPIFFTBatchTest, fft_benchmark)
+{
+    if (!LAMMPS::is_installed_pkg("KSPACE")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+
+    for (const auto &args : {"batch 1", "batch 2", "batch 4 collective yes"}) {
+        ::testing::internal::CaptureStdout();
+        command(std::string("fft_benchmark 32 30 24 iterations 3 ") + args);
+        auto output = ::testing::internal::GetCapturedStdout();
+        if (verbose) std::cout << output;
+        if (lmp->comm->me != 0) continue;
+
+        // last line has the # of batches, time, rate, and error of the round trips
+
+        auto lines  = utils::split_lines(output);
+        auto values = utils::split_words(lines.back());
+        ASSERT_EQ(values.size(), 4);
+        EXPECT_EQ(values[0], utils::split_words(args)[1]);
+        EXPECT_LT(utils::numeric(FLERR, values[3], false, lmp), 1.0e-12);
+    }
+}
+} // namespace LAMMPS_NS
@@ -0,0 +1,161 @@
+// unit tests for the exchange of coordinates and forces between NEB replicas
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "domain.h"
+#include "input.h"
+#include "lammps.h"
+#include "lattice.h"
+#include "universe.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+static const char final_file[] = "final.neb_test";
+
+class MPINEBTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log",  "none", "-screen", "none", "-in",
+                              "none",     "-echo", "none", "-nocite", "-partition", "4x1"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        if (world_rank() == 0) remove(final_file);
+    }
+
+    static int world_rank()
+    {
+        int me;
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        return me;
+    }
+
+    // 2d LJ surface with an adatom that hops to the next hollow site.
+    // the fixed atoms have no NEB forces. so the NEB path is the same,
+    // whether they are in the fix neb group or not, but only with all
+    // atoms in the group, fix neb uses the direct mode.
+
+    void setup(bool direct)
+    {
+        command("clear");
+        command("dimension 2");
+        command("boundary p f p");
+        command("atom_style atomic");
+        command("atom_modify map array sort 0 0.0");
+        command("lattice hex 0.9");
+        command("region box block 0 8 -0.25 5 -0.25 0.25");
+        command("region surface block 0 8 0 3.75 -0.25 0.25");
+        command("create_box 2 box");
+        command("create_atoms 1 region surface");
+        command("create_atoms 1 single 3.0 4.0 0.0");
+        command("mass * 1.0");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff * * 1.0 1.0 2.5");
+        command("pair_modify shift yes");
+        command("region lower block INF INF INF 1.25 INF INF");
+        command("group lower region lower");
+        command("group mobile subtract all lower");
+        command("set group lower type 2");
+        command("timestep 0.05");
+        command("fix 1 lower setforce 0.0 0.0 0.0");
+        command(std::string("fix 2 ") + (direct ? "all" : "mobile") + " neb 1.0 parallel ideal");
+        command("fix 3 all enforce2d");
+        command("min_style quickmin");
+
+        if (world_rank() == 0) {
+            auto lattice = lmp->domain->lattice;
+            FILE *fp     = fopen(final_file, "w");
+            fprintf(fp, "1\n%d %.15g %.15g 0.0\n", (int)lmp->atom->natoms, 4.0 * lattice->xlattice,
+                    4.0 * lattice->ylattice);
+            fclose(fp);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    // return the coordinates of all replicas ordered by replica and atom ID
+
+    std::vector<double> coords()
+    {
+        auto atom         = lmp->atom;
+        const int ntags   = atom->map_tag_max;
+        const int nworlds = lmp->universe->nworlds;
+        std::vector<double> mine(3 * ntags, 0.0), all(3 * ntags * nworlds, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                mine[3 * (atom->tag[i] - 1) + k] = atom->x[i][k];
+        MPI_Allgather(mine.data(), 3 * ntags, MPI_DOUBLE, all.data(), 3 * ntags, MPI_DOUBLE,
+                      lmp->universe->uworld);
+        return all;
+    }
+
+    // two NEB runs, with a second adatom added in between, so that
+    // the persistent requests of the direct mode must be recreated
+
+    std::vector<double> run(bool direct)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        setup(direct);
+        command(std::string("neb 0.0 0.01 100 50 10 final ") + final_file);
+        auto data = coords();
+        command("create_atoms 1 single 7.0 4.0 0.0");
+        command("group mobile subtract all lower");
+        command(std::string("neb 0.0 0.01 100 50 10 final ") + final_file);
+        auto more = coords();
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        data.insert(data.end(), more.begin(), more.end());
+        return data;
+    }
+};
+
+// persistent requests in the direct mode must give the same path
+// as the exchange of mapped coordinates
+
+TEST_F(MPINEBTest, direct_vs_map)
+{
+    if (!LAMMPS::is_installed_pkg("REPLICA")) GTEST_SKIP();
+    ASSERT_EQ(lmp->universe->nworlds, 4);
+    ASSERT_EQ(lmp->universe->nprocs, 4);
+
+    auto ref  = run(false);
+    auto data = run(true);
+    ASSERT_EQ(data.size(), ref.size());
+
+    // in the first run, the adatom of the intermediate replicas must be
+    // between its end points
+
+    const int stride = 3 * (lmp->atom->map_tag_max - 1);
+    const int adatom = stride - 3;
+    for (int i = 1; i < 3; ++i) {
+        EXPECT_GT(ref[i * stride + adatom], ref[adatom]);
+        EXPECT_LT(ref[i * stride + adatom], ref[3 * stride + adatom]);
+    }
+    for (std::size_t i = 0; i < data.size(); ++i)
+        EXPECT_DOUBLE_EQ(data[i], ref[i]);
+}
+} // namespace LAMMPS_NS
@@ -0,0 +1,127 @@
+// unit tests for the exchange of coordinates and forces between PIMD beads
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "fix.h"
+#include "input.h"
+#include "lammps.h"
+#include "modify.h"
+#include "universe.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPIPIMDTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log",  "none", "-screen", "none", "-in",
+                              "none",     "-echo", "none", "-nocite", "-partition", "4x1"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // argon crystal with four beads. with sorting, each bead reorders its
+    // atoms at a different step, so that the beads must exchange their
+    // atom IDs again, while the order is kept in between. return the
+    // spring energy and the coordinates of all beads ordered by bead and
+    // atom ID
+
+    std::vector<double> run(const std::string &method, bool sort)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        command("units metal");
+        command("atom_style atomic");
+        command("variable sortfreq world 10 20 30 40");
+        command("variable seed world 4928459 287287 36123 9871");
+        if (sort)
+            command("atom_modify map array sort ${sortfreq} 2.0");
+        else
+            command("atom_modify map array sort 0 0.0");
+        command("lattice fcc 5.26");
+        command("region box block 0 3 0 3 0 3");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 39.948");
+        command("velocity all create 50.0 ${seed} loop geom");
+        command("pair_style lj/cut 8.5");
+        command("pair_coeff * * 0.0104 3.40");
+        command("neighbor 1.0 bin");
+        command("neigh_modify every 5 delay 0 check no");
+        command("timestep 0.001");
+        command("fix 1 all pimd/nvt method " + method + " temp 50.0 nhc 4");
+        command("run 100 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        auto atom         = lmp->atom;
+        const int natoms  = atom->natoms;
+        const int nworlds = lmp->universe->nworlds;
+        std::vector<double> mine(3 * natoms, 0.0), all(3 * natoms * nworlds + 1, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                mine[3 * (atom->tag[i] - 1) + k] = atom->x[i][k];
+        MPI_Allgather(mine.data(), 3 * natoms, MPI_DOUBLE, all.data(), 3 * natoms, MPI_DOUBLE,
+                      lmp->universe->uworld);
+        double espring = lmp->modify->get_fix_by_id("1")->compute_vector(0);
+        MPI_Allreduce(&espring, &all.back(), 1, MPI_DOUBLE, MPI_SUM, lmp->universe->uworld);
+        return all;
+    }
+
+    // reordered atoms only change the order of the pair force sums
+
+    void compare(const std::string &method)
+    {
+        auto ref  = run(method, false);
+        auto data = run(method, true);
+        ASSERT_EQ(data.size(), ref.size());
+        EXPECT_NE(ref.back(), 0.0);
+        for (std::size_t i = 0; i < data.size(); ++i)
+            EXPECT_NEAR(data[i], ref[i], 1.0e-10 * fabs(ref[i]));
+    }
+};
+
+// the spring forces only need the neighbor beads along the ring polymer
+
+TEST_F(MPIPIMDTest, pimd)
+{
+    if (!LAMMPS::is_installed_pkg("REPLICA")) GTEST_SKIP();
+    ASSERT_EQ(lmp->universe->nworlds, 4);
+    ASSERT_EQ(lmp->universe->nprocs, 4);
+    compare("pimd");
+}
+
+// the normal-mode transforms need all beads
+
+TEST_F(MPIPIMDTest, nmpimd)
+{
+    if (!LAMMPS::is_installed_pkg("REPLICA")) GTEST_SKIP();
+    ASSERT_EQ(lmp->universe->nworlds, 4);
+    compare("nmpimd");
+}
+} // namespace LAMMPS_NS
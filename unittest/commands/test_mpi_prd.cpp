@@ -0,0 +1,116 @@
+// unit tests for the asynchronous event search of PRD
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "input.h"
+#include "lammps.h"
+#include "universe.h"
+#include "update.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPIPRDTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log",  "none", "-screen", "none", "-in",
+                              "none",     "-echo", "none", "-nocite", "-partition", "4x1"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // cold LJ crystal, in which no atom leaves its lattice site, so that
+    // all replicas run until the end without an event. return the final
+    // timestep and the coordinates of all replicas ordered by replica and
+    // atom ID
+
+    std::vector<double> run(int nsteps, const std::string &time, bool async)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        command("atom_style atomic");
+        command("atom_modify map array sort 0 0.0");
+        command("lattice fcc 0.8442");
+        command("region box block 0 3 0 3 0 3");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 0.05 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff * * 1.0 1.0");
+        command("timestep 0.005");
+        command("fix 1 all nve");
+        command("compute event all event/displace 0.5");
+        command("prd " + std::to_string(nsteps) +
+                " 20 2 20 20 event 54985 temp 0.05 min 0.0 1.0e-6 100 100 time " + time +
+                " async " + (async ? "yes" : "no"));
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        auto atom         = lmp->atom;
+        const int natoms  = atom->natoms;
+        const int nworlds = lmp->universe->nworlds;
+        std::vector<double> mine(3 * natoms, 0.0), all(3 * natoms * nworlds + 1, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                mine[3 * (atom->tag[i] - 1) + k] = atom->x[i][k];
+        MPI_Allgather(mine.data(), 3 * natoms, MPI_DOUBLE, all.data(), 3 * natoms, MPI_DOUBLE,
+                      lmp->universe->uworld);
+        all.back() = lmp->update->ntimestep;
+        return all;
+    }
+
+    // without events, the asynchronous search must end in the same
+    // unquenched state and at the same timestep as the synchronous one
+
+    void compare(int nsteps, const std::string &time)
+    {
+        auto ref  = run(nsteps, time, false);
+        auto data = run(nsteps, time, true);
+        ASSERT_EQ(data.size(), ref.size());
+        for (std::size_t i = 0; i < data.size(); ++i)
+            EXPECT_DOUBLE_EQ(data[i], ref[i]);
+    }
+};
+
+TEST_F(MPIPRDTest, async_vs_sync)
+{
+    if (!LAMMPS::is_installed_pkg("REPLICA")) GTEST_SKIP();
+    ASSERT_EQ(lmp->universe->nworlds, 4);
+    ASSERT_EQ(lmp->universe->nprocs, 4);
+    compare(200, "steps");
+}
+
+// the run ends when the steps summed over all replicas reach nsteps
+
+TEST_F(MPIPRDTest, async_vs_sync_clock)
+{
+    if (!LAMMPS::is_installed_pkg("REPLICA")) GTEST_SKIP();
+    ASSERT_EQ(lmp->universe->nworlds, 4);
+    compare(240, "clock");
+}
+} // namespace LAMMPS_NS
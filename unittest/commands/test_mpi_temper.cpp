@@ -0,0 +1,153 @@
+// unit tests for the swaps between adjacent temperatures of the temper command
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "input.h"
+#include "lammps.h"
+#include "universe.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPITemperTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    // the universe screen of proc 0 is stdout, so that the swap status
+    // and statistics can be captured
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log",    "none", "-pscreen", "none",      "-in",
+                              "none",     "-echo",   "none", "-nocite",  "-partition", "4x1"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // LJ liquid tempered at four temperatures close enough for some swaps
+    // to be accepted. return the lines of tempering output on proc 0 and
+    // the coordinates of all worlds ordered by world and atom ID
+
+    std::vector<double> run(const std::string &args, std::vector<std::string> &lines)
+    {
+        ::testing::internal::CaptureStdout();
+        command("clear");
+        command("units lj");
+        command("atom_style atomic");
+        command("atom_modify map array");
+        command("variable t world 1.0 1.05 1.1 1.15");
+        command("variable w world 2 0 3 1");
+        command("lattice fcc 0.8442");
+        command("region box block 0 3 0 3 0 3");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create $t 87287 loop geom");
+        command("pair_style lj/cut 2.5");
+        command("pair_coeff * * 1.0 1.0");
+        command("fix 1 all nvt temp $t $t 0.5");
+        command("thermo 1000");
+        command("temper 2000 50 $t 1 0 58728 " + args);
+        auto output = ::testing::internal::GetCapturedStdout();
+        if (verbose) std::cout << output;
+
+        // tempering output starts with the header and ends before the timings
+
+        lines.clear();
+        std::istringstream in(output);
+        std::string line;
+        bool found = false;
+        while (std::getline(in, line)) {
+            if (line.compare(0, 7, "Step T0") == 0) found = true;
+            if (line.compare(0, 9, "Loop time") == 0) found = false;
+            if (found) lines.push_back(line);
+        }
+
+        auto atom         = lmp->atom;
+        const int natoms  = atom->natoms;
+        const int nworlds = lmp->universe->nworlds;
+        std::vector<double> mine(3 * natoms, 0.0), all(3 * natoms * nworlds, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                mine[3 * (atom->tag[i] - 1) + k] = atom->x[i][k];
+        MPI_Allgather(mine.data(), 3 * natoms, MPI_DOUBLE, all.data(), 3 * natoms, MPI_DOUBLE,
+                      lmp->universe->uworld);
+        return all;
+    }
+
+    // the pairwise exchange must attempt and accept the same swaps in the
+    // same order, so that the output and the trajectories are identical
+
+    void compare(const std::string &index)
+    {
+        std::vector<std::string> ref_lines, lines;
+        auto ref = run(index + " exchange all", ref_lines);
+
+        // the swap statistics of all pairs are at the end of the output
+
+        if (lmp->universe->me == 0) {
+            ASSERT_GT(ref_lines.size(), 5U);
+            int attempts = 0, accepted = 0;
+            for (std::size_t i = ref_lines.size() - 3; i < ref_lines.size(); ++i) {
+                std::istringstream values(ref_lines[i]);
+                int ilo, ihi, n, m;
+                values >> ilo >> ihi >> n >> m;
+                attempts += n;
+                accepted += m;
+            }
+            EXPECT_EQ(attempts, 60);
+            EXPECT_GT(accepted, 0);
+            EXPECT_LT(accepted, attempts);
+        }
+
+        for (const auto &args : {" exchange pair", " exchange pair async yes"}) {
+            auto data = run(index + args, lines);
+            EXPECT_EQ(lines, ref_lines);
+            ASSERT_EQ(data.size(), ref.size());
+            for (std::size_t i = 0; i < data.size(); ++i)
+                EXPECT_DOUBLE_EQ(data[i], ref[i]);
+        }
+    }
+};
+
+TEST_F(MPITemperTest, pair_vs_all)
+{
+    if (!LAMMPS::is_installed_pkg("REPLICA")) GTEST_SKIP();
+    ASSERT_EQ(lmp->universe->nworlds, 4);
+    ASSERT_EQ(lmp->universe->nprocs, 4);
+    compare("");
+}
+
+// restart with temperatures that are not in the order of the worlds
+
+TEST_F(MPITemperTest, pair_vs_all_index)
+{
+    if (!LAMMPS::is_installed_pkg("REPLICA")) GTEST_SKIP();
+    ASSERT_EQ(lmp->universe->nworlds, 4);
+    compare("$w");
+}
+} // namespace LAMMPS_NS
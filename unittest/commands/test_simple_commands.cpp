@@ -13,6 +13,7 @@
 
 #include "lammps.h"
 
+#include "atom.h"
 #include "citeme.h"
 #include "comm.h"
 #include "force.h"
@@ -28,6 +29,8 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
@@ -40,6 +43,7 @@ bool verbose = false;
 namespace LAMMPS_NS {
 using ::testing::ContainsRegex;
 using ::testing::ExitedWithCode;
+using ::testing::Not;
 using ::testing::StrEq;
 
 class SimpleCommandsTest : public LAMMPSTest {};
@@ -206,6 +210,75 @@ TEST_F(SimpleCommandsTest, Processors)
                  command("processors 100 100 100"););
 }
 
+// largest distance between atoms which are consecutive in the list of local atoms
+
+static double max_consecutive_distance(LAMMPS *lmp)
+{
+    double **x  = lmp->atom->x;
+    double dmax = 0.0;
+    for (int i = 1; i < lmp->atom->nlocal; ++i) {
+        double dx = x[i][0] - x[i - 1][0];
+        double dy = x[i][1] - x[i - 1][1];
+        double dz = x[i][2] - x[i - 1][2];
+        dmax      = std::max(dmax, sqrt(dx * dx + dy * dy + dz * dz));
+    }
+    return dmax;
+}
+
+TEST_F(SimpleCommandsTest, AtomModifySort)
+{
+    ASSERT_EQ(lmp->atom->sortorder, Atom::SORT_XYZ);
+    ASSERT_DOUBLE_EQ(lmp->atom->sortthresh, 0.0);
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify sort 1 1.0 sort/order hilbert sort/adaptive 0.25");
+    command("region box block 0 8 0 8 0 8");
+    command("create_box 1 box");
+    command("create_atoms 1 random 2000 8741 NULL");
+    command("mass 1 1.0");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->sortorder, Atom::SORT_HILBERT);
+    ASSERT_DOUBLE_EQ(lmp->atom->sortthresh, 0.25);
+
+    // random order, then sorted along a Hilbert curve over 8x8x8 bins of size 1,
+    // where consecutive bins share a face
+
+    const double maxbin = 2.0 * sqrt(3.0);
+    ASSERT_GT(max_consecutive_distance(lmp), maxbin);
+    BEGIN_HIDE_OUTPUT();
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_LT(max_consecutive_distance(lmp), maxbin);
+
+    // too many bins for 64-bit curve keys: xyz order is used for these bins only
+
+    BEGIN_CAPTURE_OUTPUT();
+    command("change_box all x final 0 3000000 units box");
+    command("run 0 post no");
+    auto mesg = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(mesg, ContainsRegex(".*WARNING: Too many atom sorting bins for space-filling curve.*"));
+    ASSERT_EQ(lmp->atom->sortorder, Atom::SORT_HILBERT);
+
+    // with fewer bins again the requested curve order is used
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify sort/adaptive 0.0");
+    command("change_box all x final 0 8 units box");
+    command("displace_atoms all random 4.0 4.0 4.0 3455 units box");
+    END_HIDE_OUTPUT();
+    ASSERT_GT(max_consecutive_distance(lmp), maxbin);
+    BEGIN_CAPTURE_OUTPUT();
+    command("run 0 post no");
+    mesg = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(mesg, Not(ContainsRegex(".*WARNING: Too many atom sorting bins.*")));
+    ASSERT_LT(max_consecutive_distance(lmp), maxbin);
+
+    TEST_FAILURE(".*ERROR: Illegal atom_modify sort/order argument xxx.*",
+                 command("atom_modify sort/order xxx"););
+    TEST_FAILURE(".*ERROR: Illegal atom_modify sort/adaptive fraction 1.5.*",
+                 command("atom_modify sort/adaptive 1.5"););
+}
+
 TEST_F(SimpleCommandsTest, Quit)
 {
     BEGIN_HIDE_OUTPUT();
@@ -0,0 +1,253 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// Monte Carlo fixes with the local energy differences from Pair::energy_local()
+// must accept the same moves as with total energies. A pair style wrapped
+// in pair_style hybrid/overlay with pair_style zero has the same energy,
+// but no energy_local(), so it is used for the total energy reference.
+
+#include "fix.h"
+#include "lammps.h"
+#include "library.h"
+#include "modify.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+const char cuni[] = "units           metal\n"
+                    "atom_style      atomic\n"
+                    "atom_modify     map array\n"
+                    "lattice         fcc 3.6\n"
+                    "region          box block 0 4 0 4 0 4\n"
+                    "create_box      2 box\n"
+                    "create_atoms    1 box\n"
+                    "delete_atoms    random fraction 0.3 yes all NULL 482793\n"
+                    "set type 1 type/fraction 2 0.5 998877\n"
+                    "displace_atoms  all random 0.1 0.1 0.1 623426\n"
+                    "mass            * 60.0\n";
+
+const char inp[] = "units           metal\n"
+                   "atom_style      atomic\n"
+                   "atom_modify     map array\n"
+                   "lattice         diamond 5.83\n"
+                   "region          box block 0 2 0 2 0 2\n"
+                   "create_box      2 box\n"
+                   "create_atoms    1 box\n"
+                   "set type 1 type/fraction 2 0.5 998877\n"
+                   "displace_atoms  all random 0.1 0.1 0.1 623426\n"
+                   "mass            1 114.76\n"
+                   "mass            2 30.98\n";
+
+static constexpr double EPSILON = 1.0e-8;
+
+namespace LAMMPS_NS {
+
+// pair style commands for the local and the total energy runs
+
+struct PairSetup {
+    const char *setup;
+    std::string style, coeff;
+};
+
+static const PairSetup eam  = {cuni, "eam/alloy", "CuNi.eam.alloy Cu Ni"};
+static const PairSetup snap = {inp, "snap", "InP_equal.snapcoeff InP_JCPA2020.snapparam In P"};
+
+// fix atom/swap uses total energies for types with different cutoffs,
+// so the SNAP coefficients of InP are used with equal element radii
+
+const char snapcoeff[] = "InP_equal.snapcoeff";
+
+static bool write_snapcoeff()
+{
+    const char *potentials = std::getenv("LAMMPS_POTENTIALS");
+    std::string path       = "InP_JCPA2020.snapcoeff";
+    if (potentials) path = std::string(potentials) + "/" + path;
+    std::ifstream in(path);
+    if (!in.good()) return false;
+
+    std::ofstream out(snapcoeff);
+    std::string line;
+    bool found = false;
+    while (std::getline(in, line)) {
+        if (line.compare(0, 2, "P ") == 0) {
+            line  = "P 3.81205" + line.substr(line.find(' ', 2));
+            found = true;
+        }
+        out << line << "\n";
+    }
+    return found;
+}
+
+// return the number of atoms, the first nvector values of the MC fix,
+// the potential energy after the MC moves, the energy the MC fix has
+// accumulated from the energy differences of the accepted moves, if
+// available, and, if requested, the atom types ordered by atom ID
+
+static std::vector<double> run_mc(const PairSetup &pair, bool local, const std::string &fix,
+                                  int nsteps, int nvector, bool types)
+{
+    const char *lmpargv[] = {"mc", "-log", "none", "-nocite"};
+    int lmpargc           = sizeof(lmpargv) / sizeof(const char *);
+
+    void *lmp = lammps_open_no_mpi(lmpargc, (char **)lmpargv, nullptr);
+    lammps_commands_string(lmp, pair.setup);
+    if (local) {
+        lammps_command(lmp, ("pair_style " + pair.style).c_str());
+        lammps_command(lmp, ("pair_coeff * * " + pair.coeff).c_str());
+    } else {
+        lammps_command(lmp, ("pair_style hybrid/overlay " + pair.style + " zero 2.0").c_str());
+        lammps_command(lmp, ("pair_coeff * * " + pair.style + " " + pair.coeff).c_str());
+        lammps_command(lmp, "pair_coeff * * zero");
+    }
+    lammps_command(lmp, "timestep 0.001");
+    lammps_command(lmp, ("fix mc all " + fix).c_str());
+    lammps_command(lmp, "thermo_style custom step pe");
+    lammps_command(lmp, ("run " + std::to_string(nsteps) + " post no").c_str());
+
+    std::vector<double> data;
+    data.push_back(lammps_get_natoms(lmp));
+    for (int i = 0; i < nvector; ++i) {
+        auto *val = (double *)lammps_extract_fix(lmp, "mc", LMP_STYLE_GLOBAL, LMP_TYPE_VECTOR, i, 0);
+        data.push_back(*val);
+        lammps_free(val);
+    }
+
+    int dim;
+    auto *mc     = ((LAMMPS *)lmp)->modify->get_fix_by_id("mc");
+    auto *stored = (double *)mc->extract("energy_stored", dim);
+    double energy_stored = stored ? *stored : 0.0;
+
+    // MC moves are done after the energy of a step was computed
+
+    lammps_command(lmp, "unfix mc");
+    lammps_command(lmp, "run 0 post no");
+    data.push_back(lammps_get_thermo(lmp, "pe"));
+    data.push_back(stored ? energy_stored : data.back());
+
+    if (types) {
+        int natoms = (int)lammps_get_natoms(lmp);
+        std::vector<int> type(natoms);
+        lammps_gather_atoms(lmp, (char *)"type", 0, 1, type.data());
+        for (const auto &t : type)
+            data.push_back(t);
+    }
+    lammps_close(lmp);
+    return data;
+}
+
+// the local and the total energy runs must accept the same moves
+// and end in the same state. the sum of the local energy differences
+// must be the energy difference of the initial and final states
+
+static std::vector<double> compare_mc(const PairSetup &pair, const std::string &fix, int nsteps,
+                                      int nvector, bool types)
+{
+    ::testing::internal::CaptureStdout();
+    auto ref  = run_mc(pair, false, fix, nsteps, nvector, types);
+    auto data = run_mc(pair, true, fix, nsteps, nvector, types);
+    ::testing::internal::GetCapturedStdout();
+
+    const std::size_t pe = nvector + 1;
+    EXPECT_EQ(data.size(), ref.size());
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        if ((i == pe) || (i == pe + 1))
+            EXPECT_NEAR(data[i], ref[pe], EPSILON * fabs(ref[pe]));
+        else
+            EXPECT_EQ(data[i], ref[i]);
+    }
+    return ref;
+}
+
+// both outcomes of a trial must occur, so that the energy
+// differences of accepted and of rejected moves are tested
+
+static void expect_accepted_and_rejected(double attempts, double successes)
+{
+    EXPECT_GT(successes, 0.0);
+    EXPECT_LT(successes, attempts);
+}
+
+TEST(MCLocalEnergy, AtomSwapEAM)
+{
+    if (!lammps_config_has_package("MC")) GTEST_SKIP();
+    if (!lammps_config_has_package("MANYBODY")) GTEST_SKIP();
+    auto ref = compare_mc(eam, "atom/swap 1 20 4983 2000.0 ke no types 1 2", 4, 2, true);
+    expect_accepted_and_rejected(ref[1], ref[2]);
+}
+
+TEST(MCLocalEnergy, AtomSwapSNAP)
+{
+    if (!lammps_config_has_package("MC")) GTEST_SKIP();
+    if (!lammps_config_has_package("ML-SNAP")) GTEST_SKIP();
+    ASSERT_TRUE(write_snapcoeff());
+    auto ref = compare_mc(snap, "atom/swap 1 5 4983 2000.0 ke no types 1 2", 4, 2, true);
+    expect_accepted_and_rejected(ref[1], ref[2]);
+    remove(snapcoeff);
+}
+
+TEST(MCLocalEnergy, AtomSwapSemiGrandEAM)
+{
+    if (!lammps_config_has_package("MC")) GTEST_SKIP();
+    if (!lammps_config_has_package("MANYBODY")) GTEST_SKIP();
+    auto ref =
+        compare_mc(eam, "atom/swap 1 20 4983 2000.0 semi-grand yes types 1 2 mu 0.0 0.2", 4, 2, true);
+    expect_accepted_and_rejected(ref[1], ref[2]);
+}
+
+// insertions and deletions of atoms and translations
+
+TEST(MCLocalEnergy, GCMCEAM)
+{
+    if (!lammps_config_has_package("MC")) GTEST_SKIP();
+    if (!lammps_config_has_package("MANYBODY")) GTEST_SKIP();
+    auto ref = compare_mc(eam, "gcmc 1 10 10 1 29494 2000.0 -5.5 0.2 full_energy", 4, 6, false);
+    expect_accepted_and_rejected(ref[1], ref[2]);
+    expect_accepted_and_rejected(ref[3], ref[4]);
+    expect_accepted_and_rejected(ref[5], ref[6]);
+}
+
+TEST(MCLocalEnergy, GCMCSNAP)
+{
+    if (!lammps_config_has_package("MC")) GTEST_SKIP();
+    if (!lammps_config_has_package("ML-SNAP")) GTEST_SKIP();
+    ASSERT_TRUE(write_snapcoeff());
+    auto ref = compare_mc(snap, "gcmc 1 5 5 2 29494 2000.0 -12.0 0.2 full_energy", 4, 6, false);
+    expect_accepted_and_rejected(ref[1], ref[2]);
+    expect_accepted_and_rejected(ref[3], ref[4]);
+    expect_accepted_and_rejected(ref[5], ref[6]);
+    remove(snapcoeff);
+}
+
+// fix sgcmc requires a sampling window of at least half the box. the
+// high temperature makes the acceptance depend on the size of the
+// energy differences and not only on their sign
+
+TEST(MCLocalEnergy, SGCMCSNAP)
+{
+    if (!lammps_config_has_package("MC")) GTEST_SKIP();
+    if (!lammps_config_has_package("ML-SNAP")) GTEST_SKIP();
+    ASSERT_TRUE(write_snapcoeff());
+    auto ref = compare_mc(snap, "sgcmc 1 0.25 20000.0 -0.5 randseed 324234 window_size 0.5", 2, 2,
+                          true);
+    expect_accepted_and_rejected(ref[1] + ref[2], ref[1]);
+    remove(snapcoeff);
+}
+
+} // namespace LAMMPS_NS
@@ -0,0 +1,137 @@
+// unit tests for the row-distributed electrode matrix of fix electrode/conp
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "fix.h"
+#include "input.h"
+#include "lammps.h"
+#include "modify.h"
+#include "output.h"
+#include "thermo.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPIElectrodeTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // two electrode layers of 144 atoms each, so that the 288 matrix rows
+    // form 5 blocks of up to 64 rows, which are spread unevenly over 4 procs.
+    // return per-atom charges ordered by atom ID and the potential energy
+
+    std::vector<double> run(const std::string &options, double &memory)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        command("units real");
+        command("atom_style charge");
+        command("atom_modify map array");
+        command("boundary p p f");
+        command("lattice sc 2.5");
+        command("region box block 0 12 0 12 -1 11");
+        command("create_box 3 box");
+        command("region bot block INF INF INF INF -0.1 0.1");
+        command("region top block INF INF INF INF 9.9 10.1");
+        command("create_atoms 1 region bot");
+        command("create_atoms 2 region top");
+        command("create_atoms 3 single 3.0 4.0 3.0");
+        command("create_atoms 3 single 7.5 2.0 6.0");
+        command("create_atoms 3 single 5.0 9.0 4.5");
+        command("create_atoms 3 single 10.0 6.5 7.0");
+        command("mass * 1.0");
+        command("set type 3 charge 0.5");
+        command("set atom 290 charge -0.5");
+        command("set atom 292 charge -0.5");
+        command("group bot type 1");
+        command("group top type 2");
+        command("group ions type 3");
+        command("velocity ions create 300.0 87287 loop geom");
+        command("pair_style coul/long 10.0");
+        command("pair_coeff * *");
+        command("kspace_style ewald/electrode 1.0e-7");
+        command("kspace_modify slab 3.0");
+        command("fix conp bot electrode/conp -1.0 1.805 couple top 1.0 " + options);
+        command("fix nve ions nve");
+        command("thermo_style custom step pe");
+        command("run 4 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+
+        memory = lmp->modify->get_fix_by_id("conp")->memory_usage();
+
+        auto atom        = lmp->atom;
+        const int natoms = atom->natoms;
+        std::vector<double> mine(natoms + 1, 0.0), all(natoms + 1, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i)
+            mine[atom->tag[i] - 1] = atom->q[i];
+        MPI_Allreduce(mine.data(), all.data(), natoms, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        lmp->output->thermo->evaluate_keyword("pe", &all[natoms]);
+        return all;
+    }
+
+    // distributed matrix must reproduce the replicated matrix
+    // and use less memory per proc
+
+    void compare(const std::string &algo)
+    {
+        double mem_ref, mem_dist;
+        auto ref  = run(algo + " distributed off", mem_ref);
+        auto data = run(algo + " distributed on", mem_dist);
+        EXPECT_LT(mem_dist, 0.5 * mem_ref);
+        ASSERT_EQ(data.size(), ref.size());
+        for (std::size_t i = 0; i < data.size(); ++i)
+            EXPECT_NEAR(data[i], ref[i], 1.0e-10);
+    }
+};
+
+TEST_F(MPIElectrodeTest, mat_inv)
+{
+    if (!LAMMPS::is_installed_pkg("ELECTRODE")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("algo mat_inv symm on");
+}
+
+TEST_F(MPIElectrodeTest, mat_cg)
+{
+    if (!LAMMPS::is_installed_pkg("ELECTRODE")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("algo mat_cg 1.0e-14 symm on");
+}
+
+TEST_F(MPIElectrodeTest, mat_inv_nosymm)
+{
+    if (!LAMMPS::is_installed_pkg("ELECTRODE")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    compare("algo mat_inv symm off");
+}
+} // namespace LAMMPS_NS
@@ -0,0 +1,115 @@
+// unit tests for the parallel energy differences of fix sgcmc
+
+#define LAMMPS_LIB_MPI 1
+#include "comm.h"
+#include "fix.h"
+#include "input.h"
+#include "lammps.h"
+#include "modify.h"
+#include "output.h"
+#include "thermo.h"
+
+#include <cmath>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPISGCMCTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    double energy()
+    {
+        double pe;
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("run 0 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        lmp->output->thermo->evaluate_keyword("pe", &pe);
+        return pe;
+    }
+
+    // atoms do not move, so the energy difference of two steps is
+    // the sum of the energy differences of the swaps accepted in
+    // the MC step in between, summed over all procs
+
+    void check_mc_steps(int nsteps)
+    {
+        int dim;
+        auto *mc           = lmp->modify->get_fix_by_id("mc");
+        auto *delta_energy = (double *)mc->extract("delta_energy", dim);
+        ASSERT_NE(delta_energy, nullptr);
+
+        double accepted = 0.0, rejected = 0.0;
+        double pe = energy();
+        for (int i = 0; i < nsteps; ++i) {
+            if (!verbose) ::testing::internal::CaptureStdout();
+            command("run 1 post no");
+            if (!verbose) ::testing::internal::GetCapturedStdout();
+            accepted += mc->compute_vector(0);
+            rejected += mc->compute_vector(1);
+            double pe_new = energy();
+            EXPECT_NEAR(pe_new - pe, *delta_energy, 1.0e-10 * fabs(pe));
+            pe = pe_new;
+        }
+        EXPECT_GT(accepted, 0.0);
+        EXPECT_GT(rejected, 0.0);
+    }
+};
+
+// snap energies of the atoms near a swap, with cached energies and ghost
+// neighbors. each proc domain is at least four interaction radii wide, so
+// that swaps on different procs and periodic images do not interfere. all
+// trials of a step use the same sampling window, so that the cached energies
+// of ghost atoms near the window are reused
+
+TEST_F(MPISGCMCTest, snap)
+{
+    if (!LAMMPS::is_installed_pkg("MC")) GTEST_SKIP();
+    if (!LAMMPS::is_installed_pkg("ML-SNAP")) GTEST_SKIP();
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("processors 2 2 1");
+    command("units metal");
+    command("atom_style atomic");
+    command("lattice bcc 3.1803");
+    command("region box block 0 14 0 14 0 7");
+    command("create_box 2 box");
+    command("create_atoms 1 box");
+    command("set type 1 type/fraction 2 0.5 998877");
+    command("displace_atoms all random 0.1 0.1 0.1 623426");
+    command("mass 1 183.84");
+    command("mass 2 9.012");
+    command("pair_style snap");
+    command("pair_coeff * * WBe_Wood_PRB2019.snapcoeff WBe_Wood_PRB2019.snapparam W Be");
+    command("fix mc all sgcmc 1 0.1 20000.0 -0.5 randseed 324234 window_moves 1");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    check_mc_steps(2);
+}
+} // namespace LAMMPS_NS
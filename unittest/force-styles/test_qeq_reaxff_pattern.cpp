@@ -0,0 +1,106 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "library.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+const char setup[] = "units           real\n"
+                     "atom_style      charge\n"
+                     "atom_modify     map array\n"
+                     "lattice         diamond 3.77\n"
+                     "region          box block 0 2 0 2 0 2\n"
+                     "create_box      3 box\n"
+                     "create_atoms    1 box\n"
+                     "displace_atoms  all random 0.1 0.1 0.1 623426\n"
+                     "mass            1 1.0\n"
+                     "mass            2 12.0\n"
+                     "mass            3 16.0\n"
+                     "set type 1 type/fraction 2 0.5 998877\n"
+                     "set type 2 type/fraction 3 0.5 887766\n"
+                     "set type 1 charge  0.00\n"
+                     "set type 2 charge  0.01\n"
+                     "set type 3 charge -0.01\n"
+                     "velocity        all create 100 4534624 loop geom\n"
+                     "pair_style      reaxff NULL checkqeq yes\n"
+                     "pair_coeff      * * ffield.reax.mattsson H C O\n"
+                     "neighbor        2.0 bin\n"
+                     "neigh_modify    delay 0 every 1 check yes\n"
+                     "timestep        0.1\n"
+                     "fix             1 all nve\n";
+
+// a second run starting on the same timestep rebuilds the neighbor lists
+// in setup, after the atoms were moved and re-sorted between the runs
+
+const char rerun[] = "run 0 post no\n"
+                     "displace_atoms  all random 0.4 0.4 0.4 87287\n"
+                     "run 4 post no\n";
+
+// the line search of the minimizer may rebuild the neighbor lists
+// more than once during the same timestep
+
+const char minimize[] = "neighbor        0.1 bin\n"
+                        "min_style       cg\n"
+                        "minimize        0.0 0.0 20 200\n";
+
+static constexpr double EPSILON = 1.0e-10;
+
+namespace LAMMPS_NS {
+
+static std::vector<double> run_qeq(const std::string &pattern, const char *commands)
+{
+    const char *lmpargv[] = {"qeq", "-log", "none", "-nocite"};
+    int lmpargc           = sizeof(lmpargv) / sizeof(const char *);
+
+    void *lmp = lammps_open_no_mpi(lmpargc, (char **)lmpargv, nullptr);
+    lammps_commands_string(lmp, setup);
+    lammps_command(lmp, ("fix qeq all qeq/reaxff 1 0.0 8.0 1.0e-20 reaxff pattern " + pattern).c_str());
+    lammps_commands_string(lmp, commands);
+
+    int natoms = (int)lammps_get_natoms(lmp);
+    std::vector<double> data(natoms + 1);
+    lammps_gather_atoms(lmp, (char *)"q", 1, 1, data.data());
+    data[natoms] = lammps_get_thermo(lmp, "pe");
+    lammps_close(lmp);
+    return data;
+}
+
+static void compare_patterns(const char *commands)
+{
+    ::testing::internal::CaptureStdout();
+    auto ref  = run_qeq("rebuild", commands);
+    auto keep = run_qeq("keep", commands);
+    ::testing::internal::GetCapturedStdout();
+
+    ASSERT_EQ(keep.size(), ref.size());
+    for (std::size_t i = 0; i < ref.size(); ++i)
+        EXPECT_NEAR(keep[i], ref[i], EPSILON);
+}
+
+TEST(QEqReaxFF, PatternRerun)
+{
+    if (!lammps_config_has_package("REAXFF")) GTEST_SKIP();
+    compare_patterns(rerun);
+}
+
+TEST(QEqReaxFF, PatternMinimize)
+{
+    if (!lammps_config_has_package("REAXFF")) GTEST_SKIP();
+    compare_patterns(minimize);
+}
+
+} // namespace LAMMPS_NS
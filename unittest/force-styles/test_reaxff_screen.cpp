@@ -0,0 +1,145 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "library.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+const char setup[] = "units           real\n"
+                     "atom_style      charge\n"
+                     "atom_modify     map array\n"
+                     "lattice         diamond 3.77\n"
+                     "region          box block 0 2 0 2 0 2\n"
+                     "create_box      3 box\n"
+                     "create_atoms    1 box\n"
+                     "displace_atoms  all random 0.3 0.3 0.3 623426\n"
+                     "mass            1 1.0\n"
+                     "mass            2 12.0\n"
+                     "mass            3 16.0\n"
+                     "set type 1 type/fraction 2 0.5 998877\n"
+                     "set type 2 type/fraction 3 0.5 887766\n"
+                     "set type 1 charge  0.00\n"
+                     "set type 2 charge  0.01\n"
+                     "set type 3 charge -0.01\n";
+
+// force field with a negative p_val2 for all valence angles, so that
+// 1 - exp(-p_val2 * dtheta^2) is no longer bounded by 1
+
+const char ffield[] = "ffield.reax.negative_pval2";
+
+static constexpr double EPSILON = 1.0e-10;
+
+namespace LAMMPS_NS {
+
+static bool write_ffield()
+{
+    const char *potentials = std::getenv("LAMMPS_POTENTIALS");
+    std::string path       = "ffield.reax.mattsson";
+    if (potentials) path = std::string(potentials) + "/" + path;
+    std::ifstream in(path);
+    if (!in.good()) return false;
+
+    std::ofstream out(ffield);
+    std::string line;
+    int nangles = -1;
+    while (std::getline(in, line)) {
+        if (nangles > 0) {
+            std::istringstream values(line);
+            std::vector<std::string> words;
+            std::string word;
+            while (values >> word)
+                words.push_back(word);
+            if (std::stod(words[5]) != 0.0) words[5] = "-0.2";
+            line.clear();
+            for (const auto &w : words)
+                line += " " + w;
+            --nangles;
+        } else if ((nangles < 0) && (line.find("Nr of angles") != std::string::npos)) {
+            nangles = std::stoi(line);
+        }
+        out << line << "\n";
+    }
+    return nangles == 0;
+}
+
+// return the valence angle, penalty and coalition energies and the
+// sum of the bounds of the skipped terms
+
+static std::vector<double> run_screen(const std::string &suffix, const std::string &screen)
+{
+    const char *lmpargv[] = {"screen", "-log", "none", "-nocite"};
+    int lmpargc           = sizeof(lmpargv) / sizeof(const char *);
+
+    void *lmp = lammps_open_no_mpi(lmpargc, (char **)lmpargv, nullptr);
+    if (!suffix.empty()) {
+        lammps_command(lmp, ("package " + suffix + " 1").c_str());
+        lammps_command(lmp, ("suffix " + suffix).c_str());
+    }
+    lammps_commands_string(lmp, setup);
+    lammps_command(lmp, ("pair_style reaxff NULL checkqeq no screen " + screen).c_str());
+    lammps_command(lmp, (std::string("pair_coeff * * ") + ffield + " H C O").c_str());
+    lammps_command(lmp, "compute e all pair reaxff");
+    lammps_command(lmp, "thermo_style custom step pe c_e[5] c_e[6] c_e[7] c_e[15]");
+    lammps_command(lmp, "run 0 post no");
+
+    auto *energies = (double *)lammps_extract_compute(lmp, "e", LMP_STYLE_GLOBAL, LMP_TYPE_VECTOR);
+    std::vector<double> data;
+    for (const auto &i : {4, 5, 6, 14})
+        data.push_back(energies[i]);
+    lammps_close(lmp);
+    return data;
+}
+
+// angles with a negative p_val2 have no energy bound and must be
+// evaluated exactly, while torsions are still screened
+
+static void compare_screen(const std::string &suffix)
+{
+    ::testing::internal::CaptureStdout();
+    auto ref  = run_screen(suffix, "0.0");
+    auto data = run_screen(suffix, "1.0e10");
+    ::testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(ref[3], 0.0);
+    EXPECT_GT(data[3], 0.0);
+    for (int i = 0; i < 3; ++i)
+        EXPECT_NEAR(data[i], ref[i], EPSILON);
+    EXPECT_NE(ref[0], 0.0);
+}
+
+TEST(ReaxFFScreen, NegativePval2)
+{
+    if (!lammps_config_has_package("REAXFF")) GTEST_SKIP();
+    ASSERT_TRUE(write_ffield());
+    compare_screen("");
+    remove(ffield);
+}
+
+TEST(ReaxFFScreen, NegativePval2OMP)
+{
+    if (!lammps_config_has_package("REAXFF")) GTEST_SKIP();
+    if (!lammps_config_has_package("OPENMP")) GTEST_SKIP();
+    ASSERT_TRUE(write_ffield());
+    compare_screen("omp");
+    remove(ffield);
+}
+
+} // namespace LAMMPS_NS
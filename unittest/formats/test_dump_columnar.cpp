@@ -0,0 +1,265 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "../testing/core.h"
+#include "../testing/systems/melt.h"
+#include "../testing/utils.h"
+#include "fmt/format.h"
+#include "library.h"
+#include "utils.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using ::testing::Eq;
+
+bool verbose = false;
+
+namespace LAMMPS_NS {
+
+// minimal reader for uncompressed columnar dump frames
+
+struct ColumnarFrame {
+    int64_t timestep, natoms;
+    int32_t nchunk, triclinic;
+    std::vector<double> box;
+    std::string units;
+    std::map<std::string, double> thermo;
+    std::vector<std::string> names;
+    std::vector<uint8_t> types;
+    std::map<std::string, std::vector<double>> columns;
+};
+
+static std::string read_string(FILE *fp)
+{
+    int32_t len = 0;
+    fread(&len, sizeof(int32_t), 1, fp);
+    std::string str(len, ' ');
+    if (len) fread(&str[0], sizeof(char), len, fp);
+    return str;
+}
+
+static bool read_frame(FILE *fp, ColumnarFrame &frame)
+{
+    char magic[8];
+    if (fread(magic, sizeof(char), 8, fp) != 8) return false;
+    if (std::string(magic) != "LMPCOLS") return false;
+
+    int32_t version, endian, ibuf[7];
+    fread(&version, sizeof(int32_t), 1, fp);
+    fread(&endian, sizeof(int32_t), 1, fp);
+    fread(&frame.timestep, sizeof(int64_t), 1, fp);
+    fread(&frame.natoms, sizeof(int64_t), 1, fp);
+    fread(&frame.nchunk, sizeof(int32_t), 1, fp);
+    fread(ibuf, sizeof(int32_t), 7, fp);
+    frame.triclinic = ibuf[0];
+    frame.box.resize(frame.triclinic ? 9 : 6);
+    fread(frame.box.data(), sizeof(double), frame.box.size(), fp);
+    frame.units = read_string(fp);
+
+    uint8_t flag;
+    double time;
+    fread(&flag, sizeof(uint8_t), 1, fp);
+    if (flag) fread(&time, sizeof(double), 1, fp);
+
+    int32_t nthermo;
+    fread(&nthermo, sizeof(int32_t), 1, fp);
+    for (int i = 0; i < nthermo; ++i) {
+        auto key = read_string(fp);
+        fread(&frame.thermo[key], sizeof(double), 1, fp);
+    }
+
+    int32_t ncol;
+    fread(&ncol, sizeof(int32_t), 1, fp);
+    frame.names.clear();
+    frame.types.clear();
+    frame.columns.clear();
+    for (int i = 0; i < ncol; ++i) {
+        frame.names.push_back(read_string(fp));
+        uint8_t type;
+        fread(&type, sizeof(uint8_t), 1, fp);
+        frame.types.push_back(type);
+    }
+
+    for (int ichunk = 0; ichunk < frame.nchunk; ++ichunk) {
+        int32_t nrows;
+        fread(&nrows, sizeof(int32_t), 1, fp);
+        for (int i = 0; i < ncol; ++i) {
+            uint8_t codec;
+            int64_t nbytes;
+            fread(&codec, sizeof(uint8_t), 1, fp);
+            fread(&nbytes, sizeof(int64_t), 1, fp);
+            std::vector<char> data(nbytes);
+            if (nbytes) fread(data.data(), sizeof(char), nbytes, fp);
+            auto &col = frame.columns[frame.names[i]];
+            for (int j = 0; j < nrows; ++j) {
+                if (frame.types[i] == 0)
+                    col.push_back(((int32_t *)data.data())[j]);
+                else if (frame.types[i] == 1)
+                    col.push_back(((int64_t *)data.data())[j]);
+                else if (frame.types[i] == 2)
+                    col.push_back(((float *)data.data())[j]);
+                else
+                    col.push_back(((double *)data.data())[j]);
+            }
+        }
+    }
+    return true;
+}
+
+class DumpColumnarTest : public MeltTest {
+public:
+    void SetUp() override
+    {
+        MeltTest::SetUp();
+        if (!lammps_has_style(lmp, "dump", "columnar")) GTEST_SKIP();
+    }
+
+    void enable_triclinic()
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("change_box all triclinic");
+        END_HIDE_OUTPUT();
+    }
+
+    void generate_dumps(const std::string &text_file, const std::string &columnar_file,
+                        const std::string &fields, const std::string &dump_modify_options,
+                        int ntimesteps)
+    {
+        BEGIN_HIDE_OUTPUT();
+        command(fmt::format("dump id0 all custom 1 {} {}", text_file, fields));
+        command(fmt::format("dump id1 all columnar 1 {} {}", columnar_file, fields));
+        command("dump_modify id0 sort id format float %20.17g");
+        command("dump_modify id1 sort id");
+        if (!dump_modify_options.empty())
+            command(fmt::format("dump_modify id1 {}", dump_modify_options));
+        command(fmt::format("run {} post no", ntimesteps));
+        command("undump id0");
+        command("undump id1");
+        END_HIDE_OUTPUT();
+    }
+};
+
+TEST_F(DumpColumnarTest, run1)
+{
+    auto text_file     = "dump_columnar_text_run1.melt";
+    auto columnar_file = "dump_columnar_run1.melt.lcol";
+    auto fields        = "id type proc x y z ix iy iz vx vy vz fx fy fz";
+
+    generate_dumps(text_file, columnar_file, fields, "units yes thermo yes", 1);
+
+    ASSERT_FILE_EXISTS(text_file);
+    ASSERT_FILE_EXISTS(columnar_file);
+
+    auto lines = read_lines(text_file);
+    ASSERT_EQ(lines.size(), 82);
+
+    FILE *fp = fopen(columnar_file, "rb");
+    ASSERT_NE(fp, nullptr);
+    ColumnarFrame frame;
+    for (int iframe = 0; iframe < 2; ++iframe) {
+        ASSERT_TRUE(read_frame(fp, frame));
+        ASSERT_EQ(frame.timestep, iframe);
+        ASSERT_EQ(frame.natoms, 32);
+        ASSERT_EQ(frame.triclinic, 0);
+        ASSERT_THAT(frame.units, Eq("lj"));
+        ASSERT_EQ(frame.thermo.count("Step"), 1);
+        ASSERT_DOUBLE_EQ(frame.thermo["Step"], iframe);
+        ASSERT_EQ(frame.names, utils::split_words(fields));
+        ASSERT_EQ(frame.types[0], 1);    // id is int64
+        ASSERT_EQ(frame.types[1], 0);    // type is int32
+        ASSERT_EQ(frame.types[3], 3);    // x is float64
+
+        // compare against text dump of the same frame
+
+        for (int i = 0; i < 32; ++i) {
+            auto words = utils::split_words(lines[41 * iframe + 9 + i]);
+            for (int j = 0; j < (int)frame.names.size(); ++j)
+                ASSERT_DOUBLE_EQ(frame.columns[frame.names[j]][i], std::stod(words[j]));
+        }
+    }
+    ASSERT_FALSE(read_frame(fp, frame));
+    fclose(fp);
+    delete_file(text_file);
+    delete_file(columnar_file);
+}
+
+TEST_F(DumpColumnarTest, single_triclinic_run0)
+{
+    auto text_file     = "dump_columnar_text_tri_run0.melt";
+    auto columnar_file = "dump_columnar_tri_run0.melt.lcol";
+    auto fields        = "id type x y z";
+
+    enable_triclinic();
+    generate_dumps(text_file, columnar_file, fields, "precision single", 0);
+
+    auto lines = read_lines(text_file);
+    FILE *fp   = fopen(columnar_file, "rb");
+    ASSERT_NE(fp, nullptr);
+    ColumnarFrame frame;
+    ASSERT_TRUE(read_frame(fp, frame));
+    ASSERT_EQ(frame.triclinic, 1);
+    ASSERT_EQ(frame.box.size(), 9);
+    ASSERT_TRUE(frame.units.empty());
+    ASSERT_TRUE(frame.thermo.empty());
+    ASSERT_EQ(frame.types[2], 2);    // x is float32
+    for (int i = 0; i < 32; ++i) {
+        auto words = utils::split_words(lines[9 + i]);
+        ASSERT_EQ(frame.columns["id"][i], std::stod(words[0]));
+        ASSERT_FLOAT_EQ(frame.columns["x"][i], std::stof(words[2]));
+    }
+    fclose(fp);
+    delete_file(text_file);
+    delete_file(columnar_file);
+}
+
+TEST_F(DumpColumnarTest, invalid)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("dump id1 all columnar 1 dump.lcol id type x y z");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Unknown dump_modify precision setting half.*",
+                 command("dump_modify id1 precision half"););
+    TEST_FAILURE(".*ERROR: Unknown dump_modify codec setting lz4.*",
+                 command("dump_modify id1 codec lz4"););
+    TEST_FAILURE(".*ERROR: Dump columnar does not support string attribute element.*",
+                 command("dump id2 all columnar 1 dump.lcol id element x y z"););
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
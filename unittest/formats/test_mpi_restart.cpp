@@ -0,0 +1,183 @@
+// unit tests for reading single restart files with a chunk index in parallel
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "input.h"
+#include "lammps.h"
+#include "utils.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPIRestartTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp;
+
+    void SetUp() override
+    {
+        const char *args[] = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        char **argv        = (char **)args;
+        int argc           = sizeof(args) / sizeof(char *);
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(argc, argv, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (comm_me() == 0) {
+            remove("mpi_test.restart");
+            remove("mpi_test-base.restart");
+            for (int i = 0; i < 4; ++i)
+                remove(fmt::format("mpi_test-{}.restart", i).c_str());
+        }
+    }
+
+    static int comm_me()
+    {
+        int me;
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        return me;
+    }
+
+    // write a perturbed, load balanced lattice with velocities as a single
+    // restart file with chunk index and as a set of per-proc restart files
+
+    void write_restarts(bool triclinic)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("processors 2 2 1");
+        command("units lj");
+        command("atom_style atomic");
+        command("lattice fcc 0.8442");
+        command("region box block 0 6 0 5 0 4");
+        command("create_box 2 box");
+        command("create_atoms 1 box");
+        command("set type 1 type/fraction 2 0.3 6743");
+        command("mass * 1.0");
+        command("displace_atoms all random 0.2 0.2 0.2 87287");
+        command("velocity all create 1.5 4928459");
+        if (triclinic) command("change_box all triclinic xy final 1.2 xz final -0.7");
+        command("balance 1.0 x 0.35 y 0.6");
+        command("write_restart mpi_test.restart");
+        command("write_restart mpi_test-%.restart");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // read a restart file with a different processor grid than it was written with
+
+    void read_restart(const std::string &file, const std::string &grid)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        command("processors " + grid);
+        command("read_restart " + file);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // per-atom type, position, and velocity ordered by atom ID on all procs
+
+    std::vector<double> gather()
+    {
+        auto atom          = lmp->atom;
+        const int natoms   = atom->natoms;
+        const int nlocal   = atom->nlocal;
+        std::vector<double> mine(7 * natoms, 0.0), all(7 * natoms, 0.0);
+        for (int i = 0; i < nlocal; ++i) {
+            double *row = &mine[7 * (atom->tag[i] - 1)];
+            row[0]      = atom->type[i];
+            for (int k = 0; k < 3; ++k) {
+                row[1 + k] = atom->x[i][k];
+                row[4 + k] = atom->v[i][k];
+            }
+        }
+        MPI_Allreduce(mine.data(), all.data(), 7 * natoms, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        return all;
+    }
+
+    // count owned atoms outside my sub-domain
+
+    int outside_subdomain()
+    {
+        auto atom   = lmp->atom;
+        auto domain = lmp->domain;
+        double lamda[3], *coord, *sublo, *subhi;
+        if (domain->triclinic) {
+            sublo = domain->sublo_lamda;
+            subhi = domain->subhi_lamda;
+        } else {
+            sublo = domain->sublo;
+            subhi = domain->subhi;
+        }
+
+        int nout = 0;
+        for (int i = 0; i < atom->nlocal; ++i) {
+            if (domain->triclinic) {
+                domain->x2lamda(atom->x[i], lamda);
+                coord = lamda;
+            } else
+                coord = atom->x[i];
+            for (int k = 0; k < 3; ++k)
+                if ((coord[k] < sublo[k]) || (coord[k] >= subhi[k])) ++nout;
+        }
+        return nout;
+    }
+
+    // the multi-file reader migrates atoms after reading, which for triclinic
+    // boxes converts coordinates to lamda and back, so allow for round-off
+
+    void compare_with_multi_file(const std::string &grid)
+    {
+        read_restart("mpi_test-%.restart", grid);
+        const bigint natoms = lmp->atom->natoms;
+        auto ref            = gather();
+
+        read_restart("mpi_test.restart", grid);
+        ASSERT_EQ(lmp->atom->natoms, natoms);
+        bigint nlocal = lmp->atom->nlocal, nall;
+        MPI_Allreduce(&nlocal, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+        ASSERT_EQ(nall, natoms);
+        ASSERT_EQ(outside_subdomain(), 0);
+
+        auto data = gather();
+        ASSERT_EQ(data.size(), ref.size());
+        for (std::size_t i = 0; i < data.size(); ++i)
+            ASSERT_NEAR(data[i], ref[i], 1.0e-13);
+    }
+};
+
+TEST_F(MPIRestartTest, chunk_index_orthogonal)
+{
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    write_restarts(false);
+    compare_with_multi_file("1 2 2");
+    compare_with_multi_file("4 1 1");
+}
+
+TEST_F(MPIRestartTest, chunk_index_triclinic)
+{
+    ASSERT_EQ(lmp->comm->nprocs, 4);
+    write_restarts(true);
+    compare_with_multi_file("2 1 2");
+    compare_with_multi_file("1 4 1");
+}
+} // namespace LAMMPS_NS
@@ -39,9 +39,11 @@ TEST(MyPage, int)
     ASSERT_EQ(p.ndatum, 1);
     ASSERT_EQ(p.nchunk, 1);
     ASSERT_EQ(iptr, p.vget());
-    // use too large chunk size
+    // use larger chunk size than maxchunk, which fits into the page reserve
     p.vgot(2);
-    ASSERT_EQ(1, p.status());
+    ASSERT_EQ(0, p.status());
+    ASSERT_EQ(p.ngrow, 1);
+    ASSERT_EQ(p.chunkmax, 2);
 
     p.reset();
     ASSERT_EQ(p.ndatum, 0);
@@ -72,9 +74,16 @@ TEST(MyPage, int)
     ASSERT_EQ(p.ndatum, 16);
     ASSERT_EQ(p.nchunk, 1);
 
-    // use too large chunk size
+    // use larger chunk size than maxchunk, which fits into the page reserve
     ASSERT_EQ(iptr, p.vget());
     p.vgot(32);
+    ASSERT_EQ(0, p.status());
+    ASSERT_EQ(p.ngrow, 1);
+    ASSERT_EQ(p.chunkmax, 32);
+
+    // use too large chunk size for page and reserve
+    p.vget();
+    p.vgot(81);
     ASSERT_EQ(1, p.status());
 
     p.reset();
@@ -90,7 +99,7 @@ TEST(MyPage, int)
     ASSERT_EQ(iptr, p.get());
     ++iptr;
     ASSERT_EQ(iptr, p.get(16));
-    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(int) * 128.0);
+    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(int) * 160.0);
     ASSERT_EQ(p.ndatum, 37);
     ASSERT_EQ(p.nchunk, 4);
     p.get(16);
@@ -103,7 +112,7 @@ TEST(MyPage, int)
     p.get(16);
     iptr += 16;
     ASSERT_NE(iptr, p.get(16));
-    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(int) * 256.0);
+    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(int) * 320.0);
     ASSERT_EQ(p.ndatum, 133);
     ASSERT_EQ(p.nchunk, 10);
 }
@@ -128,9 +137,11 @@ TEST(MyPage, double)
     ASSERT_EQ(p.ndatum, 1);
     ASSERT_EQ(p.nchunk, 1);
     ASSERT_EQ(iptr, p.vget());
-    // use too large chunk size
+    // use larger chunk size than maxchunk, which fits into the page reserve
     p.vgot(2);
-    ASSERT_EQ(1, p.status());
+    ASSERT_EQ(0, p.status());
+    ASSERT_EQ(p.ngrow, 1);
+    ASSERT_EQ(p.chunkmax, 2);
 
     p.reset();
     ASSERT_EQ(p.ndatum, 0);
@@ -161,9 +172,16 @@ TEST(MyPage, double)
     ASSERT_EQ(p.ndatum, 16);
     ASSERT_EQ(p.nchunk, 1);
 
-    // use too large chunk size
+    // use larger chunk size than maxchunk, which fits into the page reserve
     ASSERT_EQ(iptr, p.vget());
     p.vgot(32);
+    ASSERT_EQ(0, p.status());
+    ASSERT_EQ(p.ngrow, 1);
+    ASSERT_EQ(p.chunkmax, 32);
+
+    // use too large chunk size for page and reserve
+    p.vget();
+    p.vgot(81);
     ASSERT_EQ(1, p.status());
 
     p.reset();
@@ -179,7 +197,7 @@ TEST(MyPage, double)
     ASSERT_EQ(iptr, p.get());
     ++iptr;
     ASSERT_EQ(iptr, p.get(16));
-    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(double) * 128.0);
+    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(double) * 160.0);
     ASSERT_EQ(p.ndatum, 37);
     ASSERT_EQ(p.nchunk, 4);
     p.get(16);
@@ -192,7 +210,7 @@ TEST(MyPage, double)
     p.get(16);
     iptr += 16;
     ASSERT_NE(iptr, p.get(16));
-    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(double) * 256.0);
+    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(double) * 320.0);
     ASSERT_EQ(p.ndatum, 133);
     ASSERT_EQ(p.nchunk, 10);
 }
@@ -217,9 +235,11 @@ TEST(MyPage, bigint)
     ASSERT_EQ(p.ndatum, 1);
     ASSERT_EQ(p.nchunk, 1);
     ASSERT_EQ(iptr, p.vget());
-    // use too large chunk size
+    // use larger chunk size than maxchunk, which fits into the page reserve
     p.vgot(2);
-    ASSERT_EQ(1, p.status());
+    ASSERT_EQ(0, p.status());
+    ASSERT_EQ(p.ngrow, 1);
+    ASSERT_EQ(p.chunkmax, 2);
 
     p.reset();
     ASSERT_EQ(p.ndatum, 0);
@@ -250,9 +270,16 @@ TEST(MyPage, bigint)
     ASSERT_EQ(p.ndatum, 16);
     ASSERT_EQ(p.nchunk, 1);
 
-    // use too large chunk size
+    // use larger chunk size than maxchunk, which fits into the page reserve
     ASSERT_EQ(iptr, p.vget());
     p.vgot(32);
+    ASSERT_EQ(0, p.status());
+    ASSERT_EQ(p.ngrow, 1);
+    ASSERT_EQ(p.chunkmax, 32);
+
+    // use too large chunk size for page and reserve
+    p.vget();
+    p.vgot(81);
     ASSERT_EQ(1, p.status());
 
     p.reset();
@@ -268,7 +295,7 @@ TEST(MyPage, bigint)
     ASSERT_EQ(iptr, p.get());
     ++iptr;
     ASSERT_EQ(iptr, p.get(16));
-    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(bigint) * 128.0);
+    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(bigint) * 160.0);
     ASSERT_EQ(p.ndatum, 37);
     ASSERT_EQ(p.nchunk, 4);
     p.get(16);
@@ -281,7 +308,7 @@ TEST(MyPage, bigint)
     p.get(16);
     iptr += 16;
     ASSERT_NE(iptr, p.get(16));
-    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(bigint) * 256.0);
+    ASSERT_DOUBLE_EQ(p.size(), (double)sizeof(bigint) * 320.0);
     ASSERT_EQ(p.ndatum, 133);
     ASSERT_EQ(p.nchunk, 10);
 }